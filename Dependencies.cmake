@@ -57,6 +57,36 @@ add_library(asio INTERFACE ${ASIO_SOURCES})
 target_include_directories(asio INTERFACE "${asio_SOURCE_DIR}/include")
 target_link_libraries(asio INTERFACE Threads::Threads)
 set_target_properties(asio PROPERTIES LINKER_LANGUAGE CXX FOLDER "dependencies/asio")
+# On Linux asio only does file I/O through io_uring, without it Utils::FileService falls back to blocking reads & writes
+if (CMAKE_SYSTEM_NAME STREQUAL "Linux")
+    option(MCPP_IO_URING "Use io_uring for file I/O, needs liburing" ON)
+    if (MCPP_IO_URING)
+        find_package(PkgConfig)
+        if (PkgConfig_FOUND)
+            pkg_check_modules(liburing IMPORTED_TARGET liburing)
+        endif ()
+        if (liburing_FOUND)
+            message(STATUS "[MCpp] Using io_uring for file I/O")
+            target_compile_definitions(asio INTERFACE ASIO_HAS_IO_URING)
+            target_link_libraries(asio INTERFACE PkgConfig::liburing)
+        else ()
+            message(WARNING "[MCpp] liburing not found, file I/O falls back to blocking reads & writes")
+        endif ()
+    endif ()
+endif ()
+
+message(STATUS "[MCpp] Getting libdeflate ...")
+set(LIBDEFLATE_BUILD_STATIC_LIB ON CACHE BOOL "" FORCE)
+set(LIBDEFLATE_BUILD_SHARED_LIB OFF CACHE BOOL "" FORCE)
+set(LIBDEFLATE_BUILD_GZIP OFF CACHE BOOL "" FORCE)
+set(LIBDEFLATE_BUILD_TESTS OFF CACHE BOOL "" FORCE)
+# Pinned by commit (v1.22), a tag could be moved
+FetchContent_Declare(libdeflate
+        GIT_REPOSITORY https://github.com/ebiggers/libdeflate
+        GIT_TAG 96836d7d9d10e3e0d53e6edb54eb908514e336c4
+)
+FetchContent_MakeAvailable(libdeflate)
+set_target_properties(libdeflate_static PROPERTIES FOLDER "dependencies/libdeflate")
 
 message(STATUS "[MCpp] Getting glfw ...")
 set(GLFW_BUILD_DOCS OFF CACHE BOOL "" FORCE)
@@ -0,0 +1,13 @@
+#include "Benchmark.h"
+
+std::vector<Bench::BenchmarkInfo> &Bench::getBenchmarks()
+{
+    static std::vector<BenchmarkInfo> s_benchmarks;
+    return s_benchmarks;
+}
+
+bool Bench::registerBenchmark(std::string a_name, BenchmarkFunction a_function)
+{
+    getBenchmarks().push_back({std::move(a_name), std::move(a_function)});
+    return true;
+}
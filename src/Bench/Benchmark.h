@@ -0,0 +1,102 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Bench
+{
+    // Passed to every benchmark, the code to measure goes into a `while (a_state.keepRunning())` loop,
+    // everything before the loop is setup & isn't timed
+    class State final
+    {
+    public:
+        explicit State(const size_t a_iterations)
+            : m_targetIterations(a_iterations) {}
+
+        [[nodiscard]]
+        bool keepRunning()
+        {
+            if (m_iterations == 0)
+            {
+                m_start = std::chrono::steady_clock::now();
+            }
+
+            if (m_iterations == m_targetIterations)
+            {
+                m_end = std::chrono::steady_clock::now();
+                return false;
+            }
+
+            m_iterations++;
+            return true;
+        }
+
+        // Amount of items (entities, bytes, packets ...) one iteration processes, used for the throughput column
+        void setItemsPerIteration(const size_t a_items)
+        {
+            m_itemsPerIteration = a_items;
+        }
+
+        [[nodiscard]]
+        size_t getIterations() const
+        {
+            return m_iterations;
+        }
+
+        [[nodiscard]]
+        size_t getItemsPerIteration() const
+        {
+            return m_itemsPerIteration;
+        }
+
+        [[nodiscard]]
+        std::chrono::nanoseconds getElapsed() const
+        {
+            return m_end - m_start;
+        }
+
+    private:
+        size_t m_targetIterations;
+        size_t m_iterations = 0;
+        size_t m_itemsPerIteration = 1;
+        std::chrono::steady_clock::time_point m_start;
+        std::chrono::steady_clock::time_point m_end;
+    };
+
+    // Keeps the compiler from optimizing away a computed value
+    template<typename T>
+    void doNotOptimize(const T &a_value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(a_value) : "memory");
+#else
+        static volatile const T *s_sink;
+        s_sink = &a_value;
+#endif
+    }
+
+    // Data shared by the benchmarks of a file, built by the first one that runs & kept until the process exits, so
+    // building it isn't timed & benchmarks that are filtered out don't pay for it
+    template<typename Fixture>
+    [[nodiscard]]
+    const Fixture &getFixture()
+    {
+        static const Fixture s_fixture;
+        return s_fixture;
+    }
+
+    using BenchmarkFunction = std::function<void(State &)>;
+
+    struct BenchmarkInfo
+    {
+        std::string name;
+        BenchmarkFunction function;
+    };
+
+    std::vector<BenchmarkInfo> &getBenchmarks();
+
+    bool registerBenchmark(std::string a_name, BenchmarkFunction a_function);
+}
@@ -0,0 +1,76 @@
+#include <random>
+#include <vector>
+
+#include "../Client/Colors.h"
+#include "Benchmark.h"
+
+// About the tinted grass & leaves of a few chunk sections, converted one by one & with the batch functions (AVX2 if
+// Colors::isVectorized())
+constexpr size_t g_colorCount = 4096;
+
+struct ColorsFixture
+{
+    std::vector<uint32_t> colors;
+    std::vector<uint32_t> tints;
+    std::vector<vec4> floatColors;
+    std::vector<vec3> hsv;
+
+    ColorsFixture()
+    {
+        std::mt19937 random(1234);
+        std::uniform_real_distribution unit(0.f, 1.f);
+        for (size_t i = 0; i < g_colorCount; i++)
+        {
+            colors.push_back(static_cast<uint32_t>(random()));
+            tints.push_back(static_cast<uint32_t>(random()) | 0xFF000000);
+            floatColors.emplace_back(unit(random), unit(random), unit(random), unit(random));
+            hsv.emplace_back(unit(random), unit(random), unit(random));
+        }
+    }
+};
+
+template<typename Function>
+void benchmarkColors(Bench::State &a_state, Function &&a_function)
+{
+    const ColorsFixture &fixture = Bench::getFixture<ColorsFixture>();
+    std::vector<uint32_t> packed(g_colorCount);
+    std::vector<vec4> unpacked(g_colorCount);
+    a_state.setItemsPerIteration(g_colorCount);
+
+    while (a_state.keepRunning())
+    {
+        a_function(fixture, packed, unpacked);
+        Bench::doNotOptimize(packed.data());
+        Bench::doNotOptimize(unpacked.data());
+    }
+}
+
+#define MCPP_COLORS_BENCHMARK(name, scalar, batch) \
+    [[maybe_unused]] static const bool g_##name##ScalarRegistered = Bench::registerBenchmark("Colors/" #name "/scalar", [](Bench::State &a_state) \
+    { \
+        benchmarkColors(a_state, [](const ColorsFixture &a_fixture, std::vector<uint32_t> &a_packed, std::vector<vec4> &a_unpacked) \
+        { \
+            for (size_t i = 0; i < g_colorCount; i++) \
+            { \
+                scalar; \
+            } \
+        }); \
+    }); \
+    [[maybe_unused]] static const bool g_##name##BatchRegistered = Bench::registerBenchmark("Colors/" #name "/batch", [](Bench::State &a_state) \
+    { \
+        benchmarkColors(a_state, [](const ColorsFixture &a_fixture, std::vector<uint32_t> &a_packed, std::vector<vec4> &a_unpacked) \
+        { \
+            batch; \
+        }); \
+    });
+
+MCPP_COLORS_BENCHMARK(packARGB, a_packed[i] = Colors::fromARGBv(a_fixture.floatColors[i]),
+                      Colors::packARGB(a_fixture.floatColors, a_packed))
+MCPP_COLORS_BENCHMARK(unpackARGB, a_unpacked[i] = Colors::toARGBv(a_fixture.colors[i]),
+                      Colors::unpackARGB(a_fixture.colors, a_unpacked))
+MCPP_COLORS_BENCHMARK(fromHSV, a_packed[i] = Colors::fromHSV(a_fixture.hsv[i].x, a_fixture.hsv[i].y, a_fixture.hsv[i].z),
+                      Colors::fromHSV(a_fixture.hsv, a_packed))
+MCPP_COLORS_BENCHMARK(srgbToLinear, a_packed[i] = Colors::srgbToLinear(a_fixture.colors[i]),
+                      Colors::srgbToLinear(a_fixture.colors, a_packed))
+MCPP_COLORS_BENCHMARK(multiply, a_packed[i] = Colors::multiply(a_fixture.colors[i], a_fixture.tints[i]),
+                      Colors::multiply(a_fixture.colors, a_fixture.tints, a_packed))
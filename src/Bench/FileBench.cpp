@@ -0,0 +1,180 @@
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "Utils/AssetBundle.h"
+#include "Utils/FileService.h"
+#include "Benchmark.h"
+
+// About the shaders & textures of a resource pack, then a region file with chunk sized reads at random offsets; the
+// files are in the page cache after the first iteration, so this measures the cost per operation, not the disk
+constexpr size_t g_assetCount = 256;
+constexpr size_t g_assetSize = 16 << 10;
+constexpr size_t g_regionSize = 16 << 20;
+constexpr size_t g_chunkReadSize = 8 << 10;
+constexpr size_t g_chunkReadCount = 256;
+
+struct FileFixture
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "mcpp-bench-files";
+    std::vector<std::filesystem::path> assets;
+    std::filesystem::path bundle = directory / "assets.mcpack";
+    std::filesystem::path region = directory / "r.0.0.mcpp";
+    std::vector<uint64_t> chunkOffsets;
+
+    FileFixture()
+    {
+        std::filesystem::create_directories(directory);
+        std::mt19937_64 random(1234);
+        std::vector<char> data(g_regionSize);
+        for (char &byte: data)
+        {
+            byte = static_cast<char>(random());
+        }
+
+        for (size_t i = 0; i < g_assetCount; i++)
+        {
+            assets.push_back(directory / std::format("asset{}.bin", i));
+            std::ofstream(assets.back(), std::ios::binary).write(data.data() + i * g_assetSize, g_assetSize);
+        }
+        std::ofstream(region, std::ios::binary).write(data.data(), g_regionSize);
+
+        Utils::AssetBundleWriter writer;
+        for (size_t i = 0; i < g_assetCount; i++)
+        {
+            writer.add(Utils::Identifier::ofVanilla(std::format("asset{}.bin", i)).value(),
+                       std::as_bytes(std::span(data).subspan(i * g_assetSize, g_assetSize)));
+        }
+        writer.write(bundle);
+
+        std::uniform_int_distribution<uint64_t> sector(0, (g_regionSize - g_chunkReadSize) / 4096);
+        for (size_t i = 0; i < g_chunkReadCount; i++)
+        {
+            chunkOffsets.push_back(sector(random) * 4096);
+        }
+    }
+
+    FileFixture(const FileFixture &) = delete;
+
+    FileFixture &operator=(const FileFixture &) = delete;
+
+    ~FileFixture()
+    {
+        std::error_code error;
+        std::filesystem::remove_all(directory, error);
+    }
+};
+
+// What ResourceManager::getResource does with every loose file
+void benchmarkAssetsIfstream(Bench::State &a_state)
+{
+    const FileFixture &fixture = Bench::getFixture<FileFixture>();
+    a_state.setItemsPerIteration(g_assetCount * g_assetSize);
+
+    while (a_state.keepRunning())
+    {
+        for (const std::filesystem::path &asset: fixture.assets)
+        {
+            std::basic_ifstream<char> stream(asset);
+            const std::vector<char> chars(std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{});
+            Bench::doNotOptimize(chars.data());
+        }
+    }
+}
+
+// What ResourceManager does with a bundle: one mapping & a lookup per asset, touching every page of it
+void benchmarkAssetsBundle(Bench::State &a_state)
+{
+    const FileFixture &fixture = Bench::getFixture<FileFixture>();
+    a_state.setItemsPerIteration(g_assetCount * g_assetSize);
+
+    while (a_state.keepRunning())
+    {
+        const Utils::AssetBundle bundle(fixture.bundle);
+        for (size_t i = 0; i < g_assetCount; i++)
+        {
+            const std::span<const std::byte> asset = bundle.find(std::format("vanilla:asset{}.bin", i)).value();
+            std::byte sum{};
+            for (size_t offset = 0; offset < asset.size(); offset += 4096)
+            {
+                sum ^= asset[offset];
+            }
+            Bench::doNotOptimize(sum);
+        }
+    }
+}
+
+// Every file at once, like loading a resource pack
+void benchmarkAssetsFileService(Bench::State &a_state)
+{
+    const FileFixture &fixture = Bench::getFixture<FileFixture>();
+    Utils::FileService files;
+    std::vector<std::future<std::vector<std::byte>>> reads;
+    a_state.setItemsPerIteration(g_assetCount * g_assetSize);
+
+    while (a_state.keepRunning())
+    {
+        for (const std::filesystem::path &asset: fixture.assets)
+        {
+            reads.push_back(asio::co_spawn(files.getContext(), files.readFile(asset), asio::use_future));
+        }
+        for (std::future<std::vector<std::byte>> &read: reads)
+        {
+            Bench::doNotOptimize(read.get().data());
+        }
+        reads.clear();
+    }
+}
+
+void benchmarkChunksIfstream(Bench::State &a_state)
+{
+    const FileFixture &fixture = Bench::getFixture<FileFixture>();
+    std::ifstream stream(fixture.region, std::ios::binary);
+    std::vector<char> chunk(g_chunkReadSize);
+    a_state.setItemsPerIteration(g_chunkReadCount);
+
+    while (a_state.keepRunning())
+    {
+        for (const uint64_t offset: fixture.chunkOffsets)
+        {
+            stream.seekg(static_cast<std::streamoff>(offset));
+            stream.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            Bench::doNotOptimize(chunk.data());
+        }
+    }
+}
+
+// Every read at once, like the chunks around a player that just joined
+void benchmarkChunksFileService(Bench::State &a_state)
+{
+    const FileFixture &fixture = Bench::getFixture<FileFixture>();
+    Utils::FileService files;
+    Utils::FileService::File region(files, fixture.region, Utils::FileService::File::Mode::Read);
+    std::vector<std::vector<std::byte>> chunks(g_chunkReadCount, std::vector<std::byte>(g_chunkReadSize));
+    std::vector<std::future<size_t>> reads;
+    a_state.setItemsPerIteration(g_chunkReadCount);
+
+    while (a_state.keepRunning())
+    {
+        for (size_t i = 0; i < g_chunkReadCount; i++)
+        {
+            reads.push_back(asio::co_spawn(files.getContext(), region.read(fixture.chunkOffsets[i], chunks[i]), asio::use_future));
+        }
+        for (std::future<size_t> &read: reads)
+        {
+            Bench::doNotOptimize(read.get());
+        }
+        reads.clear();
+    }
+}
+
+[[maybe_unused]] static const bool g_assetsIfstreamRegistered = Bench::registerBenchmark("File/assetsIfstream", benchmarkAssetsIfstream);
+[[maybe_unused]] static const bool g_assetsBundleRegistered = Bench::registerBenchmark("File/assetsBundle", benchmarkAssetsBundle);
+[[maybe_unused]] static const bool g_assetsFileServiceRegistered = Bench::registerBenchmark("File/assetsFileService", benchmarkAssetsFileService);
+[[maybe_unused]] static const bool g_chunksIfstreamRegistered = Bench::registerBenchmark("File/chunkReadsIfstream", benchmarkChunksIfstream);
+[[maybe_unused]] static const bool g_chunksFileServiceRegistered = Bench::registerBenchmark("File/chunkReadsFileService", benchmarkChunksFileService);
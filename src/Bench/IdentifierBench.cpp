@@ -0,0 +1,103 @@
+#include <format>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Utils/Identifier.h"
+#include "Benchmark.h"
+
+// About what loading the blocks, items & textures of a resource pack goes through
+constexpr size_t g_identifierCount = 1024;
+
+std::vector<std::string> makeIdentifierStrings()
+{
+    constexpr const char *namespaces[] = {"vanilla", "mcpp", "some_mod", "another.mod-name"};
+    constexpr const char *directories[] = {"block", "item", "textures/block", "textures/entity/player", "shaders"};
+
+    std::vector<std::string> strings;
+    for (size_t i = 0; i < g_identifierCount; i++)
+    {
+        strings.push_back(std::format("{}:{}/entry_{}", namespaces[i % std::size(namespaces)],
+                                      directories[i / std::size(namespaces) % std::size(directories)], i));
+    }
+    return strings;
+}
+
+void benchmarkParse(Bench::State &a_state)
+{
+    const std::vector<std::string> strings = makeIdentifierStrings();
+    a_state.setItemsPerIteration(g_identifierCount);
+
+    while (a_state.keepRunning())
+    {
+        for (const std::string &string: strings)
+        {
+            const std::optional<Utils::Identifier> identifier = Utils::Identifier::parse(string);
+            Bench::doNotOptimize(identifier);
+        }
+    }
+}
+
+// Every character is checked, an invalid one near the end is the worst case
+void benchmarkParseInvalid(Bench::State &a_state)
+{
+    std::vector<std::string> strings = makeIdentifierStrings();
+    for (std::string &string: strings)
+    {
+        string.back() = 'X';
+    }
+    a_state.setItemsPerIteration(g_identifierCount);
+
+    while (a_state.keepRunning())
+    {
+        for (const std::string &string: strings)
+        {
+            const std::optional<Utils::Identifier> identifier = Utils::Identifier::parse(string);
+            Bench::doNotOptimize(identifier);
+        }
+    }
+}
+
+void benchmarkToString(Bench::State &a_state)
+{
+    std::vector<Utils::Identifier> identifiers;
+    for (const std::string &string: makeIdentifierStrings())
+    {
+        identifiers.push_back(Utils::Identifier::parse(string).value());
+    }
+    a_state.setItemsPerIteration(g_identifierCount);
+
+    while (a_state.keepRunning())
+    {
+        for (const Utils::Identifier &identifier: identifiers)
+        {
+            const std::string string = identifier.toString();
+            Bench::doNotOptimize(string.data());
+        }
+    }
+}
+
+// What getCompiledShader does to the identifier of every shader
+void benchmarkWithPath(Bench::State &a_state)
+{
+    std::vector<Utils::Identifier> identifiers;
+    for (const std::string &string: makeIdentifierStrings())
+    {
+        identifiers.push_back(Utils::Identifier::parse(string).value());
+    }
+    a_state.setItemsPerIteration(g_identifierCount);
+
+    while (a_state.keepRunning())
+    {
+        for (const Utils::Identifier &identifier: identifiers)
+        {
+            const Utils::Identifier shader = identifier.withSuffixedPath(".vert").withPrefixedPath("shaders/");
+            Bench::doNotOptimize(shader);
+        }
+    }
+}
+
+[[maybe_unused]] static const bool g_parseRegistered = Bench::registerBenchmark("Identifier/parse", benchmarkParse);
+[[maybe_unused]] static const bool g_parseInvalidRegistered = Bench::registerBenchmark("Identifier/parseInvalid", benchmarkParseInvalid);
+[[maybe_unused]] static const bool g_toStringRegistered = Bench::registerBenchmark("Identifier/toString", benchmarkToString);
+[[maybe_unused]] static const bool g_withPathRegistered = Bench::registerBenchmark("Identifier/withPrefixedSuffixedPath", benchmarkWithPath);
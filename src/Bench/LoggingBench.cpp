@@ -0,0 +1,100 @@
+#include <barrier>
+#include <memory>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+#include "spdlog/async.h"
+#include "spdlog/sinks/ostream_sink.h"
+#include "Benchmark.h"
+#include "Logging.h"
+
+// Messages per thread & iteration, more than the queue holds, so the producers wait for the logging thread like they
+// would under a burst of warnings & the result is its throughput, not how fast the queue fills up
+constexpr size_t g_messagesPerThread = 2 * Logging::g_logQueueSize;
+
+// Set up like Logging::makeLoggerOrThrow(), but formatting into a stream without a buffer, so no file or console is
+// part of the result
+struct LoggingFixture
+{
+    std::ostream discard{nullptr};
+    std::shared_ptr<spdlog::details::thread_pool> threadPool = std::make_shared<spdlog::details::thread_pool>(Logging::g_logQueueSize, 1);
+    std::shared_ptr<spdlog::async_logger> logger = std::make_shared<spdlog::async_logger>(
+        "Bench", std::make_shared<spdlog::sinks::ostream_sink_mt>(discard), threadPool, spdlog::async_overflow_policy::block);
+
+    LoggingFixture()
+    {
+        logger->set_pattern(Logging::g_logPattern);
+        logger->set_level(spdlog::level::debug);
+    }
+};
+
+void benchmarkLogging(Bench::State &a_state, const size_t a_threadCount)
+{
+    LoggingFixture fixture;
+    a_state.setItemsPerIteration(a_threadCount * g_messagesPerThread);
+
+    // The producers are started once, every iteration they're let go & waited for at this barrier
+    std::barrier sync(static_cast<std::ptrdiff_t>(a_threadCount + 1));
+    bool stopping = false;
+    std::vector<std::jthread> threads;
+    for (size_t i = 0; i < a_threadCount; i++)
+    {
+        threads.emplace_back([&fixture, &sync, &stopping, i]
+        {
+            while (true)
+            {
+                sync.arrive_and_wait();
+                if (stopping)
+                    return;
+
+                for (size_t message = 0; message < g_messagesPerThread; message++)
+                {
+                    fixture.logger->debug("Chunk {} of worker {} loaded in {:.3f} ms", message, i, 0.25);
+                }
+                sync.arrive_and_wait();
+            }
+        });
+    }
+
+    while (a_state.keepRunning())
+    {
+        sync.arrive_and_wait();
+        sync.arrive_and_wait();
+        // Up to a queue of messages is still waiting once the producers are done, the iteration ends once the logging
+        // thread took them all; only the last one may still be formatted then
+        while (fixture.threadPool->queue_size() != 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    stopping = true;
+    sync.arrive_and_wait();
+}
+
+// Below the logger's level, what disabled debug logging costs a hot loop
+void benchmarkFilteredOut(Bench::State &a_state)
+{
+    LoggingFixture fixture;
+    fixture.logger->set_level(spdlog::level::info);
+    a_state.setItemsPerIteration(g_messagesPerThread);
+
+    while (a_state.keepRunning())
+    {
+        for (size_t message = 0; message < g_messagesPerThread; message++)
+        {
+            fixture.logger->debug("Chunk {} loaded in {:.3f} ms", message, 0.25);
+        }
+    }
+}
+
+[[maybe_unused]] static const bool g_oneThreadRegistered = Bench::registerBenchmark("Logging/async/1thread", [](Bench::State &a_state)
+{
+    benchmarkLogging(a_state, 1);
+});
+[[maybe_unused]] static const bool g_fourThreadsRegistered = Bench::registerBenchmark("Logging/async/4threads", [](Bench::State &a_state)
+{
+    benchmarkLogging(a_state, 4);
+});
+[[maybe_unused]] static const bool g_filteredOutRegistered = Bench::registerBenchmark("Logging/filteredOut", benchmarkFilteredOut);
@@ -0,0 +1,93 @@
+#include <random>
+#include <vector>
+
+#include "Network/BufferPool.h"
+#include "Network/Packets.h"
+#include "Benchmark.h"
+
+// Packets per iteration, about what a busy connection sends in one tick
+constexpr size_t g_packetCount = 1024;
+
+std::vector<Network::Packets::EntityPosition> makeEntityPositions()
+{
+    std::mt19937 random(1234);
+    std::uniform_real_distribution position(-10'000.0, 10'000.0);
+    std::uniform_real_distribution angle(-180.0f, 180.0f);
+
+    std::vector<Network::Packets::EntityPosition> packets;
+    for (size_t i = 0; i < g_packetCount; i++)
+    {
+        packets.push_back({{static_cast<int32_t>(i)}, position(random), position(random) / 100.0, position(random),
+                           angle(random), angle(random) / 2.0f, i % 3 == 0});
+    }
+    return packets;
+}
+
+std::vector<Network::Packets::BlockChange> makeBlockChanges()
+{
+    std::mt19937 random(1234);
+    std::uniform_int_distribution horizontal(-30'000, 30'000);
+    std::uniform_int_distribution vertical(-64, 319);
+    std::uniform_int_distribution state(0, 20'000);
+
+    std::vector<Network::Packets::BlockChange> packets;
+    for (size_t i = 0; i < g_packetCount; i++)
+    {
+        packets.push_back({{horizontal(random), vertical(random), horizontal(random)}, {state(random)}});
+    }
+    return packets;
+}
+
+template<typename P>
+void benchmarkEncode(Bench::State &a_state, const std::vector<P> &a_packets)
+{
+    Network::BufferPool pool;
+    a_state.setItemsPerIteration(a_packets.size());
+
+    while (a_state.keepRunning())
+    {
+        Network::PooledBuffer buffer = pool.acquire();
+        for (const P &packet: a_packets)
+        {
+            Network::encodePacket(*buffer, packet);
+        }
+        Bench::doNotOptimize(buffer->data());
+    }
+}
+
+template<typename P>
+void benchmarkDecode(Bench::State &a_state, const std::vector<P> &a_packets)
+{
+    Network::BufferPool pool;
+    Network::PooledBuffer buffer = pool.acquire();
+    for (const P &packet: a_packets)
+    {
+        Network::encodePacket(*buffer, packet);
+    }
+    a_state.setItemsPerIteration(a_packets.size());
+
+    // Splitting frames & decoding the fields, like a connection handling its receive buffer
+    while (a_state.keepRunning())
+    {
+        std::span<const std::byte> data = buffer.getData();
+        while (const std::optional<Network::PacketFrame> frame = Network::readFrame(data))
+        {
+            const P packet = Network::decodePacket<P>(frame->body);
+            Bench::doNotOptimize(packet);
+            data = data.subspan(frame->frameSize);
+        }
+    }
+}
+
+std::vector<Network::Packets::ChatMessage> makeChatMessages()
+{
+    return {g_packetCount, {"<Steve> has anyone seen my diamond pickaxe? I left it in the chest", 1'700'000'000'000}};
+}
+
+#define MCPP_PACKET_BENCHMARKS(name, makePackets) \
+    [[maybe_unused]] static const bool g_encode##name##Registered = Bench::registerBenchmark("Packet/encode" #name, [](Bench::State &a_state) { benchmarkEncode(a_state, makePackets()); }); \
+    [[maybe_unused]] static const bool g_decode##name##Registered = Bench::registerBenchmark("Packet/decode" #name, [](Bench::State &a_state) { benchmarkDecode(a_state, makePackets()); });
+
+MCPP_PACKET_BENCHMARKS(EntityPositions, makeEntityPositions)
+MCPP_PACKET_BENCHMARKS(BlockChanges, makeBlockChanges)
+MCPP_PACKET_BENCHMARKS(ChatMessages, makeChatMessages)
@@ -0,0 +1,119 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "World/VoxelRaycaster.h"
+#include "Benchmark.h"
+
+// 16x16 chunks of stone up to y = 64 with some holes in it & nothing but air above
+constexpr int32_t g_worldChunks = 16;
+constexpr int32_t g_groundHeight = 64;
+constexpr size_t g_rayCount = 4096;
+
+struct RaycastFixture
+{
+    World::ChunkMap world;
+    std::vector<World::Ray> pickingRays;
+    std::vector<World::Ray> sightRays;
+
+    RaycastFixture()
+    {
+        std::mt19937_64 random(1234);
+        for (int32_t chunkX = 0; chunkX < g_worldChunks; chunkX++)
+        {
+            for (int32_t chunkZ = 0; chunkZ < g_worldChunks; chunkZ++)
+            {
+                world.getOrCreateChunk({chunkX, chunkZ});
+            }
+        }
+
+        std::uniform_int_distribution hole(0, 15);
+        constexpr int32_t worldSize = g_worldChunks * World::SECTION_SIZE;
+        for (int32_t x = 0; x < worldSize; x++)
+        {
+            for (int32_t z = 0; z < worldSize; z++)
+            {
+                for (int32_t y = World::MIN_BLOCK_Y; y < g_groundHeight; y++)
+                {
+                    if (hole(random) != 0)
+                        world.setBlock({x, y, z}, World::Blocks::STONE);
+                }
+            }
+        }
+
+        std::uniform_real_distribution position(16.0, worldSize - 16.0);
+        std::uniform_real_distribution unit(-1.0, 1.0);
+        for (size_t i = 0; i < g_rayCount; i++)
+        {
+            // Players looking around from eye height, what block picking does every frame
+            glm::dvec3 direction(unit(random), unit(random) - 0.5, unit(random));
+            direction = direction / std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+            pickingRays.push_back({{position(random), g_groundHeight + 1.62, position(random)}, direction, 5.0});
+
+            // Mobs looking at each other over long distances, mostly through air
+            direction = glm::dvec3(unit(random), unit(random) * 0.1, unit(random));
+            direction = direction / std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+            sightRays.push_back({{position(random), g_groundHeight + 8.0, position(random)}, direction, 64.0});
+        }
+    }
+};
+
+void benchmarkRays(Bench::State &a_state, const std::vector<World::Ray> &a_rays, const World::RaycastMode a_mode)
+{
+    const World::VoxelRaycaster raycaster(Bench::getFixture<RaycastFixture>().world);
+    a_state.setItemsPerIteration(a_rays.size());
+
+    size_t hits = 0;
+    while (a_state.keepRunning())
+    {
+        for (const World::Ray &ray: a_rays)
+        {
+            hits += raycaster.cast(ray, a_mode).has_value();
+        }
+    }
+    Bench::doNotOptimize(hits);
+}
+
+void benchmarkBatch(Bench::State &a_state)
+{
+    const RaycastFixture &fixture = Bench::getFixture<RaycastFixture>();
+    const World::VoxelRaycaster raycaster(fixture.world);
+    Utils::JobSystem jobSystem;
+    std::vector<std::optional<World::RaycastHit>> results(fixture.sightRays.size());
+    a_state.setItemsPerIteration(fixture.sightRays.size());
+
+    while (a_state.keepRunning())
+    {
+        raycaster.castBatch(fixture.sightRays, results, World::RaycastMode::Opaque, &jobSystem);
+        Bench::doNotOptimize(results.data());
+    }
+}
+
+void benchmarkExposure(Bench::State &a_state)
+{
+    const World::VoxelRaycaster raycaster(Bench::getFixture<RaycastFixture>().world);
+    a_state.setItemsPerIteration(64);
+
+    // An explosion at ground level & the players around it
+    float exposure = 0.0f;
+    while (a_state.keepRunning())
+    {
+        for (int32_t i = 0; i < 64; i++)
+        {
+            const glm::dvec3 feet(128.0 + i % 8 - 4.0, g_groundHeight, 128.0 + i / 8 - 4.0);
+            exposure += raycaster.computeExposure({128.0, g_groundHeight - 0.5, 128.0}, Utils::Aabb{feet - glm::dvec3(0.3, 0.0, 0.3), feet + glm::dvec3(0.3, 1.8, 0.3)});
+        }
+    }
+    Bench::doNotOptimize(exposure);
+}
+
+[[maybe_unused]] static const bool g_pickingRegistered = Bench::registerBenchmark("Raycast/blockPicking", [](Bench::State &a_state)
+{
+    benchmarkRays(a_state, Bench::getFixture<RaycastFixture>().pickingRays, World::RaycastMode::Collider);
+});
+[[maybe_unused]] static const bool g_sightRegistered = Bench::registerBenchmark("Raycast/lineOfSight", [](Bench::State &a_state)
+{
+    benchmarkRays(a_state, Bench::getFixture<RaycastFixture>().sightRays, World::RaycastMode::Opaque);
+});
+[[maybe_unused]] static const bool g_batchRegistered = Bench::registerBenchmark("Raycast/lineOfSightBatch", benchmarkBatch);
+[[maybe_unused]] static const bool g_exposureRegistered = Bench::registerBenchmark("Raycast/explosionExposure", benchmarkExposure);
@@ -0,0 +1,54 @@
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "glslang/Public/ShaderLang.h"
+#include "spdlog/spdlog.h"
+#include "spdlog/sinks/null_sink.h"
+#include "../Client/ResourceManager.h"
+#include "Benchmark.h"
+
+// The shaders of the repository's resources, what the Client compiles for every pipeline on startup
+struct ShaderFixture
+{
+    ResourceManager resourceManager;
+
+    ShaderFixture()
+        : resourceManager(std::make_shared<spdlog::logger>("Bench", std::make_shared<spdlog::sinks::null_sink_mt>()),
+                          MCPP_RESOURCE_DIRECTORY)
+    {
+        glslang::InitializeProcess();
+    }
+
+    ShaderFixture(const ShaderFixture &) = delete;
+
+    ShaderFixture &operator=(const ShaderFixture &) = delete;
+
+    ~ShaderFixture()
+    {
+        glslang::FinalizeProcess();
+    }
+};
+
+void benchmarkCompileShader(Bench::State &a_state, const Utils::Identifier &a_identifier, const EShLanguage a_stage)
+{
+    const ShaderFixture fixture;
+    if (!fixture.resourceManager.getCompiledShader(a_identifier, a_stage).has_value())
+        throw std::runtime_error("Shader '" + a_identifier.toString() + "' not found in " MCPP_RESOURCE_DIRECTORY);
+
+    while (a_state.keepRunning())
+    {
+        const std::optional<std::vector<uint32_t>> spirV = fixture.resourceManager.getCompiledShader(a_identifier, a_stage);
+        Bench::doNotOptimize(spirV->data());
+    }
+}
+
+[[maybe_unused]] static const bool g_vertexRegistered = Bench::registerBenchmark("Shader/compileVertex", [](Bench::State &a_state)
+{
+    benchmarkCompileShader(a_state, Utils::Identifier::ofVanilla("test.vert").value(), EShLangVertex);
+});
+[[maybe_unused]] static const bool g_fragmentRegistered = Bench::registerBenchmark("Shader/compileFragment", [](Bench::State &a_state)
+{
+    benchmarkCompileShader(a_state, Utils::Identifier::ofVanilla("test.frag").value(), EShLangFragment);
+});
@@ -0,0 +1,149 @@
+#include <random>
+#include <vector>
+
+#include "World/SpatialHash.h"
+#include "Benchmark.h"
+
+// Entities are spread over a fixed area so 100k entities are also 10x as dense, like a mob farm
+constexpr double g_areaSize = 256.0;
+constexpr double g_areaHeight = 64.0;
+constexpr size_t g_queryCount = 1024;
+
+struct SpatialHashFixture
+{
+    std::vector<Ecs::EntityId> entities;
+    std::vector<Utils::Aabb> boxes;
+    World::SpatialHash index;
+
+    explicit SpatialHashFixture(const size_t a_entityCount)
+    {
+        std::mt19937_64 random(1234);
+        std::uniform_real_distribution horizontal(0.0, g_areaSize);
+        std::uniform_real_distribution vertical(0.0, g_areaHeight);
+
+        entities.reserve(a_entityCount);
+        boxes.reserve(a_entityCount);
+        for (uint32_t i = 0; i < a_entityCount; i++)
+        {
+            entities.push_back({i, 0});
+            boxes.push_back(Utils::Aabb::fromCenter({horizontal(random), vertical(random), horizontal(random)}, {0.3, 0.9, 0.3}));
+            index.insert(entities.back(), boxes.back());
+        }
+    }
+};
+
+void benchmarkInsert(Bench::State &a_state, const size_t a_entityCount)
+{
+    const SpatialHashFixture fixture(a_entityCount);
+    a_state.setItemsPerIteration(a_entityCount);
+
+    while (a_state.keepRunning())
+    {
+        World::SpatialHash index;
+        for (size_t i = 0; i < a_entityCount; i++)
+        {
+            index.insert(fixture.entities[i], fixture.boxes[i]);
+        }
+        Bench::doNotOptimize(index.size());
+    }
+}
+
+void benchmarkUpdate(Bench::State &a_state, const size_t a_entityCount)
+{
+    SpatialHashFixture fixture(a_entityCount);
+    a_state.setItemsPerIteration(a_entityCount);
+
+    // Mobs wander around a bit every tick
+    double offset = 0.1;
+    while (a_state.keepRunning())
+    {
+        for (size_t i = 0; i < a_entityCount; i++)
+        {
+            fixture.index.update(fixture.entities[i], fixture.boxes[i].offset({offset, 0.0, -offset}));
+        }
+        offset = -offset;
+    }
+}
+
+void benchmarkAabbQueries(Bench::State &a_state, const size_t a_entityCount)
+{
+    const SpatialHashFixture fixture(a_entityCount);
+    std::vector<Utils::Aabb> queries(fixture.boxes.begin(), fixture.boxes.begin() + g_queryCount);
+    for (Utils::Aabb &query: queries)
+    {
+        query = query.inflate(2.0);
+    }
+    a_state.setItemsPerIteration(g_queryCount);
+
+    size_t hits = 0;
+    while (a_state.keepRunning())
+    {
+        fixture.index.forEachInAabbBatch(queries, [&hits](size_t, Ecs::EntityId, const Utils::Aabb &) { hits++; });
+    }
+    Bench::doNotOptimize(hits);
+}
+
+void benchmarkRadiusQueries(Bench::State &a_state, const size_t a_entityCount)
+{
+    const SpatialHashFixture fixture(a_entityCount);
+    std::vector<glm::dvec3> centers;
+    for (size_t i = 0; i < g_queryCount; i++)
+    {
+        centers.push_back(fixture.boxes[i].getCenter());
+    }
+    a_state.setItemsPerIteration(g_queryCount);
+
+    // Typical AI target search range
+    size_t hits = 0;
+    while (a_state.keepRunning())
+    {
+        fixture.index.forEachInRadiusBatch(centers, 16.0, [&hits](size_t, Ecs::EntityId, const Utils::Aabb &) { hits++; });
+    }
+    Bench::doNotOptimize(hits);
+}
+
+void benchmarkRayQueries(Bench::State &a_state, const size_t a_entityCount)
+{
+    const SpatialHashFixture fixture(a_entityCount);
+    a_state.setItemsPerIteration(g_queryCount);
+
+    size_t hits = 0;
+    while (a_state.keepRunning())
+    {
+        for (size_t i = 0; i < g_queryCount; i++)
+        {
+            const glm::dvec3 origin = fixture.boxes[i].getCenter();
+            const glm::dvec3 direction = glm::normalize(glm::dvec3(1.0, -0.2, static_cast<double>(i % 7) - 3.0));
+            hits += fixture.index.raycastNearest(origin, direction, 64.0, fixture.entities[i]).has_value();
+        }
+    }
+    Bench::doNotOptimize(hits);
+}
+
+void benchmarkCollisionPairs(Bench::State &a_state, const size_t a_entityCount)
+{
+    const SpatialHashFixture fixture(a_entityCount);
+    a_state.setItemsPerIteration(a_entityCount);
+
+    // Collision candidates of every entity, what a physics broad phase does every tick
+    size_t pairs = 0;
+    while (a_state.keepRunning())
+    {
+        for (size_t i = 0; i < a_entityCount; i++)
+        {
+            fixture.index.forEachInAabb(fixture.boxes[i], [&pairs](Ecs::EntityId, const Utils::Aabb &) { pairs++; });
+        }
+    }
+    Bench::doNotOptimize(pairs);
+}
+
+#define MCPP_SPATIAL_HASH_BENCHMARKS(function, name) \
+    [[maybe_unused]] static const bool function##10kRegistered = Bench::registerBenchmark("SpatialHash/" name "/10k", [](Bench::State &a_state) { function(a_state, 10'000); }); \
+    [[maybe_unused]] static const bool function##100kRegistered = Bench::registerBenchmark("SpatialHash/" name "/100k", [](Bench::State &a_state) { function(a_state, 100'000); });
+
+MCPP_SPATIAL_HASH_BENCHMARKS(benchmarkInsert, "insert")
+MCPP_SPATIAL_HASH_BENCHMARKS(benchmarkUpdate, "update")
+MCPP_SPATIAL_HASH_BENCHMARKS(benchmarkAabbQueries, "aabbQuery")
+MCPP_SPATIAL_HASH_BENCHMARKS(benchmarkRadiusQueries, "radiusQuery")
+MCPP_SPATIAL_HASH_BENCHMARKS(benchmarkRayQueries, "rayQuery")
+MCPP_SPATIAL_HASH_BENCHMARKS(benchmarkCollisionPairs, "collisionPairs")
@@ -0,0 +1,138 @@
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.h"
+
+using namespace std::chrono_literals;
+
+// Runs every benchmark (or those whose name contains the filter) with doubling iteration counts
+// until one run takes at least g_minimumRunTime
+// Usage: MCpp-Bench [filter] [--json=<file>], the JSON file holds the same results for tracking them across commits
+constexpr std::chrono::nanoseconds g_minimumRunTime = 250ms;
+
+struct BenchmarkResult
+{
+    std::string name;
+    size_t iterations = 0;
+    double nanosecondsPerIteration = 0.0;
+    double itemsPerSecond = 0.0;
+};
+
+// Benchmark names are plain ASCII, but a quote or backslash in one mustn't break the file
+std::string escapeJson(const std::string_view a_string)
+{
+    std::string escaped;
+    for (const char character: a_string)
+    {
+        if (character == '"' || character == '\\')
+            escaped += '\\';
+        escaped += character;
+    }
+    return escaped;
+}
+
+void writeJson(std::ostream &a_stream, const std::vector<BenchmarkResult> &a_results)
+{
+#if defined(__clang__)
+    const std::string compiler = std::format("clang {}.{}.{}", __clang_major__, __clang_minor__, __clang_patchlevel__);
+#elif defined(__GNUC__)
+    const std::string compiler = std::format("gcc {}.{}.{}", __GNUC__, __GNUC_MINOR__, __GNUC_PATCHLEVEL__);
+#elif defined(_MSC_VER)
+    const std::string compiler = std::format("msvc {}", _MSC_VER);
+#else
+    const std::string compiler = "unknown";
+#endif
+#if defined(NDEBUG)
+    constexpr bool debug = false;
+#else
+    constexpr bool debug = true;
+#endif
+
+    a_stream << "{\n  \"context\": {\n";
+    a_stream << std::format("    \"date\": \"{:%FT%TZ}\",\n", std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now()));
+    a_stream << std::format("    \"compiler\": \"{}\",\n", escapeJson(compiler));
+    a_stream << std::format("    \"debug\": {},\n", debug);
+    a_stream << std::format("    \"hardwareThreads\": {}\n", std::thread::hardware_concurrency());
+    a_stream << "  },\n  \"benchmarks\": [";
+    for (size_t i = 0; i < a_results.size(); i++)
+    {
+        const BenchmarkResult &result = a_results[i];
+        a_stream << std::format("{}\n    {{\"name\": \"{}\", \"iterations\": {}, \"nsPerIteration\": {:.3f}, \"itemsPerSecond\": {:.6g}}}",
+                                i == 0 ? "" : ",", escapeJson(result.name), result.iterations,
+                                result.nanosecondsPerIteration, result.itemsPerSecond);
+    }
+    a_stream << "\n  ]\n}\n";
+}
+
+int main(const int a_argc, char **a_argv)
+{
+    std::string_view filter;
+    std::string_view jsonPath;
+    for (int i = 1; i < a_argc; i++)
+    {
+        const std::string_view argument = a_argv[i];
+        if (argument.starts_with("--json="))
+            jsonPath = argument.substr(7);
+        else if (argument.starts_with("--"))
+        {
+            std::cerr << std::format("Unknown option {}\nUsage: {} [filter] [--json=<file>]\n", argument, a_argv[0]);
+            return EXIT_FAILURE;
+        }
+        else
+            filter = argument;
+    }
+
+    std::vector<BenchmarkResult> results;
+    bool failed = false;
+    std::cout << std::format("{:<48} {:>12} {:>16} {:>16}\n", "Benchmark", "Iterations", "ns/iteration", "items/s");
+    for (const Bench::BenchmarkInfo &benchmark: Bench::getBenchmarks())
+    {
+        if (!filter.empty() && benchmark.name.find(filter) == std::string::npos)
+            continue;
+
+        try
+        {
+            for (size_t iterations = 1;; iterations *= 2)
+            {
+                Bench::State state(iterations);
+                benchmark.function(state);
+
+                if (state.getElapsed() < g_minimumRunTime)
+                    continue;
+
+                const double nanoseconds = static_cast<double>(state.getElapsed().count());
+                const double perIteration = nanoseconds / static_cast<double>(state.getIterations());
+                const double itemsPerSecond = static_cast<double>(state.getItemsPerIteration()) * 1e9 / perIteration;
+                std::cout << std::format("{:<48} {:>12} {:>16.1f} {:>16.4g}\n", benchmark.name, state.getIterations(), perIteration, itemsPerSecond);
+                results.push_back({benchmark.name, state.getIterations(), perIteration, itemsPerSecond});
+                break;
+            }
+        } catch (const std::exception &e)
+        {
+            // The others still run, a missing result shows up in the JSON as well
+            std::cout << std::format("{:<48} failed: {}\n", benchmark.name, e.what());
+            failed = true;
+        }
+    }
+
+    if (!jsonPath.empty())
+    {
+        std::ofstream json{std::string(jsonPath)};
+        writeJson(json, results);
+        if (!json)
+        {
+            std::cerr << std::format("Failed to write {}\n", jsonPath);
+            return EXIT_FAILURE;
+        }
+    }
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
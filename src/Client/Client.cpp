@@ -1,8 +1,11 @@
 #include <cmath>
+#include <iterator>
+#include <string>
 
 #include "GLFW/glfw3.h"
 #include "spdlog/spdlog.h"
 #include "glm/fwd.hpp"
+#include "glslang/Public/ShaderLang.h"
 
 #include "Logging.h"
 #include "Client.h"
@@ -13,8 +16,10 @@ constexpr int g_windowWidth = 854;
 constexpr int g_windowHeight = 480;
 shared_ptr<spdlog::logger> g_glfwLogger = nullptr;
 Client *g_client = nullptr;
-std::mutex g_clientTasksMutex;
-vector<std::function<void(const Client &)>> g_clientTasks;
+// How much of each frame may be spent on client tasks, the rest is carried over to the next frame
+constexpr std::chrono::microseconds g_clientTaskBudget(2000);
+ClientTaskQueue g_clientTasks;
+const Utils::Identifier g_testPipeline = Utils::Identifier::ofVanilla("test").value();
 
 void glfwError(const int a_errorCode, const char *a_description)
 {
@@ -38,10 +43,14 @@ void glfwWindowResize(GLFWwindow *a_glfwWindow, const int a_width, const int a_h
     }
 }
 
-void Client::addClientTask(const std::function<void(const Client &)> &a_task)
+void Client::addClientTask(ClientTaskQueue::Task &&a_task, const ClientTaskPriority a_priority)
 {
-    std::lock_guard guard(g_clientTasksMutex);
-    g_clientTasks.push_back(a_task);
+    g_clientTasks.push(std::move(a_task), a_priority);
+}
+
+ClientTaskQueue &Client::getClientTaskQueue()
+{
+    return g_clientTasks;
 }
 
 Client::Client()
@@ -69,6 +78,9 @@ Client::Client()
         throw std::runtime_error("Current GLFW Doesn't support Vulkan");
     }
 
+    m_logger->debug("Initializing glslang");
+    glslang::InitializeProcess();
+
     m_resourceManager = ResourceManager(m_logger, std::filesystem::current_path().append("resources"));
 
     m_vulkanHandler = VulkanHandler(m_logger);
@@ -89,7 +101,12 @@ Client::Client()
     m_vulkanHandler.setWindow(m_glfwWindow);
     glfwShowWindow(m_glfwWindow);
 
-    m_testPipeline = GraphicsPipeline(m_logger, m_resourceManager, Utils::Identifier::ofVanilla("test").value());
+    m_pipelines.emplace(m_logger, m_resourceManager);
+    m_pipelines->add(g_testPipeline);
+    m_resourceManager.watchShaders([this](const std::span<const Utils::Identifier> a_shaders)
+    {
+        m_pipelines->rebuild(a_shaders);
+    });
 
     m_logger->info("Finished Client initialisation");
 }
@@ -98,12 +115,18 @@ Client::~Client()
 {
     m_logger->info("Stoping Client ...");
 
+    m_logger->debug("Stopping shader watcher");
+    m_resourceManager.stopWatchingShaders();
+
     m_logger->debug("Destroying Window");
     glfwDestroyWindow(m_glfwWindow);
 
     m_logger->debug("Terminating GLFW");
     glfwTerminate();
 
+    m_logger->debug("Finalizing glslang");
+    glslang::FinalizeProcess();
+
     m_logger->flush();
 }
 
@@ -111,16 +134,15 @@ int Client::run()
 {
     m_logger->info("Running Client ...");
 
+    // There is no menu yet to pick a server from
+    startSingleplayer();
+
+    std::chrono::time_point<std::chrono::high_resolution_clock> lastFrameStart = std::chrono::high_resolution_clock::now();
     while (m_running)
     {
-        {
-            std::lock_guard guard(g_clientTasksMutex);
-            for (const std::function<void(const Client &)> &clientTask: g_clientTasks)
-            {
-                clientTask(*this);
-            }
-            g_clientTasks.clear();
-        }
+        g_clientTasks.runTasks(*this, g_clientTaskBudget);
+        m_pipelines->swapRebuilt(m_frameCount);
+        m_frameCount++;
 
         if (m_minimized)
         {
@@ -130,6 +152,15 @@ int Client::run()
         }
 
         std::chrono::time_point<std::chrono::high_resolution_clock> frameStart = std::chrono::high_resolution_clock::now();
+        m_frameArena.reset();
+        if (m_serverConnection.has_value() && !m_serverConnection->update(frameStart - lastFrameStart))
+        {
+            m_logger->info("Lost connection to the server");
+            disconnect();
+        }
+        lastFrameStart = frameStart;
+        m_vulkanHandler.updateMemoryUsage();
+        Memory::enforceBudgets(this);
         glfwPollEvents();
 
         // 1000 FPS baby TODO: make an actually competent frame-time counter
@@ -140,12 +171,29 @@ int Client::run()
         std::chrono::time_point<std::chrono::high_resolution_clock> frameEnd = std::chrono::high_resolution_clock::now();
         std::chrono::duration<float64_t> elapsed_seconds = frameEnd - frameStart;
         const float64_t fps = 1.f / elapsed_seconds.count();
-        glfwSetWindowTitle(m_glfwWindow, std::format("MCpp @{}FPS", round(fps)).c_str());
+        std::pmr::string title(&m_frameArena);
+        std::format_to(std::back_inserter(title), "MCpp @{}FPS", round(fps));
+        glfwSetWindowTitle(m_glfwWindow, title.c_str());
     }
 
     return EXIT_SUCCESS;
 }
 
+void Client::startSingleplayer()
+{
+    disconnect();
+
+    m_logger->info("Starting integrated Server ...");
+    m_integratedServer.emplace();
+    m_serverConnection.emplace(m_integratedServer->connect(), "Player");
+}
+
+void Client::disconnect()
+{
+    m_serverConnection.reset();
+    m_integratedServer.reset();
+}
+
 void Client::setFullscreen(const bool a_fullscreen) const
 {
     if (a_fullscreen)
@@ -1,17 +1,37 @@
 #pragma once
 
 #include <memory>
+#include <optional>
+#include <utility>
 
 #include "spdlog/spdlog.h"
 #include "GLFW/glfw3.h"
 
+#include "PipelineRegistry.h"
 #include "VulkanHandler.h"
 #include "ResourceManager.h"
+#include "ClientTaskQueue.h"
+#include "IntegratedServer.h"
+#include "ServerConnection.h"
+#include "Memory/LinearArena.h"
+#include "Memory/MemoryTracker.h"
+#include "Utils/Identifier.h"
 
 class Client final
 {
 public:
-    static void addClientTask(const std::function<void(const Client &)> &a_task);
+    // Queue a task to run on the main thread, may be called from any thread
+    static void addClientTask(ClientTaskQueue::Task &&a_task, ClientTaskPriority a_priority = ClientTaskPriority::Normal);
+
+    // Queue a task to run on the main thread & get a handle to its result, may be called from any thread
+    template<typename F>
+    static auto submitClientTask(F &&a_task, const ClientTaskPriority a_priority = ClientTaskPriority::Normal)
+    {
+        return getClientTaskQueue().submit(std::forward<F>(a_task), a_priority);
+    }
+
+    [[nodiscard]]
+    static ClientTaskQueue &getClientTaskQueue();
 
     Client();
 
@@ -27,6 +47,18 @@ public:
         setFullscreen(!m_fullscreen);
     };
 
+    // Scratch memory for the current frame, everything in it is freed when the next frame starts
+    [[nodiscard]]
+    Memory::LinearArena &getFrameArena()
+    {
+        return m_frameArena;
+    }
+
+    // Starts an integrated server & connects to it, replacing the current connection
+    void startSingleplayer();
+
+    void disconnect();
+
     void onWindowClose(const GLFWwindow *a_glfwWindow);
 
     void onWindowResize(const GLFWwindow *a_glfwWindow, int a_width, int a_height);
@@ -35,8 +67,15 @@ private:
     std::shared_ptr<spdlog::logger> m_logger;
     VulkanHandler m_vulkanHandler = nullptr;
     ResourceManager m_resourceManager = nullptr;
-    GraphicsPipeline m_testPipeline = nullptr;
+    // Created once the resource manager is, pipelines using changed shaders are rebuilt on the shader watcher thread &
+    // swapped in at the start of the next frame
+    std::optional<PipelineRegistry> m_pipelines;
+    uint64_t m_frameCount = 0;
     GLFWwindow *m_glfwWindow = nullptr;
+    std::optional<IntegratedServer> m_integratedServer;
+    // After the integrated server, so it's closed before the server stops
+    std::optional<ServerConnection> m_serverConnection;
+    Memory::LinearArena m_frameArena{1 << 20, Memory::getTrackedResource(Memory::MemoryTag::Scratch)};
     bool m_running = true;
     bool m_minimized = false;
     bool m_fullscreen = false;
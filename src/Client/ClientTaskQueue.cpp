@@ -0,0 +1,56 @@
+#include "ClientTaskQueue.h"
+
+void ClientTaskQueue::push(Task &&a_task, const ClientTaskPriority a_priority)
+{
+    m_pendingCount.fetch_add(1, std::memory_order_relaxed);
+    m_incoming[static_cast<size_t>(a_priority)].push(std::move(a_task));
+}
+
+void ClientTaskQueue::drainIncoming()
+{
+    for (size_t lane = 0; lane < PRIORITY_COUNT; lane++)
+    {
+        while (std::optional<Task> task = m_incoming[lane].tryPop())
+        {
+            m_carriedOver[lane].push_back(std::move(task.value()));
+        }
+    }
+}
+
+size_t ClientTaskQueue::runTasks(const Client &a_client, const std::chrono::nanoseconds a_budget)
+{
+    const auto deadline = std::chrono::steady_clock::now() + a_budget;
+
+    // Tasks submitted by the tasks we run now end up in m_incoming & wait for the next frame
+    drainIncoming();
+
+    size_t tasksRun = 0;
+    auto runFront = [&](std::deque<Task> &a_lane)
+    {
+        Task task = std::move(a_lane.front());
+        a_lane.pop_front();
+        m_pendingCount.fetch_sub(1, std::memory_order_relaxed);
+        tasksRun++;
+        task(a_client);
+    };
+
+    std::deque<Task> &immediateLane = m_carriedOver[static_cast<size_t>(ClientTaskPriority::Immediate)];
+    while (!immediateLane.empty())
+    {
+        runFront(immediateLane);
+    }
+
+    for (size_t lane = static_cast<size_t>(ClientTaskPriority::High); lane < PRIORITY_COUNT; lane++)
+    {
+        std::deque<Task> &tasks = m_carriedOver[lane];
+        while (!tasks.empty())
+        {
+            if (tasksRun > 0 && std::chrono::steady_clock::now() >= deadline)
+                return tasksRun;
+
+            runFront(tasks);
+        }
+    }
+
+    return tasksRun;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <type_traits>
+
+#include "Utils/MpscQueue.h"
+#include "Utils/TaskFuture.h"
+#include "Utils/UniqueFunction.h"
+
+class Client;
+
+enum class ClientTaskPriority : uint8_t
+{
+    // Always runs on the next frame, regardless of the frame budget
+    Immediate,
+    High,
+    Normal,
+    Low
+};
+
+// Tasks that have to run on the main (render) thread
+// Producers on any thread push without locking, the main thread runs them in priority order within a per-frame time budget
+class ClientTaskQueue final
+{
+public:
+    using Task = Utils::UniqueFunction<void(const Client &)>;
+
+    static constexpr size_t PRIORITY_COUNT = 4;
+
+    ClientTaskQueue() = default;
+
+    ClientTaskQueue(const ClientTaskQueue &) = delete;
+
+    ClientTaskQueue &operator=(const ClientTaskQueue &) = delete;
+
+    void push(Task &&a_task, ClientTaskPriority a_priority = ClientTaskPriority::Normal);
+
+    template<typename F>
+        requires std::is_invocable_v<F &, const Client &>
+    auto submit(F &&a_function, const ClientTaskPriority a_priority = ClientTaskPriority::Normal)
+        -> Utils::TaskFuture<std::invoke_result_t<F &, const Client &>>
+    {
+        using Result = std::invoke_result_t<F &, const Client &>;
+
+        Utils::TaskPromise<Result> promise;
+        Utils::TaskFuture<Result> future = promise.getFuture();
+        push([function = std::forward<F>(a_function), promise = std::move(promise)](const Client &a_client) mutable
+        {
+            promise.fulfill(function, a_client);
+        }, a_priority);
+
+        return future;
+    }
+
+    // Runs queued tasks until a_budget is used up, whatever doesn't fit is carried over to the next call
+    // At least one task is run per call so a tiny budget can't starve the queue
+    // Must only be called from the main thread, returns the amount of tasks that were run
+    size_t runTasks(const Client &a_client, std::chrono::nanoseconds a_budget);
+
+    // Tasks that were submitted but haven't run yet, approximate while producers are pushing
+    [[nodiscard]]
+    size_t getPendingCount() const
+    {
+        return m_pendingCount.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::array<Utils::MpscQueue<Task>, PRIORITY_COUNT> m_incoming;
+    // Only touched by the consumer thread
+    std::array<std::deque<Task>, PRIORITY_COUNT> m_carriedOver;
+    std::atomic<size_t> m_pendingCount = 0;
+
+    void drainIncoming();
+};
@@ -1,85 +1,345 @@
-#include <algorithm>
-#include <cmath>
-#include <cstdint>
+#include <cstddef>
 
-#include "glm/fwd.hpp"
-#include "glm/vec3.hpp"
+#include "Colors.h"
 
-using glm::float32_t;
-using glm::vec3;
+#if defined(__x86_64__) || defined(_M_X64)
+#define MCPP_COLORS_AVX2
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define MCPP_TARGET_AVX2
+#else
+// Only AVX2 & not FMA, FMA contraction would change the rounding compared to the scalar code
+#define MCPP_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
 
 namespace Colors
 {
-    uint8_t getAlpha(const uint32_t color)
+#ifdef MCPP_COLORS_AVX2
+    [[nodiscard]]
+    bool detectAvx2()
     {
-        return static_cast<uint8_t>(color >> 24 & 0xFF);
+#if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuidex(info, 7, 0);
+        return (info[1] & 1 << 5) != 0 && (_xgetbv(0) & 6) == 6;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
     }
 
-    uint8_t getRed(const uint32_t color)
+    const bool g_hasAvx2 = detectAvx2();
+
+    // Each kernel handles a multiple of 8 colors & returns how many it did, the scalar loops do the rest
+    // Lambdas don't inherit the target attribute, so the kernels only use (inlined) helper functions
+
+    [[nodiscard]]
+    MCPP_TARGET_AVX2 inline __m256i channelsFromFloat(const __m256 a_value)
     {
-        return static_cast<uint8_t>(color >> 16 & 0xFF);
+        // max_ps returns its second operand for NaN, which turns NaN into 0 like channelFromFloat()
+        const __m256 clamped = _mm256_min_ps(_mm256_max_ps(a_value, _mm256_setzero_ps()), _mm256_set1_ps(1.f));
+        return _mm256_cvttps_epi32(_mm256_mul_ps(clamped, _mm256_set1_ps(255.f)));
     }
 
-    uint8_t getGreen(const uint32_t color)
+    [[nodiscard]]
+    MCPP_TARGET_AVX2 inline __m256i packChannels(const __m256 a_alpha, const __m256 a_red, const __m256 a_green, const __m256 a_blue)
     {
-        return static_cast<uint8_t>(color >> 8 & 0xFF);
+        return _mm256_or_si256(
+            _mm256_or_si256(_mm256_slli_epi32(channelsFromFloat(a_alpha), 24), _mm256_slli_epi32(channelsFromFloat(a_red), 16)),
+            _mm256_or_si256(_mm256_slli_epi32(channelsFromFloat(a_green), 8), channelsFromFloat(a_blue))
+        );
     }
 
-    uint8_t getBlue(const uint32_t color)
+    [[nodiscard]]
+    MCPP_TARGET_AVX2 inline __m256 isSector(const __m256i a_sectors, const int32_t a_sector)
     {
-        return static_cast<uint8_t>(color & 0xFF);
+        return _mm256_castsi256_ps(_mm256_cmpeq_epi32(a_sectors, _mm256_set1_epi32(a_sector)));
+    }
+
+    [[nodiscard]]
+    MCPP_TARGET_AVX2 size_t packARGBAvx2(const std::span<const vec4> a_colors, const std::span<uint32_t> a_output)
+    {
+        static_assert(sizeof(vec4) == 4 * sizeof(float));
+        const auto *input = reinterpret_cast<const float *>(a_colors.data());
+
+        size_t i = 0;
+        for (; i + 8 <= a_colors.size(); i += 8)
+        {
+            // 8 rgba colors to one register per channel: swap the 128 bit halves into place, then transpose 4x4
+            const __m256 colors01 = _mm256_loadu_ps(input + i * 4);
+            const __m256 colors23 = _mm256_loadu_ps(input + i * 4 + 8);
+            const __m256 colors45 = _mm256_loadu_ps(input + i * 4 + 16);
+            const __m256 colors67 = _mm256_loadu_ps(input + i * 4 + 24);
+            const __m256 colors04 = _mm256_permute2f128_ps(colors01, colors45, 0x20);
+            const __m256 colors15 = _mm256_permute2f128_ps(colors01, colors45, 0x31);
+            const __m256 colors26 = _mm256_permute2f128_ps(colors23, colors67, 0x20);
+            const __m256 colors37 = _mm256_permute2f128_ps(colors23, colors67, 0x31);
+
+            const __m256 redGreen01 = _mm256_unpacklo_ps(colors04, colors15);
+            const __m256 blueAlpha01 = _mm256_unpackhi_ps(colors04, colors15);
+            const __m256 redGreen23 = _mm256_unpacklo_ps(colors26, colors37);
+            const __m256 blueAlpha23 = _mm256_unpackhi_ps(colors26, colors37);
+
+            const __m256i packed = packChannels(
+                _mm256_shuffle_ps(blueAlpha01, blueAlpha23, 0xEE),
+                _mm256_shuffle_ps(redGreen01, redGreen23, 0x44),
+                _mm256_shuffle_ps(redGreen01, redGreen23, 0xEE),
+                _mm256_shuffle_ps(blueAlpha01, blueAlpha23, 0x44)
+            );
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(a_output.data() + i), packed);
+        }
+        return i;
     }
 
-    uint32_t withAlpha(const uint32_t color, const uint8_t alpha)
+    [[nodiscard]]
+    MCPP_TARGET_AVX2 size_t unpackARGBAvx2(const std::span<const uint32_t> a_colors, const std::span<vec4> a_output)
     {
-        return static_cast<uint32_t>(alpha) << 24 | color & 0xFFFFFF00;
+        auto *output = reinterpret_cast<float *>(a_output.data());
+        const __m256i mask = _mm256_set1_epi32(0xFF);
+        const __m256 scale = _mm256_set1_ps(255.f);
+
+        size_t i = 0;
+        for (; i + 8 <= a_colors.size(); i += 8)
+        {
+            const __m256i colors = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a_colors.data() + i));
+            const __m256 alpha = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(colors, 24)), scale);
+            const __m256 red = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(colors, 16), mask)), scale);
+            const __m256 green = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(colors, 8), mask)), scale);
+            const __m256 blue = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(colors, mask)), scale);
+
+            // The inverse of the transpose in packARGBAvx2()
+            const __m256 redGreenLow = _mm256_unpacklo_ps(red, green);
+            const __m256 blueAlphaLow = _mm256_unpacklo_ps(blue, alpha);
+            const __m256 redGreenHigh = _mm256_unpackhi_ps(red, green);
+            const __m256 blueAlphaHigh = _mm256_unpackhi_ps(blue, alpha);
+            const __m256 colors04 = _mm256_shuffle_ps(redGreenLow, blueAlphaLow, 0x44);
+            const __m256 colors15 = _mm256_shuffle_ps(redGreenLow, blueAlphaLow, 0xEE);
+            const __m256 colors26 = _mm256_shuffle_ps(redGreenHigh, blueAlphaHigh, 0x44);
+            const __m256 colors37 = _mm256_shuffle_ps(redGreenHigh, blueAlphaHigh, 0xEE);
+
+            _mm256_storeu_ps(output + i * 4, _mm256_permute2f128_ps(colors04, colors15, 0x20));
+            _mm256_storeu_ps(output + i * 4 + 8, _mm256_permute2f128_ps(colors26, colors37, 0x20));
+            _mm256_storeu_ps(output + i * 4 + 16, _mm256_permute2f128_ps(colors04, colors15, 0x31));
+            _mm256_storeu_ps(output + i * 4 + 24, _mm256_permute2f128_ps(colors26, colors37, 0x31));
+        }
+        return i;
     }
 
-    uint32_t withRed(const uint32_t color, const uint8_t red)
+    [[nodiscard]]
+    MCPP_TARGET_AVX2 size_t fromHSVAvx2(const std::span<const vec3> a_hsv, const std::span<uint32_t> a_output)
     {
-        return static_cast<uint32_t>(red) << 1 | color & 0xFFFFFF00;
+        static_assert(sizeof(vec3) == 3 * sizeof(float));
+        const auto *input = reinterpret_cast<const float *>(a_hsv.data());
+        // Gathers hue, saturation & value of 8 colors from the packed vec3s
+        const __m256i offsets = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.f);
+        const __m256 six = _mm256_set1_ps(6.f);
+
+        size_t i = 0;
+        for (; i + 8 <= a_hsv.size(); i += 8)
+        {
+            const float *base = input + i * 3;
+            const __m256 hue = _mm256_i32gather_ps(base, offsets, 4);
+            const __m256 saturation = _mm256_i32gather_ps(base + 1, offsets, 4);
+            const __m256 value = _mm256_i32gather_ps(base + 2, offsets, 4);
+
+            const __m256 clampedHue = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(hue, six), zero), six);
+            const __m256i sector = _mm256_cvttps_epi32(clampedHue);
+            const __m256 hueExtra = _mm256_sub_ps(clampedHue, _mm256_cvtepi32_ps(sector));
+            const __m256 p = _mm256_mul_ps(value, _mm256_sub_ps(one, saturation));
+            const __m256 q = _mm256_mul_ps(value, _mm256_sub_ps(one, _mm256_mul_ps(saturation, hueExtra)));
+            const __m256 t = _mm256_mul_ps(value, _mm256_sub_ps(one, _mm256_mul_ps(saturation, _mm256_sub_ps(one, hueExtra))));
+
+            const __m256 sector1 = isSector(sector, 1);
+            const __m256 sector2 = isSector(sector, 2);
+            const __m256 sector3 = isSector(sector, 3);
+            const __m256 sector4 = isSector(sector, 4);
+            const __m256 sector5 = isSector(sector, 5);
+
+            // Start with sector 0 (& 6) & blend in the others, see vecFromHSV()
+            __m256 red = value;
+            red = _mm256_blendv_ps(red, q, sector1);
+            red = _mm256_blendv_ps(red, p, _mm256_or_ps(sector2, sector3));
+            red = _mm256_blendv_ps(red, t, sector4);
+
+            __m256 green = t;
+            green = _mm256_blendv_ps(green, value, _mm256_or_ps(sector1, sector2));
+            green = _mm256_blendv_ps(green, q, sector3);
+            green = _mm256_blendv_ps(green, p, _mm256_or_ps(sector4, sector5));
+
+            __m256 blue = p;
+            blue = _mm256_blendv_ps(blue, t, sector2);
+            blue = _mm256_blendv_ps(blue, value, _mm256_or_ps(sector3, sector4));
+            blue = _mm256_blendv_ps(blue, q, sector5);
+
+            const __m256 gray = _mm256_cmp_ps(saturation, zero, _CMP_EQ_OQ);
+            red = _mm256_blendv_ps(red, value, gray);
+            green = _mm256_blendv_ps(green, value, gray);
+            blue = _mm256_blendv_ps(blue, value, gray);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(a_output.data() + i), packChannels(one, red, green, blue));
+        }
+        return i;
     }
 
-    uint32_t withGreen(const uint32_t color, const uint8_t green)
+    [[nodiscard]]
+    MCPP_TARGET_AVX2 size_t mapColorChannelsAvx2(const std::span<const uint32_t> a_colors, const std::array<uint8_t, 256> &a_table,
+                                const std::span<uint32_t> a_output)
     {
-        return static_cast<uint32_t>(green) << 8 | color & 0xFFFFFF00;
+        // Gathers need 32 bit elements, so the table is widened first
+        alignas(32) int32_t table[256];
+        for (size_t i = 0; i < 256; i++)
+            table[i] = a_table[i];
+
+        const __m256i mask = _mm256_set1_epi32(0xFF);
+        size_t i = 0;
+        for (; i + 8 <= a_colors.size(); i += 8)
+        {
+            const __m256i colors = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a_colors.data() + i));
+            const __m256i red = _mm256_i32gather_epi32(table, _mm256_and_si256(_mm256_srli_epi32(colors, 16), mask), 4);
+            const __m256i green = _mm256_i32gather_epi32(table, _mm256_and_si256(_mm256_srli_epi32(colors, 8), mask), 4);
+            const __m256i blue = _mm256_i32gather_epi32(table, _mm256_and_si256(colors, mask), 4);
+            const __m256i alpha = _mm256_andnot_si256(_mm256_set1_epi32(0x00FFFFFF), colors);
+
+            const __m256i mapped = _mm256_or_si256(
+                _mm256_or_si256(alpha, _mm256_slli_epi32(red, 16)),
+                _mm256_or_si256(_mm256_slli_epi32(green, 8), blue)
+            );
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(a_output.data() + i), mapped);
+        }
+        return i;
     }
 
-    uint32_t withBlue(const uint32_t color, const uint8_t blue)
+    [[nodiscard]]
+    MCPP_TARGET_AVX2 inline __m256i multiplyWords(const __m256i a_colors, const __m256i a_tints)
     {
-        return static_cast<uint32_t>(blue) | color & 0xFFFFFF00;
+        // Same rounding as multiply(): (x + 128 + ((x + 128) >> 8)) >> 8, which fits into 16 bits
+        const __m256i product = _mm256_add_epi16(_mm256_mullo_epi16(a_colors, a_tints), _mm256_set1_epi16(128));
+        return _mm256_srli_epi16(_mm256_add_epi16(product, _mm256_srli_epi16(product, 8)), 8);
     }
 
-    uint32_t fromARGBi(const uint8_t alpha, const uint8_t red, const uint8_t green, const uint8_t blue)
+    [[nodiscard]]
+    MCPP_TARGET_AVX2 inline __m256i multiplyBytes(const __m256i a_colors, const __m256i a_tints)
     {
-        return static_cast<uint32_t>((alpha & 0xFF) << 24)
-               | static_cast<uint32_t>((red & 0xFF) << 16)
-               | static_cast<uint32_t>((green & 0xFF) << 8)
-               | static_cast<uint32_t>(blue & 0xFF);
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i low = multiplyWords(_mm256_unpacklo_epi8(a_colors, zero), _mm256_unpacklo_epi8(a_tints, zero));
+        const __m256i high = multiplyWords(_mm256_unpackhi_epi8(a_colors, zero), _mm256_unpackhi_epi8(a_tints, zero));
+        return _mm256_packus_epi16(low, high);
     }
 
-    vec3 vecFromHSV(const float hue, const float saturation, const float value)
+    [[nodiscard]]
+    MCPP_TARGET_AVX2 size_t multiplyAvx2(const std::span<const uint32_t> a_colors, const uint32_t a_tint, const std::span<uint32_t> a_output)
     {
-        if (saturation == 0)
+        const __m256i tint = _mm256_set1_epi32(static_cast<int32_t>(a_tint));
+        size_t i = 0;
+        for (; i + 8 <= a_colors.size(); i += 8)
         {
-            return vec3(value);
+            const __m256i colors = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a_colors.data() + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(a_output.data() + i), multiplyBytes(colors, tint));
         }
+        return i;
+    }
 
-        const float clampedHue = std::clamp(hue * 6.0f, 0.f, 6.f);
-        const float hueExtra = clampedHue - std::floor(clampedHue);
-        const float p = value * (1.0f - saturation);
-        const float q = value * (1.0f - saturation * hueExtra);
-        const float t = value * (1.0f - (saturation * (1.0f - hueExtra)));
-
-        switch (static_cast<int>(clampedHue))
+    [[nodiscard]]
+    MCPP_TARGET_AVX2 size_t multiplyAvx2(const std::span<const uint32_t> a_colors, const std::span<const uint32_t> a_tints,
+                        const std::span<uint32_t> a_output)
+    {
+        size_t i = 0;
+        for (; i + 8 <= a_colors.size(); i += 8)
         {
-            case 0: return {value, t, p};
-            case 1: return {q, value, p};
-            case 2: return {p, value, t};
-            case 3: return {p, q, value};
-            case 4: return {t, p, value};
-            case 5: return {value, p, q};
-            default: return {0.0f, 0.0f, 0.0f};
+            const __m256i colors = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a_colors.data() + i));
+            const __m256i tints = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a_tints.data() + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(a_output.data() + i), multiplyBytes(colors, tints));
         }
+        return i;
+    }
+#endif
+
+    bool isVectorized()
+    {
+#ifdef MCPP_COLORS_AVX2
+        return g_hasAvx2;
+#else
+        return false;
+#endif
+    }
+
+    void packARGB(const std::span<const vec4> a_colors, const std::span<uint32_t> a_output)
+    {
+        size_t i = 0;
+#ifdef MCPP_COLORS_AVX2
+        if (g_hasAvx2)
+            i = packARGBAvx2(a_colors, a_output);
+#endif
+        for (; i < a_colors.size(); i++)
+            a_output[i] = fromARGBv(a_colors[i]);
+    }
+
+    void unpackARGB(const std::span<const uint32_t> a_colors, const std::span<vec4> a_output)
+    {
+        size_t i = 0;
+#ifdef MCPP_COLORS_AVX2
+        if (g_hasAvx2)
+            i = unpackARGBAvx2(a_colors, a_output);
+#endif
+        for (; i < a_colors.size(); i++)
+            a_output[i] = toARGBv(a_colors[i]);
+    }
+
+    void fromHSV(const std::span<const vec3> a_hsv, const std::span<uint32_t> a_output)
+    {
+        size_t i = 0;
+#ifdef MCPP_COLORS_AVX2
+        if (g_hasAvx2)
+            i = fromHSVAvx2(a_hsv, a_output);
+#endif
+        for (; i < a_hsv.size(); i++)
+            a_output[i] = fromHSV(a_hsv[i].x, a_hsv[i].y, a_hsv[i].z);
+    }
+
+    void srgbToLinear(const std::span<const uint32_t> a_colors, const std::span<uint32_t> a_output)
+    {
+        size_t i = 0;
+#ifdef MCPP_COLORS_AVX2
+        if (g_hasAvx2)
+            i = mapColorChannelsAvx2(a_colors, Detail::SRGB_TO_LINEAR, a_output);
+#endif
+        for (; i < a_colors.size(); i++)
+            a_output[i] = srgbToLinear(a_colors[i]);
+    }
+
+    void linearToSrgb(const std::span<const uint32_t> a_colors, const std::span<uint32_t> a_output)
+    {
+        size_t i = 0;
+#ifdef MCPP_COLORS_AVX2
+        if (g_hasAvx2)
+            i = mapColorChannelsAvx2(a_colors, Detail::LINEAR_TO_SRGB, a_output);
+#endif
+        for (; i < a_colors.size(); i++)
+            a_output[i] = linearToSrgb(a_colors[i]);
+    }
+
+    void multiply(const std::span<const uint32_t> a_colors, const uint32_t a_tint, const std::span<uint32_t> a_output)
+    {
+        size_t i = 0;
+#ifdef MCPP_COLORS_AVX2
+        if (g_hasAvx2)
+            i = multiplyAvx2(a_colors, a_tint, a_output);
+#endif
+        for (; i < a_colors.size(); i++)
+            a_output[i] = multiply(a_colors[i], a_tint);
+    }
+
+    void multiply(const std::span<const uint32_t> a_colors, const std::span<const uint32_t> a_tints, const std::span<uint32_t> a_output)
+    {
+        size_t i = 0;
+#ifdef MCPP_COLORS_AVX2
+        if (g_hasAvx2)
+            i = multiplyAvx2(a_colors, a_tints, a_output);
+#endif
+        for (; i < a_colors.size(); i++)
+            a_output[i] = multiply(a_colors[i], a_tints[i]);
     }
 }
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <span>
 #include <stdfloat>
 
 #include "glm/vec3.hpp"
@@ -10,40 +13,80 @@
 using std::float32_t;
 using glm::vec3, glm::vec4;
 
+// Colors are packed as 0xAARRGGBB, float colors use glm's rgba order
+// Everything on single colors is constexpr, the span functions below do the same on many colors at once
+// (using AVX2 if the CPU supports it) & give bit-exact the same results as calling the scalar functions one by one
 namespace Colors
 {
-    uint8_t getAlpha(uint32_t color);
+    constexpr uint8_t getAlpha(const uint32_t color)
+    {
+        return static_cast<uint8_t>(color >> 24 & 0xFF);
+    }
 
-    uint8_t getRed(uint32_t color);
+    constexpr uint8_t getRed(const uint32_t color)
+    {
+        return static_cast<uint8_t>(color >> 16 & 0xFF);
+    }
 
-    uint8_t getGreen(uint32_t color);
+    constexpr uint8_t getGreen(const uint32_t color)
+    {
+        return static_cast<uint8_t>(color >> 8 & 0xFF);
+    }
 
-    uint8_t getBlue(uint32_t color);
+    constexpr uint8_t getBlue(const uint32_t color)
+    {
+        return static_cast<uint8_t>(color & 0xFF);
+    }
 
-    uint32_t withAlpha(uint32_t color, uint8_t alpha);
+    constexpr uint32_t withAlpha(const uint32_t color, const uint8_t alpha)
+    {
+        return static_cast<uint32_t>(alpha) << 24 | color & 0x00FFFFFF;
+    }
 
-    uint32_t withRed(uint32_t color, uint8_t red);
+    constexpr uint32_t withRed(const uint32_t color, const uint8_t red)
+    {
+        return static_cast<uint32_t>(red) << 16 | color & 0xFF00FFFF;
+    }
 
-    uint32_t withGreen(uint32_t color, uint8_t green);
+    constexpr uint32_t withGreen(const uint32_t color, const uint8_t green)
+    {
+        return static_cast<uint32_t>(green) << 8 | color & 0xFFFF00FF;
+    }
 
-    uint32_t withBlue(uint32_t color, uint8_t blue);
+    constexpr uint32_t withBlue(const uint32_t color, const uint8_t blue)
+    {
+        return static_cast<uint32_t>(blue) | color & 0xFFFFFF00;
+    }
 
-    uint32_t fromARGBi(uint8_t alpha, uint8_t red, uint8_t green, uint8_t blue);
+    constexpr uint32_t fromARGBi(const uint8_t alpha, const uint8_t red, const uint8_t green, const uint8_t blue)
+    {
+        return static_cast<uint32_t>(alpha) << 24
+               | static_cast<uint32_t>(red) << 16
+               | static_cast<uint32_t>(green) << 8
+               | static_cast<uint32_t>(blue);
+    }
 
     constexpr uint32_t fromRGBi(const uint8_t red, const uint8_t green, const uint8_t blue)
     {
         return fromARGBi(255, red, green, blue);
     }
 
+    // 0 ... 1 to 0 ... 255, rounding down; out of range values are clamped & NaN turns into 0
+    constexpr uint8_t channelFromFloat(const float32_t value)
+    {
+        const float32_t clamped = value > 0.f ? (value < 1.f ? value : 1.f) : 0.f;
+        return static_cast<uint8_t>(static_cast<int32_t>(clamped * 255.f));
+    }
+
+    constexpr float32_t channelToFloat(const uint8_t value)
+    {
+        return static_cast<float32_t>(value) / 255.f;
+    }
+
     constexpr uint32_t fromARGBf(const float32_t alpha, const float32_t red, const float32_t green,
                                  const float32_t blue)
     {
-        return fromARGBi(
-            std::clamp(static_cast<int32_t>(alpha * 255), 0, 255),
-            std::clamp(static_cast<int32_t>(red * 255), 0, 255),
-            std::clamp(static_cast<int32_t>(green * 255), 0, 255),
-            std::clamp(static_cast<int32_t>(blue * 255), 0, 255)
-        );
+        return fromARGBi(channelFromFloat(alpha), channelFromFloat(red), channelFromFloat(green), channelFromFloat(blue));
     }
 
     constexpr uint32_t fromRGBf(const float32_t red, const float32_t green, const float32_t blue)
@@ -51,39 +94,198 @@ namespace Colors
         return fromARGBf(1.f, red, green, blue);
     }
 
+    // glm initializes x, y, z & w, reading the r, g, b & a aliases of them isn't allowed in constant expressions
+
     constexpr uint32_t fromRGBv(const vec3 color)
     {
-        return fromRGBf(color.r, color.g, color.b);
+        return fromRGBf(color.x, color.y, color.z);
     }
 
     constexpr uint32_t fromARGBv(const vec4 color)
     {
-        return fromARGBf(color.a, color.r, color.g, color.b);
+        return fromARGBf(color.w, color.x, color.y, color.z);
     }
 
     constexpr vec4 toARGBv(const uint32_t color)
     {
         return {
-            static_cast<float32_t>(getAlpha(color)) / 255.f,
-            static_cast<float32_t>(getRed(color)) / 255.f,
-            static_cast<float32_t>(getGreen(color)) / 255.f,
-            static_cast<float32_t>(getBlue(color)) / 255.f
+            channelToFloat(getRed(color)),
+            channelToFloat(getGreen(color)),
+            channelToFloat(getBlue(color)),
+            channelToFloat(getAlpha(color))
         };
     }
 
     constexpr vec3 toRGBv(const uint32_t color)
     {
         return {
-            static_cast<float32_t>(getRed(color)) / 255.f,
-            static_cast<float32_t>(getGreen(color)) / 255.f,
-            static_cast<float32_t>(getBlue(color)) / 255.f
+            channelToFloat(getRed(color)),
+            channelToFloat(getGreen(color)),
+            channelToFloat(getBlue(color))
         };
     }
 
-    vec3 vecFromHSV(float hue, float saturation, float value);
+    // Hue wraps around at 1, so 0 & 1 are both red
+    constexpr vec3 vecFromHSV(const float hue, const float saturation, const float value)
+    {
+        if (saturation == 0)
+        {
+            return vec3(value);
+        }
+
+        const float scaledHue = hue * 6.0f;
+        const float clampedHue = scaledHue > 0.f ? (scaledHue < 6.f ? scaledHue : 6.f) : 0.f;
+        const int sector = static_cast<int>(clampedHue);
+        const float hueExtra = clampedHue - static_cast<float>(sector);
+        const float p = value * (1.0f - saturation);
+        const float q = value * (1.0f - saturation * hueExtra);
+        const float t = value * (1.0f - saturation * (1.0f - hueExtra));
+
+        switch (sector)
+        {
+            case 1: return {q, value, p};
+            case 2: return {p, value, t};
+            case 3: return {p, q, value};
+            case 4: return {t, p, value};
+            case 5: return {value, p, q};
+            default: return {value, t, p};
+        }
+    }
 
     constexpr uint32_t fromHSV(const float hue, const float saturation, const float value)
     {
         return fromRGBv(vecFromHSV(hue, saturation, value));
     }
+
+    // Channel wise multiplication, rounded to nearest, what biome tinting does to grass & leaves
+    constexpr uint32_t multiply(const uint32_t color, const uint32_t tint)
+    {
+        uint32_t result = 0;
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            const uint32_t product = (color >> shift & 0xFF) * (tint >> shift & 0xFF) + 128;
+            result |= (product + (product >> 8)) >> 8 << shift;
+        }
+        return result;
+    }
+
+    namespace Detail
+    {
+        // <cmath> isn't constexpr (yet), these are only used to build the lookup tables below
+        constexpr double exp(const double a_value)
+        {
+            // e^x = 2^n * e^r with |r| <= ln(2) / 2
+            constexpr double ln2 = 0.6931471805599453;
+            const auto n = static_cast<int64_t>(a_value / ln2 + (a_value < 0 ? -0.5 : 0.5));
+            const double r = a_value - static_cast<double>(n) * ln2;
+
+            double term = 1.0;
+            double sum = 1.0;
+            for (int i = 1; i < 24; i++)
+            {
+                term *= r / i;
+                sum += term;
+            }
+
+            for (int64_t i = 0; i < n; i++)
+                sum *= 2.0;
+            for (int64_t i = 0; i > n; i--)
+                sum /= 2.0;
+            return sum;
+        }
+
+        constexpr double log(double a_value)
+        {
+            // ln(x) = k * ln(2) + ln(m) with m in [1, 2) & ln(m) = 2 * atanh((m - 1) / (m + 1))
+            constexpr double ln2 = 0.6931471805599453;
+            int k = 0;
+            while (a_value >= 2.0)
+            {
+                a_value /= 2.0;
+                k++;
+            }
+            while (a_value < 1.0)
+            {
+                a_value *= 2.0;
+                k--;
+            }
+
+            const double y = (a_value - 1.0) / (a_value + 1.0);
+            double power = y;
+            double sum = 0.0;
+            for (int i = 1; i < 48; i += 2)
+            {
+                sum += power / i;
+                power *= y * y;
+            }
+            return k * ln2 + 2.0 * sum;
+        }
+
+        constexpr double pow(const double a_base, const double a_exponent)
+        {
+            return a_base <= 0.0 ? 0.0 : exp(a_exponent * log(a_base));
+        }
+
+        constexpr double srgbToLinear(const double a_value)
+        {
+            return a_value <= 0.04045 ? a_value / 12.92 : pow((a_value + 0.055) / 1.055, 2.4);
+        }
+
+        constexpr double linearToSrgb(const double a_value)
+        {
+            return a_value <= 0.0031308 ? a_value * 12.92 : 1.055 * pow(a_value, 1.0 / 2.4) - 0.055;
+        }
+
+        template<typename F>
+        constexpr std::array<uint8_t, 256> makeChannelTable(F &&a_function)
+        {
+            std::array<uint8_t, 256> table{};
+            for (size_t i = 0; i < table.size(); i++)
+            {
+                table[i] = static_cast<uint8_t>(a_function(static_cast<double>(i) / 255.0) * 255.0 + 0.5);
+            }
+            return table;
+        }
+
+        inline constexpr std::array<uint8_t, 256> SRGB_TO_LINEAR = makeChannelTable(srgbToLinear);
+        inline constexpr std::array<uint8_t, 256> LINEAR_TO_SRGB = makeChannelTable(linearToSrgb);
+
+        constexpr uint32_t mapColorChannels(const uint32_t color, const std::array<uint8_t, 256> &table)
+        {
+            return fromARGBi(getAlpha(color), table[getRed(color)], table[getGreen(color)], table[getBlue(color)]);
+        }
+    }
+
+    // Converts the color channels between sRGB & linear space, alpha stays as it is
+    constexpr uint32_t srgbToLinear(const uint32_t color)
+    {
+        return Detail::mapColorChannels(color, Detail::SRGB_TO_LINEAR);
+    }
+
+    constexpr uint32_t linearToSrgb(const uint32_t color)
+    {
+        return Detail::mapColorChannels(color, Detail::LINEAR_TO_SRGB);
+    }
+
+    // All batch functions write one output per input, a_output may be the same span as the input
+    // & must be at least as large
+
+    void packARGB(std::span<const vec4> a_colors, std::span<uint32_t> a_output);
+
+    void unpackARGB(std::span<const uint32_t> a_colors, std::span<vec4> a_output);
+
+    // a_hsv holds hue, saturation & value, the results are opaque
+    void fromHSV(std::span<const vec3> a_hsv, std::span<uint32_t> a_output);
+
+    void srgbToLinear(std::span<const uint32_t> a_colors, std::span<uint32_t> a_output);
+
+    void linearToSrgb(std::span<const uint32_t> a_colors, std::span<uint32_t> a_output);
+
+    void multiply(std::span<const uint32_t> a_colors, uint32_t a_tint, std::span<uint32_t> a_output);
+
+    void multiply(std::span<const uint32_t> a_colors, std::span<const uint32_t> a_tints, std::span<uint32_t> a_output);
+
+    // Whether the batch functions use AVX2 on this CPU
+    [[nodiscard]]
+    bool isVectorized();
 }
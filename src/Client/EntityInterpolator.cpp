@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <cmath>
+
+#include "EntityInterpolator.h"
+
+using Network::EntityState, Network::SNAPSHOTS_PER_SECOND;
+
+// How fast the render time catches up with where it should be, as a fraction of the frame time
+constexpr double g_maxTimeCorrection = 0.1;
+// Weight of a new arrival in the smoothed jitter
+constexpr double g_jitterSmoothing = 1.0 / 16.0;
+
+EntityInterpolator::Entity toEntity(const EntityState &a_state, const glm::dvec3 &a_position)
+{
+    return {a_state.entity, a_position, a_state.getYaw(), a_state.getPitch(), a_state.onGround};
+}
+
+// Along the shorter way around
+float interpolateYaw(const uint8_t a_from, const uint8_t a_to, const double a_progress)
+{
+    const auto difference = static_cast<int8_t>(static_cast<uint8_t>(a_to - a_from));
+    return static_cast<float>(a_from + difference * a_progress) / Network::ANGLE_SCALE;
+}
+
+std::optional<uint64_t> EntityInterpolator::onSnapshot(const Network::Packets::EntitySnapshot &a_snapshot)
+{
+    const auto tick = static_cast<uint64_t>(a_snapshot.tick.value);
+    const auto baseTick = static_cast<uint64_t>(a_snapshot.baseTick.value);
+    if (tick == 0 || baseTick >= tick || (!m_snapshots.empty() && tick <= m_snapshots.front().tick))
+        return {};
+
+    const auto position = std::ranges::lower_bound(m_snapshots, tick, {}, &Snapshot::tick);
+    if (position != m_snapshots.end() && position->tick == tick)
+        return {};
+
+    std::span<const EntityState> base;
+    if (baseTick != 0)
+    {
+        const auto found = std::ranges::lower_bound(m_snapshots, baseTick, {}, &Snapshot::tick);
+        if (found == m_snapshots.end() || found->tick != baseTick)
+            return {};
+        base = found->entities;
+    }
+
+    Snapshot snapshot{tick, {}};
+    Network::decodeSnapshotDelta(base, a_snapshot.entities, snapshot.entities);
+    m_snapshots.insert(position, std::move(snapshot));
+    if (m_snapshots.size() > Network::SNAPSHOT_HISTORY)
+        m_snapshots.pop_front();
+
+    if (tick > m_latestTick)
+    {
+        if (m_latestTick == 0)
+        {
+            m_renderTick = static_cast<double>(tick) - m_delayTicks;
+        }
+        else
+        {
+            const double expected = static_cast<double>(tick - m_latestTick);
+            const double actual = (m_time - m_latestArrival) * SNAPSHOTS_PER_SECOND;
+            m_jitter += (std::abs(actual - expected) - m_jitter) * g_jitterSmoothing;
+            m_delayTicks = std::clamp(MIN_DELAY_TICKS + 2.0 * m_jitter, MIN_DELAY_TICKS, MAX_DELAY_TICKS);
+        }
+        m_latestTick = tick;
+        m_latestArrival = m_time;
+    }
+    return tick;
+}
+
+void EntityInterpolator::update(const std::chrono::nanoseconds a_frameTime)
+{
+    const double seconds = std::chrono::duration<double>(a_frameTime).count();
+    m_time += seconds;
+    if (m_latestTick == 0)
+        return;
+
+    // The newest tick, moved on by the time since it arrived, minus the jitter buffer
+    const double target = static_cast<double>(m_latestTick) + (m_time - m_latestArrival) * SNAPSHOTS_PER_SECOND - m_delayTicks;
+    const double advance = seconds * SNAPSHOTS_PER_SECOND;
+    const double error = target - (m_renderTick + advance);
+    if (std::abs(error) > MAX_DELAY_TICKS)
+    {
+        m_renderTick = target;
+    }
+    else
+    {
+        // Running slightly faster or slower instead of jumping keeps the motion smooth
+        m_renderTick += advance + std::clamp(error, -advance * g_maxTimeCorrection, advance * g_maxTimeCorrection);
+    }
+
+    interpolate();
+}
+
+void EntityInterpolator::interpolate()
+{
+    m_entities.clear();
+    if (m_snapshots.empty())
+        return;
+
+    const auto to = std::ranges::upper_bound(m_snapshots, m_renderTick, {}, [](const Snapshot &a_snapshot)
+    {
+        return static_cast<double>(a_snapshot.tick);
+    });
+    if (to == m_snapshots.begin())
+    {
+        for (const EntityState &state: to->entities)
+        {
+            m_entities.push_back(toEntity(state, state.getPosition()));
+        }
+        return;
+    }
+
+    const Snapshot &from = *std::prev(to);
+    const double elapsed = m_renderTick - static_cast<double>(from.tick);
+    if (to == m_snapshots.end())
+    {
+        const double extrapolated = std::min(elapsed, MAX_EXTRAPOLATION_TICKS);
+        for (const EntityState &state: from.entities)
+        {
+            m_entities.push_back(toEntity(state, state.getPosition() + state.getVelocity() * extrapolated));
+        }
+        return;
+    }
+
+    // Entities that are gone in the next snapshot stay where they are until it's reached, new ones appear then
+    const double progress = elapsed / static_cast<double>(to->tick - from.tick);
+    auto next = to->entities.begin();
+    for (const EntityState &state: from.entities)
+    {
+        next = std::ranges::lower_bound(next, to->entities.end(), state.entity.index, {},
+                                        [](const EntityState &a_state) { return a_state.entity.index; });
+        if (next == to->entities.end() || next->entity != state.entity)
+        {
+            m_entities.push_back(toEntity(state, state.getPosition()));
+            continue;
+        }
+
+        Entity &entity = m_entities.emplace_back(toEntity(state, state.getPosition() + (next->getPosition() - state.getPosition()) * progress));
+        entity.yaw = interpolateYaw(state.yaw, next->yaw, progress);
+        entity.pitch = state.getPitch() + (next->getPitch() - state.getPitch()) * static_cast<float>(progress);
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+
+#include "glm/vec3.hpp"
+
+#include "../Common-Lib/Network/EntitySnapshot.h"
+#include "../Common-Lib/Network/Packets.h"
+
+// Keeps the last entity snapshots from the server & renders entities a little in the past, interpolated between the
+// two snapshots around the render time, so late or lost snapshots don't make them stutter
+class EntityInterpolator final
+{
+public:
+    struct Entity
+    {
+        Ecs::EntityId entity;
+        glm::dvec3 position{0.0};
+        float yaw = 0.0f;
+        float pitch = 0.0f;
+        bool onGround = false;
+    };
+
+    // Snapshots are rendered at least this many ticks after they were sent
+    static constexpr double MIN_DELAY_TICKS = 1.5;
+    static constexpr double MAX_DELAY_TICKS = 6.0;
+    // Without a newer snapshot entities keep moving with their velocity for at most this long
+    static constexpr double MAX_EXTRAPOLATION_TICKS = 2.0;
+
+    // Returns the tick to acknowledge, nothing if the snapshot is outdated or its base isn't known anymore; throws a
+    // Network::ProtocolError if it's malformed
+    [[nodiscard]]
+    std::optional<uint64_t> onSnapshot(const Network::Packets::EntitySnapshot &a_snapshot);
+
+    // Advances the render time & interpolates the entities for it, called once per frame
+    void update(std::chrono::nanoseconds a_frameTime);
+
+    [[nodiscard]]
+    const std::vector<Entity> &getEntities() const
+    {
+        return m_entities;
+    }
+
+    // Current size of the jitter buffer, grows with the variance of the snapshot arrival times
+    [[nodiscard]]
+    double getDelayTicks() const
+    {
+        return m_delayTicks;
+    }
+
+private:
+    struct Snapshot
+    {
+        uint64_t tick = 0;
+        std::vector<Network::EntityState> entities;
+    };
+
+    // Oldest first
+    std::deque<Snapshot> m_snapshots;
+    std::vector<Entity> m_entities;
+    // In ticks, fractional between snapshots
+    double m_renderTick = 0.0;
+    // Seconds since the interpolator was created, advanced by update()
+    double m_time = 0.0;
+    uint64_t m_latestTick = 0;
+    double m_latestArrival = 0.0;
+    // Smoothed deviation of the arrival times from the tick rate, in ticks
+    double m_jitter = 0.0;
+    double m_delayTicks = MIN_DELAY_TICKS;
+
+    void interpolate();
+};
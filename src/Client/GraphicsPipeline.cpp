@@ -8,25 +8,32 @@
 GraphicsPipeline::GraphicsPipeline(const std::shared_ptr<spdlog::logger> &a_logger, const ResourceManager &resourceManager, const Utils::Identifier &a_identifier)
     : m_logger(a_logger)
 {
-    const auto fragmentSpirV = resourceManager.getCompiledShader(a_identifier.withSuffixedPath(".frag"), EShLangFragment);
+    const auto [vertexShader, fragmentShader] = getShaders(a_identifier);
+
+    const auto fragmentSpirV = resourceManager.getCompiledShader(fragmentShader, EShLangFragment);
     if (!fragmentSpirV.has_value())
     {
-        throw std::runtime_error("Failed to create shader, shader '" + a_identifier.toString() + ".frag' Couldn't be compiled");
+        throw std::runtime_error("Failed to create shader, shader '" + fragmentShader.toString() + "' Couldn't be compiled");
     }
     m_fragmentSpirV = fragmentSpirV.value();
     m_vkFragmentShaderCreateInfo.codeSize = m_fragmentSpirV.size() * sizeof(uint32_t);
     m_vkFragmentShaderCreateInfo.pCode = m_fragmentSpirV.data();
 
-    const auto vertexSpirV = resourceManager.getCompiledShader(a_identifier.withSuffixedPath(".vert"), EShLangVertex);
+    const auto vertexSpirV = resourceManager.getCompiledShader(vertexShader, EShLangVertex);
     if (!vertexSpirV.has_value())
     {
-        throw std::runtime_error("Failed to create shader, shader '" + a_identifier.toString() + ".vert' Couldn't be compiled");
+        throw std::runtime_error("Failed to create shader, shader '" + vertexShader.toString() + "' Couldn't be compiled");
     }
     m_vertexSpirV = vertexSpirV.value();
     m_vkVertexShaderCreateInfo.codeSize = m_vertexSpirV.size() * sizeof(uint32_t);
     m_vkVertexShaderCreateInfo.pCode = m_vertexSpirV.data();
 }
 
+std::array<Utils::Identifier, 2> GraphicsPipeline::getShaders(const Utils::Identifier &a_identifier)
+{
+    return {a_identifier.withSuffixedPath(".vert"), a_identifier.withSuffixedPath(".frag")};
+}
+
 void GraphicsPipeline::setVkDevice(const vk::raii::Device &a_device, const vk::Extent2D &a_vkSwapExtent)
 {
     const vk::raii::ShaderModule fragmentShader(a_device, m_vkFragmentShaderCreateInfo);
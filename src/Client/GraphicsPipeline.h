@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+
 #include "spdlog/spdlog.h"
 #include "vulkan/vulkan_raii.hpp"
 
@@ -15,8 +17,13 @@ public:
 
     GraphicsPipeline(std::nullptr_t) {}
 
+    // Built from the shaders getShaders() names, throws std::runtime_error if they can't be compiled
     explicit GraphicsPipeline(const std::shared_ptr<spdlog::logger> &a_logger, const ResourceManager &resourceManager, const Utils::Identifier &a_identifier);
 
+    // The vertex & fragment shader of a pipeline, <identifier>.vert & <identifier>.frag
+    [[nodiscard]]
+    static std::array<Utils::Identifier, 2> getShaders(const Utils::Identifier &a_identifier);
+
     void setVkDevice(const vk::raii::Device &a_device, const vk::Extent2D &a_vkSwapExtent);
 
 private:
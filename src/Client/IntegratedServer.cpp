@@ -0,0 +1,28 @@
+#include "spdlog/spdlog.h"
+
+#include "IntegratedServer.h"
+
+IntegratedServer::IntegratedServer()
+    : m_thread([this]
+    {
+        try
+        {
+            (void) m_server.run();
+        } catch (std::exception &e)
+        {
+            spdlog::critical("An exception occurred while running the integrated Server: {}", e.what());
+        }
+    }) {}
+
+IntegratedServer::~IntegratedServer()
+{
+    m_server.stop();
+    m_thread.join();
+}
+
+Network::Connection IntegratedServer::connect()
+{
+    auto [client, server] = Network::Connection::createLocal();
+    m_server.addConnection(std::move(server));
+    return std::move(client);
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <thread>
+
+#include "DedicatedServer.h"
+
+// The server of singleplayer, runs the DedicatedServer logic on its own thread in the client process; clients connect
+// through an in-process connection instead of a socket
+class IntegratedServer final
+{
+public:
+    IntegratedServer();
+
+    IntegratedServer(const IntegratedServer &) = delete;
+
+    IntegratedServer &operator=(const IntegratedServer &) = delete;
+
+    // Stops the server after its current tick & waits for it
+    ~IntegratedServer();
+
+    // The client's end of a new connection, the server picks up the other end with its next tick
+    [[nodiscard]]
+    Network::Connection connect();
+
+    [[nodiscard]]
+    DedicatedServer &getServer()
+    {
+        return m_server;
+    }
+
+private:
+    DedicatedServer m_server;
+    std::jthread m_thread;
+};
@@ -0,0 +1,79 @@
+#include <stdexcept>
+#include <unordered_set>
+
+#include "PipelineRegistry.h"
+
+PipelineRegistry::PipelineRegistry(std::shared_ptr<spdlog::logger> a_logger, const ResourceManager &a_resourceManager)
+    : m_logger(std::move(a_logger)), m_resourceManager(a_resourceManager)
+{
+}
+
+GraphicsPipeline &PipelineRegistry::add(const Utils::Identifier &a_pipeline)
+{
+    const std::string identifier = a_pipeline.toString();
+    if (const auto found = m_pipelines.find(identifier); found != m_pipelines.end())
+        return found->second;
+
+    GraphicsPipeline &pipeline = m_pipelines.emplace(identifier, GraphicsPipeline(m_logger, m_resourceManager, a_pipeline)).first->second;
+    std::lock_guard lock(m_dependentsMutex);
+    for (const Utils::Identifier &shader: GraphicsPipeline::getShaders(a_pipeline))
+    {
+        m_dependents[shader.toString()].push_back(a_pipeline);
+    }
+    return pipeline;
+}
+
+GraphicsPipeline *PipelineRegistry::get(const Utils::Identifier &a_pipeline)
+{
+    const auto found = m_pipelines.find(a_pipeline.toString());
+    return found == m_pipelines.end() ? nullptr : &found->second;
+}
+
+void PipelineRegistry::rebuild(const std::span<const Utils::Identifier> a_shaders)
+{
+    // A pipeline whose vertex & fragment shader both changed is only built once
+    std::unordered_set<std::string> seen;
+    std::vector<Utils::Identifier> pipelines;
+    {
+        std::lock_guard lock(m_dependentsMutex);
+        for (const Utils::Identifier &shader: a_shaders)
+        {
+            const auto dependents = m_dependents.find(shader.toString());
+            if (dependents == m_dependents.end())
+                continue;
+
+            for (const Utils::Identifier &pipeline: dependents->second)
+            {
+                if (seen.insert(pipeline.toString()).second)
+                    pipelines.push_back(pipeline);
+            }
+        }
+    }
+
+    for (const Utils::Identifier &pipeline: pipelines)
+    {
+        try
+        {
+            m_rebuilt.push({pipeline.toString(), GraphicsPipeline(m_logger, m_resourceManager, pipeline)});
+        } catch (const std::runtime_error &e)
+        {
+            m_logger->error("Keeping the old pipeline '{}': {}", pipeline.toString(), e.what());
+        }
+    }
+}
+
+void PipelineRegistry::swapRebuilt(const uint64_t a_frame)
+{
+    while (!m_retired.empty() && m_retired.front().first + RETIRED_FRAMES <= a_frame)
+    {
+        m_retired.pop_front();
+    }
+
+    while (std::optional<Rebuilt> rebuilt = m_rebuilt.tryPop())
+    {
+        GraphicsPipeline &pipeline = m_pipelines.at(rebuilt->identifier);
+        m_retired.emplace_back(a_frame, std::move(pipeline));
+        pipeline = std::move(rebuilt->pipeline);
+        m_logger->info("Reloaded pipeline '{}'", rebuilt->identifier);
+    }
+}
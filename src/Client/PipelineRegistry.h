@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "spdlog/spdlog.h"
+
+#include "Utils/Identifier.h"
+#include "Utils/MpscQueue.h"
+#include "GraphicsPipeline.h"
+#include "ResourceManager.h"
+
+// The graphics pipelines of the Client by identifier & the shaders each of them is built from, so a changed shader
+// rebuilds exactly the pipelines using it
+// Pipelines are only used & replaced on the main thread; rebuild() runs on any thread & hands what it built over to
+// swapRebuilt(), until then (or if it doesn't compile) the old pipeline stays in use
+class PipelineRegistry final
+{
+public:
+    // Frames are recorded into a single command buffer, so a pipeline replaced in one frame is unused after the next
+    static constexpr uint64_t RETIRED_FRAMES = 2;
+
+    PipelineRegistry(std::shared_ptr<spdlog::logger> a_logger, const ResourceManager &a_resourceManager);
+
+    PipelineRegistry(const PipelineRegistry &) = delete;
+
+    PipelineRegistry &operator=(const PipelineRegistry &) = delete;
+
+    // Builds the pipeline from its shaders (see GraphicsPipeline::getShaders) unless it was added already, throws
+    // std::runtime_error if they can't be compiled
+    GraphicsPipeline &add(const Utils::Identifier &a_pipeline);
+
+    // nullptr if it wasn't added
+    [[nodiscard]]
+    GraphicsPipeline *get(const Utils::Identifier &a_pipeline);
+
+    // Rebuilds every pipeline using one of the shaders, may be called from any thread
+    void rebuild(std::span<const Utils::Identifier> a_shaders);
+
+    // Swaps in what rebuild() finished & destroys the replaced pipelines the GPU is done with, called on the main
+    // thread at the start of every frame
+    void swapRebuilt(uint64_t a_frame);
+
+private:
+    struct Rebuilt
+    {
+        std::string identifier;
+        GraphicsPipeline pipeline;
+    };
+
+    std::shared_ptr<spdlog::logger> m_logger;
+    const ResourceManager &m_resourceManager;
+    // As namespace:path, only touched on the main thread
+    std::unordered_map<std::string, GraphicsPipeline> m_pipelines;
+    std::mutex m_dependentsMutex;
+    // The pipelines built from a shader, by the shader as namespace:path
+    std::unordered_map<std::string, std::vector<Utils::Identifier>> m_dependents;
+    Utils::MpscQueue<Rebuilt> m_rebuilt;
+    // With the frame they were replaced in
+    std::deque<std::pair<uint64_t, GraphicsPipeline>> m_retired;
+};
@@ -1,12 +1,14 @@
-#include <expected>
+#include <cstring>
 #include <fstream>
+#include <sstream>
+#include <unordered_map>
 
 #include "glslang/Public/ShaderLang.h"
 #include "glslang/SPIRV/GlslangToSpv.h"
 
 #include "ResourceManager.h"
 
-using std::vector, std::expected, std::string, std::optional;
+using std::vector, std::string, std::optional;
 
 glslang::SpvOptions g_spvOptions{
     .generateDebugInfo = true
@@ -23,6 +25,19 @@ bool isResourceDirectoryValid(const std::filesystem::path &a_path)
 ResourceManager::ResourceManager(const std::shared_ptr<spdlog::logger> &a_logger, const std::filesystem::path &a_resourceDirectory)
     : m_logger(a_logger), m_resourceDirectory(a_resourceDirectory)
 {
+    if (const std::filesystem::path bundlePath = a_resourceDirectory / BUNDLE_FILE_NAME; std::filesystem::is_regular_file(bundlePath))
+    {
+        try
+        {
+            m_bundle.emplace(bundlePath);
+            m_logger->info("Loaded {} resources from '{}'", m_bundle->getEntryCount(), bundlePath.string());
+            return;
+        } catch (const std::exception &e)
+        {
+            m_logger->error("Failed to load the asset bundle, falling back to loose resources: {}", e.what());
+        }
+    }
+
     if (!isResourceDirectoryValid(a_resourceDirectory))
     {
         m_logger->error("Resource directory '{}' does not contain a valid directory structure, things will probably not go well", a_resourceDirectory.string());
@@ -34,47 +49,156 @@ void ResourceManager::setVkDevice(const vk::raii::Device &a_vkDevice)
     // TODO: make Texture Atlas
 }
 
-template<typename T>
-[[nodiscard]]
-optional<std::basic_ifstream<T>> ResourceManager::getResourceStream(const Utils::Identifier &a_identifier) const
+optional<ResourceManager::Resource> ResourceManager::getResource(const Utils::Identifier &a_identifier) const
 {
-    std::filesystem::path path = m_resourceDirectory / a_identifier.getPath();
+    if (m_bundle.has_value())
+    {
+        const string identifier = a_identifier.toString();
+        if (const optional<std::span<const std::byte>> data = m_bundle->find(identifier); data.has_value() && !isChanged(identifier))
+            return Resource(*data);
+    }
+
+    // <resource directory>/assets/<namespace>/<path>
+    std::filesystem::path path = m_resourceDirectory / "assets" / a_identifier.getNamespace();
 
-    std::stringstream namespaceStream(a_identifier.getNamespace());
+    std::stringstream pathStream(a_identifier.getPath());
     string pathPart;
 
-    while (getline(namespaceStream, pathPart, '/'))
+    while (getline(pathStream, pathPart, '/'))
         path /= pathPart;
 
     if (!std::filesystem::is_regular_file(path))
         return {};
 
-    return std::basic_ifstream<T>(path);
+    // One read of the whole file
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    // Unreadable or removed since it was checked
+    const std::streamoff size = stream.is_open() ? static_cast<std::streamoff>(stream.tellg()) : -1;
+    if (size < 0)
+        return {};
+    vector<std::byte> data(static_cast<size_t>(size));
+    stream.seekg(0);
+    stream.read(reinterpret_cast<char *>(data.data()), static_cast<std::streamsize>(data.size()));
+    if (!stream)
+        return {};
+    return Resource(std::move(data));
 }
 
-[[nodiscard]]
 optional<vector<uint32_t>> ResourceManager::getCompiledShader(const Utils::Identifier &a_identifier, const EShLanguage stage) const
 {
-    auto stream = getResourceStream<char>(a_identifier.withPrefixedPath("shaders"));
-    if (!stream.has_value())
+    const Utils::Identifier identifier = a_identifier.withPrefixedPath("shaders/");
+    if (m_bundle.has_value() && !isChanged(identifier.toString()))
+    {
+        if (const optional<std::span<const std::byte>> spirV = m_bundle->find(identifier.withSuffixedPath(string(SPIR_V_SUFFIX))))
+        {
+            vector<uint32_t> words(spirV->size() / sizeof(uint32_t));
+            std::memcpy(words.data(), spirV->data(), words.size() * sizeof(uint32_t));
+            return words;
+        }
+    }
+
+    const optional<Resource> source = getResource(identifier);
+    if (!source.has_value())
         return {};
+    return compileShader(*m_logger, identifier.toString(), source->getData(), stage);
+}
 
-    const vector chars(std::istreambuf_iterator(stream.value()), std::istreambuf_iterator<char>());
+void ResourceManager::watchShaders(ShaderCallback &&a_onChange)
+{
+    stopWatchingShaders();
 
+    const std::filesystem::path assets = m_resourceDirectory / "assets";
+    vector<std::filesystem::path> directories;
+    std::error_code error;
+    for (const std::filesystem::directory_entry &namespaceDirectory: std::filesystem::directory_iterator(assets, error))
+    {
+        if (std::filesystem::is_directory(namespaceDirectory.path() / "shaders"))
+            directories.push_back(namespaceDirectory.path() / "shaders");
+    }
+
+    // Set before the watcher thread starts, which reads it through getResource() & getCompiledShader()
+    m_shaderWatch = std::make_unique<ShaderWatch>();
+    m_shaderWatch->onChange = std::move(a_onChange);
+    try
+    {
+        m_shaderWatch->watcher.emplace(directories, [assets, shaderWatch = m_shaderWatch.get(), logger = m_logger](const std::span<const std::filesystem::path> a_paths)
+        {
+            vector<Utils::Identifier> shaders;
+            for (const std::filesystem::path &path: a_paths)
+            {
+                // <namespace>/shaders/<path>
+                const std::filesystem::path relativePath = path.lexically_relative(assets);
+                if (relativePath.empty() || !getShaderStage(path).has_value())
+                    continue;
+
+                const string shaderNamespace = relativePath.begin()->string();
+                if (const optional<Utils::Identifier> shader = Utils::Identifier::of(
+                    shaderNamespace, path.lexically_relative(assets / shaderNamespace / "shaders").generic_string()))
+                {
+                    shaders.push_back(*shader);
+                }
+            }
+            if (shaders.empty())
+                return;
+
+            {
+                std::lock_guard lock(shaderWatch->mutex);
+                for (const Utils::Identifier &shader: shaders)
+                {
+                    shaderWatch->changedResources.insert(shader.withPrefixedPath("shaders/").toString());
+                }
+            }
+
+            logger->info("{} shader(s) changed, reloading them", shaders.size());
+            try
+            {
+                shaderWatch->onChange(shaders);
+            } catch (const std::exception &e)
+            {
+                logger->error("Failed to reload shaders: {}", e.what());
+            }
+        });
+    } catch (const std::exception &e)
+    {
+        m_logger->warn("Shaders won't be reloaded when they change: {}", e.what());
+        m_shaderWatch.reset();
+    }
+}
+
+void ResourceManager::stopWatchingShaders()
+{
+    // The watcher thread is stopped before the rest goes away
+    if (m_shaderWatch != nullptr)
+        m_shaderWatch->watcher.reset();
+    m_shaderWatch.reset();
+}
+
+bool ResourceManager::isChanged(const string &a_identifier) const
+{
+    if (m_shaderWatch == nullptr)
+        return false;
+
+    std::lock_guard lock(m_shaderWatch->mutex);
+    return m_shaderWatch->changedResources.contains(a_identifier);
+}
+
+optional<vector<uint32_t>> ResourceManager::compileShader(spdlog::logger &a_logger, const std::string_view a_name,
+                                                          const std::span<const std::byte> a_source, const EShLanguage a_stage)
+{
     glslang::TShader shader{
-        stage
+        a_stage
     };
     shader.setDebugInfo(true);
 
-    const char *str = chars.data();
-    const int length = static_cast<int>(chars.size());
+    const char *str = reinterpret_cast<const char *>(a_source.data());
+    const int length = static_cast<int>(a_source.size());
     shader.setStringsWithLengths(&str, &length, 1);
 
     shader.setEnvClient(glslang::EShClient::EShClientVulkan, glslang::EShTargetClientVersion::EShTargetVulkan_1_3);
     shader.setEnvTarget(glslang::EShTargetLanguage::EShTargetSpv, glslang::EShTargetLanguageVersion::EShTargetSpv_1_6);
     shader.setEnvInput(
         glslang::EShSource::EShSourceGlsl,
-        stage,
+        a_stage,
         glslang::EShClient::EShClientOpenGL,
         glslang::EShTargetClientVersion::EShTargetOpenGL_450
     );
@@ -90,9 +214,10 @@ optional<vector<uint32_t>> ResourceManager::getCompiledShader(const Utils::Ident
         )
     )
     {
-        m_logger->warn("Failed to parse shader '{}'\nShader info log:\n{}\nDebug log:\n{}\n",
-                       a_identifier.toString(), shader.getInfoLog(), shader.getInfoDebugLog()
+        a_logger.warn("Failed to parse shader '{}'\nShader info log:\n{}\nDebug log:\n{}\n",
+                      a_name, shader.getInfoLog(), shader.getInfoDebugLog()
         );
+        return {};
     }
 
     vector<uint32_t> spirV{};
@@ -100,3 +225,19 @@ optional<vector<uint32_t>> ResourceManager::getCompiledShader(const Utils::Ident
 
     return spirV;
 }
+
+optional<EShLanguage> ResourceManager::getShaderStage(const std::filesystem::path &a_path)
+{
+    static const std::unordered_map<string, EShLanguage> s_stages = {
+        {".vert", EShLangVertex},
+        {".tesc", EShLangTessControl},
+        {".tese", EShLangTessEvaluation},
+        {".geom", EShLangGeometry},
+        {".frag", EShLangFragment},
+        {".comp", EShLangCompute}
+    };
+
+    if (const auto stage = s_stages.find(a_path.extension().string()); stage != s_stages.end())
+        return stage->second;
+    return {};
+}
@@ -1,15 +1,57 @@
 #pragma once
 #include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
 
 #include "spdlog/spdlog.h"
 #include "vulkan/vulkan_raii.hpp"
 #include "glslang/Public/ShaderLang.h"
 
+#include "Utils/AssetBundle.h"
+#include "Utils/DirectoryWatcher.h"
 #include "Utils/Identifier.h"
+#include "Utils/UniqueFunction.h"
 
+// Resources are looked up in the asset bundle of the resource directory first (see Utils::AssetBundle & MCpp-Pack),
+// then as loose files in <resource directory>/assets/<namespace>/<path>, so resources can be changed during development
+// without packing them again
 class ResourceManager final
 {
 public:
+    // Gets the changed shaders, relative to shaders/ like getCompiledShader
+    using ShaderCallback = Utils::UniqueFunction<void(std::span<const Utils::Identifier>)>;
+
+    static constexpr std::string_view BUNDLE_FILE_NAME = "assets.mcpack";
+    // Precompiled shaders are stored in bundles under the identifier of their source with this appended
+    static constexpr std::string_view SPIR_V_SUFFIX = ".spv";
+
+    // The bytes of a resource: a view into the mapped bundle, or the contents of a loose file
+    class Resource final
+    {
+    public:
+        explicit Resource(const std::span<const std::byte> a_view)
+            : m_view(a_view) {}
+
+        explicit Resource(std::vector<std::byte> &&a_data)
+            : m_data(std::move(a_data)) {}
+
+        [[nodiscard]]
+        std::span<const std::byte> getData() const
+        {
+            return m_data.empty() ? m_view : std::span<const std::byte>(m_data);
+        }
+
+    private:
+        std::span<const std::byte> m_view;
+        std::vector<std::byte> m_data;
+    };
+
     ResourceManager() = default;
 
     ResourceManager(std::nullptr_t) {}
@@ -19,14 +61,49 @@ public:
     // Used to create the Texture Atlas TODO
     void setVkDevice(const vk::raii::Device &a_vkDevice);
 
-    template<typename T>
+    // Views into the bundle stay valid as long as the ResourceManager exists
     [[nodiscard]]
-    std::optional<std::basic_ifstream<T>> getResourceStream(const Utils::Identifier &a_identifier) const;
+    std::optional<Resource> getResource(const Utils::Identifier &a_identifier) const;
 
+    // The identifier is relative to shaders/, precompiled SPIR-V from the bundle is used if there is any
     [[nodiscard]]
     std::optional<std::vector<uint32_t>> getCompiledShader(const Utils::Identifier &a_identifier, EShLanguage stage) const;
 
+    // Compiles GLSL for Vulkan, nullopt & the info log is logged if it doesn't compile; glslang::InitializeProcess()
+    // must have been called
+    [[nodiscard]]
+    static std::optional<std::vector<uint32_t>> compileShader(spdlog::logger &a_logger, std::string_view a_name,
+                                                              std::span<const std::byte> a_source, EShLanguage a_stage);
+
+    // By file extension (.vert, .frag ...), nullopt if it's not a shader
+    [[nodiscard]]
+    static std::optional<EShLanguage> getShaderStage(const std::filesystem::path &a_path);
+
+    // Calls a_onChange on a background thread whenever shaders in <resource directory>/assets/*/shaders change, those
+    // are loaded from the loose files from then on, even if they're in the bundle
+    // Only supported on Linux, logs a warning elsewhere
+    void watchShaders(ShaderCallback &&a_onChange);
+
+    // Waits for a_onChange to return if it's running
+    void stopWatchingShaders();
+
 private:
+    // On the heap, so the watcher thread can use it while the ResourceManager is moved
+    struct ShaderWatch
+    {
+        std::mutex mutex;
+        // As namespace:path
+        std::unordered_set<std::string> changedResources;
+        ShaderCallback onChange;
+        std::optional<Utils::DirectoryWatcher> watcher;
+    };
+
     std::shared_ptr<spdlog::logger> m_logger = nullptr;
     std::filesystem::path m_resourceDirectory;
+    std::optional<Utils::AssetBundle> m_bundle;
+    std::unique_ptr<ShaderWatch> m_shaderWatch;
+
+    // If it's a watched shader that changed, so the bundle has an outdated copy
+    [[nodiscard]]
+    bool isChanged(const std::string &a_identifier) const;
 };
@@ -0,0 +1,125 @@
+#include "../Common-Lib/Logging.h"
+#include "../Common-Lib/Network/Packets.h"
+#include "../Common-Lib/Network/SectionEncoding.h"
+#include "ServerConnection.h"
+
+namespace Packets = Network::Packets;
+
+ServerConnection::ServerConnection(Network::Connection &&a_connection, const std::string_view a_playerName)
+    : m_logger(Logging::getLogger("Connection")), m_connection(std::move(a_connection))
+{
+    send(Packets::Login{a_playerName});
+}
+
+ServerConnection::~ServerConnection()
+{
+    m_connection.close();
+}
+
+bool ServerConnection::update(const std::chrono::nanoseconds a_frameTime)
+{
+    try
+    {
+        // Every buffer holds whole frames
+        while (std::optional<Network::PooledBuffer> buffer = m_connection.receive())
+        {
+            std::span<const std::byte> data = buffer->getData();
+            while (const std::optional<Network::PacketFrame> frame = Network::readFrame(data))
+            {
+                handlePacket(*frame);
+                data = data.subspan(frame->frameSize);
+            }
+            if (!data.empty())
+                throw Network::ProtocolError("Incomplete packet frame");
+        }
+    } catch (const Network::ProtocolError &e)
+    {
+        m_logger->error("Disconnecting from the server: {}", e.what());
+        m_connection.close();
+    }
+
+    m_entities.update(a_frameTime);
+    return !m_connection.isClosed();
+}
+
+void ServerConnection::sendPosition(const glm::dvec3 &a_position, const float a_yaw, const float a_pitch, const bool a_onGround)
+{
+    send(Packets::EntityPosition{{0}, a_position.x, a_position.y, a_position.z, a_yaw, a_pitch, a_onGround});
+}
+
+void ServerConnection::sendBlockChange(const World::BlockPos &a_pos, const World::BlockStateId a_state)
+{
+    send(Packets::BlockChange{a_pos, {a_state}});
+}
+
+void ServerConnection::sendChatMessage(const std::string_view a_message)
+{
+    send(Packets::ChatMessage{a_message, std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count()});
+}
+
+void ServerConnection::handlePacket(const Network::PacketFrame &a_frame)
+{
+    switch (a_frame.id)
+    {
+        case Packets::KeepAlive::ID:
+        case Packets::TickTimes::ID:
+        // A TCP transport switched to compression when it passed through
+        case Packets::SetCompression::ID:
+            break;
+        case Packets::LoginSuccess::ID:
+        {
+            const auto packet = Network::decodePacket<Packets::LoginSuccess>(a_frame.body);
+            const auto bits = static_cast<uint64_t>(packet.entity.value);
+            m_playerEntity = {static_cast<uint32_t>(bits), static_cast<uint32_t>(bits >> 32)};
+            m_logger->info("Logged in at ({:.1f}, {:.1f}, {:.1f})", packet.x, packet.y, packet.z);
+            break;
+        }
+        case Packets::ChunkSectionData::ID:
+        {
+            const auto packet = Network::decodePacket<Packets::ChunkSectionData>(a_frame.body);
+            World::Chunk &chunk = m_world.getOrCreateChunk(World::ChunkPos::of(packet.pos));
+            if (packet.blocks.empty())
+            {
+                chunk.setSection(packet.pos.y, nullptr);
+                break;
+            }
+            auto section = std::make_unique<World::ChunkSection>();
+            Network::decodeSectionBlocks(packet.blocks, *section);
+            chunk.setSection(packet.pos.y, std::move(section));
+            break;
+        }
+        case Packets::BlockChange::ID:
+        {
+            const auto packet = Network::decodePacket<Packets::BlockChange>(a_frame.body);
+            m_world.setBlock(packet.pos, static_cast<World::BlockStateId>(packet.state.value));
+            break;
+        }
+        case Packets::MultiBlockChange::ID:
+        {
+            const auto packet = Network::decodePacket<Packets::MultiBlockChange>(a_frame.body);
+            const World::BlockPos origin = packet.section.getOrigin();
+            Network::PacketReader reader(packet.changes);
+            while (reader.getRemaining() > 0)
+            {
+                const int64_t change = reader.readVarLong();
+                if (reader.hasFailed())
+                    throw Network::ProtocolError("Malformed block changes");
+                const auto index = static_cast<int32_t>(change & 0xFFF);
+                m_world.setBlock(origin.offset(index & 15, index >> 8, index >> 4 & 15), static_cast<World::BlockStateId>(change >> 12));
+            }
+            break;
+        }
+        case Packets::UnloadChunk::ID:
+            m_world.removeChunk(Network::decodePacket<Packets::UnloadChunk>(a_frame.body).pos);
+            break;
+        case Packets::ChatMessage::ID:
+            m_logger->info("[Chat] {}", Network::decodePacket<Packets::ChatMessage>(a_frame.body).message);
+            break;
+        case Packets::EntitySnapshot::ID:
+            if (const std::optional<uint64_t> tick = m_entities.onSnapshot(Network::decodePacket<Packets::EntitySnapshot>(a_frame.body)))
+                send(Packets::SnapshotAck{{static_cast<int64_t>(*tick)}});
+            break;
+        default:
+            throw Network::ProtocolError(std::format("Unexpected packet {}", a_frame.id));
+    }
+}
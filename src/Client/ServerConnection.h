@@ -0,0 +1,75 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string_view>
+
+#include "spdlog/spdlog.h"
+#include "glm/vec3.hpp"
+
+#include "../Common-Lib/Network/Connection.h"
+#include "../Common-Lib/World/ChunkMap.h"
+#include "EntityInterpolator.h"
+
+// The client's side of a connection to a server: logs in, keeps the world & entities the server sends & sends the
+// player's actions; used from the main thread only
+class ServerConnection final
+{
+public:
+    ServerConnection(Network::Connection &&a_connection, std::string_view a_playerName);
+
+    ServerConnection(const ServerConnection &) = delete;
+
+    ServerConnection &operator=(const ServerConnection &) = delete;
+
+    // Closes the connection
+    ~ServerConnection();
+
+    // Handles everything received since the last frame, returns false once the connection is closed
+    [[nodiscard]]
+    bool update(std::chrono::nanoseconds a_frameTime);
+
+    void sendPosition(const glm::dvec3 &a_position, float a_yaw, float a_pitch, bool a_onGround);
+
+    void sendBlockChange(const World::BlockPos &a_pos, World::BlockStateId a_state);
+
+    void sendChatMessage(std::string_view a_message);
+
+    // Invalid until the server accepted the login
+    [[nodiscard]]
+    Ecs::EntityId getPlayerEntity() const
+    {
+        return m_playerEntity;
+    }
+
+    [[nodiscard]]
+    const World::ChunkMap &getWorld() const
+    {
+        return m_world;
+    }
+
+    [[nodiscard]]
+    const EntityInterpolator &getEntities() const
+    {
+        return m_entities;
+    }
+
+private:
+    std::shared_ptr<spdlog::logger> m_logger;
+    Network::Connection m_connection;
+    Network::BufferPool m_buffers;
+    World::ChunkMap m_world;
+    EntityInterpolator m_entities;
+    Ecs::EntityId m_playerEntity;
+
+    // Throws a Network::ProtocolError for packets the server must not send
+    void handlePacket(const Network::PacketFrame &a_frame);
+
+    template<typename P>
+    void send(const P &a_packet)
+    {
+        Network::PooledBuffer buffer = m_buffers.acquire();
+        Network::encodePacket(*buffer, a_packet);
+        m_connection.send(std::move(buffer));
+    }
+};
@@ -3,6 +3,7 @@
 #include "GLFW/glfw3.h"
 
 #include "../Common-Lib/Logging.h"
+#include "../Common-Lib/Memory/MemoryTracker.h"
 #include "VulkanHandler.h"
 
 using std::vector, std::string, std::shared_ptr, std::optional;
@@ -208,6 +209,36 @@ void VulkanHandler::onWindowResize(const GLFWwindow *a_glfwWindow, int a_width,
     createVkImageViews();
 }
 
+void VulkanHandler::updateMemoryUsage() const
+{
+    if (m_vkPhysicalDevice == nullptr)
+        return;
+
+    size_t usage = 0;
+    size_t budget = 0;
+    if (m_vkMemoryBudgetSupported)
+    {
+        const auto properties = m_vkPhysicalDevice.getMemoryProperties2<vk::PhysicalDeviceMemoryProperties2, vk::PhysicalDeviceMemoryBudgetPropertiesEXT>();
+        const auto &heaps = properties.get<vk::PhysicalDeviceMemoryProperties2>().memoryProperties;
+        const auto &heapBudgets = properties.get<vk::PhysicalDeviceMemoryBudgetPropertiesEXT>();
+        for (uint32_t i = 0; i < heaps.memoryHeapCount; i++)
+        {
+            usage += heapBudgets.heapUsage[i];
+            budget += heapBudgets.heapBudget[i];
+        }
+    }
+    else
+    {
+        // Without the extension the driver can't tell us our usage, the heap sizes are the best budget we have
+        const auto heaps = m_vkPhysicalDevice.getMemoryProperties();
+        for (uint32_t i = 0; i < heaps.memoryHeapCount; i++)
+        {
+            budget += heaps.memoryHeaps[i].size;
+        }
+    }
+    Memory::reportDeviceMemory(usage, budget);
+}
+
 int64_t getVkDeviceScore(const vk::PhysicalDevice &a_device)
 {
     const auto deviceProperties = a_device.getProperties();
@@ -276,6 +307,19 @@ void VulkanHandler::pickVkDevice()
     m_vkPhysicalDevice.clear();
     m_vkPhysicalDevice = currentBest;
 
+    // Optional, without it only the memory we allocate ourselves can be accounted for
+    vector<const char *> enabledDeviceExtensions = requiredDeviceExtensions;
+    const auto supportedDeviceExtensions = currentBest.enumerateDeviceExtensionProperties();
+    m_vkMemoryBudgetSupported = std::ranges::any_of(supportedDeviceExtensions, [](const auto &a_extensionProperty)
+    {
+        return strcmp(a_extensionProperty.extensionName, vk::EXTMemoryBudgetExtensionName) == 0;
+    });
+    if (m_vkMemoryBudgetSupported)
+    {
+        enabledDeviceExtensions.push_back(vk::EXTMemoryBudgetExtensionName);
+    }
+    m_logger->debug("VK_EXT_memory_budget supported: {}", m_vkMemoryBudgetSupported);
+
     float queuePriority = 0.5f;
     vk::DeviceQueueCreateInfo deviceQueueCreateInfo{
         .queueFamilyIndex = static_cast<uint32_t>(currentBestCheckResult.graphicsQueueFamilyIndex),
@@ -295,8 +339,8 @@ void VulkanHandler::pickVkDevice()
         .pNext = &featureChain.get<vk::PhysicalDeviceFeatures2>(),
         .queueCreateInfoCount = 1,
         .pQueueCreateInfos = &deviceQueueCreateInfo,
-        .enabledExtensionCount = static_cast<uint32_t>(requiredDeviceExtensions.size()),
-        .ppEnabledExtensionNames = requiredDeviceExtensions.data()
+        .enabledExtensionCount = static_cast<uint32_t>(enabledDeviceExtensions.size()),
+        .ppEnabledExtensionNames = enabledDeviceExtensions.data()
     };
 
     m_vkDevice.clear();
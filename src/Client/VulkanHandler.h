@@ -20,6 +20,9 @@ public:
 
     void onWindowResize(const GLFWwindow *a_glfwWindow, int a_width, int a_height);
 
+    // Reports the device memory used by this process to the memory tracker, exact if VK_EXT_memory_budget is supported
+    void updateMemoryUsage() const;
+
 private:
     std::shared_ptr<spdlog::logger> m_logger = nullptr;
     ResourceManager *m_resourceManager = nullptr;
@@ -31,6 +34,7 @@ private:
     vk::raii::SurfaceKHR m_vkSurface = nullptr;
     vk::raii::PhysicalDevice m_vkPhysicalDevice = nullptr;
     vk::raii::Device m_vkDevice = nullptr;
+    bool m_vkMemoryBudgetSupported = false;
     uint32_t m_vkGraphicsQueueFamilyIndex = -1;
     uint32_t m_vkPresentQueueFamilyIndex = -1;
     vk::raii::Queue m_vkGraphicsQueue = nullptr;
@@ -0,0 +1,127 @@
+#include <algorithm>
+
+#include "Archetype.h"
+
+using Ecs::Archetype, Ecs::EntityId;
+
+[[nodiscard]]
+constexpr size_t alignUp(const size_t a_value, const size_t a_alignment)
+{
+    return (a_value + a_alignment - 1) / a_alignment * a_alignment;
+}
+
+Archetype::Archetype(const uint32_t a_index, std::vector<ComponentTypeId> a_componentTypes)
+    : m_index(a_index), m_componentTypes(std::move(a_componentTypes)), m_columnOfType(MAX_COMPONENT_TYPES, -1)
+{
+    size_t bytesPerEntity = sizeof(EntityId);
+    m_componentInfos.reserve(m_componentTypes.size());
+    for (size_t column = 0; column < m_componentTypes.size(); column++)
+    {
+        const ComponentTypeId typeId = m_componentTypes[column];
+        const ComponentInfo &info = getComponentInfo(typeId);
+        m_componentInfos.push_back(&info);
+        m_columnOfType[typeId] = static_cast<int32_t>(column);
+        m_mask.set(typeId);
+        bytesPerEntity += info.size;
+    }
+
+    m_chunkCapacity = static_cast<uint32_t>(std::max<size_t>(CHUNK_BYTES / bytesPerEntity, 1));
+    while (m_chunkCapacity > 1 && computeLayout(m_chunkCapacity, nullptr) > CHUNK_BYTES)
+    {
+        m_chunkCapacity--;
+    }
+    m_chunkBytes = std::max(CHUNK_BYTES, computeLayout(m_chunkCapacity, &m_columnOffsets));
+}
+
+Archetype::~Archetype()
+{
+    for (uint32_t row = 0; row < m_entityCount; row++)
+    {
+        for (size_t column = 0; column < m_componentInfos.size(); column++)
+        {
+            m_componentInfos[column]->destroy(getComponent(row, column));
+        }
+    }
+}
+
+size_t Archetype::computeLayout(const uint32_t a_capacity, std::vector<size_t> *a_offsets) const
+{
+    // The entity ids live at the start of the chunk, every column starts on its own cache line
+    size_t offset = sizeof(EntityId) * a_capacity;
+    for (const ComponentInfo *info: m_componentInfos)
+    {
+        offset = alignUp(offset, 64);
+        if (a_offsets != nullptr)
+            a_offsets->push_back(offset);
+        offset += info->size * a_capacity;
+    }
+    return offset;
+}
+
+std::span<const EntityId> Archetype::getChunkEntities(const size_t a_chunk) const
+{
+    const ArchetypeChunk &chunk = m_chunks[a_chunk];
+    return {reinterpret_cast<const EntityId *>(chunk.data.get()), chunk.count};
+}
+
+void *Archetype::getComponent(const uint32_t a_row, const size_t a_column) const
+{
+    const ArchetypeChunk &chunk = m_chunks[a_row / m_chunkCapacity];
+    return chunk.data.get() + m_columnOffsets[a_column] + a_row % m_chunkCapacity * m_componentInfos[a_column]->size;
+}
+
+EntityId Archetype::getEntity(const uint32_t a_row) const
+{
+    const ArchetypeChunk &chunk = m_chunks[a_row / m_chunkCapacity];
+    return reinterpret_cast<const EntityId *>(chunk.data.get())[a_row % m_chunkCapacity];
+}
+
+uint32_t Archetype::pushRow(const EntityId a_entity)
+{
+    const size_t chunkIndex = m_entityCount / m_chunkCapacity;
+    if (chunkIndex == m_chunks.size())
+    {
+        m_chunks.push_back({
+            .data = decltype(ArchetypeChunk::data)(static_cast<std::byte *>(::operator new(m_chunkBytes, std::align_val_t(64)))),
+            .count = 0
+        });
+    }
+
+    ArchetypeChunk &chunk = m_chunks[chunkIndex];
+    reinterpret_cast<EntityId *>(chunk.data.get())[chunk.count] = a_entity;
+    chunk.count++;
+    return static_cast<uint32_t>(m_entityCount++);
+}
+
+EntityId Archetype::eraseRow(const uint32_t a_row)
+{
+    const auto lastRow = static_cast<uint32_t>(m_entityCount - 1);
+    EntityId movedEntity = NULL_ENTITY;
+
+    if (a_row != lastRow)
+    {
+        for (size_t column = 0; column < m_componentInfos.size(); column++)
+        {
+            void *source = getComponent(lastRow, column);
+            m_componentInfos[column]->moveConstruct(getComponent(a_row, column), source);
+            m_componentInfos[column]->destroy(source);
+        }
+
+        movedEntity = getEntity(lastRow);
+        ArchetypeChunk &chunk = m_chunks[a_row / m_chunkCapacity];
+        reinterpret_cast<EntityId *>(chunk.data.get())[a_row % m_chunkCapacity] = movedEntity;
+    }
+
+    m_chunks[lastRow / m_chunkCapacity].count--;
+    m_entityCount--;
+    return movedEntity;
+}
+
+EntityId Archetype::destroyRow(const uint32_t a_row)
+{
+    for (size_t column = 0; column < m_componentInfos.size(); column++)
+    {
+        m_componentInfos[column]->destroy(getComponent(a_row, column));
+    }
+    return eraseRow(a_row);
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "Component.h"
+#include "EntityId.h"
+
+namespace Ecs
+{
+    // Fixed size block of memory holding the components of up to Archetype::getChunkCapacity() entities
+    // Every component type has its own contiguous array inside the chunk (structure of arrays)
+    struct ArchetypeChunk
+    {
+        struct AlignedDelete
+        {
+            void operator()(std::byte *a_data) const
+            {
+                ::operator delete(a_data, std::align_val_t(64));
+            }
+        };
+
+        std::unique_ptr<std::byte[], AlignedDelete> data;
+        uint32_t count = 0;
+    };
+
+    // All entities with exactly the same set of component types
+    // Rows are densely packed: removing an entity moves the last entity into the hole
+    class Archetype final
+    {
+    public:
+        static constexpr size_t CHUNK_BYTES = 16 * 1024;
+
+        Archetype(uint32_t a_index, std::vector<ComponentTypeId> a_componentTypes);
+
+        Archetype(const Archetype &) = delete;
+
+        Archetype &operator=(const Archetype &) = delete;
+
+        ~Archetype();
+
+        [[nodiscard]]
+        uint32_t getIndex() const
+        {
+            return m_index;
+        }
+
+        [[nodiscard]]
+        const std::vector<ComponentTypeId> &getComponentTypes() const
+        {
+            return m_componentTypes;
+        }
+
+        [[nodiscard]]
+        const ComponentMask &getMask() const
+        {
+            return m_mask;
+        }
+
+        // Index of the column storing a_typeId, or -1 if this archetype doesn't have that component
+        [[nodiscard]]
+        int32_t getColumn(const ComponentTypeId a_typeId) const
+        {
+            return m_columnOfType[a_typeId];
+        }
+
+        [[nodiscard]]
+        uint32_t getChunkCapacity() const
+        {
+            return m_chunkCapacity;
+        }
+
+        [[nodiscard]]
+        size_t getEntityCount() const
+        {
+            return m_entityCount;
+        }
+
+        // Amount of chunks that hold at least one entity
+        [[nodiscard]]
+        size_t getChunkCount() const
+        {
+            return (m_entityCount + m_chunkCapacity - 1) / m_chunkCapacity;
+        }
+
+        [[nodiscard]]
+        uint32_t getChunkSize(const size_t a_chunk) const
+        {
+            return m_chunks[a_chunk].count;
+        }
+
+        [[nodiscard]]
+        std::span<const EntityId> getChunkEntities(size_t a_chunk) const;
+
+        [[nodiscard]]
+        void *getColumnData(const size_t a_chunk, const size_t a_column) const
+        {
+            return m_chunks[a_chunk].data.get() + m_columnOffsets[a_column];
+        }
+
+        [[nodiscard]]
+        void *getComponent(uint32_t a_row, size_t a_column) const;
+
+        [[nodiscard]]
+        EntityId getEntity(uint32_t a_row) const;
+
+        // Appends a row for a_entity & returns it, the components of the new row are uninitialized
+        uint32_t pushRow(EntityId a_entity);
+
+        // Fills the hole at a_row, whose components must already be destroyed or moved out, with the last row
+        // Returns the entity that was moved into a_row, or NULL_ENTITY if a_row was the last row
+        EntityId eraseRow(uint32_t a_row);
+
+        // Destroys the components of a_row & fills the hole, see eraseRow()
+        EntityId destroyRow(uint32_t a_row);
+
+        // Cached transitions to the archetype with one component type added / removed
+        std::unordered_map<ComponentTypeId, Archetype *> addEdges;
+        std::unordered_map<ComponentTypeId, Archetype *> removeEdges;
+
+    private:
+        uint32_t m_index;
+        std::vector<ComponentTypeId> m_componentTypes;
+        std::vector<const ComponentInfo *> m_componentInfos;
+        std::vector<size_t> m_columnOffsets;
+        std::vector<int32_t> m_columnOfType;
+        ComponentMask m_mask;
+        uint32_t m_chunkCapacity = 0;
+        size_t m_chunkBytes = CHUNK_BYTES;
+        size_t m_entityCount = 0;
+        std::vector<ArchetypeChunk> m_chunks;
+
+        [[nodiscard]]
+        size_t computeLayout(uint32_t a_capacity, std::vector<size_t> *a_offsets) const;
+    };
+}
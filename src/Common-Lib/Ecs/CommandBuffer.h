@@ -0,0 +1,78 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Utils/UniqueFunction.h"
+#include "EntityId.h"
+#include "Registry.h"
+
+namespace Ecs
+{
+    // Records structural changes so they can be made while iterating & applied afterward
+    // Not thread safe, use one per thread (see Utils::JobSystem::getCurrentThreadIndex()) & apply them in a fixed order
+    class CommandBuffer final
+    {
+    public:
+        template<typename... Ts>
+        void createEntity(Ts &&... a_components)
+        {
+            m_commands.emplace_back([... components = std::forward<Ts>(a_components)](Registry &a_registry) mutable
+            {
+                a_registry.createEntity(std::move(components)...);
+            });
+        }
+
+        void destroyEntity(const EntityId a_entity)
+        {
+            m_commands.emplace_back([a_entity](Registry &a_registry)
+            {
+                a_registry.destroyEntity(a_entity);
+            });
+        }
+
+        template<typename T>
+        void addComponent(const EntityId a_entity, T &&a_component)
+        {
+            m_commands.emplace_back([a_entity, component = std::forward<T>(a_component)](Registry &a_registry) mutable
+            {
+                a_registry.addComponent(a_entity, std::move(component));
+            });
+        }
+
+        template<typename T>
+        void removeComponent(const EntityId a_entity)
+        {
+            m_commands.emplace_back([a_entity](Registry &a_registry)
+            {
+                a_registry.removeComponent<T>(a_entity);
+            });
+        }
+
+        [[nodiscard]]
+        bool isEmpty() const
+        {
+            return m_commands.empty();
+        }
+
+        [[nodiscard]]
+        size_t size() const
+        {
+            return m_commands.size();
+        }
+
+        // Runs the recorded commands in order, commands on entities that are no longer alive do nothing
+        void apply(Registry &a_registry)
+        {
+            for (Utils::UniqueFunction<void(Registry &)> &command: m_commands)
+            {
+                command(a_registry);
+            }
+            m_commands.clear();
+        }
+
+    private:
+        std::vector<Utils::UniqueFunction<void(Registry &)>> m_commands;
+    };
+}
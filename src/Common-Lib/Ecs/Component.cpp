@@ -0,0 +1,27 @@
+#include <array>
+#include <mutex>
+#include <stdexcept>
+
+#include "Component.h"
+
+std::mutex g_componentRegistryMutex;
+std::array<Ecs::ComponentInfo, Ecs::MAX_COMPONENT_TYPES> g_componentInfos;
+size_t g_componentTypeCount = 0;
+
+Ecs::ComponentTypeId Ecs::registerComponentType(const ComponentInfo &a_info)
+{
+    std::lock_guard guard(g_componentRegistryMutex);
+    if (g_componentTypeCount >= MAX_COMPONENT_TYPES)
+    {
+        throw std::runtime_error(std::string("Too many component types, failed to register ") + a_info.name);
+    }
+
+    g_componentInfos[g_componentTypeCount] = a_info;
+    return static_cast<ComponentTypeId>(g_componentTypeCount++);
+}
+
+const Ecs::ComponentInfo &Ecs::getComponentInfo(const ComponentTypeId a_typeId)
+{
+    // Entries are written once before their id is handed out & never change afterward
+    return g_componentInfos[a_typeId];
+}
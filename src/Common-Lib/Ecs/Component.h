@@ -0,0 +1,75 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+
+namespace Ecs
+{
+    using ComponentTypeId = uint16_t;
+
+    inline constexpr size_t MAX_COMPONENT_TYPES = 256;
+
+    using ComponentMask = std::bitset<MAX_COMPONENT_TYPES>;
+
+    // Type erased description of a component, enough for archetypes to store & move components they know nothing about
+    struct ComponentInfo
+    {
+        const char *name = nullptr;
+        size_t size = 0;
+        size_t alignment = 0;
+        // Move-constructs into a_destination, the source is left for destroy()
+        void (*moveConstruct)(void *a_destination, void *a_source) = nullptr;
+        void (*destroy)(void *a_component) = nullptr;
+    };
+
+    // Archetype chunks are 64 byte aligned, so components can't require more than that
+    template<typename T>
+    concept Component = std::is_object_v<T> && !std::is_const_v<T> && alignof(T) <= 64
+                        && std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>;
+
+    // Registers a component type & returns its id, throws if more than MAX_COMPONENT_TYPES are registered
+    [[nodiscard]]
+    ComponentTypeId registerComponentType(const ComponentInfo &a_info);
+
+    [[nodiscard]]
+    const ComponentInfo &getComponentInfo(ComponentTypeId a_typeId);
+
+    template<Component T>
+    [[nodiscard]]
+    constexpr ComponentInfo makeComponentInfo()
+    {
+        return {
+            .name = typeid(T).name(),
+            .size = sizeof(T),
+            .alignment = alignof(T),
+            .moveConstruct = [](void *a_destination, void *a_source)
+            {
+                ::new(a_destination) T(std::move(*static_cast<T *>(a_source)));
+            },
+            .destroy = [](void *a_component)
+            {
+                static_cast<T *>(a_component)->~T();
+            }
+        };
+    }
+
+    template<Component T>
+    [[nodiscard]]
+    ComponentTypeId getUnqualifiedComponentTypeId()
+    {
+        static const ComponentTypeId s_typeId = registerComponentType(makeComponentInfo<T>());
+        return s_typeId;
+    }
+
+    // const T & T& share the id of T
+    template<typename T>
+    [[nodiscard]]
+    ComponentTypeId getComponentTypeId()
+    {
+        return getUnqualifiedComponentTypeId<std::remove_cvref_t<T>>();
+    }
+}
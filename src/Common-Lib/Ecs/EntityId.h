@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+
+namespace Ecs
+{
+    // Handle to an entity, the generation makes handles to destroyed entities detectable after their slot got reused
+    struct EntityId
+    {
+        static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+        uint32_t index = INVALID_INDEX;
+        uint32_t generation = 0;
+
+        [[nodiscard]]
+        constexpr bool isValid() const
+        {
+            return index != INVALID_INDEX;
+        }
+
+        [[nodiscard]]
+        constexpr uint64_t toBits() const
+        {
+            return static_cast<uint64_t>(generation) << 32 | index;
+        }
+
+        constexpr bool operator==(const EntityId &) const = default;
+    };
+
+    inline constexpr EntityId NULL_ENTITY{};
+}
+
+template<>
+struct std::hash<Ecs::EntityId>
+{
+    size_t operator()(const Ecs::EntityId &a_entity) const noexcept
+    {
+        return std::hash<uint64_t>{}(a_entity.toBits());
+    }
+};
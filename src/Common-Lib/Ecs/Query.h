@@ -0,0 +1,182 @@
+#pragma once
+
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "Utils/JobSystem.h"
+#include "Archetype.h"
+#include "Component.h"
+#include "Registry.h"
+
+namespace Ecs
+{
+    // The entities of one archetype chunk, with a contiguous array per component type
+    class ChunkView final
+    {
+    public:
+        ChunkView(const Archetype &a_archetype, const size_t a_chunk)
+            : m_archetype(a_archetype), m_chunk(a_chunk), m_size(a_archetype.getChunkSize(a_chunk)) {}
+
+        [[nodiscard]]
+        size_t size() const
+        {
+            return m_size;
+        }
+
+        [[nodiscard]]
+        std::span<const EntityId> getEntities() const
+        {
+            return m_archetype.getChunkEntities(m_chunk);
+        }
+
+        template<typename T>
+        [[nodiscard]]
+        bool has() const
+        {
+            return m_archetype.getColumn(getComponentTypeId<T>()) >= 0;
+        }
+
+        // T must be one of the component types of the archetype, use a const T for read-only access
+        template<typename T>
+        [[nodiscard]]
+        std::span<T> get() const
+        {
+            const int32_t column = m_archetype.getColumn(getComponentTypeId<T>());
+            return {static_cast<T *>(m_archetype.getColumnData(m_chunk, column)), m_size};
+        }
+
+    private:
+        const Archetype &m_archetype;
+        size_t m_chunk;
+        size_t m_size;
+    };
+
+    // Iterates all entities that have every component in Ts (& none of the excluded ones)
+    // The matching archetypes are cached & only newly created archetypes are checked on later runs
+    template<typename... Ts>
+    class Query final
+    {
+    public:
+        Query()
+        {
+            (m_include.set(getComponentTypeId<Ts>()), ...);
+        }
+
+        template<typename... Excluded>
+        Query &exclude()
+        {
+            (m_exclude.set(getComponentTypeId<Excluded>()), ...);
+            resetCache();
+            return *this;
+        }
+
+        [[nodiscard]]
+        const std::vector<const Archetype *> &getMatchingArchetypes(const Registry &a_registry)
+        {
+            if (m_registry != &a_registry)
+            {
+                resetCache();
+                m_registry = &a_registry;
+            }
+
+            const auto &archetypes = a_registry.getArchetypes();
+            for (; m_checkedArchetypes < archetypes.size(); m_checkedArchetypes++)
+            {
+                const Archetype &archetype = *archetypes[m_checkedArchetypes];
+                if ((archetype.getMask() & m_include) == m_include && (archetype.getMask() & m_exclude).none())
+                {
+                    m_matches.push_back(&archetype);
+                }
+            }
+            return m_matches;
+        }
+
+        [[nodiscard]]
+        size_t count(const Registry &a_registry)
+        {
+            size_t total = 0;
+            for (const Archetype *archetype: getMatchingArchetypes(a_registry))
+            {
+                total += archetype->getEntityCount();
+            }
+            return total;
+        }
+
+        // a_function(const ChunkView &)
+        template<typename F>
+        void forEachChunk(const Registry &a_registry, F &&a_function)
+        {
+            for (const Archetype *archetype: getMatchingArchetypes(a_registry))
+            {
+                for (size_t chunk = 0; chunk < archetype->getChunkCount(); chunk++)
+                {
+                    a_function(ChunkView(*archetype, chunk));
+                }
+            }
+        }
+
+        // a_function(EntityId, Ts &...)
+        template<typename F>
+        void forEach(const Registry &a_registry, F &&a_function)
+        {
+            forEachChunk(a_registry, [&a_function](const ChunkView &a_chunk)
+            {
+                runChunk(a_chunk, a_function);
+            });
+        }
+
+        // Like forEach(), but chunks are spread over the threads of a_jobSystem
+        // a_function is called concurrently, so it must only write to the components it was given
+        template<typename F>
+        void parallelForEach(const Registry &a_registry, Utils::JobSystem &a_jobSystem, F &&a_function)
+        {
+            m_chunkScratch.clear();
+            for (const Archetype *archetype: getMatchingArchetypes(a_registry))
+            {
+                for (size_t chunk = 0; chunk < archetype->getChunkCount(); chunk++)
+                {
+                    m_chunkScratch.emplace_back(archetype, chunk);
+                }
+            }
+
+            a_jobSystem.parallelFor(m_chunkScratch.size(), 1, [this, &a_function](const size_t a_begin, const size_t a_end)
+            {
+                for (size_t i = a_begin; i < a_end; i++)
+                {
+                    runChunk(ChunkView(*m_chunkScratch[i].first, m_chunkScratch[i].second), a_function);
+                }
+            });
+        }
+
+    private:
+        ComponentMask m_include;
+        ComponentMask m_exclude;
+        const Registry *m_registry = nullptr;
+        size_t m_checkedArchetypes = 0;
+        std::vector<const Archetype *> m_matches;
+        std::vector<std::pair<const Archetype *, size_t>> m_chunkScratch;
+
+        void resetCache()
+        {
+            m_checkedArchetypes = 0;
+            m_matches.clear();
+        }
+
+        template<typename F>
+        static void runChunk(const ChunkView &a_chunk, F &a_function)
+        {
+            const std::span<const EntityId> entities = a_chunk.getEntities();
+            const std::tuple<Ts *...> columns{a_chunk.get<Ts>().data()...};
+
+            [&]<size_t... I>(std::index_sequence<I...>)
+            {
+                for (size_t row = 0; row < entities.size(); row++)
+                {
+                    a_function(entities[row], std::get<I>(columns)[row]...);
+                }
+            }(std::index_sequence_for<Ts...>{});
+        }
+    };
+}
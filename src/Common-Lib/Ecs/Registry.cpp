@@ -0,0 +1,113 @@
+#include "Registry.h"
+
+using Ecs::Registry, Ecs::Archetype, Ecs::EntityId;
+
+Registry::Registry()
+{
+    getOrCreateArchetype({});
+}
+
+bool Registry::destroyEntity(const EntityId a_entity)
+{
+    if (!isAlive(a_entity))
+        return false;
+
+    EntitySlot &slot = m_slots[a_entity.index];
+    if (const EntityId moved = slot.archetype->destroyRow(slot.row); moved.isValid())
+    {
+        m_slots[moved.index].row = slot.row;
+    }
+
+    slot.archetype = nullptr;
+    slot.generation++;
+    m_freeSlots.push_back(a_entity.index);
+    return true;
+}
+
+bool Registry::isAlive(const EntityId a_entity) const
+{
+    return a_entity.index < m_slots.size()
+           && m_slots[a_entity.index].generation == a_entity.generation
+           && m_slots[a_entity.index].archetype != nullptr;
+}
+
+EntityId Registry::allocateEntityId()
+{
+    if (!m_freeSlots.empty())
+    {
+        const uint32_t index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        return {index, m_slots[index].generation};
+    }
+
+    m_slots.emplace_back();
+    return {static_cast<uint32_t>(m_slots.size() - 1), 0};
+}
+
+Archetype *Registry::getOrCreateArchetype(std::vector<ComponentTypeId> a_componentTypes)
+{
+    if (const auto found = m_archetypeLookup.find(a_componentTypes); found != m_archetypeLookup.end())
+        return found->second;
+
+    auto archetype = std::make_unique<Archetype>(static_cast<uint32_t>(m_archetypes.size()), a_componentTypes);
+    Archetype *result = archetype.get();
+    m_archetypes.push_back(std::move(archetype));
+    m_archetypeLookup.emplace(std::move(a_componentTypes), result);
+    return result;
+}
+
+Archetype *Registry::getArchetypeWith(Archetype *a_archetype, const ComponentTypeId a_added)
+{
+    if (const auto edge = a_archetype->addEdges.find(a_added); edge != a_archetype->addEdges.end())
+        return edge->second;
+
+    std::vector<ComponentTypeId> componentTypes = a_archetype->getComponentTypes();
+    componentTypes.insert(std::ranges::upper_bound(componentTypes, a_added), a_added);
+
+    Archetype *target = getOrCreateArchetype(std::move(componentTypes));
+    a_archetype->addEdges.emplace(a_added, target);
+    target->removeEdges.emplace(a_added, a_archetype);
+    return target;
+}
+
+Archetype *Registry::getArchetypeWithout(Archetype *a_archetype, const ComponentTypeId a_removed)
+{
+    if (const auto edge = a_archetype->removeEdges.find(a_removed); edge != a_archetype->removeEdges.end())
+        return edge->second;
+
+    std::vector<ComponentTypeId> componentTypes = a_archetype->getComponentTypes();
+    std::erase(componentTypes, a_removed);
+
+    Archetype *target = getOrCreateArchetype(std::move(componentTypes));
+    a_archetype->removeEdges.emplace(a_removed, target);
+    target->addEdges.emplace(a_removed, a_archetype);
+    return target;
+}
+
+void Registry::moveEntity(const EntityId a_entity, Archetype *a_target)
+{
+    EntitySlot &slot = m_slots[a_entity.index];
+    Archetype *source = slot.archetype;
+    const uint32_t sourceRow = slot.row;
+    const uint32_t targetRow = a_target->pushRow(a_entity);
+
+    const std::vector<ComponentTypeId> &sourceTypes = source->getComponentTypes();
+    for (size_t column = 0; column < sourceTypes.size(); column++)
+    {
+        const ComponentInfo &info = getComponentInfo(sourceTypes[column]);
+        void *component = source->getComponent(sourceRow, column);
+        if (const int32_t targetColumn = a_target->getColumn(sourceTypes[column]); targetColumn >= 0)
+        {
+            info.moveConstruct(a_target->getComponent(targetRow, targetColumn), component);
+        }
+        info.destroy(component);
+    }
+
+    if (const EntityId moved = source->eraseRow(sourceRow); moved.isValid())
+    {
+        m_slots[moved.index].row = sourceRow;
+    }
+
+    slot.archetype = a_target;
+    slot.row = targetRow;
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Archetype.h"
+#include "Component.h"
+#include "EntityId.h"
+
+namespace Ecs
+{
+    // Owns all entities & their components, grouped into archetypes
+    // Structural changes (create / destroy / add / remove) invalidate component pointers & must not happen while
+    // iterating a Query, record them into a CommandBuffer instead
+    class Registry final
+    {
+    public:
+        Registry();
+
+        Registry(const Registry &) = delete;
+
+        Registry &operator=(const Registry &) = delete;
+
+        template<typename... Ts>
+        EntityId createEntity(Ts &&... a_components)
+        {
+            std::vector<ComponentTypeId> componentTypes{getComponentTypeId<Ts>()...};
+            std::ranges::sort(componentTypes);
+            Archetype *archetype = getOrCreateArchetype(std::move(componentTypes));
+
+            const EntityId entity = allocateEntityId();
+            const uint32_t row = archetype->pushRow(entity);
+            (constructComponent(*archetype, row, std::forward<Ts>(a_components)), ...);
+
+            m_slots[entity.index].archetype = archetype;
+            m_slots[entity.index].row = row;
+            return entity;
+        }
+
+        // Returns false if the entity was already destroyed
+        bool destroyEntity(EntityId a_entity);
+
+        [[nodiscard]]
+        bool isAlive(EntityId a_entity) const;
+
+        // Adds a_component to the entity or overwrites the existing one, returns false if the entity isn't alive
+        template<typename T>
+        bool addComponent(const EntityId a_entity, T &&a_component)
+        {
+            using Type = std::remove_cvref_t<T>;
+            if (!isAlive(a_entity))
+                return false;
+
+            if (Type *existing = tryGetComponent<Type>(a_entity))
+            {
+                *existing = std::forward<T>(a_component);
+                return true;
+            }
+
+            // Construct first, so a throwing copy can't leave a half moved entity behind
+            Type component(std::forward<T>(a_component));
+            const ComponentTypeId typeId = getComponentTypeId<Type>();
+            EntitySlot &slot = m_slots[a_entity.index];
+            Archetype *target = getArchetypeWith(slot.archetype, typeId);
+            moveEntity(a_entity, target);
+            constructComponent(*target, slot.row, std::move(component));
+            return true;
+        }
+
+        // Returns false if the entity isn't alive or didn't have the component
+        template<typename T>
+        bool removeComponent(const EntityId a_entity)
+        {
+            if (!hasComponent<T>(a_entity))
+                return false;
+
+            EntitySlot &slot = m_slots[a_entity.index];
+            moveEntity(a_entity, getArchetypeWithout(slot.archetype, getComponentTypeId<T>()));
+            return true;
+        }
+
+        template<typename T>
+        [[nodiscard]]
+        bool hasComponent(const EntityId a_entity) const
+        {
+            return isAlive(a_entity) && m_slots[a_entity.index].archetype->getColumn(getComponentTypeId<T>()) >= 0;
+        }
+
+        // The pointer is invalidated by the next structural change
+        template<typename T>
+        [[nodiscard]]
+        T *tryGetComponent(const EntityId a_entity) const
+        {
+            if (!isAlive(a_entity))
+                return nullptr;
+
+            const EntitySlot &slot = m_slots[a_entity.index];
+            const int32_t column = slot.archetype->getColumn(getComponentTypeId<T>());
+            if (column < 0)
+                return nullptr;
+
+            return static_cast<T *>(slot.archetype->getComponent(slot.row, column));
+        }
+
+        [[nodiscard]]
+        size_t getEntityCount() const
+        {
+            return m_slots.size() - m_freeSlots.size();
+        }
+
+        // Archetypes are never removed, so an index into this stays valid
+        [[nodiscard]]
+        const std::vector<std::unique_ptr<Archetype>> &getArchetypes() const
+        {
+            return m_archetypes;
+        }
+
+    private:
+        struct EntitySlot
+        {
+            Archetype *archetype = nullptr;
+            uint32_t row = 0;
+            uint32_t generation = 0;
+        };
+
+        std::vector<EntitySlot> m_slots;
+        std::vector<uint32_t> m_freeSlots;
+        std::vector<std::unique_ptr<Archetype>> m_archetypes;
+        std::map<std::vector<ComponentTypeId>, Archetype *> m_archetypeLookup;
+
+        [[nodiscard]]
+        EntityId allocateEntityId();
+
+        Archetype *getOrCreateArchetype(std::vector<ComponentTypeId> a_componentTypes);
+
+        Archetype *getArchetypeWith(Archetype *a_archetype, ComponentTypeId a_added);
+
+        Archetype *getArchetypeWithout(Archetype *a_archetype, ComponentTypeId a_removed);
+
+        // Moves the components both archetypes share & destroys the ones a_target doesn't have
+        // Components a_target has, but the current archetype doesn't, are left uninitialized
+        void moveEntity(EntityId a_entity, Archetype *a_target);
+
+        template<typename T>
+        static void constructComponent(const Archetype &a_archetype, const uint32_t a_row, T &&a_component)
+        {
+            using Type = std::remove_cvref_t<T>;
+            void *destination = a_archetype.getComponent(a_row, a_archetype.getColumn(getComponentTypeId<Type>()));
+            ::new(destination) Type(std::forward<T>(a_component));
+        }
+    };
+}
@@ -1,10 +1,45 @@
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <format>
+
 #include "spdlog/spdlog.h"
 #include "spdlog/async.h"
+#include "spdlog/sinks/stdout_color_sinks.h"
+#include "spdlog/sinks/basic_file_sink.h"
 
+#include "Memory/MemoryTracker.h"
 #include "Logging.h"
 
 namespace Logging
 {
+    // Opened when the program starts, not in the header, so including it doesn't open the log files
+    std::shared_ptr<spdlog::sinks::basic_file_sink_mt> makeDateSink()
+    {
+        const std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        const std::tm *localtimeNow = std::localtime(&now);
+
+        char buffer[256];
+        std::strftime(buffer, sizeof(buffer), "%Y-%m-%d", localtimeNow);
+        std::string date = buffer;
+
+        int32_t extraDigit = 1;
+        while (std::filesystem::exists(std::format("logs/{}-{}.log", date, extraDigit)))
+        {
+            extraDigit++;
+        }
+
+        return std::make_shared<spdlog::sinks::basic_file_sink_mt>(
+            std::format("logs/{}-{}.log", date, extraDigit),
+            true
+        );
+    }
+
+    const auto g_latestLogSink = std::make_shared<spdlog::sinks::basic_file_sink_mt>("logs/latest.log", true);
+    const auto g_debugLogSink = std::make_shared<spdlog::sinks::basic_file_sink_mt>("logs/debug.log", true);
+    const auto g_dateLogSink = makeDateSink();
+    const auto g_stdoutSink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+
     std::shared_ptr<spdlog::logger> makeLoggerOrThrow(
         const std::string &name,
         const std::shared_ptr<spdlog::details::thread_pool> &threadPool,
@@ -22,7 +57,7 @@ namespace Logging
             name, sinks.begin(), sinks.end(),
             threadPool, overflowPolicy
         );
-        logger->set_pattern("[%T] %^[thread %t/%l]%$ (%n) %v");
+        logger->set_pattern(g_logPattern);
         logger->set_level(spdlog::level::debug);
 
         spdlog::register_logger(logger);
@@ -40,13 +75,34 @@ namespace Logging
         return logger;
     }
 
+    size_t getDroppedMessageCount()
+    {
+        if (!g_isInitialized)
+            return 0;
+
+        const std::shared_ptr<spdlog::details::thread_pool> threadPool = spdlog::thread_pool();
+#if SPDLOG_VERSION >= 11300
+        return threadPool->overrun_counter() + threadPool->discard_counter();
+#else
+        return threadPool->overrun_counter();
+#endif
+    }
+
+    size_t getQueuedMessageCount()
+    {
+        if (!g_isInitialized)
+            return 0;
+        return spdlog::thread_pool()->queue_size();
+    }
 
     void setupLogging()
     {
         if (g_isInitialized) return;
         g_isInitialized = true;
 
-        spdlog::init_thread_pool(65536, 1);
+        spdlog::init_thread_pool(g_logQueueSize, 1);
+        // The queue is allocated up front & lives until the process exits
+        Memory::trackAllocation(Memory::MemoryTag::Logging, g_logQueueSize * sizeof(spdlog::details::async_msg));
 
         g_stdoutSink->set_level(spdlog::level::debug);
         g_debugLogSink->set_level(spdlog::level::debug);
@@ -1,13 +1,17 @@
 #pragma once
 
-#include <filesystem>
+#include <cstddef>
+#include <memory>
+#include <string>
 
-#include "spdlog/sinks/stdout_color_sinks.h"
-#include "spdlog/sinks/basic_file_sink.h"
 #include "spdlog/async.h"
 
 namespace Logging
 {
+    // Messages the async loggers can queue before they block
+    inline constexpr size_t g_logQueueSize = 65536;
+    inline constexpr const char *g_logPattern = "[%T] %^[thread %t/%l]%$ (%n) %v";
+
     // Setup logging sinks (aka: log files) & the logger pattern
     void setupLogging();
 
@@ -15,6 +19,15 @@ namespace Logging
     [[nodiscard]]
     std::shared_ptr<spdlog::logger> getLogger(const std::string &name);
 
+    // Messages the async loggers dropped because the queue was full, 0 before setupLogging()
+    // Loggers using the block policy wait instead, only the overrun & discard policies drop messages
+    [[nodiscard]]
+    size_t getDroppedMessageCount();
+
+    // Messages waiting to be written by the logging thread, 0 before setupLogging()
+    [[nodiscard]]
+    size_t getQueuedMessageCount();
+
     // Create a logger & register it, will throw an exception if a logger with that name already exist
     [[nodiscard]]
     std::shared_ptr<spdlog::logger> makeLoggerOrThrow(
@@ -50,31 +63,5 @@ namespace Logging
         return makeLoggerOrThrow(name, spdlog::thread_pool(), overflowPolicy);
     }
 
-    [[nodiscard]]
-    inline std::shared_ptr<spdlog::sinks::basic_file_sink_mt> makeDateSink()
-    {
-        const std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-        const std::tm *localtimeNow = std::localtime(&now);
-
-        char buffer[256];
-        std::strftime(buffer, sizeof(buffer), "%Y-%m-%d", localtimeNow);
-        std::string date = buffer;
-
-        int32_t extraDigit = 1;
-        while (std::filesystem::exists(std::format("logs/{}-{}.log", date, extraDigit)))
-        {
-            extraDigit++;
-        }
-
-        return std::make_shared<spdlog::sinks::basic_file_sink_mt>(
-            std::format("logs/{}-{}.log", date, extraDigit),
-            true
-        );
-    }
-
-    inline const auto g_latestLogSink = std::make_shared<spdlog::sinks::basic_file_sink_mt>("logs/latest.log", true);
-    inline const auto g_debugLogSink = std::make_shared<spdlog::sinks::basic_file_sink_mt>("logs/debug.log", true);
-    inline const auto g_dateLogSink = makeDateSink();
-    inline const auto g_stdoutSink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
     inline bool g_isInitialized = false;
 }
@@ -0,0 +1,138 @@
+#include <algorithm>
+
+#include "FixedSizePool.h"
+
+using Memory::FixedSizePool;
+
+thread_local FixedSizePool::ThreadCaches FixedSizePool::s_threadCaches;
+
+FixedSizePool::ThreadCaches::~ThreadCaches()
+{
+    for (ThreadCache &cache: caches)
+    {
+        cache.pool->drain(cache, cache.count);
+    }
+}
+
+FixedSizePool::FixedSizePool(const size_t a_blockSize, const size_t a_blockAlignment, const size_t a_blocksPerSlab,
+                             std::pmr::memory_resource *a_upstream)
+    : m_blockAlignment(std::max(a_blockAlignment, alignof(FreeBlock))),
+      m_blocksPerSlab(std::max<size_t>(a_blocksPerSlab, 1)),
+      m_upstream(a_upstream)
+{
+    // Every block has to fit a free list link & keep the alignment of the ones after it
+    const size_t size = std::max(a_blockSize, sizeof(FreeBlock));
+    m_blockSize = (size + m_blockAlignment - 1) / m_blockAlignment * m_blockAlignment;
+}
+
+FixedSizePool::~FixedSizePool()
+{
+    // A new pool at the same address must not see the blocks cached by this thread
+    std::erase_if(s_threadCaches.caches, [this](const ThreadCache &a_cache)
+    {
+        return a_cache.pool == this;
+    });
+    for (void *slab: m_slabs)
+    {
+        m_upstream->deallocate(slab, m_blockSize * m_blocksPerSlab, m_blockAlignment);
+    }
+}
+
+size_t FixedSizePool::getCapacity() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_slabs.size() * m_blocksPerSlab * m_blockSize;
+}
+
+FixedSizePool::ThreadCache &FixedSizePool::getThreadCache()
+{
+    for (ThreadCache &cache: s_threadCaches.caches)
+    {
+        if (cache.pool == this)
+            return cache;
+    }
+    return s_threadCaches.caches.emplace_back(this, nullptr, 0);
+}
+
+void FixedSizePool::refill(ThreadCache &a_cache)
+{
+    std::lock_guard lock(m_mutex);
+    if (m_sharedCount == 0)
+    {
+        auto *slab = static_cast<std::byte *>(m_upstream->allocate(m_blockSize * m_blocksPerSlab, m_blockAlignment));
+        m_slabs.push_back(slab);
+        for (size_t i = m_blocksPerSlab; i-- > 0;)
+        {
+            auto *block = reinterpret_cast<FreeBlock *>(slab + i * m_blockSize);
+            block->next = m_sharedHead;
+            m_sharedHead = block;
+        }
+        m_sharedCount += m_blocksPerSlab;
+    }
+
+    for (size_t i = 0; i < BATCH_SIZE && m_sharedHead != nullptr; i++)
+    {
+        FreeBlock *block = m_sharedHead;
+        m_sharedHead = block->next;
+        m_sharedCount--;
+        block->next = a_cache.head;
+        a_cache.head = block;
+        a_cache.count++;
+    }
+}
+
+void *FixedSizePool::do_allocate(const size_t a_bytes, const size_t a_alignment)
+{
+    if (a_bytes > m_blockSize || a_alignment > m_blockAlignment)
+        return m_upstream->allocate(a_bytes, a_alignment);
+
+    ThreadCache &cache = getThreadCache();
+    if (cache.head == nullptr)
+        refill(cache);
+
+    FreeBlock *block = cache.head;
+    cache.head = block->next;
+    cache.count--;
+
+    const size_t used = m_usedBlocks.fetch_add(1, std::memory_order_relaxed) + 1;
+    size_t highWaterMark = m_highWaterMark.load(std::memory_order_relaxed);
+    while (used > highWaterMark && !m_highWaterMark.compare_exchange_weak(highWaterMark, used, std::memory_order_relaxed))
+    {
+    }
+    return block;
+}
+
+void FixedSizePool::do_deallocate(void *a_pointer, const size_t a_bytes, const size_t a_alignment)
+{
+    if (a_bytes > m_blockSize || a_alignment > m_blockAlignment)
+    {
+        m_upstream->deallocate(a_pointer, a_bytes, a_alignment);
+        return;
+    }
+
+    m_usedBlocks.fetch_sub(1, std::memory_order_relaxed);
+
+    // Blocks freed on another thread than they were allocated on simply join this thread's list
+    ThreadCache &cache = getThreadCache();
+    auto *block = static_cast<FreeBlock *>(a_pointer);
+    block->next = cache.head;
+    cache.head = block;
+    cache.count++;
+
+    if (cache.count >= 2 * BATCH_SIZE)
+        drain(cache, BATCH_SIZE);
+}
+
+void FixedSizePool::drain(ThreadCache &a_cache, const size_t a_count)
+{
+    std::lock_guard lock(m_mutex);
+    for (size_t i = 0; i < a_count; i++)
+    {
+        FreeBlock *moved = a_cache.head;
+        a_cache.head = moved->next;
+        a_cache.count--;
+        moved->next = m_sharedHead;
+        m_sharedHead = moved;
+        m_sharedCount++;
+    }
+}
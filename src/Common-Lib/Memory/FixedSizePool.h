@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+namespace Memory
+{
+    // Thread safe pool of equally sized blocks for small, frequently allocated objects, usable by std::pmr containers
+    // & std::pmr::polymorphic_allocator; allocations larger than the block size go to the upstream resource
+    // Every thread allocates from & frees to its own free list, blocks only move through the (locked) shared list in
+    // batches & when the thread exits; memory is returned to the upstream resource when the pool is destroyed, so a
+    // pool has to outlive every thread that used it except the one destroying it
+    class FixedSizePool final : public std::pmr::memory_resource
+    {
+    public:
+        explicit FixedSizePool(size_t a_blockSize, size_t a_blockAlignment = alignof(std::max_align_t),
+                               size_t a_blocksPerSlab = 256,
+                               std::pmr::memory_resource *a_upstream = std::pmr::new_delete_resource());
+
+        FixedSizePool(const FixedSizePool &) = delete;
+
+        FixedSizePool &operator=(const FixedSizePool &) = delete;
+
+        ~FixedSizePool() override;
+
+        [[nodiscard]]
+        size_t getBlockSize() const
+        {
+            return m_blockSize;
+        }
+
+        // Blocks currently handed out
+        [[nodiscard]]
+        size_t getUsedBlocks() const
+        {
+            return m_usedBlocks.load(std::memory_order_relaxed);
+        }
+
+        // Highest getUsedBlocks() ever reached
+        [[nodiscard]]
+        size_t getHighWaterMark() const
+        {
+            return m_highWaterMark.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]]
+        size_t getCapacity() const;
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock *next;
+        };
+
+        struct ThreadCache
+        {
+            FixedSizePool *pool;
+            FreeBlock *head;
+            size_t count;
+        };
+
+        // Gives the blocks of an exiting thread back to their pools
+        struct ThreadCaches
+        {
+            std::vector<ThreadCache> caches;
+
+            ~ThreadCaches();
+        };
+
+        // Blocks moved between a thread's free list & the shared one at once
+        static constexpr size_t BATCH_SIZE = 32;
+
+        static thread_local ThreadCaches s_threadCaches;
+
+        size_t m_blockSize;
+        size_t m_blockAlignment;
+        size_t m_blocksPerSlab;
+        std::pmr::memory_resource *m_upstream;
+        std::atomic<size_t> m_usedBlocks = 0;
+        std::atomic<size_t> m_highWaterMark = 0;
+
+        mutable std::mutex m_mutex;
+        std::vector<void *> m_slabs;
+        FreeBlock *m_sharedHead = nullptr;
+        size_t m_sharedCount = 0;
+
+        [[nodiscard]]
+        ThreadCache &getThreadCache();
+
+        // Moves a batch of blocks into a_cache, from the shared list or a new slab
+        void refill(ThreadCache &a_cache);
+
+        // Moves a_count blocks from a_cache to the shared list
+        void drain(ThreadCache &a_cache, size_t a_count);
+
+        void *do_allocate(size_t a_bytes, size_t a_alignment) override;
+
+        void do_deallocate(void *a_pointer, size_t a_bytes, size_t a_alignment) override;
+
+        [[nodiscard]]
+        bool do_is_equal(const std::pmr::memory_resource &a_other) const noexcept override
+        {
+            return this == &a_other;
+        }
+    };
+}
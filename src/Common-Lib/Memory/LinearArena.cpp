@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <cstdint>
+
+#include "LinearArena.h"
+
+using Memory::LinearArena;
+
+LinearArena::LinearArena(const size_t a_blockSize, std::pmr::memory_resource *a_upstream)
+    : m_upstream(a_upstream), m_blockSize(a_blockSize) {}
+
+LinearArena::~LinearArena()
+{
+    releaseBlocks();
+}
+
+void LinearArena::reset()
+{
+    if (m_blocks.size() > 1)
+    {
+        const size_t capacity = m_capacity;
+        releaseBlocks();
+        addBlock(capacity);
+    }
+
+    if (!m_blocks.empty())
+    {
+        m_cursor = m_blocks.back().data;
+        m_end = m_cursor + m_blocks.back().size;
+    }
+    m_usedBytes = 0;
+    m_lastAllocation = nullptr;
+}
+
+void LinearArena::release()
+{
+    releaseBlocks();
+    m_usedBytes = 0;
+    m_lastAllocation = nullptr;
+}
+
+void LinearArena::addBlock(const size_t a_minimumSize)
+{
+    const size_t size = std::max(m_blockSize, a_minimumSize);
+    auto *data = static_cast<std::byte *>(m_upstream->allocate(size, BLOCK_ALIGNMENT));
+    m_blocks.push_back({data, size});
+    m_capacity += size;
+    m_cursor = data;
+    m_end = data + size;
+}
+
+void LinearArena::releaseBlocks()
+{
+    for (const Block &block: m_blocks)
+    {
+        m_upstream->deallocate(block.data, block.size, BLOCK_ALIGNMENT);
+    }
+    m_blocks.clear();
+    m_capacity = 0;
+    m_cursor = nullptr;
+    m_end = nullptr;
+}
+
+void *LinearArena::do_allocate(const size_t a_bytes, const size_t a_alignment)
+{
+    auto address = reinterpret_cast<uintptr_t>(m_cursor);
+    size_t padding = (a_alignment - address % a_alignment) % a_alignment;
+    if (m_cursor == nullptr || padding + a_bytes > static_cast<size_t>(m_end - m_cursor))
+    {
+        // The rest of the current block is wasted, blocks are aligned to BLOCK_ALIGNMENT so larger
+        // alignments need room for padding
+        addBlock(a_bytes + (a_alignment > BLOCK_ALIGNMENT ? a_alignment : 0));
+        address = reinterpret_cast<uintptr_t>(m_cursor);
+        padding = (a_alignment - address % a_alignment) % a_alignment;
+    }
+
+    std::byte *result = m_cursor + padding;
+    m_cursor = result + a_bytes;
+    m_lastAllocation = result;
+    m_lastPadding = padding;
+    m_usedBytes += padding + a_bytes;
+    m_highWaterMark = std::max(m_highWaterMark, m_usedBytes);
+    return result;
+}
+
+void LinearArena::do_deallocate(void *a_pointer, const size_t a_bytes, size_t)
+{
+    // Only the most recent allocation can be given back, like a temporary buffer that is freed right away
+    if (a_pointer == m_lastAllocation && m_lastAllocation + a_bytes == m_cursor)
+    {
+        m_cursor = m_lastAllocation - m_lastPadding;
+        m_usedBytes -= m_lastPadding + a_bytes;
+        m_lastAllocation = nullptr;
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace Memory
+{
+    // Bump allocator for temporaries that all die at the same time (a frame, a tick), usable by std::pmr containers
+    // Only the most recent allocation can be deallocated (a temporary freed right away), reset() frees everything at once;
+    // not thread safe
+    class alignas(64) LinearArena final : public std::pmr::memory_resource
+    {
+    public:
+        explicit LinearArena(size_t a_blockSize = 1 << 20,
+                             std::pmr::memory_resource *a_upstream = std::pmr::new_delete_resource());
+
+        LinearArena(const LinearArena &) = delete;
+
+        LinearArena &operator=(const LinearArena &) = delete;
+
+        ~LinearArena() override;
+
+        // Invalidates every allocation; if more than one block was needed since the last reset, they are replaced
+        // by a single block of their combined size, so the arena settles on one block large enough for the peak
+        void reset();
+
+        // Like reset(), but also gives all memory back to the upstream resource
+        void release();
+
+        // Bytes handed out since the last reset, including alignment padding
+        [[nodiscard]]
+        size_t getUsedBytes() const
+        {
+            return m_usedBytes;
+        }
+
+        // Highest getUsedBytes() ever reached, what a good initial block size would be
+        [[nodiscard]]
+        size_t getHighWaterMark() const
+        {
+            return m_highWaterMark;
+        }
+
+        void resetHighWaterMark()
+        {
+            m_highWaterMark = m_usedBytes;
+        }
+
+        // Bytes reserved from the upstream resource
+        [[nodiscard]]
+        size_t getCapacity() const
+        {
+            return m_capacity;
+        }
+
+    private:
+        struct Block
+        {
+            std::byte *data;
+            size_t size;
+        };
+
+        static constexpr size_t BLOCK_ALIGNMENT = 64;
+
+        std::pmr::memory_resource *m_upstream;
+        size_t m_blockSize;
+        std::vector<Block> m_blocks;
+        std::byte *m_cursor = nullptr;
+        std::byte *m_end = nullptr;
+        // The most recent allocation & the padding in front of it, until it's deallocated
+        std::byte *m_lastAllocation = nullptr;
+        size_t m_lastPadding = 0;
+        size_t m_usedBytes = 0;
+        size_t m_highWaterMark = 0;
+        size_t m_capacity = 0;
+
+        void addBlock(size_t a_minimumSize);
+
+        void releaseBlocks();
+
+        void *do_allocate(size_t a_bytes, size_t a_alignment) override;
+
+        void do_deallocate(void *a_pointer, size_t a_bytes, size_t a_alignment) override;
+
+        [[nodiscard]]
+        bool do_is_equal(const std::pmr::memory_resource &a_other) const noexcept override
+        {
+            return this == &a_other;
+        }
+    };
+}
@@ -0,0 +1,281 @@
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "MemoryTracker.h"
+
+using Memory::MemoryTag, Memory::MemoryUsage, Memory::EvictionCallback, Memory::TrackedResource,
+        Memory::MEMORY_TAG_COUNT;
+
+// Signed, a thread that frees more than it allocated simply goes negative
+struct alignas(64) ThreadCounters
+{
+    std::array<std::atomic<int64_t>, MEMORY_TAG_COUNT> host{};
+    std::array<std::atomic<int64_t>, MEMORY_TAG_COUNT> device{};
+    std::atomic<bool> inUse = false;
+};
+
+struct CounterRegistry
+{
+    std::mutex mutex;
+    // Never shrinks, the counters of exited threads keep their sums & are reused by new threads
+    std::vector<std::unique_ptr<ThreadCounters>> counters;
+    std::atomic<size_t> deviceReported = 0;
+    std::atomic<size_t> deviceBudget = 0;
+};
+
+struct EvictionEntry
+{
+    uint64_t id;
+    const void *owner;
+    EvictionCallback callback;
+};
+
+struct BudgetRegistry
+{
+    std::mutex mutex;
+    std::array<size_t, MEMORY_TAG_COUNT> budgets{};
+    std::array<std::vector<EvictionEntry>, MEMORY_TAG_COUNT> callbacks;
+    uint64_t nextCallbackId = 0;
+};
+
+thread_local ThreadCounters *g_threadCounters = nullptr;
+thread_local bool g_threadCountersReleased = false;
+
+// Memory is also freed by static destructors, so the registries are never destroyed
+CounterRegistry &getCounterRegistry()
+{
+    static auto *registry = new CounterRegistry();
+    return *registry;
+}
+
+BudgetRegistry &getBudgetRegistry()
+{
+    static auto *registry = new BudgetRegistry();
+    return *registry;
+}
+
+struct CounterRelease
+{
+    ~CounterRelease()
+    {
+        g_threadCounters->inUse.store(false, std::memory_order_release);
+        g_threadCounters = nullptr;
+        g_threadCountersReleased = true;
+    }
+};
+
+ThreadCounters *acquireCounters()
+{
+    CounterRegistry &registry = getCounterRegistry();
+    std::lock_guard lock(registry.mutex);
+    for (const std::unique_ptr<ThreadCounters> &counters: registry.counters)
+    {
+        bool expected = false;
+        if (counters->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            return counters.get();
+    }
+
+    ThreadCounters *counters = registry.counters.emplace_back(std::make_unique<ThreadCounters>()).get();
+    counters->inUse.store(true, std::memory_order_relaxed);
+    return counters;
+}
+
+ThreadCounters &getThreadCounters()
+{
+    if (g_threadCounters == nullptr)
+    {
+        g_threadCounters = acquireCounters();
+        // A thread tracking memory while its thread_locals are destroyed keeps these counters for good
+        if (!g_threadCountersReleased)
+        {
+            thread_local CounterRelease release;
+        }
+    }
+    return *g_threadCounters;
+}
+
+// Only the owning thread writes, so a load & store is enough & avoids a locked instruction
+void addToCounter(std::atomic<int64_t> &a_counter, const int64_t a_delta)
+{
+    a_counter.store(a_counter.load(std::memory_order_relaxed) + a_delta, std::memory_order_relaxed);
+}
+
+namespace Memory
+{
+    std::string_view getTagName(const MemoryTag a_tag)
+    {
+        switch (a_tag)
+        {
+            case MemoryTag::Chunks:
+                return "chunks";
+            case MemoryTag::Meshes:
+                return "meshes";
+            case MemoryTag::NetworkBuffers:
+                return "network buffers";
+            case MemoryTag::Textures:
+                return "textures";
+            case MemoryTag::Logging:
+                return "logging";
+            case MemoryTag::Scratch:
+                return "scratch";
+            case MemoryTag::Other:
+                return "other";
+        }
+        return "unknown";
+    }
+
+    void trackAllocation(const MemoryTag a_tag, const size_t a_bytes)
+    {
+        addToCounter(getThreadCounters().host[static_cast<size_t>(a_tag)], static_cast<int64_t>(a_bytes));
+    }
+
+    void trackDeallocation(const MemoryTag a_tag, const size_t a_bytes)
+    {
+        addToCounter(getThreadCounters().host[static_cast<size_t>(a_tag)], -static_cast<int64_t>(a_bytes));
+    }
+
+    void trackDeviceAllocation(const MemoryTag a_tag, const size_t a_bytes)
+    {
+        addToCounter(getThreadCounters().device[static_cast<size_t>(a_tag)], static_cast<int64_t>(a_bytes));
+    }
+
+    void trackDeviceDeallocation(const MemoryTag a_tag, const size_t a_bytes)
+    {
+        addToCounter(getThreadCounters().device[static_cast<size_t>(a_tag)], -static_cast<int64_t>(a_bytes));
+    }
+
+    void reportDeviceMemory(const size_t a_usage, const size_t a_budget)
+    {
+        CounterRegistry &registry = getCounterRegistry();
+        registry.deviceReported.store(a_usage, std::memory_order_relaxed);
+        registry.deviceBudget.store(a_budget, std::memory_order_relaxed);
+    }
+
+    size_t MemoryUsage::getHostTotal() const
+    {
+        size_t total = 0;
+        for (const size_t bytes: host)
+        {
+            total += bytes;
+        }
+        return total;
+    }
+
+    size_t MemoryUsage::getDeviceTotal() const
+    {
+        size_t total = 0;
+        for (const size_t bytes: device)
+        {
+            total += bytes;
+        }
+        return std::max(total, deviceReported);
+    }
+
+    MemoryUsage getMemoryUsage()
+    {
+        CounterRegistry &registry = getCounterRegistry();
+        std::array<int64_t, MEMORY_TAG_COUNT> host{};
+        std::array<int64_t, MEMORY_TAG_COUNT> device{};
+        {
+            std::lock_guard lock(registry.mutex);
+            for (const std::unique_ptr<ThreadCounters> &counters: registry.counters)
+            {
+                for (size_t i = 0; i < MEMORY_TAG_COUNT; i++)
+                {
+                    host[i] += counters->host[i].load(std::memory_order_relaxed);
+                    device[i] += counters->device[i].load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // The counters of different threads are read at slightly different times, so a sum can briefly be negative
+        MemoryUsage usage;
+        for (size_t i = 0; i < MEMORY_TAG_COUNT; i++)
+        {
+            usage.host[i] = static_cast<size_t>(std::max<int64_t>(host[i], 0));
+            usage.device[i] = static_cast<size_t>(std::max<int64_t>(device[i], 0));
+        }
+        usage.deviceReported = registry.deviceReported.load(std::memory_order_relaxed);
+        usage.deviceBudget = registry.deviceBudget.load(std::memory_order_relaxed);
+        return usage;
+    }
+
+    void setBudget(const MemoryTag a_tag, const size_t a_bytes)
+    {
+        BudgetRegistry &registry = getBudgetRegistry();
+        std::lock_guard lock(registry.mutex);
+        registry.budgets[static_cast<size_t>(a_tag)] = a_bytes;
+    }
+
+    size_t getBudget(const MemoryTag a_tag)
+    {
+        BudgetRegistry &registry = getBudgetRegistry();
+        std::lock_guard lock(registry.mutex);
+        return registry.budgets[static_cast<size_t>(a_tag)];
+    }
+
+    uint64_t addEvictionCallback(const MemoryTag a_tag, const void *a_owner, EvictionCallback a_callback)
+    {
+        BudgetRegistry &registry = getBudgetRegistry();
+        std::lock_guard lock(registry.mutex);
+        const uint64_t id = registry.nextCallbackId++;
+        registry.callbacks[static_cast<size_t>(a_tag)].push_back({id, a_owner, std::move(a_callback)});
+        return id;
+    }
+
+    void removeEvictionCallback(const MemoryTag a_tag, const uint64_t a_id)
+    {
+        BudgetRegistry &registry = getBudgetRegistry();
+        std::lock_guard lock(registry.mutex);
+        std::erase_if(registry.callbacks[static_cast<size_t>(a_tag)], [a_id](const EvictionEntry &a_entry)
+        {
+            return a_entry.id == a_id;
+        });
+    }
+
+    size_t enforceBudgets(const void *a_owner)
+    {
+        BudgetRegistry &registry = getBudgetRegistry();
+        std::lock_guard lock(registry.mutex);
+        if (std::ranges::all_of(registry.budgets, [](const size_t a_budget) { return a_budget == 0; }))
+            return 0;
+
+        const MemoryUsage usage = getMemoryUsage();
+        size_t remainingExcess = 0;
+        for (size_t i = 0; i < MEMORY_TAG_COUNT; i++)
+        {
+            const size_t budget = registry.budgets[i];
+            const size_t used = usage.get(static_cast<MemoryTag>(i));
+            if (budget == 0 || used <= budget)
+                continue;
+
+            size_t excess = used - budget;
+            for (EvictionEntry &entry: registry.callbacks[i])
+            {
+                if (excess == 0)
+                    break;
+                if (entry.owner == a_owner)
+                    excess -= std::min(entry.callback(excess), excess);
+            }
+            remainingExcess += excess;
+        }
+        return remainingExcess;
+    }
+
+    TrackedResource *getTrackedResource(const MemoryTag a_tag)
+    {
+        static auto *resources = new std::array<TrackedResource, MEMORY_TAG_COUNT>{
+            TrackedResource(MemoryTag::Chunks),
+            TrackedResource(MemoryTag::Meshes),
+            TrackedResource(MemoryTag::NetworkBuffers),
+            TrackedResource(MemoryTag::Textures),
+            TrackedResource(MemoryTag::Logging),
+            TrackedResource(MemoryTag::Scratch),
+            TrackedResource(MemoryTag::Other),
+        };
+        return &(*resources)[static_cast<size_t>(a_tag)];
+    }
+}
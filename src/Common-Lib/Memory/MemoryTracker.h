@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+
+#include "Utils/UniqueFunction.h"
+
+namespace Memory
+{
+    // What memory is used for, every tracked allocation is counted for exactly one tag
+    enum class MemoryTag : uint8_t
+    {
+        Chunks,
+        Meshes,
+        NetworkBuffers,
+        Textures,
+        Logging,
+        Scratch,
+        Other,
+    };
+
+    constexpr size_t MEMORY_TAG_COUNT = 7;
+
+    [[nodiscard]]
+    std::string_view getTagName(MemoryTag a_tag);
+
+    // Counters are per thread & only written by their own thread, so tracking is a plain add without any locking
+    // Memory freed on another thread than it was allocated on is subtracted there, only the sums are meaningful
+    void trackAllocation(MemoryTag a_tag, size_t a_bytes);
+
+    void trackDeallocation(MemoryTag a_tag, size_t a_bytes);
+
+    // GPU memory the client allocated itself, e.g. mesh buffers & texture images
+    void trackDeviceAllocation(MemoryTag a_tag, size_t a_bytes);
+
+    void trackDeviceDeallocation(MemoryTag a_tag, size_t a_bytes);
+
+    // What the driver reports for the whole process (VK_EXT_memory_budget), including memory nobody tagged
+    void reportDeviceMemory(size_t a_usage, size_t a_budget);
+
+    struct MemoryUsage
+    {
+        std::array<size_t, MEMORY_TAG_COUNT> host{};
+        std::array<size_t, MEMORY_TAG_COUNT> device{};
+        size_t deviceReported = 0;
+        size_t deviceBudget = 0;
+
+        [[nodiscard]]
+        size_t getHostTotal() const;
+
+        [[nodiscard]]
+        size_t getDeviceTotal() const;
+
+        [[nodiscard]]
+        size_t get(const MemoryTag a_tag) const
+        {
+            return host[static_cast<size_t>(a_tag)] + device[static_cast<size_t>(a_tag)];
+        }
+    };
+
+    // Sums the counters of all threads, meant to be called about once per tick or frame, not per allocation
+    [[nodiscard]]
+    MemoryUsage getMemoryUsage();
+
+    // Gets the bytes a tag is over its budget, returns how many it (about) freed
+    using EvictionCallback = Utils::UniqueFunction<size_t(size_t a_excessBytes)>;
+
+    // Soft limit on host + device memory of a tag, 0 for none; going over it is allowed until enforceBudgets() runs
+    void setBudget(MemoryTag a_tag, size_t a_bytes);
+
+    [[nodiscard]]
+    size_t getBudget(MemoryTag a_tag);
+
+    // Called in the order they were added until the excess is freed, returns an id for removeEvictionCallback()
+    // a_owner (e.g. the object whose memory the callback frees) is what enforceBudgets() runs it for
+    uint64_t addEvictionCallback(MemoryTag a_tag, const void *a_owner, EvictionCallback a_callback);
+
+    // Has to be called before whatever the callback references is destroyed
+    void removeEvictionCallback(MemoryTag a_tag, uint64_t a_id);
+
+    // Runs the eviction callbacks a_owner added for every tag over its budget, on the calling thread; callbacks of other
+    // owners (like the integrated server's in the client) only run when they enforce them on their own thread
+    // Callbacks must not change budgets or add callbacks; returns how many bytes all tags together are still over their
+    // budgets after a_owner's callbacks
+    size_t enforceBudgets(const void *a_owner);
+
+    // Passes allocations through to the upstream resource & tracks them, lets std::pmr containers & arenas tag themselves
+    class TrackedResource final : public std::pmr::memory_resource
+    {
+    public:
+        explicit TrackedResource(const MemoryTag a_tag,
+                                 std::pmr::memory_resource *a_upstream = std::pmr::new_delete_resource())
+            : m_tag(a_tag), m_upstream(a_upstream) {}
+
+        [[nodiscard]]
+        MemoryTag getTag() const
+        {
+            return m_tag;
+        }
+
+    private:
+        MemoryTag m_tag;
+        std::pmr::memory_resource *m_upstream;
+
+        void *do_allocate(const size_t a_bytes, const size_t a_alignment) override
+        {
+            void *pointer = m_upstream->allocate(a_bytes, a_alignment);
+            trackAllocation(m_tag, a_bytes);
+            return pointer;
+        }
+
+        void do_deallocate(void *a_pointer, const size_t a_bytes, const size_t a_alignment) override
+        {
+            m_upstream->deallocate(a_pointer, a_bytes, a_alignment);
+            trackDeallocation(m_tag, a_bytes);
+        }
+
+        [[nodiscard]]
+        bool do_is_equal(const std::pmr::memory_resource &a_other) const noexcept override
+        {
+            return this == &a_other;
+        }
+    };
+
+    // A shared TrackedResource over new / delete for every tag
+    [[nodiscard]]
+    TrackedResource *getTrackedResource(MemoryTag a_tag);
+}
@@ -0,0 +1,74 @@
+#include "Memory/FixedSizePool.h"
+#include "Memory/MemoryTracker.h"
+#include "BufferPool.h"
+
+using Network::BufferPool, Network::PooledBuffer, Network::ByteBuffer;
+
+// The default initial capacity, buffers that grow past it move on to the tracked resource
+constexpr size_t g_blockSize = 4096;
+constexpr size_t g_blocksPerSlab = 64;
+
+// Never destroyed, buffers may still be freed by the destructors of other statics
+std::pmr::memory_resource *getBlockPool()
+{
+    static auto *pool = new Memory::FixedSizePool(g_blockSize, alignof(std::max_align_t), g_blocksPerSlab,
+                                                  Memory::getTrackedResource(Memory::MemoryTag::NetworkBuffers));
+    return pool;
+}
+
+PooledBuffer &PooledBuffer::operator=(PooledBuffer &&a_other) noexcept
+{
+    if (this != &a_other)
+    {
+        if (m_pool != nullptr)
+            m_pool->release(std::move(m_buffer));
+        m_pool = std::exchange(a_other.m_pool, nullptr);
+        m_buffer = std::move(a_other.m_buffer);
+    }
+    return *this;
+}
+
+PooledBuffer::~PooledBuffer()
+{
+    if (m_pool != nullptr)
+        m_pool->release(std::move(m_buffer));
+}
+
+BufferPool::BufferPool(const size_t a_initialCapacity, const size_t a_maxPooledBuffers, const size_t a_maxPooledCapacity)
+    : m_initialCapacity(a_initialCapacity), m_maxPooledBuffers(a_maxPooledBuffers), m_maxPooledCapacity(a_maxPooledCapacity) {}
+
+PooledBuffer BufferPool::acquire()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        if (!m_buffers.empty())
+        {
+            ByteBuffer buffer = std::move(m_buffers.back());
+            m_buffers.pop_back();
+            return {this, std::move(buffer)};
+        }
+    }
+
+    ByteBuffer buffer(getBlockPool());
+    buffer.reserve(m_initialCapacity);
+    return {this, std::move(buffer)};
+}
+
+size_t BufferPool::getPooledCount() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_buffers.size();
+}
+
+void BufferPool::release(ByteBuffer &&a_buffer)
+{
+    if (a_buffer.capacity() > m_maxPooledCapacity)
+        return;
+
+    a_buffer.clear();
+    std::lock_guard lock(m_mutex);
+    if (m_buffers.size() < m_maxPooledBuffers)
+    {
+        m_buffers.push_back(std::move(a_buffer));
+    }
+}
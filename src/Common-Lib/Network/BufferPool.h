@@ -0,0 +1,80 @@
+#pragma once
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "PacketCodec.h"
+
+namespace Network
+{
+    class BufferPool;
+
+    // A buffer borrowed from a BufferPool, goes back to it (emptied, keeping its capacity) when destroyed
+    class PooledBuffer final
+    {
+    public:
+        PooledBuffer(BufferPool *a_pool, ByteBuffer &&a_buffer)
+            : m_pool(a_pool), m_buffer(std::move(a_buffer)) {}
+
+        PooledBuffer(PooledBuffer &&a_other) noexcept
+            : m_pool(std::exchange(a_other.m_pool, nullptr)), m_buffer(std::move(a_other.m_buffer)) {}
+
+        PooledBuffer &operator=(PooledBuffer &&a_other) noexcept;
+
+        PooledBuffer(const PooledBuffer &) = delete;
+
+        PooledBuffer &operator=(const PooledBuffer &) = delete;
+
+        ~PooledBuffer();
+
+        ByteBuffer &operator*()
+        {
+            return m_buffer;
+        }
+
+        ByteBuffer *operator->()
+        {
+            return &m_buffer;
+        }
+
+        [[nodiscard]]
+        std::span<const std::byte> getData() const
+        {
+            return m_buffer;
+        }
+
+    private:
+        BufferPool *m_pool;
+        ByteBuffer m_buffer;
+    };
+
+    // Reuses send & receive buffers, so encoding a packet usually doesn't allocate; thread safe, must outlive its buffers
+    // New buffers start out in a block of a Memory::FixedSizePool shared by every BufferPool (so buffers of different
+    // pools can still be moved & swapped without copying), buffers are mostly freed on other threads than they were
+    // encoded on; buffer memory is tracked as MemoryTag::NetworkBuffers
+    class BufferPool final
+    {
+    public:
+        explicit BufferPool(size_t a_initialCapacity = 4096, size_t a_maxPooledBuffers = 256,
+                            size_t a_maxPooledCapacity = 1 << 20);
+
+        [[nodiscard]]
+        PooledBuffer acquire();
+
+        [[nodiscard]]
+        size_t getPooledCount() const;
+
+    private:
+        friend class PooledBuffer;
+
+        size_t m_initialCapacity;
+        size_t m_maxPooledBuffers;
+        // Buffers that grew past this (e.g. for a chunk) are freed instead of being kept around
+        size_t m_maxPooledCapacity;
+        mutable std::mutex m_mutex;
+        std::vector<ByteBuffer> m_buffers;
+
+        void release(ByteBuffer &&a_buffer);
+    };
+}
@@ -0,0 +1,50 @@
+#include "Connection.h"
+
+using Network::PacketChannel, Network::Connection, Network::PooledBuffer;
+
+bool PacketChannel::push(PooledBuffer &&a_buffer)
+{
+    if (isClosed())
+        return false;
+
+    PooledBuffer buffer = m_pool.acquire();
+    std::swap(*buffer, *a_buffer);
+    if (!m_ring.tryPush(std::move(buffer)))
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+std::pair<Connection, Connection> Connection::createLocal(const size_t a_capacity)
+{
+    auto first = std::make_shared<PacketChannel>(a_capacity);
+    auto second = std::make_shared<PacketChannel>(a_capacity);
+
+    // Closing either end closes both channels, so both ends see it
+    const auto close = [first, second]
+    {
+        first->close();
+        second->close();
+    };
+    const auto sendTo = [&close](std::shared_ptr<PacketChannel> a_channel)
+    {
+        return [channel = std::move(a_channel), close](PooledBuffer &&a_buffer)
+        {
+            if (!channel->push(std::move(a_buffer)))
+                close();
+        };
+    };
+
+    return {
+        Connection(first, sendTo(second), close),
+        Connection(second, sendTo(first), close)
+    };
+}
+
+void Connection::close()
+{
+    m_incoming->close();
+    m_close();
+}
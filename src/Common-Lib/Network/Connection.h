@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "Utils/SpscRing.h"
+#include "Utils/UniqueFunction.h"
+#include "BufferPool.h"
+#include "PacketCompression.h"
+
+namespace Network
+{
+    // Buffers of packet frames from one producer thread to one consumer thread
+    // Pushed buffers swap contents with a buffer of the channel's own pool, so the data isn't copied, the producer
+    // keeps a buffer for its pool & the popped ones don't depend on the pool of the producer staying alive
+    class PacketChannel final
+    {
+    public:
+        explicit PacketChannel(const size_t a_capacity)
+            : m_ring(a_capacity) {}
+
+        // A full channel means the receiver stopped keeping up, it's closed like a stalled socket & false is returned
+        bool push(PooledBuffer &&a_buffer);
+
+        // Popped buffers must not outlive the channel
+        [[nodiscard]]
+        std::optional<PooledBuffer> pop()
+        {
+            return m_ring.tryPop();
+        }
+
+        // Buffers that were pushed but not popped yet, safe to call from any thread
+        [[nodiscard]]
+        size_t getSize() const
+        {
+            return m_ring.getSize();
+        }
+
+        // Buffers that are already queued can still be popped
+        void close()
+        {
+            m_closed.store(true, std::memory_order_release);
+        }
+
+        [[nodiscard]]
+        bool isClosed() const
+        {
+            return m_closed.load(std::memory_order_acquire);
+        }
+
+    private:
+        // Before the ring, so it's destroyed after the buffers in it
+        BufferPool m_pool;
+        Utils::SpscRing<PooledBuffer> m_ring;
+        std::atomic<bool> m_closed = false;
+    };
+
+    // One end of a connection, whatever the transport: buffers of packet frames go out through a send function &
+    // come in through a channel; an end is used by one thread at a time
+    class Connection final
+    {
+    public:
+        using SendFunction = Utils::UniqueFunction<void(PooledBuffer &&)>;
+        using CloseFunction = Utils::UniqueFunction<void()>;
+        using StatsFunction = Utils::UniqueFunction<CompressionStats()>;
+
+        // Buffers sent through the channel of the other end of an in-process connection
+        static constexpr size_t LOCAL_CHANNEL_CAPACITY = 1024;
+
+        // a_compressionStats is only needed for transports that compress
+        Connection(std::shared_ptr<PacketChannel> a_incoming, SendFunction a_send, CloseFunction a_close,
+                   StatsFunction a_compressionStats = nullptr)
+            : m_incoming(std::move(a_incoming)), m_send(std::move(a_send)), m_close(std::move(a_close)),
+              m_compressionStats(std::move(a_compressionStats)) {}
+
+        // Both ends of an in-process connection, buffers are handed over by moving them through a lock-free ring,
+        // without a socket, copies or compression
+        [[nodiscard]]
+        static std::pair<Connection, Connection> createLocal(size_t a_capacity = LOCAL_CHANNEL_CAPACITY);
+
+        // Does nothing once the connection is closed
+        void send(PooledBuffer &&a_buffer)
+        {
+            if (!isClosed())
+                m_send(std::move(a_buffer));
+        }
+
+        [[nodiscard]]
+        std::optional<PooledBuffer> receive()
+        {
+            return m_incoming->pop();
+        }
+
+        // Received buffers that weren't taken yet
+        [[nodiscard]]
+        size_t getReceiveQueueSize() const
+        {
+            return m_incoming->getSize();
+        }
+
+        // Closes both ends
+        void close();
+
+        // Of both directions, nothing for connections that don't compress (yet)
+        [[nodiscard]]
+        CompressionStats getCompressionStats()
+        {
+            return m_compressionStats ? m_compressionStats() : CompressionStats{};
+        }
+
+        // Either end was closed or the transport failed
+        [[nodiscard]]
+        bool isClosed() const
+        {
+            return m_incoming->isClosed();
+        }
+
+    private:
+        std::shared_ptr<PacketChannel> m_incoming;
+        SendFunction m_send;
+        CloseFunction m_close;
+        StatsFunction m_compressionStats;
+    };
+}
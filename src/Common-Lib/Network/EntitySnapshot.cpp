@@ -0,0 +1,248 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "glm/common.hpp"
+
+#include "EntitySnapshot.h"
+
+using Network::EntityState, Network::PacketReader, Network::PacketWriter, Network::ProtocolError;
+
+// Change flags of a snapshot delta entry
+constexpr uint8_t g_changedX = 1 << 0;
+constexpr uint8_t g_changedY = 1 << 1;
+constexpr uint8_t g_changedZ = 1 << 2;
+constexpr uint8_t g_changedVelocity = 1 << 3;
+constexpr uint8_t g_changedRotation = 1 << 4;
+// Not a change, the current value, so an entity only landing still fits in one byte
+constexpr uint8_t g_onGround = 1 << 5;
+// Everything follows in full, the entity replaces whatever the client had at its index
+constexpr uint8_t g_created = 1 << 6;
+constexpr uint8_t g_removed = 1 << 7;
+// Index gap, flags, generation, 3 positions, 3 velocities & 2 angles
+constexpr size_t g_maxEntrySize = Network::MAX_VAR_INT_SIZE * 2 + 1 + Network::MAX_VAR_LONG_SIZE * 3 + 3 * 3 + 2;
+
+uint64_t toZigZag(const int64_t a_value)
+{
+    return static_cast<uint64_t>(a_value) << 1 ^ static_cast<uint64_t>(a_value >> 63);
+}
+
+int64_t fromZigZag(const uint64_t a_value)
+{
+    return static_cast<int64_t>(a_value >> 1 ^ -(a_value & 1));
+}
+
+int16_t quantizeVelocity(const double a_velocity)
+{
+    constexpr double limit = std::numeric_limits<int16_t>::max();
+    return static_cast<int16_t>(std::clamp(std::round(a_velocity * Network::VELOCITY_SCALE), -limit, limit));
+}
+
+uint8_t getChanges(const EntityState &a_base, const EntityState &a_state)
+{
+    uint8_t changes = a_state.onGround ? g_onGround : 0;
+    if (a_base.position.x != a_state.position.x)
+        changes |= g_changedX;
+    if (a_base.position.y != a_state.position.y)
+        changes |= g_changedY;
+    if (a_base.position.z != a_state.position.z)
+        changes |= g_changedZ;
+    if (a_base.velocity != a_state.velocity)
+        changes |= g_changedVelocity;
+    if (a_base.yaw != a_state.yaw || a_base.pitch != a_state.pitch)
+        changes |= g_changedRotation;
+    return changes;
+}
+
+void writeVelocity(PacketWriter &a_writer, const glm::i16vec3 &a_velocity, const glm::i16vec3 &a_base)
+{
+    for (int32_t i = 0; i < 3; i++)
+    {
+        a_writer.writeVarInt(static_cast<int32_t>(toZigZag(a_velocity[i] - a_base[i])));
+    }
+}
+
+glm::i16vec3 readVelocity(PacketReader &a_reader, const glm::i16vec3 &a_base)
+{
+    glm::i16vec3 velocity;
+    for (int32_t i = 0; i < 3; i++)
+    {
+        const int64_t value = a_base[i] + fromZigZag(static_cast<uint32_t>(a_reader.readVarInt()));
+        if (value < std::numeric_limits<int16_t>::min() || value > std::numeric_limits<int16_t>::max())
+            throw ProtocolError("Entity velocity out of range");
+        velocity[i] = static_cast<int16_t>(value);
+    }
+    return velocity;
+}
+
+// Writes the entry of a_state, or nothing if it didn't change
+void writeEntry(PacketWriter &a_writer, int64_t &a_previousIndex, const EntityState *a_base, const EntityState &a_state)
+{
+    const bool created = a_base == nullptr || a_base->entity.generation != a_state.entity.generation;
+    const uint8_t changes = created ? g_created | (a_state.onGround ? g_onGround : 0) : getChanges(*a_base, a_state);
+    if (!created && (changes & ~g_onGround) == 0 && a_base->onGround == a_state.onGround)
+        return;
+
+    a_writer.writeVarInt(static_cast<int32_t>(a_state.entity.index - a_previousIndex - 1));
+    a_previousIndex = a_state.entity.index;
+    a_writer.writeByte(static_cast<std::byte>(changes));
+
+    if (created)
+    {
+        a_writer.writeVarInt(static_cast<int32_t>(a_state.entity.generation));
+        for (int32_t i = 0; i < 3; i++)
+        {
+            a_writer.writeVarLong(static_cast<int64_t>(toZigZag(a_state.position[i])));
+        }
+        writeVelocity(a_writer, a_state.velocity, glm::i16vec3(0));
+        a_writer.writeByte(static_cast<std::byte>(a_state.yaw));
+        a_writer.writeByte(static_cast<std::byte>(a_state.pitch));
+        return;
+    }
+
+    for (int32_t i = 0; i < 3; i++)
+    {
+        if ((changes & g_changedX << i) != 0)
+            a_writer.writeVarLong(static_cast<int64_t>(toZigZag(a_state.position[i] - a_base->position[i])));
+    }
+    if ((changes & g_changedVelocity) != 0)
+        writeVelocity(a_writer, a_state.velocity, a_base->velocity);
+    if ((changes & g_changedRotation) != 0)
+    {
+        a_writer.writeByte(static_cast<std::byte>(a_state.yaw));
+        a_writer.writeByte(static_cast<std::byte>(a_state.pitch));
+    }
+}
+
+void writeRemoval(PacketWriter &a_writer, int64_t &a_previousIndex, const EntityState &a_base)
+{
+    a_writer.writeVarInt(static_cast<int32_t>(a_base.entity.index - a_previousIndex - 1));
+    a_previousIndex = a_base.entity.index;
+    a_writer.writeByte(static_cast<std::byte>(g_removed));
+}
+
+EntityState EntityState::quantize(const Ecs::EntityId a_entity, const glm::dvec3 &a_position,
+                                  const glm::dvec3 &a_velocity, const float a_yaw, const float a_pitch,
+                                  const bool a_onGround)
+{
+    return {
+        .entity = a_entity,
+        .position = glm::i64vec3(glm::round(a_position * POSITION_SCALE)),
+        .velocity = {quantizeVelocity(a_velocity.x), quantizeVelocity(a_velocity.y), quantizeVelocity(a_velocity.z)},
+        // Wraps around, 360° is 0
+        .yaw = static_cast<uint8_t>(static_cast<int32_t>(std::lround(a_yaw * ANGLE_SCALE))),
+        .pitch = static_cast<uint8_t>(static_cast<int8_t>(std::lround(std::clamp(a_pitch, -90.0f, 90.0f) * ANGLE_SCALE))),
+        .onGround = a_onGround
+    };
+}
+
+namespace Network
+{
+    void encodeSnapshotDelta(const std::span<const EntityState> a_base, const std::span<const EntityState> a_snapshot,
+                             ByteBuffer &a_buffer)
+    {
+        const size_t offset = a_buffer.size();
+        a_buffer.resize(offset + (a_base.size() + a_snapshot.size()) * g_maxEntrySize);
+        PacketWriter writer(std::span<std::byte>(a_buffer).subspan(offset));
+
+        // Both are sorted by index, so this is a merge
+        int64_t previousIndex = -1;
+        auto base = a_base.begin();
+        for (const EntityState &state: a_snapshot)
+        {
+            for (; base != a_base.end() && base->entity.index < state.entity.index; ++base)
+            {
+                writeRemoval(writer, previousIndex, *base);
+            }
+
+            if (base != a_base.end() && base->entity.index == state.entity.index)
+                writeEntry(writer, previousIndex, &*base++, state);
+            else
+                writeEntry(writer, previousIndex, nullptr, state);
+        }
+        for (; base != a_base.end(); ++base)
+        {
+            writeRemoval(writer, previousIndex, *base);
+        }
+
+        a_buffer.resize(a_buffer.size() - writer.getRemaining());
+    }
+
+    void decodeSnapshotDelta(const std::span<const EntityState> a_base, const std::span<const std::byte> a_data,
+                             std::vector<EntityState> &a_snapshot)
+    {
+        a_snapshot.clear();
+        a_snapshot.reserve(a_base.size());
+
+        PacketReader reader(a_data);
+        int64_t previousIndex = -1;
+        auto base = a_base.begin();
+        while (reader.getRemaining() > 0)
+        {
+            const auto gap = static_cast<uint32_t>(reader.readVarInt());
+            const auto changes = static_cast<uint8_t>(reader.readByte());
+            const int64_t index = previousIndex + 1 + gap;
+            if (reader.hasFailed() || index >= Ecs::EntityId::INVALID_INDEX)
+                throw ProtocolError("Malformed snapshot entry");
+            previousIndex = index;
+
+            for (; base != a_base.end() && base->entity.index < index; ++base)
+            {
+                a_snapshot.push_back(*base);
+            }
+            const EntityState *previous = base != a_base.end() && base->entity.index == index ? &*base++ : nullptr;
+
+            if ((changes & g_removed) != 0)
+            {
+                if (changes != g_removed)
+                    throw ProtocolError("Malformed snapshot entry");
+                if (previous == nullptr)
+                    throw ProtocolError("Removed an unknown entity");
+                continue;
+            }
+
+            EntityState &state = a_snapshot.emplace_back();
+            state.entity.index = static_cast<uint32_t>(index);
+            state.onGround = (changes & g_onGround) != 0;
+            if ((changes & g_created) != 0)
+            {
+                state.entity.generation = static_cast<uint32_t>(reader.readVarInt());
+                for (int32_t i = 0; i < 3; i++)
+                {
+                    state.position[i] = fromZigZag(static_cast<uint64_t>(reader.readVarLong()));
+                }
+                state.velocity = readVelocity(reader, glm::i16vec3(0));
+                state.yaw = static_cast<uint8_t>(reader.readByte());
+                state.pitch = static_cast<uint8_t>(reader.readByte());
+            }
+            else
+            {
+                if (previous == nullptr)
+                    throw ProtocolError("Changed an unknown entity");
+
+                state.entity.generation = previous->entity.generation;
+                for (int32_t i = 0; i < 3; i++)
+                {
+                    state.position[i] = previous->position[i];
+                    if ((changes & g_changedX << i) != 0)
+                        state.position[i] += fromZigZag(static_cast<uint64_t>(reader.readVarLong()));
+                }
+                state.velocity = (changes & g_changedVelocity) != 0 ? readVelocity(reader, previous->velocity) : previous->velocity;
+                state.yaw = previous->yaw;
+                state.pitch = previous->pitch;
+                if ((changes & g_changedRotation) != 0)
+                {
+                    state.yaw = static_cast<uint8_t>(reader.readByte());
+                    state.pitch = static_cast<uint8_t>(reader.readByte());
+                }
+            }
+        }
+        if (reader.hasFailed())
+            throw ProtocolError("Truncated snapshot");
+
+        for (; base != a_base.end(); ++base)
+        {
+            a_snapshot.push_back(*base);
+        }
+    }
+}
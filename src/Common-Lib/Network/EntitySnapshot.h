@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "glm/vec3.hpp"
+#include "glm/ext/vector_int3_sized.hpp"
+
+#include "Ecs/EntityId.h"
+#include "PacketCodec.h"
+
+namespace Network
+{
+    // The server sends one snapshot per tick
+    inline constexpr int32_t SNAPSHOTS_PER_SECOND = 20;
+    // Snapshots both sides keep around as delta bases, a client acknowledging older ones gets a full snapshot
+    inline constexpr size_t SNAPSHOT_HISTORY = 32;
+
+    // Positions in 1/4096 blocks
+    inline constexpr double POSITION_SCALE = 4096.0;
+    // Velocities in 1/8000 blocks per tick, clamped to the int16 range (about 4 blocks per tick)
+    inline constexpr double VELOCITY_SCALE = 8000.0;
+    // Yaw & pitch in 1/256 turns
+    inline constexpr float ANGLE_SCALE = 256.0f / 360.0f;
+
+    // Replicated state of one entity, quantized so unchanged values compare equal & changes are small integers
+    struct EntityState
+    {
+        Ecs::EntityId entity;
+        glm::i64vec3 position{0};
+        glm::i16vec3 velocity{0};
+        uint8_t yaw = 0;
+        uint8_t pitch = 0;
+        bool onGround = false;
+
+        [[nodiscard]]
+        static EntityState quantize(Ecs::EntityId a_entity, const glm::dvec3 &a_position, const glm::dvec3 &a_velocity,
+                                    float a_yaw, float a_pitch, bool a_onGround);
+
+        [[nodiscard]]
+        glm::dvec3 getPosition() const
+        {
+            return glm::dvec3(position) / POSITION_SCALE;
+        }
+
+        // Blocks per tick
+        [[nodiscard]]
+        glm::dvec3 getVelocity() const
+        {
+            return glm::dvec3(velocity) / VELOCITY_SCALE;
+        }
+
+        // Degrees in [0, 360)
+        [[nodiscard]]
+        float getYaw() const
+        {
+            return static_cast<float>(yaw) / ANGLE_SCALE;
+        }
+
+        [[nodiscard]]
+        float getPitch() const
+        {
+            return static_cast<float>(static_cast<int8_t>(pitch)) / ANGLE_SCALE;
+        }
+
+        bool operator==(const EntityState &) const = default;
+    };
+
+    // Snapshots are the states of all replicated entities at one tick, sorted by entity index
+    // The delta to a base snapshot only has the entities that changed: per entity the index gap to the previous one,
+    // a byte of change flags & then the changed fields, positions & velocities as zigzag differences
+    // Entities missing from the base (or with another generation) are sent in full, an empty base makes a full snapshot
+    void encodeSnapshotDelta(std::span<const EntityState> a_base, std::span<const EntityState> a_snapshot,
+                             ByteBuffer &a_buffer);
+
+    // Replaces a_snapshot with a_base with the delta applied, throws a ProtocolError if the delta doesn't fit the base
+    void decodeSnapshotDelta(std::span<const EntityState> a_base, std::span<const std::byte> a_data,
+                             std::vector<EntityState> &a_snapshot);
+}
@@ -0,0 +1,44 @@
+#include <format>
+
+#include "PacketCodec.h"
+
+using Network::PacketFrame, Network::ProtocolError;
+
+namespace Network
+{
+    std::optional<PacketFrame> readFrame(const std::span<const std::byte> a_data)
+    {
+        // The length prefix itself may not have arrived completely yet
+        uint32_t payloadSize = 0;
+        size_t prefixSize = 0;
+        for (;; prefixSize++)
+        {
+            if (prefixSize == MAX_VAR_INT_SIZE)
+                throw ProtocolError("Frame length is longer than a VarInt");
+            if (prefixSize == a_data.size())
+                return {};
+
+            const auto byte = static_cast<uint32_t>(a_data[prefixSize]);
+            payloadSize |= (byte & 0x7F) << 7 * prefixSize;
+            if ((byte & 0x80) == 0)
+                break;
+        }
+        prefixSize++;
+
+        if (payloadSize == 0 || payloadSize > MAX_FRAME_SIZE)
+            throw ProtocolError(std::format("Invalid frame length {}", payloadSize));
+        if (a_data.size() - prefixSize < payloadSize)
+            return {};
+
+        PacketReader reader(a_data.subspan(prefixSize, payloadSize));
+        const int32_t id = reader.readVarInt();
+        if (reader.hasFailed() || id < 0)
+            throw ProtocolError("Invalid packet id");
+
+        return PacketFrame{
+            .id = id,
+            .body = a_data.subspan(prefixSize + payloadSize - reader.getRemaining(), reader.getRemaining()),
+            .frameSize = prefixSize + payloadSize
+        };
+    }
+}
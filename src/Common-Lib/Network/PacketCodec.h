@@ -0,0 +1,615 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "World/BlockPos.h"
+
+namespace Network
+{
+    // Wire types, the type of a packet field picks its encoding
+    struct VarInt
+    {
+        int32_t value = 0;
+    };
+
+    struct VarLong
+    {
+        int64_t value = 0;
+    };
+
+    // Id of a Utils::IdentifierRegistry entry, sent as a VarInt instead of the identifier string
+    struct RegistryId
+    {
+        uint32_t value = 0;
+    };
+
+    using ByteBuffer = std::pmr::vector<std::byte>;
+
+    inline constexpr size_t MAX_VAR_INT_SIZE = 5;
+    inline constexpr size_t MAX_VAR_LONG_SIZE = 10;
+    // Longer frames, strings & byte arrays are rejected while decoding
+    inline constexpr size_t MAX_FRAME_SIZE = 1 << 21;
+
+    // Thrown for data a peer should never have sent, the connection should be closed
+    class ProtocolError final : public std::runtime_error
+    {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    [[nodiscard]]
+    constexpr size_t getVarIntSize(const int32_t a_value)
+    {
+        // Every 7 bits of the highest set bit take a byte, 0 still takes one
+        return (std::bit_width(static_cast<uint32_t>(a_value) | 1) + 6) / 7;
+    }
+
+    [[nodiscard]]
+    constexpr size_t getVarLongSize(const int64_t a_value)
+    {
+        return (std::bit_width(static_cast<uint64_t>(a_value) | 1) + 6) / 7;
+    }
+
+    // Writes into memory that was sized up front (packet sizes are computed before encoding), so there are no checks
+    class PacketWriter final
+    {
+    public:
+        explicit PacketWriter(const std::span<std::byte> a_buffer)
+            : m_cursor(a_buffer.data()), m_end(a_buffer.data() + a_buffer.size()) {}
+
+        [[nodiscard]]
+        size_t getRemaining() const
+        {
+            return static_cast<size_t>(m_end - m_cursor);
+        }
+
+        void writeByte(const std::byte a_byte)
+        {
+            *m_cursor++ = a_byte;
+        }
+
+        void writeVarInt(const int32_t a_value)
+        {
+            auto value = static_cast<uint32_t>(a_value);
+            while (value >= 0x80)
+            {
+                *m_cursor++ = static_cast<std::byte>(value | 0x80);
+                value >>= 7;
+            }
+            *m_cursor++ = static_cast<std::byte>(value);
+        }
+
+        // Always takes a_size bytes, padded with empty continuation bytes; for lengths that have to be written before
+        // the data they describe, the reader doesn't care about the padding
+        void writeVarInt(const int32_t a_value, const size_t a_size)
+        {
+            auto value = static_cast<uint32_t>(a_value);
+            for (size_t i = 1; i < a_size; i++)
+            {
+                *m_cursor++ = static_cast<std::byte>(value & 0x7F | 0x80);
+                value >>= 7;
+            }
+            *m_cursor++ = static_cast<std::byte>(value);
+        }
+
+        void writeVarLong(const int64_t a_value)
+        {
+            auto value = static_cast<uint64_t>(a_value);
+            while (value >= 0x80)
+            {
+                *m_cursor++ = static_cast<std::byte>(value | 0x80);
+                value >>= 7;
+            }
+            *m_cursor++ = static_cast<std::byte>(value);
+        }
+
+        // Big endian
+        template<std::integral T>
+            requires (!std::same_as<T, bool>)
+        void writeInteger(const T a_value)
+        {
+            auto bits = static_cast<std::make_unsigned_t<T>>(a_value);
+            if constexpr (std::endian::native == std::endian::little && sizeof(T) > 1)
+                bits = std::byteswap(bits);
+            std::memcpy(m_cursor, &bits, sizeof(T));
+            m_cursor += sizeof(T);
+        }
+
+        void writeFloat(const float a_value)
+        {
+            writeInteger(std::bit_cast<uint32_t>(a_value));
+        }
+
+        void writeDouble(const double a_value)
+        {
+            writeInteger(std::bit_cast<uint64_t>(a_value));
+        }
+
+        void writeBytes(const std::span<const std::byte> a_bytes)
+        {
+            // An empty span may not point anywhere
+            if (a_bytes.empty())
+                return;
+            std::memcpy(m_cursor, a_bytes.data(), a_bytes.size());
+            m_cursor += a_bytes.size();
+        }
+
+    private:
+        std::byte *m_cursor;
+        std::byte *m_end;
+    };
+
+    // Reads from a received buffer, reading past the end or malformed values mark the reader as failed instead of
+    // throwing for every field; strings & byte arrays are returned as views into the buffer
+    class PacketReader final
+    {
+    public:
+        explicit PacketReader(const std::span<const std::byte> a_buffer)
+            : m_cursor(a_buffer.data()), m_end(a_buffer.data() + a_buffer.size()) {}
+
+        [[nodiscard]]
+        bool hasFailed() const
+        {
+            return m_failed;
+        }
+
+        [[nodiscard]]
+        size_t getRemaining() const
+        {
+            return static_cast<size_t>(m_end - m_cursor);
+        }
+
+        std::byte readByte()
+        {
+            if (m_cursor == m_end)
+            {
+                fail();
+                return {};
+            }
+            return *m_cursor++;
+        }
+
+        int32_t readVarInt()
+        {
+            uint32_t result = 0;
+            for (uint32_t shift = 0; shift < 7 * MAX_VAR_INT_SIZE; shift += 7)
+            {
+                if (m_cursor == m_end)
+                    break;
+                const auto byte = static_cast<uint32_t>(*m_cursor++);
+                result |= (byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                    return static_cast<int32_t>(result);
+            }
+            fail();
+            return 0;
+        }
+
+        int64_t readVarLong()
+        {
+            uint64_t result = 0;
+            for (uint32_t shift = 0; shift < 7 * MAX_VAR_LONG_SIZE; shift += 7)
+            {
+                if (m_cursor == m_end)
+                    break;
+                const auto byte = static_cast<uint64_t>(*m_cursor++);
+                result |= (byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                    return static_cast<int64_t>(result);
+            }
+            fail();
+            return 0;
+        }
+
+        template<std::integral T>
+            requires (!std::same_as<T, bool>)
+        T readInteger()
+        {
+            if (getRemaining() < sizeof(T))
+            {
+                fail();
+                return 0;
+            }
+            std::make_unsigned_t<T> bits;
+            std::memcpy(&bits, m_cursor, sizeof(T));
+            m_cursor += sizeof(T);
+            if constexpr (std::endian::native == std::endian::little && sizeof(T) > 1)
+                bits = std::byteswap(bits);
+            return static_cast<T>(bits);
+        }
+
+        float readFloat()
+        {
+            return std::bit_cast<float>(readInteger<uint32_t>());
+        }
+
+        double readDouble()
+        {
+            return std::bit_cast<double>(readInteger<uint64_t>());
+        }
+
+        std::span<const std::byte> readBytes(const size_t a_count)
+        {
+            if (getRemaining() < a_count)
+            {
+                fail();
+                return {};
+            }
+            const std::span<const std::byte> bytes(m_cursor, a_count);
+            m_cursor += a_count;
+            return bytes;
+        }
+
+        // A VarInt length followed by that many bytes
+        std::span<const std::byte> readByteArray()
+        {
+            const int32_t length = readVarInt();
+            if (length < 0 || static_cast<size_t>(length) > MAX_FRAME_SIZE)
+            {
+                fail();
+                return {};
+            }
+            return readBytes(static_cast<size_t>(length));
+        }
+
+    private:
+        const std::byte *m_cursor;
+        const std::byte *m_end;
+        bool m_failed = false;
+
+        void fail()
+        {
+            m_failed = true;
+            m_cursor = m_end;
+        }
+    };
+
+    // How one field type is encoded, getSize() has to match exactly what write() writes
+    template<typename T>
+    struct FieldCodec;
+
+    template<std::integral T>
+        requires (!std::same_as<T, bool>)
+    struct FieldCodec<T>
+    {
+        static constexpr size_t getSize(T)
+        {
+            return sizeof(T);
+        }
+
+        static void write(PacketWriter &a_writer, const T a_value)
+        {
+            a_writer.writeInteger(a_value);
+        }
+
+        static T read(PacketReader &a_reader)
+        {
+            return a_reader.readInteger<T>();
+        }
+    };
+
+    template<>
+    struct FieldCodec<bool>
+    {
+        static constexpr size_t getSize(bool)
+        {
+            return 1;
+        }
+
+        static void write(PacketWriter &a_writer, const bool a_value)
+        {
+            a_writer.writeByte(static_cast<std::byte>(a_value));
+        }
+
+        static bool read(PacketReader &a_reader)
+        {
+            return a_reader.readByte() != std::byte{0};
+        }
+    };
+
+    template<>
+    struct FieldCodec<float>
+    {
+        static constexpr size_t getSize(float)
+        {
+            return sizeof(float);
+        }
+
+        static void write(PacketWriter &a_writer, const float a_value)
+        {
+            a_writer.writeFloat(a_value);
+        }
+
+        static float read(PacketReader &a_reader)
+        {
+            return a_reader.readFloat();
+        }
+    };
+
+    template<>
+    struct FieldCodec<double>
+    {
+        static constexpr size_t getSize(double)
+        {
+            return sizeof(double);
+        }
+
+        static void write(PacketWriter &a_writer, const double a_value)
+        {
+            a_writer.writeDouble(a_value);
+        }
+
+        static double read(PacketReader &a_reader)
+        {
+            return a_reader.readDouble();
+        }
+    };
+
+    template<>
+    struct FieldCodec<VarInt>
+    {
+        static constexpr size_t getSize(const VarInt a_value)
+        {
+            return getVarIntSize(a_value.value);
+        }
+
+        static void write(PacketWriter &a_writer, const VarInt a_value)
+        {
+            a_writer.writeVarInt(a_value.value);
+        }
+
+        static VarInt read(PacketReader &a_reader)
+        {
+            return {a_reader.readVarInt()};
+        }
+    };
+
+    template<>
+    struct FieldCodec<VarLong>
+    {
+        static constexpr size_t getSize(const VarLong a_value)
+        {
+            return getVarLongSize(a_value.value);
+        }
+
+        static void write(PacketWriter &a_writer, const VarLong a_value)
+        {
+            a_writer.writeVarLong(a_value.value);
+        }
+
+        static VarLong read(PacketReader &a_reader)
+        {
+            return {a_reader.readVarLong()};
+        }
+    };
+
+    template<>
+    struct FieldCodec<RegistryId>
+    {
+        static constexpr size_t getSize(const RegistryId a_value)
+        {
+            return getVarIntSize(static_cast<int32_t>(a_value.value));
+        }
+
+        static void write(PacketWriter &a_writer, const RegistryId a_value)
+        {
+            a_writer.writeVarInt(static_cast<int32_t>(a_value.value));
+        }
+
+        static RegistryId read(PacketReader &a_reader)
+        {
+            return {static_cast<uint32_t>(a_reader.readVarInt())};
+        }
+    };
+
+    // Packed into 64 bits: 26 bits x, 26 bits z, 12 bits y
+    template<>
+    struct FieldCodec<World::BlockPos>
+    {
+        static constexpr size_t getSize(const World::BlockPos &)
+        {
+            return sizeof(uint64_t);
+        }
+
+        static void write(PacketWriter &a_writer, const World::BlockPos &a_pos)
+        {
+            a_writer.writeInteger((static_cast<uint64_t>(a_pos.x) & 0x3FFFFFF) << 38
+                                  | (static_cast<uint64_t>(a_pos.z) & 0x3FFFFFF) << 12
+                                  | (static_cast<uint64_t>(a_pos.y) & 0xFFF));
+        }
+
+        static World::BlockPos read(PacketReader &a_reader)
+        {
+            const auto packed = a_reader.readInteger<int64_t>();
+            return {
+                static_cast<int32_t>(packed >> 38),
+                static_cast<int32_t>(packed << 52 >> 52),
+                static_cast<int32_t>(packed << 26 >> 38)
+            };
+        }
+    };
+
+    // Packed into 64 bits: 22 bits x, 22 bits z, 20 bits y
+    template<>
+    struct FieldCodec<World::SectionPos>
+    {
+        static constexpr size_t getSize(const World::SectionPos &)
+        {
+            return sizeof(uint64_t);
+        }
+
+        static void write(PacketWriter &a_writer, const World::SectionPos &a_pos)
+        {
+            a_writer.writeInteger((static_cast<uint64_t>(a_pos.x) & 0x3FFFFF) << 42
+                                  | (static_cast<uint64_t>(a_pos.z) & 0x3FFFFF) << 20
+                                  | (static_cast<uint64_t>(a_pos.y) & 0xFFFFF));
+        }
+
+        static World::SectionPos read(PacketReader &a_reader)
+        {
+            const auto packed = a_reader.readInteger<int64_t>();
+            return {
+                static_cast<int32_t>(packed >> 42),
+                static_cast<int32_t>(packed << 44 >> 44),
+                static_cast<int32_t>(packed << 22 >> 42)
+            };
+        }
+    };
+
+    template<>
+    struct FieldCodec<World::ChunkPos>
+    {
+        static constexpr size_t getSize(const World::ChunkPos &)
+        {
+            return 2 * sizeof(int32_t);
+        }
+
+        static void write(PacketWriter &a_writer, const World::ChunkPos &a_pos)
+        {
+            a_writer.writeInteger(a_pos.x);
+            a_writer.writeInteger(a_pos.z);
+        }
+
+        static World::ChunkPos read(PacketReader &a_reader)
+        {
+            const auto x = a_reader.readInteger<int32_t>();
+            return {x, a_reader.readInteger<int32_t>()};
+        }
+    };
+
+    // A VarInt length followed by the UTF-8 bytes, decoded strings point into the received buffer
+    template<>
+    struct FieldCodec<std::string_view>
+    {
+        static constexpr size_t getSize(const std::string_view a_value)
+        {
+            return getVarIntSize(static_cast<int32_t>(a_value.size())) + a_value.size();
+        }
+
+        static void write(PacketWriter &a_writer, const std::string_view a_value)
+        {
+            a_writer.writeVarInt(static_cast<int32_t>(a_value.size()));
+            a_writer.writeBytes(std::as_bytes(std::span(a_value)));
+        }
+
+        static std::string_view read(PacketReader &a_reader)
+        {
+            const std::span<const std::byte> bytes = a_reader.readByteArray();
+            return {reinterpret_cast<const char *>(bytes.data()), bytes.size()};
+        }
+    };
+
+    template<>
+    struct FieldCodec<std::span<const std::byte>>
+    {
+        static constexpr size_t getSize(const std::span<const std::byte> a_value)
+        {
+            return getVarIntSize(static_cast<int32_t>(a_value.size())) + a_value.size();
+        }
+
+        static void write(PacketWriter &a_writer, const std::span<const std::byte> a_value)
+        {
+            a_writer.writeVarInt(static_cast<int32_t>(a_value.size()));
+            a_writer.writeBytes(a_value);
+        }
+
+        static std::span<const std::byte> read(PacketReader &a_reader)
+        {
+            return a_reader.readByteArray();
+        }
+    };
+
+    // A packet is a struct with a static ID & a static getFields() that returns a tuple of member pointers in wire order,
+    // the serializers for it are generated from that:
+    // struct KeepAlive { static constexpr int32_t ID = 0; int64_t id; static constexpr auto getFields() { return std::tuple{&KeepAlive::id}; } };
+    template<typename P>
+    concept PacketType = std::is_default_constructible_v<P> && requires
+    {
+        { P::ID } -> std::convertible_to<int32_t>;
+        P::getFields();
+    };
+
+    template<typename P, typename Field>
+    using FieldType = std::remove_cvref_t<decltype(std::declval<const P &>().*std::declval<Field>())>;
+
+    // Size of the fields, without the frame header
+    template<PacketType P>
+    [[nodiscard]]
+    constexpr size_t getBodySize(const P &a_packet)
+    {
+        return std::apply([&a_packet](const auto... a_fields)
+        {
+            return (size_t{0} + ... + FieldCodec<FieldType<P, decltype(a_fields)>>::getSize(a_packet.*a_fields));
+        }, P::getFields());
+    }
+
+    // Frames are a VarInt length of the rest, the VarInt packet id & the fields
+    template<PacketType P>
+    [[nodiscard]]
+    constexpr size_t getFrameSize(const P &a_packet)
+    {
+        const size_t payloadSize = getVarIntSize(P::ID) + getBodySize(a_packet);
+        return getVarIntSize(static_cast<int32_t>(payloadSize)) + payloadSize;
+    }
+
+    // Encodes a_packet as a frame at the end of a_buffer, directly into its memory
+    template<PacketType P>
+    void encodePacket(ByteBuffer &a_buffer, const P &a_packet)
+    {
+        const size_t bodySize = getBodySize(a_packet);
+        const size_t payloadSize = getVarIntSize(P::ID) + bodySize;
+        const size_t offset = a_buffer.size();
+        a_buffer.resize(offset + getVarIntSize(static_cast<int32_t>(payloadSize)) + payloadSize);
+
+        PacketWriter writer(std::span<std::byte>(a_buffer).subspan(offset));
+        writer.writeVarInt(static_cast<int32_t>(payloadSize));
+        writer.writeVarInt(P::ID);
+        std::apply([&writer, &a_packet](const auto... a_fields)
+        {
+            (FieldCodec<FieldType<P, decltype(a_fields)>>::write(writer, a_packet.*a_fields), ...);
+        }, P::getFields());
+    }
+
+    // Decodes the body of a frame with P::ID, views in the result point into a_body; throws a ProtocolError if the body
+    // is malformed or has bytes left over
+    template<PacketType P>
+    [[nodiscard]]
+    P decodePacket(const std::span<const std::byte> a_body)
+    {
+        PacketReader reader(a_body);
+        P packet;
+        std::apply([&reader, &packet](const auto... a_fields)
+        {
+            ((packet.*a_fields = FieldCodec<FieldType<P, decltype(a_fields)>>::read(reader)), ...);
+        }, P::getFields());
+
+        if (reader.hasFailed() || reader.getRemaining() != 0)
+            throw ProtocolError("Malformed packet");
+        return packet;
+    }
+
+    struct PacketFrame
+    {
+        int32_t id = 0;
+        std::span<const std::byte> body;
+        // Including the length prefix, what to drop from the receive buffer once the packet is handled
+        size_t frameSize = 0;
+    };
+
+    // Splits the first frame off received data, an empty optional if it hasn't been received completely yet;
+    // throws a ProtocolError for invalid lengths & ids
+    [[nodiscard]]
+    std::optional<PacketFrame> readFrame(std::span<const std::byte> a_data);
+}
@@ -0,0 +1,144 @@
+#include <format>
+
+#include "libdeflate.h"
+
+#include "Memory/MemoryTracker.h"
+#include "PacketCompression.h"
+
+using Network::AtomicCompressionStats, Network::CompressionStats, Network::PacketCompressor, Network::PacketDecompressor,
+        Network::PacketFrame, Network::ProtocolError;
+using std::chrono::steady_clock;
+
+void AtomicCompressionStats::add(const uint64_t a_packets, const uint64_t a_compressedPackets,
+                                 const uint64_t a_uncompressedBytes, const uint64_t a_wireBytes,
+                                 const std::chrono::nanoseconds a_time)
+{
+    m_packets.fetch_add(a_packets, std::memory_order_relaxed);
+    m_compressedPackets.fetch_add(a_compressedPackets, std::memory_order_relaxed);
+    m_uncompressedBytes.fetch_add(a_uncompressedBytes, std::memory_order_relaxed);
+    m_wireBytes.fetch_add(a_wireBytes, std::memory_order_relaxed);
+    m_nanoseconds.fetch_add(a_time.count(), std::memory_order_relaxed);
+}
+
+CompressionStats AtomicCompressionStats::get() const
+{
+    return {
+        .packets = m_packets.load(std::memory_order_relaxed),
+        .compressedPackets = m_compressedPackets.load(std::memory_order_relaxed),
+        .uncompressedBytes = m_uncompressedBytes.load(std::memory_order_relaxed),
+        .wireBytes = m_wireBytes.load(std::memory_order_relaxed),
+        .time = std::chrono::nanoseconds(m_nanoseconds.load(std::memory_order_relaxed))
+    };
+}
+
+PacketCompressor::PacketCompressor(const size_t a_threshold, const int a_level)
+    : m_compressor(libdeflate_alloc_compressor(a_level)), m_threshold(a_threshold)
+{
+    if (m_compressor == nullptr)
+        throw std::runtime_error(std::format("Failed to allocate a compressor for level {}", a_level));
+}
+
+PacketCompressor::~PacketCompressor()
+{
+    libdeflate_free_compressor(m_compressor);
+}
+
+void PacketCompressor::compressFrames(std::span<const std::byte> a_frames, ByteBuffer &a_out)
+{
+    const steady_clock::time_point start = steady_clock::now();
+    const size_t outStart = a_out.size();
+    uint64_t packets = 0;
+    uint64_t compressedPackets = 0;
+    uint64_t uncompressedBytes = 0;
+
+    while (!a_frames.empty())
+    {
+        PacketReader reader(a_frames);
+        const auto payloadSize = static_cast<size_t>(reader.readVarInt());
+        const std::span<const std::byte> payload = a_frames.subspan(a_frames.size() - reader.getRemaining(), payloadSize);
+        a_frames = a_frames.subspan(a_frames.size() - reader.getRemaining() + payloadSize);
+        packets++;
+        uncompressedBytes += payloadSize;
+
+        const size_t offset = a_out.size();
+        if (payloadSize >= m_threshold)
+        {
+            // The frame length is written before compressing, padded to what the largest possible result would need
+            const size_t dataLengthSize = getVarIntSize(static_cast<int32_t>(payloadSize));
+            const size_t bound = libdeflate_zlib_compress_bound(m_compressor, payloadSize);
+            const size_t lengthSize = getVarIntSize(static_cast<int32_t>(dataLengthSize + bound));
+            a_out.resize(offset + lengthSize + dataLengthSize + bound);
+
+            std::byte *compressed = a_out.data() + offset + lengthSize + dataLengthSize;
+            const size_t compressedSize = libdeflate_zlib_compress(m_compressor, payload.data(), payloadSize, compressed, bound);
+            if (compressedSize != 0 && compressedSize < payloadSize)
+            {
+                PacketWriter writer(std::span<std::byte>(a_out).subspan(offset));
+                writer.writeVarInt(static_cast<int32_t>(dataLengthSize + compressedSize), lengthSize);
+                writer.writeVarInt(static_cast<int32_t>(payloadSize));
+                a_out.resize(offset + lengthSize + dataLengthSize + compressedSize);
+                compressedPackets++;
+                continue;
+            }
+            // Incompressible, e.g. already compressed data
+            a_out.resize(offset);
+        }
+
+        a_out.resize(offset + getVarIntSize(static_cast<int32_t>(payloadSize + 1)) + 1 + payloadSize);
+        PacketWriter writer(std::span<std::byte>(a_out).subspan(offset));
+        writer.writeVarInt(static_cast<int32_t>(payloadSize + 1));
+        writer.writeVarInt(0);
+        writer.writeBytes(payload);
+    }
+
+    m_stats.add(packets, compressedPackets, uncompressedBytes, a_out.size() - outStart, steady_clock::now() - start);
+}
+
+PacketDecompressor::PacketDecompressor(const size_t a_threshold)
+    : m_decompressor(libdeflate_alloc_decompressor()), m_threshold(a_threshold),
+      m_buffer(Memory::getTrackedResource(Memory::MemoryTag::NetworkBuffers))
+{
+    if (m_decompressor == nullptr)
+        throw std::runtime_error("Failed to allocate a decompressor");
+}
+
+PacketDecompressor::~PacketDecompressor()
+{
+    libdeflate_free_decompressor(m_decompressor);
+}
+
+std::optional<PacketFrame> PacketDecompressor::readFrame(const std::span<const std::byte> a_data)
+{
+    // The uncompressed length is where an uncompressed frame has its packet id
+    const std::optional<PacketFrame> outer = Network::readFrame(a_data);
+    if (!outer.has_value())
+        return {};
+
+    const steady_clock::time_point start = steady_clock::now();
+    const auto dataLength = static_cast<size_t>(outer->id);
+    std::span<const std::byte> payload = outer->body;
+    if (dataLength != 0)
+    {
+        if (dataLength < m_threshold || dataLength > MAX_FRAME_SIZE)
+            throw ProtocolError(std::format("Invalid uncompressed packet length {}", dataLength));
+
+        m_buffer.resize(dataLength);
+        size_t actualLength = 0;
+        if (libdeflate_zlib_decompress(m_decompressor, payload.data(), payload.size(), m_buffer.data(), dataLength, &actualLength) != LIBDEFLATE_SUCCESS
+            || actualLength != dataLength)
+            throw ProtocolError("Malformed compressed packet");
+        payload = m_buffer;
+    }
+
+    PacketReader reader(payload);
+    const int32_t id = reader.readVarInt();
+    if (reader.hasFailed() || id < 0)
+        throw ProtocolError("Invalid packet id");
+
+    m_stats.add(1, dataLength != 0, payload.size(), outer->frameSize, steady_clock::now() - start);
+    return PacketFrame{
+        .id = id,
+        .body = payload.subspan(payload.size() - reader.getRemaining()),
+        .frameSize = outer->frameSize
+    };
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include "PacketCodec.h"
+
+struct libdeflate_compressor;
+struct libdeflate_decompressor;
+
+namespace Network
+{
+    // Packets with an id & body of at least this many bytes are compressed, smaller ones aren't worth the CPU time
+    inline constexpr size_t DEFAULT_COMPRESSION_THRESHOLD = 256;
+
+    struct CompressionStats
+    {
+        uint64_t packets = 0;
+        uint64_t compressedPackets = 0;
+        // Packet ids & bodies before compression / after decompression
+        uint64_t uncompressedBytes = 0;
+        // Everything on the wire, frame headers included
+        uint64_t wireBytes = 0;
+        // Time spent in (de)compression, it's all CPU work
+        std::chrono::nanoseconds time{0};
+
+        // Wire bytes per uncompressed byte, below 1 is a saving
+        [[nodiscard]]
+        double getRatio() const
+        {
+            return uncompressedBytes == 0 ? 1.0 : static_cast<double>(wireBytes) / static_cast<double>(uncompressedBytes);
+        }
+
+        // E.g. to sum up both directions of a connection
+        CompressionStats &operator+=(const CompressionStats &a_other)
+        {
+            packets += a_other.packets;
+            compressedPackets += a_other.compressedPackets;
+            uncompressedBytes += a_other.uncompressedBytes;
+            wireBytes += a_other.wireBytes;
+            time += a_other.time;
+            return *this;
+        }
+    };
+
+    // Written by one thread & read by any, e.g. for reporting from the tick thread
+    class AtomicCompressionStats final
+    {
+    public:
+        void add(uint64_t a_packets, uint64_t a_compressedPackets, uint64_t a_uncompressedBytes, uint64_t a_wireBytes,
+                 std::chrono::nanoseconds a_time);
+
+        [[nodiscard]]
+        CompressionStats get() const;
+
+    private:
+        std::atomic<uint64_t> m_packets = 0;
+        std::atomic<uint64_t> m_compressedPackets = 0;
+        std::atomic<uint64_t> m_uncompressedBytes = 0;
+        std::atomic<uint64_t> m_wireBytes = 0;
+        std::atomic<int64_t> m_nanoseconds = 0;
+    };
+
+    // With compression a frame is a VarInt length, the VarInt uncompressed length of the packet id & body (0 if they
+    // aren't compressed) & the (zlib compressed) packet id & body
+    // One compressor per connection, its deflate context is allocated once & reused for every packet; not thread safe
+    class PacketCompressor final
+    {
+    public:
+        explicit PacketCompressor(size_t a_threshold = DEFAULT_COMPRESSION_THRESHOLD, int a_level = 6);
+
+        PacketCompressor(const PacketCompressor &) = delete;
+
+        PacketCompressor &operator=(const PacketCompressor &) = delete;
+
+        ~PacketCompressor();
+
+        // Converts frames written by encodePacket() to compressed frames at the end of a_out
+        void compressFrames(std::span<const std::byte> a_frames, ByteBuffer &a_out);
+
+        [[nodiscard]]
+        CompressionStats getStats() const
+        {
+            return m_stats.get();
+        }
+
+    private:
+        libdeflate_compressor *m_compressor;
+        size_t m_threshold;
+        AtomicCompressionStats m_stats;
+    };
+
+    class PacketDecompressor final
+    {
+    public:
+        explicit PacketDecompressor(size_t a_threshold = DEFAULT_COMPRESSION_THRESHOLD);
+
+        PacketDecompressor(const PacketDecompressor &) = delete;
+
+        PacketDecompressor &operator=(const PacketDecompressor &) = delete;
+
+        ~PacketDecompressor();
+
+        // Like Network::readFrame() for compressed frames; bodies of compressed packets point into a buffer of the
+        // decompressor that the next call reuses, uncompressed ones into a_data
+        [[nodiscard]]
+        std::optional<PacketFrame> readFrame(std::span<const std::byte> a_data);
+
+        [[nodiscard]]
+        CompressionStats getStats() const
+        {
+            return m_stats.get();
+        }
+
+    private:
+        libdeflate_decompressor *m_decompressor;
+        size_t m_threshold;
+        ByteBuffer m_buffer;
+        AtomicCompressionStats m_stats;
+    };
+}
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <tuple>
+
+#include "World/BlockPos.h"
+#include "PacketCodec.h"
+
+// Packet definitions, the ids are shared by both directions for now
+namespace Network::Packets
+{
+    struct KeepAlive
+    {
+        static constexpr int32_t ID = 0x00;
+
+        int64_t id = 0;
+
+        static constexpr auto getFields()
+        {
+            return std::tuple{&KeepAlive::id};
+        }
+    };
+
+    struct BlockChange
+    {
+        static constexpr int32_t ID = 0x01;
+
+        World::BlockPos pos;
+        VarInt state;
+
+        static constexpr auto getFields()
+        {
+            return std::tuple{&BlockChange::pos, &BlockChange::state};
+        }
+    };
+
+    struct EntityPosition
+    {
+        static constexpr int32_t ID = 0x02;
+
+        VarInt entityId;
+        double x = 0.0;
+        double y = 0.0;
+        double z = 0.0;
+        float yaw = 0.0f;
+        float pitch = 0.0f;
+        bool onGround = false;
+
+        static constexpr auto getFields()
+        {
+            return std::tuple{
+                &EntityPosition::entityId, &EntityPosition::x, &EntityPosition::y, &EntityPosition::z,
+                &EntityPosition::yaw, &EntityPosition::pitch, &EntityPosition::onGround
+            };
+        }
+    };
+
+    // The decoded message points into the receive buffer, it has to be copied to outlive it
+    struct ChatMessage
+    {
+        static constexpr int32_t ID = 0x03;
+
+        std::string_view message;
+        int64_t timestamp = 0;
+
+        static constexpr auto getFields()
+        {
+            return std::tuple{&ChatMessage::message, &ChatMessage::timestamp};
+        }
+    };
+
+    // The sound is an id of the sound registry
+    struct PlaySound
+    {
+        static constexpr int32_t ID = 0x04;
+
+        RegistryId sound;
+        World::BlockPos pos;
+        float volume = 1.0f;
+        float pitch = 1.0f;
+
+        static constexpr auto getFields()
+        {
+            return std::tuple{&PlaySound::sound, &PlaySound::pos, &PlaySound::volume, &PlaySound::pitch};
+        }
+    };
+
+    // The blocks of a section, encoded by Network::encodeSectionBlocks(); empty for a section of only air
+    struct ChunkSectionData
+    {
+        static constexpr int32_t ID = 0x05;
+
+        World::SectionPos pos;
+        std::span<const std::byte> blocks;
+
+        static constexpr auto getFields()
+        {
+            return std::tuple{&ChunkSectionData::pos, &ChunkSectionData::blocks};
+        }
+    };
+
+    // Block changes of one section in one tick, VarLongs of (state << 12 | ChunkSection::getIndex())
+    struct MultiBlockChange
+    {
+        static constexpr int32_t ID = 0x06;
+
+        World::SectionPos section;
+        std::span<const std::byte> changes;
+
+        static constexpr auto getFields()
+        {
+            return std::tuple{&MultiBlockChange::section, &MultiBlockChange::changes};
+        }
+    };
+
+    // The client drops the column, it is sent again if it comes back into view
+    struct UnloadChunk
+    {
+        static constexpr int32_t ID = 0x07;
+
+        World::ChunkPos pos;
+
+        static constexpr auto getFields()
+        {
+            return std::tuple{&UnloadChunk::pos};
+        }
+    };
+
+    // Entity states of a tick as a delta to the snapshot of baseTick (0 for a full snapshot), see
+    // Network::encodeSnapshotDelta(); the client answers with a SnapshotAck once it decoded it
+    struct EntitySnapshot
+    {
+        static constexpr int32_t ID = 0x08;
+
+        VarLong tick;
+        VarLong baseTick;
+        std::span<const std::byte> entities;
+
+        static constexpr auto getFields()
+        {
+            return std::tuple{&EntitySnapshot::tick, &EntitySnapshot::baseTick, &EntitySnapshot::entities};
+        }
+    };
+
+    // The server bases the following snapshots on this one
+    struct SnapshotAck
+    {
+        static constexpr int32_t ID = 0x09;
+
+        VarLong tick;
+
+        static constexpr auto getFields()
+        {
+            return std::tuple{&SnapshotAck::tick};
+        }
+    };
+
+    // First packet of a client, answered with LoginSuccess
+    struct Login
+    {
+        static constexpr int32_t ID = 0x0A;
+
+        std::string_view name;
+
+        static constexpr auto getFields()
+        {
+            return std::tuple{&Login::name};
+        }
+    };
+
+    // The entity of the player (Ecs::EntityId::toBits()) & where it spawned
+    struct LoginSuccess
+    {
+        static constexpr int32_t ID = 0x0B;
+
+        VarLong entity;
+        double x = 0.0;
+        double y = 0.0;
+        double z = 0.0;
+
+        static constexpr auto getFields()
+        {
+            return std::tuple{&LoginSuccess::entity, &LoginSuccess::x, &LoginSuccess::y, &LoginSuccess::z};
+        }
+    };
+
+    // Sent once a second, the durations of the server ticks since the last one as VarInts of microseconds, ending with
+    // the tick before `tick`
+    struct TickTimes
+    {
+        static constexpr int32_t ID = 0x0C;
+
+        VarLong tick;
+        std::span<const std::byte> durations;
+
+        static constexpr auto getFields()
+        {
+            return std::tuple{&TickTimes::tick, &TickTimes::durations};
+        }
+    };
+
+    // Sent by the server right before LoginSuccess, every frame after it is compressed in both directions (see
+    // Network::PacketCompressor) with packets from `threshold` bytes on; TCP connections switch on their own when it
+    // passes through, in-process ones ignore it; the client sends nothing between Login & LoginSuccess
+    struct SetCompression
+    {
+        static constexpr int32_t ID = 0x0D;
+
+        VarInt threshold;
+
+        static constexpr auto getFields()
+        {
+            return std::tuple{&SetCompression::threshold};
+        }
+    };
+}
@@ -0,0 +1,110 @@
+#include <limits>
+
+#include "SectionEncoding.h"
+
+using World::ChunkSection, World::BlockStateId, World::SECTION_VOLUME, World::SECTIONS_PER_CHUNK;
+
+// Lengths are written before the blocks they describe, padded to this size, a section takes at most 16 KiB
+constexpr size_t g_sectionLengthSize = 3;
+
+// Calls a_function(runLength, state) for every run of equal blocks
+template<typename F>
+void forEachRun(const ChunkSection &a_section, F &&a_function)
+{
+    const auto &blocks = a_section.getBlocks();
+    size_t runStart = 0;
+    for (size_t i = 1; i <= blocks.size(); i++)
+    {
+        if (i == blocks.size() || blocks[i] != blocks[runStart])
+        {
+            a_function(static_cast<int32_t>(i - runStart), blocks[runStart]);
+            runStart = i;
+        }
+    }
+}
+
+namespace Network
+{
+    void encodeSectionBlocks(const ChunkSection &a_section, ByteBuffer &a_buffer)
+    {
+        size_t size = 0;
+        forEachRun(a_section, [&size](const int32_t a_length, const BlockStateId a_state)
+        {
+            size += getVarIntSize(a_length) + getVarIntSize(a_state);
+        });
+
+        const size_t offset = a_buffer.size();
+        a_buffer.resize(offset + size);
+        PacketWriter writer(std::span<std::byte>(a_buffer).subspan(offset));
+        forEachRun(a_section, [&writer](const int32_t a_length, const BlockStateId a_state)
+        {
+            writer.writeVarInt(a_length);
+            writer.writeVarInt(a_state);
+        });
+    }
+
+    void decodeSectionBlocks(const std::span<const std::byte> a_data, ChunkSection &a_section)
+    {
+        PacketReader reader(a_data);
+        int32_t index = 0;
+        while (reader.getRemaining() > 0)
+        {
+            const int32_t length = reader.readVarInt();
+            const int32_t state = reader.readVarInt();
+            if (reader.hasFailed() || length <= 0 || length > SECTION_VOLUME - index
+                || state < 0 || state > std::numeric_limits<BlockStateId>::max())
+                throw ProtocolError("Malformed section blocks");
+
+            for (const int32_t end = index + length; index < end; index++)
+            {
+                a_section.setBlock(index & 15, index >> 8, index >> 4 & 15, static_cast<BlockStateId>(state));
+            }
+        }
+
+        if (index != SECTION_VOLUME)
+            throw ProtocolError("Section blocks don't cover the whole section");
+    }
+
+    void encodeChunkSections(const std::span<const IndexedSection> a_sections, ByteBuffer &a_buffer)
+    {
+        for (const auto &[index, section]: a_sections)
+        {
+            const size_t offset = a_buffer.size();
+            a_buffer.resize(offset + 1 + g_sectionLengthSize);
+            if (section != nullptr)
+            {
+                encodeSectionBlocks(*section, a_buffer);
+            }
+            else
+            {
+                // One run of air
+                a_buffer.resize(a_buffer.size() + getVarIntSize(SECTION_VOLUME) + getVarIntSize(World::Blocks::AIR));
+                PacketWriter writer(std::span<std::byte>(a_buffer).last(getVarIntSize(SECTION_VOLUME) + getVarIntSize(World::Blocks::AIR)));
+                writer.writeVarInt(SECTION_VOLUME);
+                writer.writeVarInt(World::Blocks::AIR);
+            }
+
+            PacketWriter writer(std::span<std::byte>(a_buffer).subspan(offset, 1 + g_sectionLengthSize));
+            writer.writeByte(static_cast<std::byte>(index));
+            writer.writeVarInt(static_cast<int32_t>(a_buffer.size() - offset - 1 - g_sectionLengthSize), g_sectionLengthSize);
+        }
+    }
+
+    std::vector<std::pair<int32_t, std::unique_ptr<ChunkSection>>> decodeChunkSections(const std::span<const std::byte> a_data)
+    {
+        std::vector<std::pair<int32_t, std::unique_ptr<ChunkSection>>> sections;
+        PacketReader reader(a_data);
+        while (reader.getRemaining() > 0)
+        {
+            const auto index = static_cast<int32_t>(reader.readByte());
+            const std::span<const std::byte> blocks = reader.readByteArray();
+            if (reader.hasFailed() || index >= SECTIONS_PER_CHUNK)
+                throw ProtocolError("Malformed chunk sections");
+
+            auto section = std::make_unique<ChunkSection>();
+            decodeSectionBlocks(blocks, *section);
+            sections.emplace_back(index, section->isEmpty() ? nullptr : std::move(section));
+        }
+        return sections;
+    }
+}
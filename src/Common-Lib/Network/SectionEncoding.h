@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "World/ChunkSection.h"
+#include "PacketCodec.h"
+
+namespace Network
+{
+    // Run length encoded in index order (y, z, x), pairs of VarInt run length & VarInt block state; terrain is mostly
+    // horizontal layers, so a typical section is a few dozen bytes instead of 8 KiB
+    void encodeSectionBlocks(const World::ChunkSection &a_section, ByteBuffer &a_buffer);
+
+    // Throws a ProtocolError unless the runs cover exactly one section
+    void decodeSectionBlocks(std::span<const std::byte> a_data, World::ChunkSection &a_section);
+
+    // A section of a chunk by its index in the chunk (0 is MIN_SECTION_Y), nullptr is a section of air
+    struct IndexedSection
+    {
+        int32_t index = 0;
+        const World::ChunkSection *section = nullptr;
+    };
+
+    // Several sections of one chunk, each as its index byte & its VarInt length prefixed blocks; for keeping chunks
+    // outside of the world, not for the wire
+    void encodeChunkSections(std::span<const IndexedSection> a_sections, ByteBuffer &a_buffer);
+
+    // Sections of air come back as nullptr, throws a ProtocolError for malformed data
+    [[nodiscard]]
+    std::vector<std::pair<int32_t, std::unique_ptr<World::ChunkSection>>> decodeChunkSections(std::span<const std::byte> a_data);
+}
@@ -0,0 +1,297 @@
+#include <atomic>
+#include <deque>
+#include <format>
+#include <memory>
+#include <optional>
+
+#include "PacketCompression.h"
+#include "Packets.h"
+#include "TcpConnection.h"
+
+namespace Network
+{
+    // Size of a single socket read
+    constexpr size_t g_readSize = 16 * 1024;
+    // A peer that lets more than this pile up unsent stopped reading, it's disconnected like a full local channel
+    constexpr size_t g_maxQueuedBytes = 16 << 20;
+    // Sum of m_queuedBytes of all transports, only for reporting
+    std::atomic<size_t> g_totalQueuedBytes = 0;
+
+    // As an uncompressed frame at the end of a_buffer
+    void appendFrame(ByteBuffer &a_buffer, const PacketFrame &a_frame)
+    {
+        const size_t payloadSize = getVarIntSize(a_frame.id) + a_frame.body.size();
+        const size_t offset = a_buffer.size();
+        a_buffer.resize(offset + getVarIntSize(static_cast<int32_t>(payloadSize)) + payloadSize);
+        PacketWriter writer(std::span<std::byte>(a_buffer).subspan(offset));
+        writer.writeVarInt(static_cast<int32_t>(payloadSize));
+        writer.writeVarInt(a_frame.id);
+        writer.writeBytes(a_frame.body);
+    }
+
+    // The socket side of a TCP connection, kept alive by its pending operations & by the Connection end
+    class TcpTransport final : public std::enable_shared_from_this<TcpTransport>
+    {
+    public:
+        TcpTransport(asio::ip::tcp::socket &&a_socket, const size_t a_channelCapacity)
+            : m_socket(std::move(a_socket)), m_incoming(std::make_shared<PacketChannel>(a_channelCapacity)) {}
+
+        ~TcpTransport()
+        {
+            clearWriteQueue();
+        }
+
+        [[nodiscard]]
+        const std::shared_ptr<PacketChannel> &getIncoming() const
+        {
+            return m_incoming;
+        }
+
+        void startReading()
+        {
+            asio::post(m_socket.get_executor(), [self = shared_from_this()]
+            {
+                self->read();
+            });
+        }
+
+        // Of both directions, safe to call from any thread
+        [[nodiscard]]
+        CompressionStats getCompressionStats() const
+        {
+            if (!m_compressing.load(std::memory_order_acquire))
+                return {};
+            CompressionStats stats = m_compressor->getStats();
+            stats += m_decompressor->getStats();
+            return stats;
+        }
+
+        void send(PooledBuffer &&a_buffer)
+        {
+            asio::post(m_socket.get_executor(), [self = shared_from_this(), frames = std::move(a_buffer)]() mutable
+            {
+                if (self->m_closing)
+                    return;
+
+                std::optional<PooledBuffer> compressed = self->compress(std::move(frames));
+                if (!compressed.has_value())
+                    return;
+                PooledBuffer &buffer = *compressed;
+                if (self->m_queuedBytes + buffer->size() > g_maxQueuedBytes)
+                {
+                    self->closeSocket();
+                    return;
+                }
+
+                self->m_queuedBytes += buffer->size();
+                g_totalQueuedBytes.fetch_add(buffer->size(), std::memory_order_relaxed);
+                self->m_writeQueue.push_back(std::move(buffer));
+                if (self->m_writeQueue.size() == 1)
+                    self->write();
+            });
+        }
+
+        // What's already queued is still written before the socket closes
+        void close()
+        {
+            asio::post(m_socket.get_executor(), [self = shared_from_this()]
+            {
+                self->m_closing = true;
+                if (self->m_writeQueue.empty())
+                    self->closeSocket();
+            });
+        }
+
+    private:
+        asio::ip::tcp::socket m_socket;
+        std::shared_ptr<PacketChannel> m_incoming;
+        BufferPool m_pool;
+        // Bytes of frames that haven't been received completely yet, followed by space for the next read
+        std::vector<std::byte> m_received;
+        size_t m_receivedSize = 0;
+        std::deque<PooledBuffer> m_writeQueue;
+        size_t m_queuedBytes = 0;
+        bool m_closing = false;
+        // Created once a SetCompression packet was sent or received, m_compressing tells other threads
+        std::optional<PacketCompressor> m_compressor;
+        std::optional<PacketDecompressor> m_decompressor;
+        std::atomic<bool> m_compressing = false;
+
+        // Every frame after the SetCompression is compressed, in both directions
+        void startCompressing(const int32_t a_threshold)
+        {
+            if (a_threshold < 0)
+                throw ProtocolError(std::format("Invalid compression threshold {}", a_threshold));
+
+            m_compressor.emplace(static_cast<size_t>(a_threshold));
+            m_decompressor.emplace(static_cast<size_t>(a_threshold));
+            m_compressing.store(true, std::memory_order_release);
+        }
+
+        // Frames after a SetCompression among them are compressed, until one was sent they're only looked at; closes the
+        // connection & returns nothing if they're malformed
+        std::optional<PooledBuffer> compress(PooledBuffer &&a_frames)
+        {
+            const std::span<const std::byte> frames = a_frames.getData();
+            size_t uncompressed = 0;
+            try
+            {
+                while (!m_compressor.has_value() && uncompressed < frames.size())
+                {
+                    const std::optional<PacketFrame> frame = readFrame(frames.subspan(uncompressed));
+                    if (!frame.has_value())
+                        throw ProtocolError("Incomplete packet frame");
+                    uncompressed += frame->frameSize;
+                    if (frame->id == Packets::SetCompression::ID)
+                        startCompressing(decodePacket<Packets::SetCompression>(frame->body).threshold.value);
+                }
+            } catch (const ProtocolError &)
+            {
+                closeSocket();
+                return {};
+            }
+            if (uncompressed == frames.size())
+                return std::move(a_frames);
+
+            PooledBuffer compressed = m_pool.acquire();
+            compressed->assign(frames.begin(), frames.begin() + static_cast<ptrdiff_t>(uncompressed));
+            m_compressor->compressFrames(frames.subspan(uncompressed), *compressed);
+            return compressed;
+        }
+
+        void read()
+        {
+            if (m_received.size() < m_receivedSize + g_readSize)
+                m_received.resize(m_receivedSize + g_readSize);
+
+            m_socket.async_read_some(asio::buffer(m_received.data() + m_receivedSize, g_readSize),
+                                     [self = shared_from_this()](const asio::error_code &a_error, const size_t a_size)
+                                     {
+                                         if (a_error)
+                                         {
+                                             self->closeSocket();
+                                             return;
+                                         }
+                                         self->m_receivedSize += a_size;
+                                         if (self->pushFrames())
+                                             self->read();
+                                     });
+        }
+
+        // Hands every complete frame over as one buffer of uncompressed frames & keeps the rest, false if the connection
+        // got closed
+        bool pushFrames()
+        {
+            const std::span<const std::byte> received(m_received.data(), m_receivedSize);
+            PooledBuffer buffer = m_pool.acquire();
+            size_t complete = 0;
+            try
+            {
+                while (complete < received.size())
+                {
+                    const std::span<const std::byte> rest = received.subspan(complete);
+                    if (m_decompressor.has_value())
+                    {
+                        const std::optional<PacketFrame> frame = m_decompressor->readFrame(rest);
+                        if (!frame.has_value())
+                            break;
+                        appendFrame(*buffer, *frame);
+                        complete += frame->frameSize;
+                        continue;
+                    }
+
+                    const std::optional<PacketFrame> frame = readFrame(rest);
+                    if (!frame.has_value())
+                        break;
+                    buffer->insert(buffer->end(), rest.begin(), rest.begin() + static_cast<ptrdiff_t>(frame->frameSize));
+                    complete += frame->frameSize;
+                    if (frame->id == Packets::SetCompression::ID)
+                        startCompressing(decodePacket<Packets::SetCompression>(frame->body).threshold.value);
+                }
+            } catch (const ProtocolError &)
+            {
+                closeSocket();
+                return false;
+            }
+
+            if (complete > 0)
+            {
+                if (!m_incoming->push(std::move(buffer)))
+                {
+                    closeSocket();
+                    return false;
+                }
+                std::copy(received.begin() + static_cast<ptrdiff_t>(complete), received.end(), m_received.begin());
+                m_receivedSize -= complete;
+            }
+            return !m_incoming->isClosed();
+        }
+
+        void write()
+        {
+            asio::async_write(m_socket, asio::buffer(m_writeQueue.front()->data(), m_writeQueue.front()->size()),
+                              [self = shared_from_this()](const asio::error_code &a_error, size_t)
+                              {
+                                  if (a_error)
+                                  {
+                                      self->clearWriteQueue();
+                                      self->closeSocket();
+                                      return;
+                                  }
+                                  self->m_queuedBytes -= self->m_writeQueue.front()->size();
+                                  g_totalQueuedBytes.fetch_sub(self->m_writeQueue.front()->size(), std::memory_order_relaxed);
+                                  self->m_writeQueue.pop_front();
+                                  if (!self->m_writeQueue.empty())
+                                      self->write();
+                                  else if (self->m_closing)
+                                      self->closeSocket();
+                              });
+        }
+
+        void clearWriteQueue()
+        {
+            g_totalQueuedBytes.fetch_sub(m_queuedBytes, std::memory_order_relaxed);
+            m_queuedBytes = 0;
+            m_writeQueue.clear();
+        }
+
+        // A write that's still in progress gets aborted & drops the queue
+        void closeSocket()
+        {
+            m_incoming->close();
+            m_closing = true;
+            asio::error_code ignored;
+            m_socket.shutdown(asio::ip::tcp::socket::shutdown_both, ignored);
+            m_socket.close(ignored);
+        }
+    };
+
+    size_t getQueuedTcpBytes()
+    {
+        return g_totalQueuedBytes.load(std::memory_order_relaxed);
+    }
+
+    Connection createTcpConnection(asio::ip::tcp::socket &&a_socket, const size_t a_channelCapacity)
+    {
+        asio::error_code ignored;
+        a_socket.set_option(asio::ip::tcp::no_delay(true), ignored);
+
+        auto transport = std::make_shared<TcpTransport>(std::move(a_socket), a_channelCapacity);
+        transport->startReading();
+        return {
+            transport->getIncoming(),
+            [transport](PooledBuffer &&a_buffer)
+            {
+                transport->send(std::move(a_buffer));
+            },
+            [transport]
+            {
+                transport->close();
+            },
+            [transport]
+            {
+                return transport->getCompressionStats();
+            }
+        };
+    }
+}
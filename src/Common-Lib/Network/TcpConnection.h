@@ -0,0 +1,18 @@
+#pragma once
+
+#include "asio.hpp"
+
+#include "Connection.h"
+
+namespace Network
+{
+    // Frames read from the socket go into the channel of the returned end as buffers of whole frames, sent buffers are
+    // queued & written in order; all socket work happens on the socket's executor, which must be a strand or a single
+    // thread; a read / write error or a malformed frame closes the connection
+    [[nodiscard]]
+    Connection createTcpConnection(asio::ip::tcp::socket &&a_socket, size_t a_channelCapacity = Connection::LOCAL_CHANNEL_CAPACITY);
+
+    // Bytes that were sent through any TCP connection of the process but aren't written to their socket yet
+    [[nodiscard]]
+    size_t getQueuedTcpBytes();
+}
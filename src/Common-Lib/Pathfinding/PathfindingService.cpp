@@ -0,0 +1,400 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "PathfindingService.h"
+
+using Pathfinding::PathfindingService, Pathfinding::Path, Pathfinding::PathfindingStats;
+
+// Requests between positions further apart than this (in blocks, per axis) fail right away
+constexpr int32_t g_maxPathDistance = 256;
+constexpr size_t g_maxCoarseExpansions = 8192;
+// A fine search that expands more positions than this returns the path to the closest position it found
+constexpr size_t g_maxFineExpansions = 16384;
+// The clock is only checked every this many fine expansions
+constexpr size_t g_expansionsPerClockCheck = 128;
+// The caches are dropped entirely once they grow beyond this many entries
+constexpr size_t g_maxCacheEntries = 4096;
+constexpr int32_t g_maxFallDistance = 3;
+
+[[nodiscard]]
+float estimateCost(const World::BlockPos &a_from, const World::BlockPos &a_to)
+{
+    // Every horizontal step costs at least 1 & every vertical block at least 0.5, so this never overestimates
+    return static_cast<float>(std::abs(a_from.x - a_to.x) + std::abs(a_from.z - a_to.z))
+           + 0.5f * static_cast<float>(std::abs(a_from.y - a_to.y));
+}
+
+[[nodiscard]]
+float estimateCost(const World::SectionPos &a_from, const World::SectionPos &a_to)
+{
+    return static_cast<float>(std::abs(a_from.x - a_to.x) + std::abs(a_from.y - a_to.y) + std::abs(a_from.z - a_to.z));
+}
+
+PathfindingService::PathfindingService(const World::ChunkMap &a_world)
+    : m_world(a_world), m_sectionGraph(a_world) {}
+
+Utils::TaskFuture<Path> PathfindingService::requestPath(const World::BlockPos &a_start, const World::BlockPos &a_goal)
+{
+    auto request = std::make_unique<PathRequest>();
+    request->start = a_start;
+    request->goal = a_goal;
+    Utils::TaskFuture<Path> future = request->promise.getFuture();
+
+    if (const auto fromStart = m_pathCache.find(a_start); fromStart != m_pathCache.end())
+    {
+        if (const auto cached = fromStart->second.find(a_goal); cached != fromStart->second.end() && isCacheEntryValid(cached->second))
+        {
+            request->promise.setValue(cached->second.path);
+            m_stats.cachedRequests++;
+            return future;
+        }
+    }
+
+    m_requests.push_back(std::move(request));
+    return future;
+}
+
+void PathfindingService::tick(const std::chrono::nanoseconds a_budget)
+{
+    const auto deadline = std::chrono::steady_clock::now() + a_budget;
+    while (!m_requests.empty() && std::chrono::steady_clock::now() < deadline)
+    {
+        PathRequest &request = *m_requests.front();
+        if (!request.corridorReady && !findCorridor(request))
+        {
+            finish(request, {{request.start}, false});
+            m_requests.pop_front();
+            continue;
+        }
+
+        if (!advanceFineSearch(request, deadline))
+            return;
+
+        m_requests.pop_front();
+    }
+}
+
+void PathfindingService::onBlockChanged(const World::BlockPos &a_pos)
+{
+    // Whether a mob can stand at a position depends on the block below & above it too
+    m_sectionGraph.invalidate(a_pos);
+    if (World::blockToLocal(a_pos.y) == 0)
+        m_sectionGraph.invalidate(a_pos.offset(0, -1, 0));
+    if (World::blockToLocal(a_pos.y) == World::SECTION_SIZE - 1)
+        m_sectionGraph.invalidate(a_pos.offset(0, 1, 0));
+}
+
+void PathfindingService::onChunkChanged(const World::ChunkPos a_pos)
+{
+    m_sectionGraph.invalidateChunk(a_pos);
+}
+
+PathfindingStats PathfindingService::getStats() const
+{
+    PathfindingStats stats = m_stats;
+    stats.pendingRequests = m_requests.size();
+    return stats;
+}
+
+bool PathfindingService::isCacheEntryValid(const CachedEntry &a_entry) const
+{
+    for (size_t i = 0; i < a_entry.sections.size(); i++)
+    {
+        if (m_sectionGraph.getVersion(a_entry.sections[i]) != a_entry.versions[i])
+            return false;
+    }
+    return true;
+}
+
+PathfindingService::CachedEntry PathfindingService::makeCacheEntry(std::vector<World::SectionPos> a_sections, Path a_path) const
+{
+    CachedEntry entry{std::move(a_sections), {}, std::move(a_path)};
+    entry.versions.reserve(entry.sections.size());
+    for (const World::SectionPos &section: entry.sections)
+    {
+        entry.versions.push_back(m_sectionGraph.getVersion(section));
+    }
+    return entry;
+}
+
+bool PathfindingService::findCorridor(PathRequest &a_request)
+{
+    a_request.corridorReady = true;
+
+    if (std::abs(a_request.start.x - a_request.goal.x) > g_maxPathDistance
+        || std::abs(a_request.start.y - a_request.goal.y) > g_maxPathDistance
+        || std::abs(a_request.start.z - a_request.goal.z) > g_maxPathDistance)
+        return false;
+
+    const World::SectionPos startSection = World::SectionPos::of(a_request.start);
+    const World::SectionPos goalSection = World::SectionPos::of(a_request.goal);
+
+    std::vector<World::SectionPos> corridor;
+    if (const auto fromStart = m_corridorCache.find(startSection); fromStart != m_corridorCache.end())
+    {
+        if (const auto cached = fromStart->second.find(goalSection); cached != fromStart->second.end() && isCacheEntryValid(cached->second))
+            corridor = cached->second.sections;
+    }
+
+    if (corridor.empty())
+    {
+        struct CoarseNode
+        {
+            World::SectionPos pos;
+            // FACE_COUNT for the start section, which counts as entered from everywhere
+            uint8_t entry;
+            float cost;
+            int32_t parent;
+        };
+
+        std::vector<CoarseNode> nodes{{startSection, FACE_COUNT, 0.0f, -1}};
+        std::unordered_map<World::SectionPos, std::array<int32_t, FACE_COUNT + 1>> visited;
+        visited[startSection].fill(-1);
+        visited[startSection][FACE_COUNT] = 0;
+        std::priority_queue<std::pair<float, int32_t>, std::vector<std::pair<float, int32_t>>, std::greater<>> open;
+        open.emplace(estimateCost(startSection, goalSection), 0);
+
+        int32_t goalNode = -1;
+        for (size_t expansions = 0; !open.empty() && expansions < g_maxCoarseExpansions; expansions++)
+        {
+            const auto [estimate, index] = open.top();
+            open.pop();
+            const CoarseNode current = nodes[index];
+            if (estimate > current.cost + estimateCost(current.pos, goalSection) + 0.001f)
+                continue;
+
+            if (current.pos == goalSection)
+            {
+                goalNode = index;
+                break;
+            }
+
+            const std::optional<SectionNode> node = m_sectionGraph.getNode(current.pos);
+            if (!node.has_value())
+                continue;
+
+            for (uint8_t face = 0; face < FACE_COUNT; face++)
+            {
+                const bool canExit = current.entry == FACE_COUNT
+                                         ? node->isPassable(static_cast<Face>(face))
+                                         : node->connects(static_cast<Face>(current.entry), static_cast<Face>(face));
+                if (!canExit)
+                    continue;
+
+                const World::SectionPos neighborPos = getNeighbor(current.pos, static_cast<Face>(face));
+                const Face neighborEntry = getOpposite(static_cast<Face>(face));
+                const std::optional<SectionNode> neighbor = m_sectionGraph.getNode(neighborPos);
+                if (!neighbor.has_value() || !neighbor->isPassable(neighborEntry))
+                    continue;
+
+                const float cost = current.cost + 1.0f;
+                auto [entry, inserted] = visited.try_emplace(neighborPos);
+                if (inserted)
+                    entry->second.fill(-1);
+
+                int32_t &existing = entry->second[static_cast<size_t>(neighborEntry)];
+                if (existing >= 0 && nodes[existing].cost <= cost)
+                    continue;
+
+                existing = static_cast<int32_t>(nodes.size());
+                nodes.push_back({neighborPos, static_cast<uint8_t>(neighborEntry), cost, index});
+                open.emplace(cost + estimateCost(neighborPos, goalSection), existing);
+            }
+        }
+
+        if (goalNode < 0)
+            return false;
+
+        for (int32_t index = goalNode; index >= 0; index = nodes[index].parent)
+        {
+            corridor.push_back(nodes[index].pos);
+        }
+        std::ranges::reverse(corridor);
+
+        if (m_corridorCacheSize >= g_maxCacheEntries)
+        {
+            m_corridorCache.clear();
+            m_corridorCacheSize = 0;
+        }
+        m_corridorCache[startSection].insert_or_assign(goalSection, makeCacheEntry(corridor, {}));
+        m_corridorCacheSize++;
+    }
+
+    // Paths along the edge of a section may cut through its neighbors, so those are part of the corridor as well
+    for (const World::SectionPos &section: corridor)
+    {
+        for (int32_t x = -1; x <= 1; x++)
+            for (int32_t y = -1; y <= 1; y++)
+                for (int32_t z = -1; z <= 1; z++)
+                    a_request.corridor.insert({section.x + x, section.y + y, section.z + z});
+    }
+    a_request.corridorSections = std::move(corridor);
+
+    a_request.nodes.push_back({a_request.start, 0.0f, -1});
+    a_request.visited.emplace(a_request.start, 0);
+    a_request.closestDistance = estimateCost(a_request.start, a_request.goal);
+    a_request.open.emplace(a_request.closestDistance, 0);
+    return true;
+}
+
+bool PathfindingService::advanceFineSearch(PathRequest &a_request, const std::chrono::steady_clock::time_point a_deadline)
+{
+    auto tryAdd = [&](const World::BlockPos &a_pos, const float a_cost, const int32_t a_parent)
+    {
+        if (a_request.restrictToCorridor && !a_request.corridor.contains(World::SectionPos::of(a_pos)))
+            return;
+
+        auto [visited, inserted] = a_request.visited.try_emplace(a_pos, static_cast<int32_t>(a_request.nodes.size()));
+        if (inserted)
+        {
+            a_request.nodes.push_back({a_pos, a_cost, a_parent});
+        } else
+        {
+            FineNode &existing = a_request.nodes[visited->second];
+            if (existing.cost <= a_cost)
+                return;
+            existing.cost = a_cost;
+            existing.parent = a_parent;
+        }
+
+        const float distance = estimateCost(a_pos, a_request.goal);
+        if (distance < a_request.closestDistance)
+        {
+            a_request.closestDistance = distance;
+            a_request.closestNode = visited->second;
+        }
+        a_request.open.emplace(a_cost + distance, visited->second);
+    };
+
+    constexpr std::array<std::pair<int32_t, int32_t>, 4> horizontalSteps{{{1, 0}, {-1, 0}, {0, 1}, {0, -1}}};
+
+    while (!a_request.open.empty())
+    {
+        if (a_request.expansions % g_expansionsPerClockCheck == 0 && a_request.expansions != 0
+            && std::chrono::steady_clock::now() >= a_deadline)
+            return false;
+
+        const auto [estimate, index] = a_request.open.top();
+        a_request.open.pop();
+        const FineNode current = a_request.nodes[index];
+        if (estimate > current.cost + estimateCost(current.pos, a_request.goal) + 0.001f)
+            continue;
+
+        if (current.pos == a_request.goal)
+        {
+            a_request.closestNode = index;
+            break;
+        }
+
+        a_request.expansions++;
+        m_stats.fineExpansions++;
+        if (a_request.expansions >= g_maxFineExpansions)
+            break;
+
+        for (const auto &[stepX, stepZ]: horizontalSteps)
+        {
+            const World::BlockPos next = current.pos.offset(stepX, 0, stepZ);
+            if (isStandable(next))
+            {
+                tryAdd(next, current.cost + 1.0f, index);
+                continue;
+            }
+
+            if (isSolid(next))
+            {
+                // Jump up one block, needs room above the current position
+                if (isStandable(next.offset(0, 1, 0)) && !isSolid(current.pos.offset(0, 2, 0)))
+                    tryAdd(next.offset(0, 1, 0), current.cost + 1.5f, index);
+                continue;
+            }
+
+            // Walk off the edge & fall
+            if (isSolid(next.offset(0, 1, 0)))
+                continue;
+            for (int32_t fall = 1; fall <= g_maxFallDistance; fall++)
+            {
+                const World::BlockPos landing = next.offset(0, -fall, 0);
+                if (isSolid(landing))
+                    break;
+                if (isStandable(landing))
+                {
+                    tryAdd(landing, current.cost + 1.0f + 0.5f * static_cast<float>(fall), index);
+                    break;
+                }
+            }
+        }
+    }
+
+    if (a_request.open.empty() && a_request.restrictToCorridor
+        && a_request.nodes[a_request.closestNode].pos != a_request.goal && a_request.expansions < g_maxFineExpansions)
+    {
+        a_request.restrictToCorridor = false;
+        a_request.nodes.resize(1);
+        a_request.visited.clear();
+        a_request.visited.emplace(a_request.start, 0);
+        a_request.closestNode = 0;
+        a_request.closestDistance = estimateCost(a_request.start, a_request.goal);
+        a_request.open.emplace(a_request.closestDistance, 0);
+        return advanceFineSearch(a_request, a_deadline);
+    }
+
+    Path path;
+    path.reachesGoal = a_request.nodes[a_request.closestNode].pos == a_request.goal;
+    for (int32_t index = a_request.closestNode; index >= 0; index = a_request.nodes[index].parent)
+    {
+        path.nodes.push_back(a_request.nodes[index].pos);
+    }
+    std::ranges::reverse(path.nodes);
+    finish(a_request, std::move(path));
+    return true;
+}
+
+void PathfindingService::finish(PathRequest &a_request, Path a_path)
+{
+    m_stats.completedRequests++;
+    // Failed & partial searches aren't cached, a change anywhere they went (not only along the path) can make them
+    // succeed
+    if (!a_path.reachesGoal)
+    {
+        a_request.promise.setValue(std::move(a_path));
+        return;
+    }
+
+    std::vector<World::SectionPos> sections;
+    for (const World::BlockPos &pos: a_path.nodes)
+    {
+        // The block below decides whether a position can be stood on
+        for (const World::SectionPos section: {World::SectionPos::of(pos), World::SectionPos::of(pos.offset(0, -1, 0))})
+        {
+            if (std::ranges::find(sections, section) == sections.end())
+                sections.push_back(section);
+        }
+    }
+    // A shorter path may open up as soon as anything in the corridor changes
+    for (const World::SectionPos &section: a_request.corridorSections)
+    {
+        if (std::ranges::find(sections, section) == sections.end())
+            sections.push_back(section);
+    }
+
+    if (m_pathCacheSize >= g_maxCacheEntries)
+    {
+        m_pathCache.clear();
+        m_pathCacheSize = 0;
+    }
+    m_pathCache[a_request.start].insert_or_assign(a_request.goal, makeCacheEntry(std::move(sections), a_path));
+    m_pathCacheSize++;
+
+    a_request.promise.setValue(std::move(a_path));
+}
+
+bool PathfindingService::isSolid(const World::BlockPos &a_pos) const
+{
+    return !World::Blocks::getCollisionShape(m_world.getBlock(a_pos)).isEmpty();
+}
+
+bool PathfindingService::isStandable(const World::BlockPos &a_pos) const
+{
+    return !isSolid(a_pos) && !isSolid(a_pos.offset(0, 1, 0)) && isSolid(a_pos.offset(0, -1, 0));
+}
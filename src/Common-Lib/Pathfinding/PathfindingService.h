@@ -0,0 +1,122 @@
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Utils/TaskFuture.h"
+#include "World/BlockPos.h"
+#include "World/ChunkMap.h"
+#include "SectionGraph.h"
+
+namespace Pathfinding
+{
+    struct Path
+    {
+        // Standing positions from the start to the goal (or the closest position found), including both
+        std::vector<World::BlockPos> nodes;
+        bool reachesGoal = false;
+    };
+
+    struct PathfindingStats
+    {
+        size_t completedRequests = 0;
+        size_t cachedRequests = 0;
+        size_t pendingRequests = 0;
+        size_t fineExpansions = 0;
+    };
+
+    // Hierarchical A*: a coarse search over the SectionGraph picks a corridor of sections, the fine (per block) search
+    // only expands positions inside that corridor; targets the coarse graph can't reach are rejected without a fine search
+    // The coarse graph ignores gravity, so if the corridor is a dead end the fine search is repeated without it
+    // Requests are answered over several ticks, tick() resumes unfinished searches where they stopped
+    // Paths that reach their goal are cached until a section along them or their corridor changes, failed ones aren't
+    class PathfindingService final
+    {
+    public:
+        explicit PathfindingService(const World::ChunkMap &a_world);
+
+        [[nodiscard]]
+        Utils::TaskFuture<Path> requestPath(const World::BlockPos &a_start, const World::BlockPos &a_goal);
+
+        // Works on pending requests until a_budget is used up
+        void tick(std::chrono::nanoseconds a_budget);
+
+        // Must be called for every block change, so cached sections & paths through them are dropped
+        void onBlockChanged(const World::BlockPos &a_pos);
+
+        void onChunkChanged(World::ChunkPos a_pos);
+
+        [[nodiscard]]
+        PathfindingStats getStats() const;
+
+    private:
+        // A corridor (or path) together with the versions of the sections it was built from
+        struct CachedEntry
+        {
+            std::vector<World::SectionPos> sections;
+            std::vector<uint32_t> versions;
+            Path path;
+        };
+
+        struct FineNode
+        {
+            World::BlockPos pos;
+            float cost = 0.0f;
+            int32_t parent = -1;
+        };
+
+        struct PathRequest
+        {
+            World::BlockPos start;
+            World::BlockPos goal;
+            Utils::TaskPromise<Path> promise;
+            bool corridorReady = false;
+            // Cleared once the corridor turned out to be a dead end, the search then restarts unrestricted
+            bool restrictToCorridor = true;
+            std::unordered_set<World::SectionPos> corridor;
+            std::vector<World::SectionPos> corridorSections;
+            std::vector<FineNode> nodes;
+            std::unordered_map<World::BlockPos, int32_t> visited;
+            // (estimated total cost, node index), smallest first
+            std::priority_queue<std::pair<float, int32_t>, std::vector<std::pair<float, int32_t>>, std::greater<>> open;
+            int32_t closestNode = 0;
+            float closestDistance = 0.0f;
+            size_t expansions = 0;
+        };
+
+        const World::ChunkMap &m_world;
+        SectionGraph m_sectionGraph;
+        std::deque<std::unique_ptr<PathRequest>> m_requests;
+        // start -> goal -> entry, sections for the corridors & block positions for the fine paths
+        std::unordered_map<World::SectionPos, std::unordered_map<World::SectionPos, CachedEntry>> m_corridorCache;
+        std::unordered_map<World::BlockPos, std::unordered_map<World::BlockPos, CachedEntry>> m_pathCache;
+        size_t m_corridorCacheSize = 0;
+        size_t m_pathCacheSize = 0;
+        PathfindingStats m_stats;
+
+        [[nodiscard]]
+        bool isCacheEntryValid(const CachedEntry &a_entry) const;
+
+        [[nodiscard]]
+        CachedEntry makeCacheEntry(std::vector<World::SectionPos> a_sections, Path a_path) const;
+
+        // Coarse A* over sections, returns false if the goal section is unreachable
+        bool findCorridor(PathRequest &a_request);
+
+        // Returns true once the request is finished, false if it ran out of time
+        bool advanceFineSearch(PathRequest &a_request, std::chrono::steady_clock::time_point a_deadline);
+
+        void finish(PathRequest &a_request, Path a_path);
+
+        [[nodiscard]]
+        bool isSolid(const World::BlockPos &a_pos) const;
+
+        [[nodiscard]]
+        bool isStandable(const World::BlockPos &a_pos) const;
+    };
+}
@@ -0,0 +1,124 @@
+#include <bitset>
+
+#include "SectionGraph.h"
+
+using Pathfinding::SectionGraph, Pathfinding::SectionNode;
+
+// Every face connected to every other face, what an empty (all air) section looks like
+constexpr uint64_t g_allFacesConnected = (1ull << Pathfinding::FACE_COUNT * Pathfinding::FACE_COUNT) - 1;
+
+[[nodiscard]]
+uint8_t getTouchedFaces(const int32_t a_x, const int32_t a_y, const int32_t a_z)
+{
+    constexpr int32_t last = World::SECTION_SIZE - 1;
+    return static_cast<uint8_t>(
+        (a_y == 0) << static_cast<int>(Pathfinding::Face::Down)
+        | (a_y == last) << static_cast<int>(Pathfinding::Face::Up)
+        | (a_z == 0) << static_cast<int>(Pathfinding::Face::North)
+        | (a_z == last) << static_cast<int>(Pathfinding::Face::South)
+        | (a_x == 0) << static_cast<int>(Pathfinding::Face::West)
+        | (a_x == last) << static_cast<int>(Pathfinding::Face::East)
+    );
+}
+
+std::optional<SectionNode> SectionGraph::getNode(const World::SectionPos &a_pos)
+{
+    if (a_pos.y < World::MIN_SECTION_Y || a_pos.y >= World::MIN_SECTION_Y + World::SECTIONS_PER_CHUNK)
+        return {};
+
+    if (const auto found = m_nodes.find(a_pos); found != m_nodes.end())
+        return found->second;
+
+    const World::Chunk *chunk = m_world.getChunk(World::ChunkPos::of(a_pos));
+    if (chunk == nullptr)
+        return {};
+
+    const World::ChunkSection *section = chunk->getSection(a_pos.y);
+    const SectionNode node = section == nullptr
+                                 ? SectionNode{g_allFacesConnected, (1 << FACE_COUNT) - 1}
+                                 : buildNode(*section);
+    m_nodes.emplace(a_pos, node);
+    return node;
+}
+
+SectionNode SectionGraph::buildNode(const World::ChunkSection &a_section)
+{
+    std::bitset<World::SECTION_VOLUME> visited;
+    const auto &blocks = a_section.getBlocks();
+    for (size_t i = 0; i < blocks.size(); i++)
+    {
+        if (!World::Blocks::getCollisionShape(blocks[i]).isEmpty())
+            visited.set(i);
+    }
+
+    SectionNode node;
+    for (size_t start = 0; start < blocks.size(); start++)
+    {
+        if (visited.test(start))
+            continue;
+
+        // Flood fill one connected region of passable blocks & collect the faces it touches
+        uint8_t touchedFaces = 0;
+        visited.set(start);
+        m_floodStack.clear();
+        m_floodStack.push_back(static_cast<uint16_t>(start));
+        while (!m_floodStack.empty())
+        {
+            const uint16_t index = m_floodStack.back();
+            m_floodStack.pop_back();
+
+            const int32_t x = index & 15, z = index >> 4 & 15, y = index >> 8;
+            touchedFaces |= getTouchedFaces(x, y, z);
+
+            auto visit = [&](const int32_t a_x, const int32_t a_y, const int32_t a_z)
+            {
+                if ((a_x | a_y | a_z) & ~15)
+                    return;
+
+                const size_t neighbor = World::ChunkSection::getIndex(a_x, a_y, a_z);
+                if (!visited.test(neighbor))
+                {
+                    visited.set(neighbor);
+                    m_floodStack.push_back(static_cast<uint16_t>(neighbor));
+                }
+            };
+            visit(x - 1, y, z);
+            visit(x + 1, y, z);
+            visit(x, y - 1, z);
+            visit(x, y + 1, z);
+            visit(x, y, z - 1);
+            visit(x, y, z + 1);
+        }
+
+        node.passableFaces |= touchedFaces;
+        for (size_t from = 0; from < FACE_COUNT; from++)
+        {
+            if (touchedFaces >> from & 1)
+                node.faceConnections |= static_cast<uint64_t>(touchedFaces) << from * FACE_COUNT;
+        }
+    }
+    return node;
+}
+
+void SectionGraph::invalidate(const World::BlockPos &a_pos)
+{
+    const World::SectionPos section = World::SectionPos::of(a_pos);
+    m_nodes.erase(section);
+    m_versions[section]++;
+}
+
+void SectionGraph::invalidateChunk(const World::ChunkPos a_pos)
+{
+    for (int32_t y = World::MIN_SECTION_Y; y < World::MIN_SECTION_Y + World::SECTIONS_PER_CHUNK; y++)
+    {
+        const World::SectionPos section{a_pos.x, y, a_pos.z};
+        m_nodes.erase(section);
+        m_versions[section]++;
+    }
+}
+
+uint32_t SectionGraph::getVersion(const World::SectionPos &a_pos) const
+{
+    const auto found = m_versions.find(a_pos);
+    return found == m_versions.end() ? 0 : found->second;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "World/BlockPos.h"
+#include "World/ChunkMap.h"
+
+namespace Pathfinding
+{
+    using World::Face, World::FACE_COUNT, World::getOpposite, World::getNeighbor;
+
+    // Which faces of a section are connected to each other through blocks without collision
+    struct SectionNode
+    {
+        // Bit (from * FACE_COUNT + to) is set if a mob could get from face `from` to face `to`
+        uint64_t faceConnections = 0;
+        // Bit n is set if face n has at least one passable block
+        uint8_t passableFaces = 0;
+
+        [[nodiscard]]
+        bool connects(const Face a_from, const Face a_to) const
+        {
+            return faceConnections >> (static_cast<size_t>(a_from) * FACE_COUNT + static_cast<size_t>(a_to)) & 1;
+        }
+
+        [[nodiscard]]
+        bool isPassable(const Face a_face) const
+        {
+            return passableFaces >> static_cast<size_t>(a_face) & 1;
+        }
+    };
+
+    // Coarse connectivity of the world, one node per section, built lazily & dropped when a block in the section changes
+    class SectionGraph final
+    {
+    public:
+        explicit SectionGraph(const World::ChunkMap &a_world)
+            : m_world(a_world) {}
+
+        // nullopt if the section isn't loaded (or outside the world), unloaded sections are never walkable
+        [[nodiscard]]
+        std::optional<SectionNode> getNode(const World::SectionPos &a_pos);
+
+        void invalidate(const World::BlockPos &a_pos);
+
+        void invalidateChunk(World::ChunkPos a_pos);
+
+        // Increased every time a section is invalidated, cached paths remember the versions they were built with
+        [[nodiscard]]
+        uint32_t getVersion(const World::SectionPos &a_pos) const;
+
+        [[nodiscard]]
+        size_t getCachedNodeCount() const
+        {
+            return m_nodes.size();
+        }
+
+    private:
+        const World::ChunkMap &m_world;
+        std::unordered_map<World::SectionPos, SectionNode> m_nodes;
+        std::unordered_map<World::SectionPos, uint32_t> m_versions;
+        // Flood fill scratch, kept to avoid allocating for every section
+        std::vector<uint16_t> m_floodStack;
+
+        [[nodiscard]]
+        SectionNode buildNode(const World::ChunkSection &a_section);
+    };
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "glm/vec3.hpp"
+
+#include "Utils/Aabb.h"
+
+namespace Physics
+{
+    // Position of the entity's feet (bottom center of its collision box)
+    struct Position
+    {
+        glm::dvec3 value{0.0};
+    };
+
+    // Degrees, where the entity is looking; the physics step doesn't use it
+    struct Rotation
+    {
+        float yaw = 0.0f;
+        float pitch = 0.0f;
+    };
+
+    struct RigidBody
+    {
+        glm::dvec3 velocity{0.0};
+        // Blocks per tick²
+        double gravity = 0.08;
+        // Fraction of the velocity lost every tick
+        double drag = 0.02;
+        // Extra horizontal velocity loss while standing on something
+        double groundFriction = 0.4;
+        bool onGround = false;
+        bool horizontalCollision = false;
+    };
+
+    struct Collider
+    {
+        double halfWidth = 0.3;
+        double height = 1.8;
+
+        [[nodiscard]]
+        Utils::Aabb getBox(const glm::dvec3 &a_position) const
+        {
+            return {
+                {a_position.x - halfWidth, a_position.y, a_position.z - halfWidth},
+                {a_position.x + halfWidth, a_position.y + height, a_position.z + halfWidth}
+            };
+        }
+    };
+}
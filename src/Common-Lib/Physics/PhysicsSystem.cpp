@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <cmath>
+
+#include "PhysicsSystem.h"
+
+using Physics::PhysicsSystem, Physics::CollisionShapeBatch, Physics::PhysicsStepStats;
+
+// Boxes closer than this are considered touching, keeps entities from getting stuck on rounding errors
+constexpr double g_collisionEpsilon = 1.0E-7;
+// Entities resting on the ground with less velocity than this only check that they're still supported
+constexpr double g_restingVelocitySquared = 1.0E-12;
+
+void CollisionShapeBatch::clear()
+{
+    for (int axis = 0; axis < 3; axis++)
+    {
+        m_min[axis].clear();
+        m_max[axis].clear();
+    }
+}
+
+void CollisionShapeBatch::add(const Utils::Aabb &a_box)
+{
+    for (int axis = 0; axis < 3; axis++)
+    {
+        m_min[axis].push_back(a_box.min[axis]);
+        m_max[axis].push_back(a_box.max[axis]);
+    }
+}
+
+void CollisionShapeBatch::gather(const World::ChunkMap &a_world, const Utils::Aabb &a_region)
+{
+    clear();
+
+    const World::BlockPos from = World::BlockPos::containing(a_region.min);
+    const World::BlockPos to = World::BlockPos::containing(a_region.max);
+    const int32_t minY = std::max(from.y, World::MIN_BLOCK_Y);
+    const int32_t maxY = std::min(to.y, World::MAX_BLOCK_Y);
+
+    for (int32_t x = from.x; x <= to.x; x++)
+    {
+        for (int32_t z = from.z; z <= to.z; z++)
+        {
+            const World::Chunk *chunk = a_world.getChunk({World::blockToSection(x), World::blockToSection(z)});
+            for (int32_t y = minY; y <= maxY; y++)
+            {
+                const glm::dvec3 origin(x, y, z);
+                if (chunk == nullptr)
+                {
+                    add(World::FULL_CUBE_SHAPE.boxes.front().offset(origin));
+                    continue;
+                }
+
+                const World::ChunkSection *section = chunk->getSection(World::blockToSection(y));
+                if (section == nullptr)
+                {
+                    // Skip the rest of the empty section
+                    y |= World::SECTION_SIZE - 1;
+                    continue;
+                }
+
+                const World::BlockStateId state = section->getBlock(World::blockToLocal(x), World::blockToLocal(y), World::blockToLocal(z));
+                for (const Utils::Aabb &box: World::Blocks::getCollisionShape(state).boxes)
+                {
+                    add(box.offset(origin));
+                }
+            }
+        }
+    }
+}
+
+void CollisionShapeBatch::retainIntersecting(const Utils::Aabb &a_region)
+{
+    const size_t count = size();
+    m_keep.resize(count);
+
+    // Branch free so the compiler can turn it into packed compares
+    const double *minX = m_min[0].data(), *minY = m_min[1].data(), *minZ = m_min[2].data();
+    const double *maxX = m_max[0].data(), *maxY = m_max[1].data(), *maxZ = m_max[2].data();
+    uint8_t *keep = m_keep.data();
+    for (size_t i = 0; i < count; i++)
+    {
+        keep[i] = static_cast<uint8_t>((minX[i] < a_region.max.x) & (maxX[i] > a_region.min.x)
+                                       & (minY[i] < a_region.max.y) & (maxY[i] > a_region.min.y)
+                                       & (minZ[i] < a_region.max.z) & (maxZ[i] > a_region.min.z));
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!keep[i])
+            continue;
+
+        for (int axis = 0; axis < 3; axis++)
+        {
+            m_min[axis][kept] = m_min[axis][i];
+            m_max[axis][kept] = m_max[axis][i];
+        }
+        kept++;
+    }
+
+    for (int axis = 0; axis < 3; axis++)
+    {
+        m_min[axis].resize(kept);
+        m_max[axis].resize(kept);
+    }
+}
+
+double CollisionShapeBatch::clipMovement(const Utils::Aabb &a_box, const int a_axis, const double a_movement) const
+{
+    if (std::abs(a_movement) < g_collisionEpsilon)
+        return a_movement;
+
+    const int axis1 = (a_axis + 1) % 3;
+    const int axis2 = (a_axis + 2) % 3;
+    const double *min = m_min[a_axis].data(), *max = m_max[a_axis].data();
+    const double *min1 = m_min[axis1].data(), *max1 = m_max[axis1].data();
+    const double *min2 = m_min[axis2].data(), *max2 = m_max[axis2].data();
+
+    double movement = a_movement;
+    for (size_t i = 0; i < size(); i++)
+    {
+        const bool overlaps = min1[i] < a_box.max[axis1] - g_collisionEpsilon && max1[i] > a_box.min[axis1] + g_collisionEpsilon
+                              && min2[i] < a_box.max[axis2] - g_collisionEpsilon && max2[i] > a_box.min[axis2] + g_collisionEpsilon;
+        if (!overlaps)
+            continue;
+
+        if (a_movement > 0.0)
+        {
+            if (const double gap = min[i] - a_box.max[a_axis]; gap >= -g_collisionEpsilon)
+                movement = std::min(movement, gap);
+        } else
+        {
+            if (const double gap = max[i] - a_box.min[a_axis]; gap <= g_collisionEpsilon)
+                movement = std::max(movement, gap);
+        }
+    }
+    return movement;
+}
+
+glm::dvec3 PhysicsSystem::collide(const World::ChunkMap &a_world, const Utils::Aabb &a_box, const glm::dvec3 &a_movement,
+                                  CollisionShapeBatch &a_scratch)
+{
+    // Gather once for the whole sweep, then throw away everything the sweep can't reach
+    const Utils::Aabb swept = a_box.expandTowards(a_movement);
+    a_scratch.gather(a_world, swept);
+    a_scratch.retainIntersecting(swept);
+    if (a_scratch.size() == 0)
+        return a_movement;
+
+    // Vertical first, then the larger horizontal axis, same order as vanilla
+    glm::dvec3 movement(0.0);
+    Utils::Aabb box = a_box;
+
+    movement.y = a_scratch.clipMovement(box, 1, a_movement.y);
+    box = box.offset({0.0, movement.y, 0.0});
+
+    const bool zFirst = std::abs(a_movement.z) > std::abs(a_movement.x);
+    const int horizontalAxes[2] = {zFirst ? 2 : 0, zFirst ? 0 : 2};
+    for (const int axis: horizontalAxes)
+    {
+        movement[axis] = a_scratch.clipMovement(box, axis, a_movement[axis]);
+        glm::dvec3 offset(0.0);
+        offset[axis] = movement[axis];
+        box = box.offset(offset);
+    }
+
+    return movement;
+}
+
+PhysicsStepStats PhysicsSystem::step(const World::ChunkMap &a_world, const Ecs::Registry &a_registry, Utils::JobSystem &a_jobSystem)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    m_threadScratch.resize(a_jobSystem.getThreadCount());
+    for (ThreadScratch &scratch: m_threadScratch)
+    {
+        scratch.movedEntities = 0;
+        scratch.collisionCandidates = 0;
+    }
+
+    m_query.parallelForEach(a_registry, a_jobSystem, [&](Ecs::EntityId, Position &a_position, RigidBody &a_body, const Collider &a_collider)
+    {
+        ThreadScratch &scratch = m_threadScratch[Utils::JobSystem::getCurrentThreadIndex()];
+
+        glm::dvec3 velocity = a_body.velocity;
+        velocity.y -= a_body.gravity;
+        if (a_body.onGround && velocity.x * velocity.x + velocity.z * velocity.z < g_restingVelocitySquared)
+        {
+            // Resting on the ground, only probe one step down for whatever supports it, it falls if that was removed
+            const glm::dvec3 fall(0.0, std::min(velocity.y, 0.0), 0.0);
+            const bool supported = fall.y == 0.0 || collide(a_world, a_collider.getBox(a_position.value), fall, scratch.shapes).y != fall.y;
+            if (supported)
+            {
+                a_body.velocity = glm::dvec3(0.0);
+                return;
+            }
+        }
+
+        const glm::dvec3 movement = collide(a_world, a_collider.getBox(a_position.value), velocity, scratch.shapes);
+        scratch.movedEntities++;
+        scratch.collisionCandidates += scratch.shapes.size();
+
+        a_position.value += movement;
+
+        const bool collidedX = movement.x != velocity.x;
+        const bool collidedY = movement.y != velocity.y;
+        const bool collidedZ = movement.z != velocity.z;
+        a_body.onGround = collidedY && velocity.y < 0.0;
+        a_body.horizontalCollision = collidedX || collidedZ;
+
+        if (collidedX)
+            velocity.x = 0.0;
+        if (collidedY)
+            velocity.y = 0.0;
+        if (collidedZ)
+            velocity.z = 0.0;
+
+        velocity *= 1.0 - a_body.drag;
+        if (a_body.onGround)
+        {
+            velocity.x *= 1.0 - a_body.groundFriction;
+            velocity.z *= 1.0 - a_body.groundFriction;
+        }
+        a_body.velocity = velocity;
+    });
+
+    PhysicsStepStats stats;
+    for (const ThreadScratch &scratch: m_threadScratch)
+    {
+        stats.movedEntities += scratch.movedEntities;
+        stats.collisionCandidates += scratch.collisionCandidates;
+    }
+    stats.duration = std::chrono::steady_clock::now() - start;
+
+    m_lastStepStats = stats;
+    return stats;
+}
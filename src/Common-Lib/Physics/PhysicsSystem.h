@@ -0,0 +1,85 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+#include "glm/vec3.hpp"
+
+#include "Ecs/Query.h"
+#include "Ecs/Registry.h"
+#include "Utils/Aabb.h"
+#include "Utils/JobSystem.h"
+#include "World/ChunkMap.h"
+#include "PhysicsComponents.h"
+
+namespace Physics
+{
+    struct PhysicsStepStats
+    {
+        std::chrono::nanoseconds duration{0};
+        size_t movedEntities = 0;
+        // Block collision boxes that survived the broad phase, summed over all entities
+        size_t collisionCandidates = 0;
+    };
+
+    // Block collision boxes near one entity, as separate arrays per bound so the clipping loops vectorize
+    class CollisionShapeBatch final
+    {
+    public:
+        void clear();
+
+        void add(const Utils::Aabb &a_box);
+
+        // Gathers the collision boxes of every block a_region touches, unloaded chunks count as solid
+        void gather(const World::ChunkMap &a_world, const Utils::Aabb &a_region);
+
+        // Drops every box that doesn't intersect a_region
+        void retainIntersecting(const Utils::Aabb &a_region);
+
+        // Swept AABB clipping: how far a_box can move along a_axis (up to a_movement) before it hits a box
+        [[nodiscard]]
+        double clipMovement(const Utils::Aabb &a_box, int a_axis, double a_movement) const;
+
+        [[nodiscard]]
+        size_t size() const
+        {
+            return m_min[0].size();
+        }
+
+    private:
+        std::vector<double> m_min[3];
+        std::vector<double> m_max[3];
+        std::vector<uint8_t> m_keep;
+    };
+
+    // Moves every entity with a Position, RigidBody & Collider & resolves collisions against blocks
+    // Entities are processed in parallel, one archetype chunk per job
+    class PhysicsSystem final
+    {
+    public:
+        PhysicsStepStats step(const World::ChunkMap &a_world, const Ecs::Registry &a_registry, Utils::JobSystem &a_jobSystem);
+
+        [[nodiscard]]
+        const PhysicsStepStats &getLastStepStats() const
+        {
+            return m_lastStepStats;
+        }
+
+        // Resolves a_movement of a_box against a_world, returns the movement that is actually possible
+        [[nodiscard]]
+        static glm::dvec3 collide(const World::ChunkMap &a_world, const Utils::Aabb &a_box, const glm::dvec3 &a_movement,
+                                  CollisionShapeBatch &a_scratch);
+
+    private:
+        struct alignas(64) ThreadScratch
+        {
+            CollisionShapeBatch shapes;
+            size_t movedEntities = 0;
+            size_t collisionCandidates = 0;
+        };
+
+        Ecs::Query<Position, RigidBody, const Collider> m_query;
+        std::vector<ThreadScratch> m_threadScratch;
+        PhysicsStepStats m_lastStepStats;
+    };
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <algorithm>
+
+#include "glm/vec3.hpp"
+
+namespace Utils
+{
+    // Axis aligned bounding box in world space
+    struct Aabb
+    {
+        glm::dvec3 min{0.0};
+        glm::dvec3 max{0.0};
+
+        [[nodiscard]]
+        static constexpr Aabb fromCenter(const glm::dvec3 &a_center, const glm::dvec3 &a_halfExtents)
+        {
+            return {a_center - a_halfExtents, a_center + a_halfExtents};
+        }
+
+        [[nodiscard]]
+        constexpr glm::dvec3 getCenter() const
+        {
+            return (min + max) * 0.5;
+        }
+
+        [[nodiscard]]
+        constexpr glm::dvec3 getHalfExtents() const
+        {
+            return (max - min) * 0.5;
+        }
+
+        [[nodiscard]]
+        constexpr Aabb offset(const glm::dvec3 &a_offset) const
+        {
+            return {min + a_offset, max + a_offset};
+        }
+
+        [[nodiscard]]
+        constexpr Aabb inflate(const double a_amount) const
+        {
+            return {min - glm::dvec3(a_amount), max + glm::dvec3(a_amount)};
+        }
+
+        // Grows the box in the direction of a_movement, covers everything the box touches while moving
+        [[nodiscard]]
+        constexpr Aabb expandTowards(const glm::dvec3 &a_movement) const
+        {
+            Aabb result = *this;
+            for (int axis = 0; axis < 3; axis++)
+            {
+                if (a_movement[axis] < 0)
+                    result.min[axis] += a_movement[axis];
+                else
+                    result.max[axis] += a_movement[axis];
+            }
+            return result;
+        }
+
+        // Touching boxes do not intersect
+        [[nodiscard]]
+        constexpr bool intersects(const Aabb &a_other) const
+        {
+            return min.x < a_other.max.x && max.x > a_other.min.x
+                   && min.y < a_other.max.y && max.y > a_other.min.y
+                   && min.z < a_other.max.z && max.z > a_other.min.z;
+        }
+
+        [[nodiscard]]
+        constexpr bool contains(const glm::dvec3 &a_point) const
+        {
+            return a_point.x >= min.x && a_point.x <= max.x
+                   && a_point.y >= min.y && a_point.y <= max.y
+                   && a_point.z >= min.z && a_point.z <= max.z;
+        }
+
+        [[nodiscard]]
+        constexpr double distanceSquaredTo(const glm::dvec3 &a_point) const
+        {
+            double distanceSquared = 0.0;
+            for (int axis = 0; axis < 3; axis++)
+            {
+                const double delta = std::max({min[axis] - a_point[axis], 0.0, a_point[axis] - max[axis]});
+                distanceSquared += delta * delta;
+            }
+            return distanceSquared;
+        }
+
+        // Slab test, returns the distance along a_direction (in multiples of it) at which the ray enters the box,
+        // 0 if it starts inside, or a negative value if it misses within [0, a_maxDistance]
+        [[nodiscard]]
+        constexpr double intersectRay(const glm::dvec3 &a_origin, const glm::dvec3 &a_inverseDirection, const double a_maxDistance) const
+        {
+            double near = 0.0;
+            double far = a_maxDistance;
+            for (int axis = 0; axis < 3; axis++)
+            {
+                double t0 = (min[axis] - a_origin[axis]) * a_inverseDirection[axis];
+                double t1 = (max[axis] - a_origin[axis]) * a_inverseDirection[axis];
+                if (t0 > t1)
+                    std::swap(t0, t1);
+
+                // NaN (0 * inf, ray parallel to & inside of the slab) must not reject the hit, hence the inverted checks
+                near = t0 > near ? t0 : near;
+                far = t1 < far ? t1 : far;
+                if (near > far)
+                    return -1.0;
+            }
+            return near;
+        }
+    };
+}
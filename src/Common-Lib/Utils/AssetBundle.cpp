@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+
+#include "AssetBundle.h"
+
+using Utils::AssetBundle;
+using Utils::AssetBundleWriter;
+
+// The bundle is used as it's mapped
+static_assert(std::endian::native == std::endian::little, "Asset bundles are little endian");
+static_assert(sizeof(AssetBundle::Header) == 32 && sizeof(AssetBundle::Entry) == 32);
+
+AssetBundle::AssetBundle(const std::filesystem::path &a_path)
+    : m_file(a_path)
+{
+    const std::span<const std::byte> data = m_file.getData();
+    Header header{};
+    if (data.size() < sizeof(Header))
+        throw std::runtime_error(std::format("Asset bundle {} is truncated", a_path.string()));
+    std::memcpy(&header, data.data(), sizeof(Header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+        throw std::runtime_error(std::format("{} isn't an asset bundle", a_path.string()));
+    if (header.version != VERSION)
+        throw std::runtime_error(std::format("Asset bundle {} has version {}, expected {}", a_path.string(), header.version, VERSION));
+
+    // Everything is checked once here, lookups don't have to
+    const uint64_t indexEnd = sizeof(Header) + static_cast<uint64_t>(header.entryCount) * sizeof(Entry);
+    if (indexEnd > data.size() || header.namesOffset < indexEnd || header.namesOffset > data.size()
+        || header.namesSize > data.size() - header.namesOffset)
+        throw std::runtime_error(std::format("Asset bundle {} is truncated", a_path.string()));
+
+    m_entries = {reinterpret_cast<const Entry *>(data.data() + sizeof(Header)), header.entryCount};
+    m_names = {reinterpret_cast<const char *>(data.data() + header.namesOffset), header.namesSize};
+    for (size_t i = 0; i < m_entries.size(); i++)
+    {
+        const Entry &entry = m_entries[i];
+        if (entry.offset > data.size() || entry.size > data.size() - entry.offset
+            || static_cast<uint64_t>(entry.nameOffset) + entry.nameSize > m_names.size()
+            || i > 0 && m_entries[i - 1].hash > entry.hash)
+            throw std::runtime_error(std::format("Asset bundle {} has an invalid entry {}", a_path.string(), i));
+    }
+}
+
+uint64_t AssetBundle::getHash(const std::string_view a_identifier)
+{
+    uint64_t hash = 0xCBF29CE484222325;
+    for (const char character: a_identifier)
+    {
+        hash = (hash ^ static_cast<uint8_t>(character)) * 0x100000001B3;
+    }
+    return hash;
+}
+
+std::optional<std::span<const std::byte>> AssetBundle::find(const Identifier &a_identifier) const
+{
+    return find(a_identifier.toString());
+}
+
+std::optional<std::span<const std::byte>> AssetBundle::find(const std::string_view a_identifier) const
+{
+    const uint64_t hash = getHash(a_identifier);
+    for (auto entry = std::ranges::lower_bound(m_entries, hash, {}, &Entry::hash);
+         entry != m_entries.end() && entry->hash == hash; ++entry)
+    {
+        if (m_names.substr(entry->nameOffset, entry->nameSize) == a_identifier)
+            return m_file.getData().subspan(entry->offset, entry->size);
+    }
+    return std::nullopt;
+}
+
+std::string_view AssetBundle::getName(const size_t a_index) const
+{
+    return m_names.substr(m_entries[a_index].nameOffset, m_entries[a_index].nameSize);
+}
+
+void AssetBundleWriter::add(const Identifier &a_identifier, const std::span<const std::byte> a_data)
+{
+    m_entries[a_identifier.toString()].assign(a_data.begin(), a_data.end());
+}
+
+void AssetBundleWriter::write(const std::filesystem::path &a_path) const
+{
+    using Entry = AssetBundle::Entry;
+
+    std::vector<std::pair<uint64_t, const std::string *>> order;
+    for (const auto &[name, data]: m_entries)
+    {
+        order.emplace_back(AssetBundle::getHash(name), &name);
+    }
+    std::ranges::sort(order, [](const auto &a_first, const auto &a_second)
+    {
+        return a_first.first != a_second.first ? a_first.first < a_second.first : *a_first.second < *a_second.second;
+    });
+
+    AssetBundle::Header header{};
+    std::memcpy(header.magic, AssetBundle::MAGIC, sizeof(header.magic));
+    header.version = AssetBundle::VERSION;
+    header.entryCount = static_cast<uint32_t>(order.size());
+    header.namesOffset = sizeof(AssetBundle::Header) + order.size() * sizeof(Entry);
+
+    std::vector<Entry> entries;
+    std::string names;
+    for (const auto &[hash, name]: order)
+    {
+        entries.push_back({hash, 0, m_entries.at(*name).size(), static_cast<uint32_t>(names.size()), static_cast<uint32_t>(name->size())});
+        names += *name;
+    }
+    header.namesSize = names.size();
+
+    uint64_t offset = header.namesOffset + header.namesSize;
+    for (Entry &entry: entries)
+    {
+        offset = (offset + AssetBundle::BLOB_ALIGNMENT - 1) / AssetBundle::BLOB_ALIGNMENT * AssetBundle::BLOB_ALIGNMENT;
+        entry.offset = offset;
+        offset += entry.size;
+    }
+
+    std::ofstream stream(a_path, std::ios::binary | std::ios::trunc);
+    stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    stream.write(reinterpret_cast<const char *>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(Entry)));
+    stream.write(names.data(), static_cast<std::streamsize>(names.size()));
+    constexpr char padding[AssetBundle::BLOB_ALIGNMENT] = {};
+    uint64_t position = header.namesOffset + header.namesSize;
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        stream.write(padding, static_cast<std::streamsize>(entries[i].offset - position));
+        const std::vector<std::byte> &data = m_entries.at(*order[i].second);
+        stream.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+        position = entries[i].offset + entries[i].size;
+    }
+    if (!stream)
+        throw std::runtime_error(std::format("Failed to write asset bundle {}", a_path.string()));
+}
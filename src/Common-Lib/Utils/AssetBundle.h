@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Identifier.h"
+#include "MappedFile.h"
+
+namespace Utils
+{
+    // Many assets packed into one file that's mapped as a whole, so loading them is one open & mmap instead of one per
+    // asset & their data is used right from the mapping without copying it
+    // Layout, little endian: a Header, the index of all entries sorted by the hash of their identifier, then the
+    // identifiers one after the other (namespace:path, without terminators), then the data of every entry, each aligned
+    // to BLOB_ALIGNMENT
+    // Throws std::runtime_error (or std::system_error) if the file can't be opened or isn't a valid bundle
+    class AssetBundle final
+    {
+    public:
+        static constexpr char MAGIC[8] = {'M', 'C', 'p', 'p', 'P', 'a', 'c', 'k'};
+        static constexpr uint32_t VERSION = 1;
+        // Enough for SIMD loads & for uploading texture data straight from the mapping
+        static constexpr size_t BLOB_ALIGNMENT = 64;
+
+        struct Header
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t entryCount;
+            // Of the identifiers, from the start of the file
+            uint64_t namesOffset;
+            uint64_t namesSize;
+        };
+
+        struct Entry
+        {
+            // getHash() of the identifier
+            uint64_t hash;
+            // Of the data, from the start of the file
+            uint64_t offset;
+            uint64_t size;
+            // Of the identifier, from namesOffset
+            uint32_t nameOffset;
+            uint32_t nameSize;
+        };
+
+        explicit AssetBundle(const std::filesystem::path &a_path);
+
+        // FNV-1a of the identifier's string form
+        [[nodiscard]]
+        static uint64_t getHash(std::string_view a_identifier);
+
+        // A view into the mapping, nullopt if the bundle doesn't contain the identifier
+        [[nodiscard]]
+        std::optional<std::span<const std::byte>> find(const Identifier &a_identifier) const;
+
+        [[nodiscard]]
+        std::optional<std::span<const std::byte>> find(std::string_view a_identifier) const;
+
+        [[nodiscard]]
+        size_t getEntryCount() const
+        {
+            return m_entries.size();
+        }
+
+        // The identifier of entry a_index as namespace:path, a view into the mapping
+        [[nodiscard]]
+        std::string_view getName(size_t a_index) const;
+
+    private:
+        MappedFile m_file;
+        std::span<const Entry> m_entries;
+        std::string_view m_names;
+    };
+
+    // Collects assets & writes them as an AssetBundle
+    class AssetBundleWriter final
+    {
+    public:
+        // Replaces what was added for the identifier before
+        void add(const Identifier &a_identifier, std::span<const std::byte> a_data);
+
+        [[nodiscard]]
+        size_t getEntryCount() const
+        {
+            return m_entries.size();
+        }
+
+        // Throws std::runtime_error if the file can't be written
+        void write(const std::filesystem::path &a_path) const;
+
+    private:
+        // By identifier as namespace:path
+        std::unordered_map<std::string, std::vector<std::byte>> m_entries;
+    };
+}
@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <exception>
+#include <system_error>
+#include <vector>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "DirectoryWatcher.h"
+
+using Utils::DirectoryWatcher;
+
+#if defined(__linux__)
+// Directories are watched for being created too, so new ones get watched as well
+constexpr uint32_t g_watchMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR;
+
+DirectoryWatcher::DirectoryWatcher(const std::span<const std::filesystem::path> a_directories, Callback &&a_onChange)
+    : m_onChange(std::move(a_onChange))
+{
+    m_inotify = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotify < 0)
+        throw std::system_error(errno, std::generic_category(), "Failed to initialize inotify");
+
+    m_stop = ::eventfd(0, EFD_CLOEXEC);
+    if (m_stop < 0)
+    {
+        const int error = errno;
+        ::close(m_inotify);
+        throw std::system_error(error, std::generic_category(), "Failed to create an eventfd");
+    }
+
+    try
+    {
+        for (const std::filesystem::path &directory: a_directories)
+        {
+            addDirectory(directory);
+        }
+    } catch (...)
+    {
+        ::close(m_stop);
+        ::close(m_inotify);
+        throw;
+    }
+
+    m_thread = std::thread(&DirectoryWatcher::run, this);
+}
+
+DirectoryWatcher::~DirectoryWatcher()
+{
+    constexpr uint64_t value = 1;
+    [[maybe_unused]] const ssize_t written = ::write(m_stop, &value, sizeof(value));
+    m_thread.join();
+
+    ::close(m_stop);
+    ::close(m_inotify);
+}
+
+void DirectoryWatcher::addDirectory(const std::filesystem::path &a_directory)
+{
+    const int watch = ::inotify_add_watch(m_inotify, a_directory.c_str(), g_watchMask);
+    if (watch < 0)
+        throw std::system_error(errno, std::generic_category(), "Failed to watch " + a_directory.string());
+    m_directories[watch] = a_directory;
+
+    std::error_code error;
+    for (const std::filesystem::directory_entry &entry: std::filesystem::directory_iterator(a_directory, error))
+    {
+        if (entry.is_directory(error))
+            addDirectory(entry.path());
+    }
+}
+
+void DirectoryWatcher::run()
+{
+    std::vector<std::filesystem::path> changed;
+    alignas(inotify_event) char buffer[4096];
+
+    const auto addChanged = [&changed](const std::filesystem::path &a_path)
+    {
+        if (std::ranges::find(changed, a_path) == changed.end())
+            changed.push_back(a_path);
+    };
+
+    while (true)
+    {
+        pollfd descriptors[] = {{m_inotify, POLLIN, 0}, {m_stop, POLLIN, 0}};
+        const int ready = ::poll(descriptors, std::size(descriptors), changed.empty() ? -1 : static_cast<int>(DEBOUNCE_TIME.count()));
+        if (ready < 0 && errno != EINTR || descriptors[1].revents != 0)
+            return;
+
+        // Nothing changed for DEBOUNCE_TIME
+        if (ready == 0)
+        {
+            m_onChange(changed);
+            changed.clear();
+            continue;
+        }
+
+        const ssize_t length = ::read(m_inotify, buffer, sizeof(buffer));
+        for (ssize_t offset = 0; offset < length;)
+        {
+            const auto *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            const auto directory = m_directories.find(event->wd);
+            if (event->mask & IN_IGNORED)
+            {
+                if (directory != m_directories.end())
+                    m_directories.erase(directory);
+                continue;
+            }
+            if (directory == m_directories.end() || event->len == 0)
+                continue;
+
+            const std::filesystem::path path = directory->second / event->name;
+            if (event->mask & IN_ISDIR)
+            {
+                // Files may have been put into it before it was watched
+                try
+                {
+                    addDirectory(path);
+                    for (const std::filesystem::directory_entry &entry: std::filesystem::recursive_directory_iterator(path))
+                    {
+                        if (entry.is_regular_file())
+                            addChanged(entry.path());
+                    }
+                } catch (const std::exception &)
+                {
+                    // It was removed again already
+                }
+            } else if (!(event->mask & IN_CREATE))
+            {
+                // Files are reported once they're written (or moved here), not when they're created empty
+                addChanged(path);
+            }
+        }
+    }
+}
+#else
+DirectoryWatcher::DirectoryWatcher(const std::span<const std::filesystem::path> a_directories, Callback &&a_onChange)
+{
+    throw std::system_error(std::make_error_code(std::errc::function_not_supported), "Watching directories is only supported on Linux");
+}
+
+DirectoryWatcher::~DirectoryWatcher() = default;
+
+void DirectoryWatcher::addDirectory(const std::filesystem::path &a_directory)
+{
+}
+
+void DirectoryWatcher::run()
+{
+}
+#endif
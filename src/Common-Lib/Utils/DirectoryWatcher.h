@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <span>
+#include <thread>
+#include <unordered_map>
+
+#include "UniqueFunction.h"
+
+namespace Utils
+{
+    // Watches directory trees (with inotify) for files that are written, created or moved into them, on a thread of its own
+    // Changes are collected until none came for DEBOUNCE_TIME, as editors often save a file in several steps, then
+    // a_onChange is called on the watcher thread with every file that changed
+    // Only supported on Linux, throws std::system_error elsewhere or if a directory can't be watched
+    class DirectoryWatcher final
+    {
+    public:
+        using Callback = UniqueFunction<void(std::span<const std::filesystem::path>)>;
+
+        static constexpr std::chrono::milliseconds DEBOUNCE_TIME{100};
+
+        DirectoryWatcher(std::span<const std::filesystem::path> a_directories, Callback &&a_onChange);
+
+        DirectoryWatcher(const DirectoryWatcher &) = delete;
+
+        DirectoryWatcher &operator=(const DirectoryWatcher &) = delete;
+
+        // Waits for a_onChange to return if it's running
+        ~DirectoryWatcher();
+
+    private:
+        int m_inotify = -1;
+        // Written to wake the watcher thread up when it should stop
+        int m_stop = -1;
+        // By watch descriptor, only touched by the watcher thread once it's started
+        std::unordered_map<int, std::filesystem::path> m_directories;
+        Callback m_onChange;
+        std::thread m_thread;
+
+        // Watches a_directory & every directory in it
+        void addDirectory(const std::filesystem::path &a_directory);
+
+        void run();
+    };
+}
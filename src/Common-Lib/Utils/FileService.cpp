@@ -0,0 +1,129 @@
+#include <system_error>
+
+#if !defined(ASIO_HAS_FILE)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "FileService.h"
+
+using Utils::FileService;
+
+#if defined(ASIO_HAS_FILE)
+asio::file_base::flags getOpenFlags(const FileService::File::Mode a_mode)
+{
+    if (a_mode == FileService::File::Mode::Read)
+        return asio::file_base::read_only;
+    return asio::file_base::read_write | asio::file_base::create;
+}
+#endif
+
+FileService::File::File(FileService &a_service, const std::filesystem::path &a_path, const Mode a_mode)
+    : m_service(a_service),
+#if defined(ASIO_HAS_FILE)
+      m_file(a_service.getContext(), a_path.string(), getOpenFlags(a_mode))
+{
+}
+#else
+      m_descriptor(::open(a_path.c_str(), a_mode == Mode::Read ? O_RDONLY | O_CLOEXEC : O_RDWR | O_CREAT | O_CLOEXEC, 0644))
+{
+    if (m_descriptor < 0)
+        throw std::system_error(errno, std::generic_category(), "Failed to open " + a_path.string());
+}
+#endif
+
+FileService::File::~File()
+{
+#if !defined(ASIO_HAS_FILE)
+    ::close(m_descriptor);
+#endif
+}
+
+uint64_t FileService::File::getSize() const
+{
+#if defined(ASIO_HAS_FILE)
+    return m_file.size();
+#else
+    struct stat status{};
+    if (::fstat(m_descriptor, &status) != 0)
+        throw std::system_error(errno, std::generic_category(), "Failed to get the size of a file");
+    return static_cast<uint64_t>(status.st_size);
+#endif
+}
+
+asio::awaitable<size_t> FileService::File::read(const uint64_t a_offset, const std::span<std::byte> a_buffer)
+{
+    size_t total = 0;
+#if defined(ASIO_HAS_FILE)
+    while (total < a_buffer.size())
+    {
+        const auto [error, bytes] = co_await m_file.async_read_some_at(a_offset + total, asio::buffer(a_buffer.subspan(total)), asio::as_tuple(asio::use_awaitable));
+        if (error == asio::error::eof)
+            break;
+        if (error)
+            throw std::system_error(error, "Failed to read a file");
+        total += bytes;
+    }
+#else
+    while (total < a_buffer.size())
+    {
+        const ssize_t bytes = ::pread(m_descriptor, a_buffer.data() + total, a_buffer.size() - total, static_cast<off_t>(a_offset + total));
+        if (bytes < 0 && errno == EINTR)
+            continue;
+        if (bytes < 0)
+            throw std::system_error(errno, std::generic_category(), "Failed to read a file");
+        if (bytes == 0)
+            break;
+        total += static_cast<size_t>(bytes);
+    }
+#endif
+    co_return total;
+}
+
+asio::awaitable<void> FileService::File::write(const uint64_t a_offset, const std::span<const std::byte> a_data)
+{
+#if defined(ASIO_HAS_FILE)
+    const auto [error, bytes] = co_await asio::async_write_at(m_file, a_offset, asio::buffer(a_data), asio::as_tuple(asio::use_awaitable));
+    if (error)
+        throw std::system_error(error, "Failed to write a file");
+#else
+    for (size_t total = 0; total < a_data.size();)
+    {
+        const ssize_t bytes = ::pwrite(m_descriptor, a_data.data() + total, a_data.size() - total, static_cast<off_t>(a_offset + total));
+        if (bytes < 0 && errno == EINTR)
+            continue;
+        if (bytes < 0)
+            throw std::system_error(errno, std::generic_category(), "Failed to write a file");
+        total += static_cast<size_t>(bytes);
+    }
+#endif
+    co_return;
+}
+
+FileService::FileService(const size_t a_threadCount)
+    : m_work(asio::make_work_guard(m_context))
+{
+    for (size_t i = 0; i < a_threadCount; i++)
+    {
+        m_threads.emplace_back([this]
+        {
+            m_context.run();
+        });
+    }
+}
+
+FileService::~FileService()
+{
+    m_work.reset();
+    m_threads.clear();
+}
+
+asio::awaitable<std::vector<std::byte>> FileService::readFile(const std::filesystem::path a_path)
+{
+    File file(*this, a_path, File::Mode::Read);
+    std::vector<std::byte> data(file.getSize());
+    data.resize(co_await file.read(0, data));
+    co_return data;
+}
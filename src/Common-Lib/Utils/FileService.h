@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "asio.hpp"
+
+namespace Utils
+{
+    // Asynchronous file I/O as coroutines, on a few threads of its own
+    // With asio's file support (io_uring on Linux, see MCPP_IO_URING, IOCP on Windows) operations only wait in the
+    // kernel: the reads & writes of all coroutines go through one ring & are submitted together, straight into the
+    // callers' buffers; without it, they're positional reads & writes on the service's threads
+    // Coroutines using it are expected to run on getContext(), co_spawn them there
+    class FileService final
+    {
+    public:
+        // An open file, reads & writes take their offset, so any number of them can run at the same time
+        // Throws std::system_error if opening or an operation fails, has to be closed before its service is destroyed
+        class File final
+        {
+        public:
+            enum class Mode : uint8_t
+            {
+                Read,
+                // Creates the file if it doesn't exist
+                ReadWrite
+            };
+
+            File(FileService &a_service, const std::filesystem::path &a_path, Mode a_mode);
+
+            File(const File &) = delete;
+
+            File &operator=(const File &) = delete;
+
+            ~File();
+
+            [[nodiscard]]
+            uint64_t getSize() const;
+
+            // Reads until the buffer is full or the file ends, returns how many bytes were read
+            [[nodiscard]]
+            asio::awaitable<size_t> read(uint64_t a_offset, std::span<std::byte> a_buffer);
+
+            asio::awaitable<void> write(uint64_t a_offset, std::span<const std::byte> a_data);
+
+        private:
+            FileService &m_service;
+#if defined(ASIO_HAS_FILE)
+            asio::random_access_file m_file;
+#else
+            int m_descriptor;
+#endif
+        };
+
+        explicit FileService(size_t a_threadCount = 2);
+
+        FileService(const FileService &) = delete;
+
+        FileService &operator=(const FileService &) = delete;
+
+        // Waits for every operation that was started
+        ~FileService();
+
+        [[nodiscard]]
+        asio::io_context &getContext()
+        {
+            return m_context;
+        }
+
+        // The whole file, throws std::system_error if it can't be read
+        [[nodiscard]]
+        asio::awaitable<std::vector<std::byte>> readFile(std::filesystem::path a_path);
+
+    private:
+        asio::io_context m_context;
+        asio::executor_work_guard<asio::io_context::executor_type> m_work;
+        // Last, so they're stopped before the rest is destroyed
+        std::vector<std::jthread> m_threads;
+    };
+}
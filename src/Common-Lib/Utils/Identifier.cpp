@@ -80,7 +80,7 @@ bool Identifier::isPathCharValid(const char c)
 [[nodiscard]]
 string Identifier::getNamespace() const
 {
-    return this->m_path;
+    return this->m_namespace;
 }
 
 [[nodiscard]]
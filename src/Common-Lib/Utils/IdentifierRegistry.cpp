@@ -0,0 +1,20 @@
+#include "IdentifierRegistry.h"
+
+using Utils::IdentifierRegistry;
+
+uint32_t IdentifierRegistry::add(const Identifier &a_identifier)
+{
+    const auto [entry, inserted] = m_ids.try_emplace(a_identifier.toString(), static_cast<uint32_t>(m_identifiers.size()));
+    if (inserted)
+    {
+        m_identifiers.push_back(a_identifier);
+    }
+    return entry->second;
+}
+
+std::optional<uint32_t> IdentifierRegistry::getId(const Identifier &a_identifier) const
+{
+    if (const auto found = m_ids.find(a_identifier.toString()); found != m_ids.end())
+        return found->second;
+    return {};
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Identifier.h"
+
+namespace Utils
+{
+    // Gives identifiers (sounds, items, entity types ...) dense numeric ids in registration order, so they can be sent
+    // over the network as a VarInt instead of a string; both sides have to register the same identifiers in the same order
+    class IdentifierRegistry final
+    {
+    public:
+        // Returns the existing id if a_identifier is already registered
+        uint32_t add(const Identifier &a_identifier);
+
+        [[nodiscard]]
+        std::optional<uint32_t> getId(const Identifier &a_identifier) const;
+
+        // nullptr for ids that aren't registered, e.g. ones received from a misbehaving peer
+        [[nodiscard]]
+        const Identifier *get(const uint32_t a_id) const
+        {
+            return a_id < m_identifiers.size() ? &m_identifiers[a_id] : nullptr;
+        }
+
+        [[nodiscard]]
+        size_t size() const
+        {
+            return m_identifiers.size();
+        }
+
+    private:
+        std::vector<Identifier> m_identifiers;
+        std::unordered_map<string, uint32_t> m_ids;
+    };
+}
@@ -0,0 +1,64 @@
+#include "JobSystem.h"
+
+using Utils::JobSystem;
+
+thread_local size_t g_jobThreadIndex = 0;
+
+JobSystem::JobSystem(const size_t a_workerCount)
+{
+    m_workers.reserve(a_workerCount);
+    for (size_t i = 0; i < a_workerCount; i++)
+    {
+        m_workers.emplace_back([this, i] { workerLoop(i + 1); });
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard guard(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+    m_workers.clear();
+}
+
+size_t JobSystem::getDefaultWorkerCount()
+{
+    const size_t hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
+size_t JobSystem::getCurrentThreadIndex()
+{
+    return g_jobThreadIndex;
+}
+
+void JobSystem::submit(Job &&a_job)
+{
+    {
+        std::lock_guard guard(m_mutex);
+        m_jobs.push_back(std::move(a_job));
+    }
+    m_condition.notify_one();
+}
+
+void JobSystem::workerLoop(const size_t a_threadIndex)
+{
+    g_jobThreadIndex = a_threadIndex;
+
+    while (true)
+    {
+        Job job;
+        {
+            std::unique_lock lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+            if (m_jobs.empty())
+                return;
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+        job();
+    }
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "UniqueFunction.h"
+
+namespace Utils
+{
+    // Fixed size pool of worker threads for fork/join style parallelism
+    class JobSystem final
+    {
+    public:
+        using Job = UniqueFunction<void()>;
+
+        // a_workerCount does not include the calling thread, which participates in parallelFor
+        explicit JobSystem(size_t a_workerCount = getDefaultWorkerCount());
+
+        JobSystem(const JobSystem &) = delete;
+
+        JobSystem &operator=(const JobSystem &) = delete;
+
+        ~JobSystem();
+
+        [[nodiscard]]
+        static size_t getDefaultWorkerCount();
+
+        // 0 on threads that don't belong to a JobSystem, 1 ... getWorkerCount() on worker threads
+        // Useful to index per-thread scratch data (like command buffers) sized getThreadCount()
+        [[nodiscard]]
+        static size_t getCurrentThreadIndex();
+
+        [[nodiscard]]
+        size_t getWorkerCount() const
+        {
+            return m_workers.size();
+        }
+
+        // Worker threads + the calling thread
+        [[nodiscard]]
+        size_t getThreadCount() const
+        {
+            return m_workers.size() + 1;
+        }
+
+        void submit(Job &&a_job);
+
+        // Calls a_function(begin, end) for ranges of at most a_grainSize indices covering [0, a_count)
+        // Blocks until every range finished, the calling thread works on ranges too
+        // The first exception thrown by a_function is rethrown after all ranges are done
+        template<typename F>
+        void parallelFor(const size_t a_count, const size_t a_grainSize, F &&a_function)
+        {
+            if (a_count == 0)
+                return;
+
+            const size_t grainSize = std::max<size_t>(a_grainSize, 1);
+            const size_t rangeCount = (a_count + grainSize - 1) / grainSize;
+            if (rangeCount == 1 || m_workers.empty())
+            {
+                for (size_t begin = 0; begin < a_count; begin += grainSize)
+                {
+                    a_function(begin, std::min(begin + grainSize, a_count));
+                }
+                return;
+            }
+
+            auto state = std::make_shared<ParallelForState>(a_count, grainSize, rangeCount);
+            auto *function = &a_function;
+            auto work = [state, function]
+            {
+                // a_function is only touched after claiming a range, which is impossible once the caller returned
+                while (true)
+                {
+                    const size_t begin = state->next.fetch_add(state->grainSize, std::memory_order_relaxed);
+                    if (begin >= state->count)
+                        return;
+
+                    try
+                    {
+                        (*function)(begin, std::min(begin + state->grainSize, state->count));
+                    } catch (...)
+                    {
+                        std::lock_guard guard(state->exceptionMutex);
+                        if (!state->exception)
+                            state->exception = std::current_exception();
+                    }
+
+                    if (state->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    {
+                        state->remaining.notify_all();
+                    }
+                }
+            };
+
+            const size_t helperCount = std::min(m_workers.size(), rangeCount - 1);
+            for (size_t i = 0; i < helperCount; i++)
+            {
+                submit(Job(work));
+            }
+            work();
+
+            for (size_t remaining = state->remaining.load(std::memory_order_acquire);
+                 remaining != 0;
+                 remaining = state->remaining.load(std::memory_order_acquire))
+            {
+                state->remaining.wait(remaining, std::memory_order_acquire);
+            }
+
+            if (state->exception)
+                std::rethrow_exception(state->exception);
+        }
+
+    private:
+        struct ParallelForState
+        {
+            ParallelForState(const size_t a_count, const size_t a_grainSize, const size_t a_rangeCount)
+                : count(a_count), grainSize(a_grainSize), remaining(a_rangeCount) {}
+
+            const size_t count;
+            const size_t grainSize;
+            std::atomic<size_t> next = 0;
+            std::atomic<size_t> remaining;
+            std::mutex exceptionMutex;
+            std::exception_ptr exception;
+        };
+
+        std::vector<std::jthread> m_workers;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::deque<Job> m_jobs;
+        bool m_stopping = false;
+
+        void workerLoop(size_t a_threadIndex);
+    };
+}
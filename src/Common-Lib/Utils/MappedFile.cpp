@@ -0,0 +1,119 @@
+#include <system_error>
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "MappedFile.h"
+
+using Utils::MappedFile;
+
+#if defined(_WIN32)
+MappedFile::MappedFile(const std::filesystem::path &a_path)
+{
+    const HANDLE file = CreateFileW(a_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "Failed to open " + a_path.string());
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size))
+    {
+        const DWORD error = GetLastError();
+        CloseHandle(file);
+        throw std::system_error(static_cast<int>(error), std::system_category(), "Failed to get the size of " + a_path.string());
+    }
+    m_size = static_cast<size_t>(size.QuadPart);
+
+    // An empty file can't be mapped, there's nothing to map either
+    if (m_size > 0)
+    {
+        const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping != nullptr)
+        {
+            m_data = static_cast<const std::byte *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping);
+        }
+        if (m_data == nullptr)
+        {
+            const DWORD error = GetLastError();
+            CloseHandle(file);
+            throw std::system_error(static_cast<int>(error), std::system_category(), "Failed to map " + a_path.string());
+        }
+    }
+    // The view keeps the file open
+    CloseHandle(file);
+}
+
+void MappedFile::unmap()
+{
+    if (m_data != nullptr)
+        UnmapViewOfFile(m_data);
+}
+#else
+MappedFile::MappedFile(const std::filesystem::path &a_path)
+{
+    const int descriptor = ::open(a_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0)
+        throw std::system_error(errno, std::generic_category(), "Failed to open " + a_path.string());
+
+    struct stat status{};
+    if (::fstat(descriptor, &status) != 0)
+    {
+        const int error = errno;
+        ::close(descriptor);
+        throw std::system_error(error, std::generic_category(), "Failed to get the size of " + a_path.string());
+    }
+    m_size = static_cast<size_t>(status.st_size);
+
+    // An empty file can't be mapped, there's nothing to map either
+    if (m_size > 0)
+    {
+        void *data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (data == MAP_FAILED)
+        {
+            const int error = errno;
+            ::close(descriptor);
+            throw std::system_error(error, std::generic_category(), "Failed to map " + a_path.string());
+        }
+        m_data = static_cast<const std::byte *>(data);
+    }
+    // The mapping keeps the file open
+    ::close(descriptor);
+}
+
+void MappedFile::unmap()
+{
+    if (m_data != nullptr)
+        ::munmap(const_cast<std::byte *>(m_data), m_size);
+}
+#endif
+
+MappedFile::MappedFile(MappedFile &&a_other) noexcept
+    : m_data(std::exchange(a_other.m_data, nullptr)), m_size(std::exchange(a_other.m_size, 0))
+{
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&a_other) noexcept
+{
+    if (this != &a_other)
+    {
+        unmap();
+        m_data = std::exchange(a_other.m_data, nullptr);
+        m_size = std::exchange(a_other.m_size, 0);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    unmap();
+}
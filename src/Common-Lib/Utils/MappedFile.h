@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace Utils
+{
+    // A whole file mapped read-only into memory, pages are only read from disk (or the page cache) once they're
+    // touched & shared with every other process mapping the same file
+    // Throws std::system_error if the file can't be opened or mapped; the file mustn't be changed while it's mapped
+    class MappedFile final
+    {
+    public:
+        explicit MappedFile(const std::filesystem::path &a_path);
+
+        MappedFile(MappedFile &&a_other) noexcept;
+
+        MappedFile &operator=(MappedFile &&a_other) noexcept;
+
+        MappedFile(const MappedFile &) = delete;
+
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        ~MappedFile();
+
+        // Stays valid as long as the file is mapped, even if this is moved
+        [[nodiscard]]
+        std::span<const std::byte> getData() const
+        {
+            return {m_data, m_size};
+        }
+
+    private:
+        const std::byte *m_data = nullptr;
+        size_t m_size = 0;
+
+        void unmap();
+    };
+}
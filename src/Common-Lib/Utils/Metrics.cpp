@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <stdexcept>
+
+#include "Metrics.h"
+
+using Utils::Histogram;
+using Utils::MetricRegistry;
+
+// Most tick phases take well under a millisecond
+const std::vector<double> MetricRegistry::DURATION_BOUNDS = {
+    0.00005, 0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0
+};
+
+Histogram::Histogram(std::vector<double> a_bounds)
+    : m_bounds(std::move(a_bounds)), m_buckets(std::make_unique<std::atomic<uint64_t>[]>(m_bounds.size() + 1))
+{
+    if (!std::ranges::is_sorted(m_bounds))
+        throw std::invalid_argument("Histogram bounds have to be sorted");
+}
+
+void Histogram::observe(const double a_value)
+{
+    // There are only a few bounds, a linear scan beats a binary search
+    size_t bucket = 0;
+    while (bucket < m_bounds.size() && a_value > m_bounds[bucket])
+    {
+        bucket++;
+    }
+    m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(a_value, std::memory_order_relaxed);
+}
+
+Utils::Counter &MetricRegistry::addCounter(const std::string_view a_name, const std::string_view a_help, MetricLabels a_labels)
+{
+    return add(a_name, a_help, std::move(a_labels), std::make_unique<Counter>());
+}
+
+Utils::Gauge &MetricRegistry::addGauge(const std::string_view a_name, const std::string_view a_help, MetricLabels a_labels)
+{
+    return add(a_name, a_help, std::move(a_labels), std::make_unique<Gauge>());
+}
+
+Histogram &MetricRegistry::addHistogram(const std::string_view a_name, const std::string_view a_help,
+                                        std::vector<double> a_bounds, MetricLabels a_labels)
+{
+    return add(a_name, a_help, std::move(a_labels), std::make_unique<Histogram>(std::move(a_bounds)));
+}
+
+void MetricRegistry::remove(const std::string_view a_name, const MetricLabels &a_labels)
+{
+    std::lock_guard lock(m_mutex);
+    const auto family = std::ranges::find(m_families, a_name, &Family::name);
+    if (family != m_families.end())
+        std::erase_if(family->series, [&a_labels](const Series &a_series) { return a_series.labels == a_labels; });
+}
+
+template<typename T>
+T &MetricRegistry::add(const std::string_view a_name, const std::string_view a_help, MetricLabels a_labels,
+                       std::unique_ptr<T> a_metric)
+{
+    T &metric = *a_metric;
+    Series series{std::move(a_labels), std::move(a_metric)};
+
+    std::lock_guard lock(m_mutex);
+    const auto family = std::ranges::find(m_families, a_name, &Family::name);
+    if (family == m_families.end())
+    {
+        m_families.push_back({std::string(a_name), std::string(a_help), series.metric.index(), {}});
+        m_families.back().series.push_back(std::move(series));
+    }
+    else if (family->type != series.metric.index())
+    {
+        throw std::invalid_argument(std::format("Metric {} was added as another type before", a_name));
+    }
+    else
+    {
+        family->series.push_back(std::move(series));
+    }
+    return metric;
+}
+
+// Label values escape backslashes, quotes & line breaks
+void appendLabels(std::string &a_out, const Utils::MetricLabels &a_labels, const std::string_view a_extraName = {},
+                  const std::string_view a_extraValue = {})
+{
+    if (a_labels.empty() && a_extraName.empty())
+        return;
+
+    a_out += '{';
+    const auto appendLabel = [&a_out](const std::string_view a_name, const std::string_view a_value)
+    {
+        if (a_out.back() != '{')
+            a_out += ',';
+        a_out += a_name;
+        a_out += "=\"";
+        for (const char character: a_value)
+        {
+            if (character == '\n')
+            {
+                a_out += "\\n";
+                continue;
+            }
+            if (character == '\\' || character == '"')
+                a_out += '\\';
+            a_out += character;
+        }
+        a_out += '"';
+    };
+    for (const auto &[name, value]: a_labels)
+    {
+        appendLabel(name, value);
+    }
+    if (!a_extraName.empty())
+        appendLabel(a_extraName, a_extraValue);
+    a_out += '}';
+}
+
+std::string formatMetricValue(const double a_value)
+{
+    if (std::isnan(a_value))
+        return "NaN";
+    if (std::isinf(a_value))
+        return a_value > 0 ? "+Inf" : "-Inf";
+    return std::format("{}", a_value);
+}
+
+std::string MetricRegistry::render() const
+{
+    constexpr std::string_view typeNames[] = {"counter", "gauge", "histogram"};
+
+    std::string out;
+    std::lock_guard lock(m_mutex);
+    for (const Family &family: m_families)
+    {
+        out += std::format("# HELP {} {}\n# TYPE {} {}\n", family.name, family.help, family.name, typeNames[family.type]);
+        for (const Series &series: family.series)
+        {
+            if (const auto *counter = std::get_if<std::unique_ptr<Counter>>(&series.metric))
+            {
+                out += family.name;
+                appendLabels(out, series.labels);
+                out += std::format(" {}\n", (*counter)->get());
+            }
+            else if (const auto *gauge = std::get_if<std::unique_ptr<Gauge>>(&series.metric))
+            {
+                out += family.name;
+                appendLabels(out, series.labels);
+                out += std::format(" {}\n", formatMetricValue((*gauge)->get()));
+            }
+            else
+            {
+                // Buckets are cumulative in the format
+                const Histogram &histogram = *std::get<std::unique_ptr<Histogram>>(series.metric);
+                uint64_t count = 0;
+                for (size_t i = 0; i <= histogram.getBounds().size(); i++)
+                {
+                    count += histogram.getBucket(i);
+                    out += family.name + "_bucket";
+                    appendLabels(out, series.labels, "le", i < histogram.getBounds().size() ? formatMetricValue(histogram.getBounds()[i]) : "+Inf");
+                    out += std::format(" {}\n", count);
+                }
+                out += family.name + "_sum";
+                appendLabels(out, series.labels);
+                out += std::format(" {}\n", formatMetricValue(histogram.getSum()));
+                out += family.name + "_count";
+                appendLabels(out, series.labels);
+                out += std::format(" {}\n", count);
+            }
+        }
+    }
+    return out;
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace Utils
+{
+    // Label names & values of one series of a metric, e.g. {{"tag", "Chunks"}}
+    using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+    // Only goes up, updating it is a relaxed atomic add
+    class Counter final
+    {
+    public:
+        void add(const uint64_t a_value = 1)
+        {
+            m_value.fetch_add(a_value, std::memory_order_relaxed);
+        }
+
+        // For totals that are counted elsewhere, e.g. in the stats of a subsystem; they must never go down
+        void set(const uint64_t a_value)
+        {
+            m_value.store(a_value, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]]
+        uint64_t get() const
+        {
+            return m_value.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<uint64_t> m_value = 0;
+    };
+
+    class Gauge final
+    {
+    public:
+        void set(const double a_value)
+        {
+            m_value.store(a_value, std::memory_order_relaxed);
+        }
+
+        void add(const double a_value)
+        {
+            m_value.fetch_add(a_value, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]]
+        double get() const
+        {
+            return m_value.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<double> m_value = 0.0;
+    };
+
+    // Counts observed values into buckets with fixed upper bounds, an observation is a short scan over the bounds & two
+    // relaxed atomic adds; a reader running at the same time can see the sum & the buckets of different observations
+    class Histogram final
+    {
+    public:
+        // Sorted ascending, values above the last one go into an implicit +Inf bucket
+        explicit Histogram(std::vector<double> a_bounds);
+
+        void observe(double a_value);
+
+        [[nodiscard]]
+        const std::vector<double> &getBounds() const
+        {
+            return m_bounds;
+        }
+
+        // Observations that went into bucket a_index only, not cumulative; a_index == getBounds().size() is +Inf
+        [[nodiscard]]
+        uint64_t getBucket(const size_t a_index) const
+        {
+            return m_buckets[a_index].load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]]
+        double getSum() const
+        {
+            return m_sum.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::vector<double> m_bounds;
+        std::unique_ptr<std::atomic<uint64_t>[]> m_buckets;
+        std::atomic<double> m_sum = 0.0;
+    };
+
+    // Metrics of a process by name & labels, rendered in the Prometheus text exposition format
+    // Adding & removing metrics locks, updating them doesn't, they stay in place until they're removed or the registry is
+    // destroyed; metrics with the same name are one family & have to be of the same type, names & labels aren't validated
+    class MetricRegistry final
+    {
+    public:
+        // Bucket bounds in seconds for durations from 50 microseconds up to a second
+        static const std::vector<double> DURATION_BOUNDS;
+
+        MetricRegistry() = default;
+
+        MetricRegistry(const MetricRegistry &) = delete;
+
+        MetricRegistry &operator=(const MetricRegistry &) = delete;
+
+        // Throws std::invalid_argument if the name was added as another type before
+        Counter &addCounter(std::string_view a_name, std::string_view a_help, MetricLabels a_labels = {});
+
+        Gauge &addGauge(std::string_view a_name, std::string_view a_help, MetricLabels a_labels = {});
+
+        Histogram &addHistogram(std::string_view a_name, std::string_view a_help, std::vector<double> a_bounds,
+                                MetricLabels a_labels = {});
+
+        // Drops the series with exactly these labels, e.g. of a connection that closed; references to it are invalid
+        // afterwards
+        void remove(std::string_view a_name, const MetricLabels &a_labels);
+
+        // Safe to call from any thread, while the metrics are updated
+        [[nodiscard]]
+        std::string render() const;
+
+    private:
+        using Metric = std::variant<std::unique_ptr<Counter>, std::unique_ptr<Gauge>, std::unique_ptr<Histogram>>;
+
+        struct Series
+        {
+            MetricLabels labels;
+            Metric metric;
+        };
+
+        struct Family
+        {
+            std::string name;
+            std::string help;
+            // Index of the variant alternative
+            size_t type = 0;
+            std::vector<Series> series;
+        };
+
+        mutable std::mutex m_mutex;
+        // In the order they were added
+        std::vector<Family> m_families;
+
+        template<typename T>
+        T &add(std::string_view a_name, std::string_view a_help, MetricLabels a_labels, std::unique_ptr<T> a_metric);
+    };
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace Utils
+{
+    // Unbounded lock-free multi-producer single-consumer queue (Vyukov's intrusive node queue)
+    // push() may be called from any thread, tryPop() only from the single consumer thread
+    template<typename T>
+    class MpscQueue final
+    {
+    public:
+        MpscQueue() = default;
+
+        MpscQueue(const MpscQueue &) = delete;
+
+        MpscQueue &operator=(const MpscQueue &) = delete;
+
+        ~MpscQueue()
+        {
+            while (tryPop().has_value()) {}
+        }
+
+        void push(T &&a_value)
+        {
+            pushNode(new Node(std::move(a_value)));
+        }
+
+        // May spuriously return nothing while a producer is in the middle of a push,
+        // the value becomes visible on a later call
+        [[nodiscard]]
+        std::optional<T> tryPop()
+        {
+            Node *tail = m_tail;
+            Node *next = tail->next.load(std::memory_order_acquire);
+
+            if (tail == &m_stub)
+            {
+                if (next == nullptr)
+                    return {};
+
+                m_tail = next;
+                tail = next;
+                next = next->next.load(std::memory_order_acquire);
+            }
+
+            if (next != nullptr)
+            {
+                m_tail = next;
+                return takeValue(tail);
+            }
+
+            if (tail != m_head.load(std::memory_order_acquire))
+                return {};
+
+            pushNode(&m_stub);
+
+            next = tail->next.load(std::memory_order_acquire);
+            if (next != nullptr)
+            {
+                m_tail = next;
+                return takeValue(tail);
+            }
+
+            return {};
+        }
+
+        // Only meaningful on the consumer thread
+        [[nodiscard]]
+        bool isEmpty() const
+        {
+            return m_tail == &m_stub && m_stub.next.load(std::memory_order_acquire) == nullptr;
+        }
+
+    private:
+        struct Node
+        {
+            Node() = default;
+
+            explicit Node(T &&a_value) : value(std::move(a_value)) {}
+
+            std::atomic<Node *> next = nullptr;
+            std::optional<T> value;
+        };
+
+        void pushNode(Node *a_node)
+        {
+            a_node->next.store(nullptr, std::memory_order_relaxed);
+            Node *previous = m_head.exchange(a_node, std::memory_order_acq_rel);
+            previous->next.store(a_node, std::memory_order_release);
+        }
+
+        static std::optional<T> takeValue(Node *a_node)
+        {
+            std::optional<T> value = std::move(a_node->value);
+            delete a_node;
+            return value;
+        }
+
+        Node m_stub;
+        alignas(64) std::atomic<Node *> m_head = &m_stub;
+        alignas(64) Node *m_tail = &m_stub;
+    };
+}
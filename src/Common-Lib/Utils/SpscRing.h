@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace Utils
+{
+    // Bounded lock-free single-producer single-consumer ring buffer
+    // tryPush() may only be called from the producer thread, tryPop() only from the consumer thread
+    template<typename T>
+    class SpscRing final
+    {
+    public:
+        // Rounded up to a power of two
+        explicit SpscRing(const size_t a_capacity)
+            : m_mask(std::bit_ceil(a_capacity) - 1), m_slots(std::make_unique<std::optional<T>[]>(m_mask + 1)) {}
+
+        SpscRing(const SpscRing &) = delete;
+
+        SpscRing &operator=(const SpscRing &) = delete;
+
+        // Returns false & leaves a_value alone if the ring is full
+        [[nodiscard]]
+        bool tryPush(T &&a_value)
+        {
+            const size_t head = m_head.load(std::memory_order_relaxed);
+            if (head - m_cachedTail > m_mask)
+            {
+                m_cachedTail = m_tail.load(std::memory_order_acquire);
+                if (head - m_cachedTail > m_mask)
+                    return false;
+            }
+
+            m_slots[head & m_mask].emplace(std::move(a_value));
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        [[nodiscard]]
+        std::optional<T> tryPop()
+        {
+            const size_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail == m_cachedHead)
+            {
+                m_cachedHead = m_head.load(std::memory_order_acquire);
+                if (tail == m_cachedHead)
+                    return {};
+            }
+
+            std::optional<T> value = std::move(m_slots[tail & m_mask]);
+            m_slots[tail & m_mask].reset();
+            m_tail.store(tail + 1, std::memory_order_release);
+            return value;
+        }
+
+        // Safe to call from any thread, already outdated when it returns
+        [[nodiscard]]
+        size_t getSize() const
+        {
+            // Tail first, the head can only have moved further since
+            const size_t tail = m_tail.load(std::memory_order_acquire);
+            return m_head.load(std::memory_order_acquire) - tail;
+        }
+
+        [[nodiscard]]
+        size_t getCapacity() const
+        {
+            return m_mask + 1;
+        }
+
+    private:
+        size_t m_mask;
+        std::unique_ptr<std::optional<T>[]> m_slots;
+        // Each side keeps a copy of the other's index & only reloads it when the ring looks full / empty, so the
+        // cache lines of the indices aren't bounced between the threads on every call
+        alignas(64) std::atomic<size_t> m_head = 0;
+        size_t m_cachedTail = 0;
+        alignas(64) std::atomic<size_t> m_tail = 0;
+        size_t m_cachedHead = 0;
+    };
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace Utils
+{
+    enum class TaskStatus : uint8_t
+    {
+        Pending,
+        Ready,
+        Failed,
+        // The promise was destroyed without a result, e.g.: the task was dropped during shutdown
+        Abandoned
+    };
+
+    namespace Detail
+    {
+        template<typename T>
+        struct TaskState
+        {
+            using Stored = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+            std::atomic<TaskStatus> status = TaskStatus::Pending;
+            std::optional<Stored> value;
+            std::exception_ptr exception;
+
+            void complete(const TaskStatus a_status)
+            {
+                status.store(a_status, std::memory_order_release);
+                status.notify_all();
+            }
+        };
+    }
+
+    // Result handle of a task that is executed on another thread
+    // the state is published with a single atomic store, so polling a handle never contends with the producer
+    template<typename T>
+    class TaskFuture final
+    {
+    public:
+        TaskFuture() = default;
+
+        explicit TaskFuture(std::shared_ptr<Detail::TaskState<T>> a_state)
+            : m_state(std::move(a_state)) {}
+
+        [[nodiscard]]
+        bool isValid() const
+        {
+            return m_state != nullptr;
+        }
+
+        [[nodiscard]]
+        TaskStatus getStatus() const
+        {
+            return m_state->status.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]]
+        bool isReady() const
+        {
+            return getStatus() != TaskStatus::Pending;
+        }
+
+        void wait() const
+        {
+            m_state->status.wait(TaskStatus::Pending, std::memory_order_acquire);
+        }
+
+        // Blocks until the task finished, rethrows the exception thrown by the task if there was one
+        T get()
+        {
+            wait();
+            switch (getStatus())
+            {
+                case TaskStatus::Failed: std::rethrow_exception(m_state->exception);
+                case TaskStatus::Abandoned: throw std::runtime_error("Task was abandoned before it could run");
+                default: break;
+            }
+
+            if constexpr (!std::is_void_v<T>)
+            {
+                return std::move(m_state->value.value());
+            }
+        }
+
+        // Returns the result if the task has already finished successfully, never blocks
+        [[nodiscard]]
+        std::optional<typename Detail::TaskState<T>::Stored> tryGet()
+        {
+            if (getStatus() != TaskStatus::Ready)
+                return {};
+
+            return std::move(m_state->value);
+        }
+
+    private:
+        std::shared_ptr<Detail::TaskState<T>> m_state;
+    };
+
+    template<typename T>
+    class TaskPromise final
+    {
+    public:
+        TaskPromise()
+            : m_state(std::make_shared<Detail::TaskState<T>>()) {}
+
+        TaskPromise(TaskPromise &&) noexcept = default;
+
+        TaskPromise &operator=(TaskPromise &&) noexcept = default;
+
+        TaskPromise(const TaskPromise &) = delete;
+
+        TaskPromise &operator=(const TaskPromise &) = delete;
+
+        ~TaskPromise()
+        {
+            if (m_state != nullptr && m_state->status.load(std::memory_order_relaxed) == TaskStatus::Pending)
+            {
+                m_state->complete(TaskStatus::Abandoned);
+            }
+        }
+
+        [[nodiscard]]
+        TaskFuture<T> getFuture() const
+        {
+            return TaskFuture<T>(m_state);
+        }
+
+        template<typename... Args>
+        void setValue(Args &&... a_args)
+        {
+            m_state->value.emplace(std::forward<Args>(a_args)...);
+            m_state->complete(TaskStatus::Ready);
+        }
+
+        void setException(std::exception_ptr a_exception)
+        {
+            m_state->exception = std::move(a_exception);
+            m_state->complete(TaskStatus::Failed);
+        }
+
+        // Invokes a_function & stores either its result or the exception it threw
+        template<typename F, typename... Args>
+        void fulfill(F &a_function, Args &&... a_args)
+        {
+            try
+            {
+                if constexpr (std::is_void_v<T>)
+                {
+                    a_function(std::forward<Args>(a_args)...);
+                    setValue();
+                } else
+                {
+                    setValue(a_function(std::forward<Args>(a_args)...));
+                }
+            } catch (...)
+            {
+                setException(std::current_exception());
+            }
+        }
+
+    private:
+        std::shared_ptr<Detail::TaskState<T>> m_state;
+    };
+}
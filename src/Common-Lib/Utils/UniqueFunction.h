@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Utils
+{
+    template<typename Signature>
+    class UniqueFunction;
+
+    // Move-only replacement for std::function, callables up to INLINE_SIZE bytes are stored without a heap allocation
+    template<typename R, typename... Args>
+    class UniqueFunction<R(Args...)> final
+    {
+    public:
+        static constexpr size_t INLINE_SIZE = 48;
+
+        UniqueFunction() = default;
+
+        UniqueFunction(std::nullptr_t) {}
+
+        template<typename F>
+            requires (!std::is_same_v<std::remove_cvref_t<F>, UniqueFunction> && std::is_invocable_r_v<R, F &, Args...>)
+        UniqueFunction(F &&a_function)
+        {
+            using Callable = std::decay_t<F>;
+            if constexpr (isStoredInline<Callable>())
+            {
+                ::new(static_cast<void *>(&m_storage)) Callable(std::forward<F>(a_function));
+                m_operations = &INLINE_OPERATIONS<Callable>;
+            } else
+            {
+                *reinterpret_cast<Callable **>(&m_storage) = new Callable(std::forward<F>(a_function));
+                m_operations = &HEAP_OPERATIONS<Callable>;
+            }
+        }
+
+        UniqueFunction(UniqueFunction &&a_other) noexcept
+        {
+            moveFrom(a_other);
+        }
+
+        UniqueFunction &operator=(UniqueFunction &&a_other) noexcept
+        {
+            if (this != &a_other)
+            {
+                reset();
+                moveFrom(a_other);
+            }
+            return *this;
+        }
+
+        UniqueFunction(const UniqueFunction &) = delete;
+
+        UniqueFunction &operator=(const UniqueFunction &) = delete;
+
+        ~UniqueFunction()
+        {
+            reset();
+        }
+
+        R operator()(Args... a_args)
+        {
+            return m_operations->invoke(&m_storage, std::forward<Args>(a_args)...);
+        }
+
+        [[nodiscard]]
+        explicit operator bool() const
+        {
+            return m_operations != nullptr;
+        }
+
+        void reset()
+        {
+            if (m_operations != nullptr)
+            {
+                m_operations->destroy(&m_storage);
+                m_operations = nullptr;
+            }
+        }
+
+    private:
+        struct Operations
+        {
+            R (*invoke)(void *a_storage, Args &&... a_args);
+            // Move-constructs into a_destination & destroys the source
+            void (*relocate)(void *a_destination, void *a_source);
+            void (*destroy)(void *a_storage);
+        };
+
+        template<typename Callable>
+        static consteval bool isStoredInline()
+        {
+            return sizeof(Callable) <= INLINE_SIZE
+                   && alignof(Callable) <= alignof(std::max_align_t)
+                   && std::is_nothrow_move_constructible_v<Callable>;
+        }
+
+        template<typename Callable>
+        static constexpr Operations INLINE_OPERATIONS{
+            .invoke = [](void *a_storage, Args &&... a_args) -> R
+            {
+                return std::invoke(*std::launder(static_cast<Callable *>(a_storage)), std::forward<Args>(a_args)...);
+            },
+            .relocate = [](void *a_destination, void *a_source)
+            {
+                Callable *source = std::launder(static_cast<Callable *>(a_source));
+                ::new(a_destination) Callable(std::move(*source));
+                source->~Callable();
+            },
+            .destroy = [](void *a_storage)
+            {
+                std::launder(static_cast<Callable *>(a_storage))->~Callable();
+            }
+        };
+
+        template<typename Callable>
+        static constexpr Operations HEAP_OPERATIONS{
+            .invoke = [](void *a_storage, Args &&... a_args) -> R
+            {
+                return std::invoke(**static_cast<Callable **>(a_storage), std::forward<Args>(a_args)...);
+            },
+            .relocate = [](void *a_destination, void *a_source)
+            {
+                *static_cast<Callable **>(a_destination) = *static_cast<Callable **>(a_source);
+            },
+            .destroy = [](void *a_storage)
+            {
+                delete *static_cast<Callable **>(a_storage);
+            }
+        };
+
+        void moveFrom(UniqueFunction &a_other) noexcept
+        {
+            if (a_other.m_operations != nullptr)
+            {
+                a_other.m_operations->relocate(&m_storage, &a_other.m_storage);
+                m_operations = a_other.m_operations;
+                a_other.m_operations = nullptr;
+            }
+        }
+
+        alignas(std::max_align_t) std::byte m_storage[INLINE_SIZE]{};
+        const Operations *m_operations = nullptr;
+    };
+}
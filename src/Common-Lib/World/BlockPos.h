@@ -0,0 +1,204 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+
+#include "glm/vec3.hpp"
+
+namespace World
+{
+    inline constexpr int32_t SECTION_SIZE = 16;
+    inline constexpr int32_t SECTION_VOLUME = SECTION_SIZE * SECTION_SIZE * SECTION_SIZE;
+    // Vertical extent of a chunk in sections, y = -64 ... 319
+    inline constexpr int32_t MIN_SECTION_Y = -4;
+    inline constexpr int32_t SECTIONS_PER_CHUNK = 24;
+    inline constexpr int32_t MIN_BLOCK_Y = MIN_SECTION_Y * SECTION_SIZE;
+    inline constexpr int32_t MAX_BLOCK_Y = (MIN_SECTION_Y + SECTIONS_PER_CHUNK) * SECTION_SIZE - 1;
+
+    [[nodiscard]]
+    constexpr int32_t blockToSection(const int32_t a_coordinate)
+    {
+        return a_coordinate >> 4;
+    }
+
+    [[nodiscard]]
+    constexpr int32_t blockToLocal(const int32_t a_coordinate)
+    {
+        return a_coordinate & 15;
+    }
+
+    // Faces of a block or section, opposite faces differ only in the lowest bit
+    enum class Face : uint8_t
+    {
+        Down,
+        Up,
+        North,
+        South,
+        West,
+        East
+    };
+
+    inline constexpr size_t FACE_COUNT = 6;
+
+    [[nodiscard]]
+    constexpr Face getOpposite(const Face a_face)
+    {
+        return static_cast<Face>(static_cast<uint8_t>(a_face) ^ 1);
+    }
+
+    struct BlockPos
+    {
+        int32_t x = 0;
+        int32_t y = 0;
+        int32_t z = 0;
+
+        [[nodiscard]]
+        static BlockPos containing(const glm::dvec3 &a_position)
+        {
+            return {
+                static_cast<int32_t>(std::floor(a_position.x)),
+                static_cast<int32_t>(std::floor(a_position.y)),
+                static_cast<int32_t>(std::floor(a_position.z))
+            };
+        }
+
+        [[nodiscard]]
+        constexpr BlockPos offset(const int32_t a_x, const int32_t a_y, const int32_t a_z) const
+        {
+            return {x + a_x, y + a_y, z + a_z};
+        }
+
+        // Same bit layout as the vanilla protocol: 26 bits x, 26 bits z, 12 bits y
+        [[nodiscard]]
+        constexpr uint64_t pack() const
+        {
+            return (static_cast<uint64_t>(x) & 0x3FFFFFF) << 38
+                   | (static_cast<uint64_t>(z) & 0x3FFFFFF) << 12
+                   | static_cast<uint64_t>(y) & 0xFFF;
+        }
+
+        [[nodiscard]]
+        static constexpr BlockPos unpack(const uint64_t a_packed)
+        {
+            const auto value = static_cast<int64_t>(a_packed);
+            return {
+                static_cast<int32_t>(value >> 38),
+                static_cast<int32_t>(value << 52 >> 52),
+                static_cast<int32_t>(value << 26 >> 38)
+            };
+        }
+
+        constexpr bool operator==(const BlockPos &) const = default;
+    };
+
+    struct SectionPos
+    {
+        int32_t x = 0;
+        int32_t y = 0;
+        int32_t z = 0;
+
+        [[nodiscard]]
+        static constexpr SectionPos of(const BlockPos &a_pos)
+        {
+            return {blockToSection(a_pos.x), blockToSection(a_pos.y), blockToSection(a_pos.z)};
+        }
+
+        [[nodiscard]]
+        constexpr BlockPos getOrigin() const
+        {
+            return {x * SECTION_SIZE, y * SECTION_SIZE, z * SECTION_SIZE};
+        }
+
+        [[nodiscard]]
+        constexpr uint64_t pack() const
+        {
+            return BlockPos{x, y, z}.pack();
+        }
+
+        constexpr bool operator==(const SectionPos &) const = default;
+    };
+
+    [[nodiscard]]
+    constexpr SectionPos getNeighbor(const SectionPos &a_pos, const Face a_face)
+    {
+        switch (a_face)
+        {
+            case Face::Down: return {a_pos.x, a_pos.y - 1, a_pos.z};
+            case Face::Up: return {a_pos.x, a_pos.y + 1, a_pos.z};
+            case Face::North: return {a_pos.x, a_pos.y, a_pos.z - 1};
+            case Face::South: return {a_pos.x, a_pos.y, a_pos.z + 1};
+            case Face::West: return {a_pos.x - 1, a_pos.y, a_pos.z};
+            case Face::East: return {a_pos.x + 1, a_pos.y, a_pos.z};
+        }
+        return a_pos;
+    }
+
+    struct ChunkPos
+    {
+        int32_t x = 0;
+        int32_t z = 0;
+
+        [[nodiscard]]
+        static constexpr ChunkPos of(const BlockPos &a_pos)
+        {
+            return {blockToSection(a_pos.x), blockToSection(a_pos.z)};
+        }
+
+        [[nodiscard]]
+        static constexpr ChunkPos of(const SectionPos &a_pos)
+        {
+            return {a_pos.x, a_pos.z};
+        }
+
+        [[nodiscard]]
+        constexpr uint64_t pack() const
+        {
+            return static_cast<uint64_t>(static_cast<uint32_t>(x)) | static_cast<uint64_t>(static_cast<uint32_t>(z)) << 32;
+        }
+
+        [[nodiscard]]
+        static constexpr ChunkPos unpack(const uint64_t a_packed)
+        {
+            return {static_cast<int32_t>(static_cast<uint32_t>(a_packed)), static_cast<int32_t>(static_cast<uint32_t>(a_packed >> 32))};
+        }
+
+        // Chebyshev distance in chunks, what view distance is measured in
+        [[nodiscard]]
+        constexpr int32_t distanceTo(const ChunkPos &a_other) const
+        {
+            const int32_t deltaX = x > a_other.x ? x - a_other.x : a_other.x - x;
+            const int32_t deltaZ = z > a_other.z ? z - a_other.z : a_other.z - z;
+            return deltaX > deltaZ ? deltaX : deltaZ;
+        }
+
+        constexpr bool operator==(const ChunkPos &) const = default;
+    };
+}
+
+template<>
+struct std::hash<World::BlockPos>
+{
+    size_t operator()(const World::BlockPos &a_pos) const noexcept
+    {
+        return std::hash<uint64_t>{}(a_pos.pack());
+    }
+};
+
+template<>
+struct std::hash<World::SectionPos>
+{
+    size_t operator()(const World::SectionPos &a_pos) const noexcept
+    {
+        return std::hash<uint64_t>{}(a_pos.pack());
+    }
+};
+
+template<>
+struct std::hash<World::ChunkPos>
+{
+    size_t operator()(const World::ChunkPos &a_pos) const noexcept
+    {
+        return std::hash<uint64_t>{}(a_pos.pack() * 0x9E3779B97F4A7C15ull);
+    }
+};
@@ -0,0 +1,260 @@
+#include <algorithm>
+
+#include "BlockTickScheduler.h"
+
+using World::BlockTickScheduler, World::BlockTickStats, World::BlockPos;
+
+BlockTickScheduler::BlockTickScheduler(const ChunkMap &a_world, const uint32_t a_randomTickSpeed)
+    : m_world(a_world), m_randomTickSpeed(a_randomTickSpeed) {}
+
+void BlockTickScheduler::setHandler(std::vector<Handler> &a_handlers, const BlockStateId a_state, Handler a_handler)
+{
+    if (a_state >= a_handlers.size())
+        a_handlers.resize(a_state + 1);
+    a_handlers[a_state] = std::move(a_handler);
+}
+
+BlockTickScheduler::Handler *BlockTickScheduler::getHandler(std::vector<Handler> &a_handlers, const BlockStateId a_state)
+{
+    if (a_state >= a_handlers.size() || !a_handlers[a_state])
+        return nullptr;
+    return &a_handlers[a_state];
+}
+
+void BlockTickScheduler::setScheduledTickHandler(const BlockStateId a_state, Handler a_handler)
+{
+    setHandler(m_scheduledTickHandlers, a_state, std::move(a_handler));
+}
+
+void BlockTickScheduler::setRandomTickHandler(const BlockStateId a_state, Handler a_handler)
+{
+    setHandler(m_randomTickHandlers, a_state, std::move(a_handler));
+}
+
+void BlockTickScheduler::setNeighborUpdateHandler(const BlockStateId a_state, Handler a_handler)
+{
+    setHandler(m_neighborUpdateHandlers, a_state, std::move(a_handler));
+}
+
+void BlockTickScheduler::scheduleTick(const BlockPos &a_pos, const BlockStateId a_state, const uint32_t a_delay)
+{
+    if (!m_scheduledPositions.insert(a_pos).second)
+        return;
+
+    // A delay of 0 would land in the bucket that is currently being processed
+    const uint64_t delay = std::max<uint64_t>(a_delay, 1);
+    const ScheduledTick scheduled{a_pos, a_state, m_currentTick + delay};
+    if (delay < WHEEL_SIZE)
+        m_wheel[scheduled.dueTick % WHEEL_SIZE].push_back(scheduled);
+    else
+        m_farTicks.push(scheduled);
+}
+
+void BlockTickScheduler::addScheduledTick(const ScheduledTick &a_tick)
+{
+    if (!m_scheduledPositions.insert(a_tick.pos).second)
+        return;
+
+    // Not called while ticking, so the current bucket is still to be processed
+    const ScheduledTick scheduled{a_tick.pos, a_tick.state, std::max(a_tick.dueTick, m_currentTick)};
+    if (scheduled.dueTick < m_currentTick + WHEEL_SIZE)
+        m_wheel[scheduled.dueTick % WHEEL_SIZE].push_back(scheduled);
+    else
+        m_farTicks.push(scheduled);
+}
+
+void BlockTickScheduler::onBlockChanged(const BlockPos &a_pos)
+{
+    constexpr int32_t offsets[7][3]{{0, 0, 0}, {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}};
+    for (const auto &[x, y, z]: offsets)
+    {
+        queueNeighborUpdate(a_pos.offset(x, y, z));
+    }
+}
+
+void BlockTickScheduler::queueNeighborUpdate(const BlockPos &a_pos)
+{
+    if (m_pendingNeighborUpdates.contains(a_pos))
+        return;
+
+    if (m_neighborUpdates.size() >= MAX_PENDING_NEIGHBOR_UPDATES)
+    {
+        m_droppedNeighborUpdates++;
+        return;
+    }
+
+    m_pendingNeighborUpdates.insert(a_pos);
+    m_neighborUpdates.push_back(a_pos);
+}
+
+void BlockTickScheduler::takePending(std::vector<ScheduledTick> &a_scheduledTicks, std::vector<BlockPos> &a_neighborUpdates)
+{
+    for (std::vector<ScheduledTick> &bucket: m_wheel)
+    {
+        a_scheduledTicks.insert(a_scheduledTicks.end(), bucket.begin(), bucket.end());
+        bucket.clear();
+    }
+    for (; !m_farTicks.empty(); m_farTicks.pop())
+    {
+        a_scheduledTicks.push_back(m_farTicks.top());
+    }
+    m_scheduledPositions.clear();
+
+    a_neighborUpdates.insert(a_neighborUpdates.end(), m_neighborUpdates.begin(), m_neighborUpdates.end());
+    m_neighborUpdates.clear();
+    m_pendingNeighborUpdates.clear();
+}
+
+BlockTickStats BlockTickScheduler::tick()
+{
+    const auto start = std::chrono::steady_clock::now();
+    BlockTickStats stats;
+
+    runScheduledTicks(stats);
+    // Collected up front, handlers may change blocks & so free or allocate sections
+    m_randomTickSections.clear();
+    for (const auto &[chunkPos, chunk]: m_world.getChunks())
+    {
+        addRandomTickSections(*chunk);
+    }
+    runRandomTicks(stats);
+    runNeighborUpdates(stats);
+
+    stats.droppedNeighborUpdates = m_droppedNeighborUpdates;
+    m_droppedNeighborUpdates = 0;
+    m_currentTick++;
+    stats.duration = std::chrono::steady_clock::now() - start;
+    return stats;
+}
+
+BlockTickStats BlockTickScheduler::tick(const std::span<const ChunkPos> a_chunks)
+{
+    const auto start = std::chrono::steady_clock::now();
+    BlockTickStats stats;
+
+    runScheduledTicks(stats);
+    m_randomTickSections.clear();
+    for (const ChunkPos &pos: a_chunks)
+    {
+        if (const Chunk *chunk = m_world.getChunk(pos); chunk != nullptr)
+            addRandomTickSections(*chunk);
+    }
+    runRandomTicks(stats);
+    runNeighborUpdates(stats);
+
+    stats.droppedNeighborUpdates = m_droppedNeighborUpdates;
+    m_droppedNeighborUpdates = 0;
+    m_currentTick++;
+    stats.duration = std::chrono::steady_clock::now() - start;
+    return stats;
+}
+
+uint32_t BlockTickScheduler::nextRandom()
+{
+    // xorshift32, random ticks don't need anything better
+    m_randomState ^= m_randomState << 13;
+    m_randomState ^= m_randomState >> 17;
+    m_randomState ^= m_randomState << 5;
+    return m_randomState;
+}
+
+void BlockTickScheduler::runScheduledTicks(BlockTickStats &a_stats)
+{
+    while (!m_farTicks.empty() && m_farTicks.top().dueTick < m_currentTick + WHEEL_SIZE)
+    {
+        m_wheel[m_farTicks.top().dueTick % WHEEL_SIZE].push_back(m_farTicks.top());
+        m_farTicks.pop();
+    }
+
+    // Handlers may schedule new ticks, which never go into the current bucket, so it can be swapped out safely
+    std::vector<ScheduledTick> &bucket = m_wheel[m_currentTick % WHEEL_SIZE];
+    m_dueTicks.clear();
+    std::swap(m_dueTicks, bucket);
+
+    size_t processed = 0;
+    for (; processed < m_dueTicks.size() && processed < MAX_SCHEDULED_TICKS_PER_TICK; processed++)
+    {
+        const ScheduledTick &scheduled = m_dueTicks[processed];
+        m_scheduledPositions.erase(scheduled.pos);
+
+        const BlockStateId state = m_world.getBlock(scheduled.pos);
+        if (state != scheduled.state)
+            continue;
+
+        if (Handler *handler = getHandler(m_scheduledTickHandlers, state); handler != nullptr)
+        {
+            (*handler)(scheduled.pos, state);
+            a_stats.scheduledTicks++;
+        }
+    }
+
+    // Whatever didn't fit into this tick is due on the next one
+    std::vector<ScheduledTick> &nextBucket = m_wheel[(m_currentTick + 1) % WHEEL_SIZE];
+    for (size_t i = processed; i < m_dueTicks.size(); i++)
+    {
+        nextBucket.push_back(m_dueTicks[i]);
+        nextBucket.back().dueTick = m_currentTick + 1;
+    }
+}
+
+void BlockTickScheduler::addRandomTickSections(const Chunk &a_chunk)
+{
+    const ChunkPos chunkPos = a_chunk.getPos();
+    for (int32_t sectionY = MIN_SECTION_Y; sectionY < MIN_SECTION_Y + SECTIONS_PER_CHUNK; sectionY++)
+    {
+        const ChunkSection *section = a_chunk.getSection(sectionY);
+        if (section != nullptr && section->getRandomTickingCount() > 0)
+            m_randomTickSections.push_back({chunkPos.x, sectionY, chunkPos.z});
+    }
+}
+
+void BlockTickScheduler::runRandomTicks(BlockTickStats &a_stats)
+{
+    if (m_randomTickSpeed == 0)
+        return;
+
+    a_stats.randomTickedSections = m_randomTickSections.size();
+
+    for (const SectionPos &sectionPos: m_randomTickSections)
+    {
+        const BlockPos origin = sectionPos.getOrigin();
+        for (uint32_t i = 0; i < m_randomTickSpeed; i++)
+        {
+            const ChunkSection *section = m_world.getSection(sectionPos);
+            if (section == nullptr)
+                break;
+
+            const uint32_t random = nextRandom();
+            const int32_t x = static_cast<int32_t>(random & 15);
+            const int32_t y = static_cast<int32_t>(random >> 4 & 15);
+            const int32_t z = static_cast<int32_t>(random >> 8 & 15);
+            const BlockStateId state = section->getBlock(x, y, z);
+            if (!Blocks::getProperties(state).ticksRandomly)
+                continue;
+
+            if (Handler *handler = getHandler(m_randomTickHandlers, state); handler != nullptr)
+            {
+                (*handler)(origin.offset(x, y, z), state);
+                a_stats.randomTicks++;
+            }
+        }
+    }
+}
+
+void BlockTickScheduler::runNeighborUpdates(BlockTickStats &a_stats)
+{
+    // Updates queued by the handlers run in the same tick, until the per tick limit is reached
+    for (size_t processed = 0; !m_neighborUpdates.empty() && processed < MAX_NEIGHBOR_UPDATES_PER_TICK; processed++)
+    {
+        const BlockPos pos = m_neighborUpdates.front();
+        m_neighborUpdates.pop_front();
+        m_pendingNeighborUpdates.erase(pos);
+
+        const BlockStateId state = m_world.getBlock(pos);
+        if (Handler *handler = getHandler(m_neighborUpdateHandlers, state); handler != nullptr)
+        {
+            (*handler)(pos, state);
+            a_stats.neighborUpdates++;
+        }
+    }
+}
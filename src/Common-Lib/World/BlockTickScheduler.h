@@ -0,0 +1,170 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <queue>
+#include <span>
+#include <unordered_set>
+#include <vector>
+
+#include "Utils/UniqueFunction.h"
+#include "BlockPos.h"
+#include "Blocks.h"
+#include "ChunkMap.h"
+
+namespace World
+{
+    struct BlockTickStats
+    {
+        std::chrono::nanoseconds duration{0};
+        size_t scheduledTicks = 0;
+        size_t randomTicks = 0;
+        size_t neighborUpdates = 0;
+        // Sections that contained at least one randomly ticking block
+        size_t randomTickedSections = 0;
+        // Neighbor updates that didn't fit into the queue
+        size_t droppedNeighborUpdates = 0;
+    };
+
+    // Runs the block updates of one world: scheduled ticks, random ticks & neighbor updates
+    // What a block does is up to its handlers, which may change blocks (& so schedule more work) while they run;
+    // every block change has to be reported through onBlockChanged()
+    class BlockTickScheduler final
+    {
+    public:
+        using Handler = Utils::UniqueFunction<void(const BlockPos &, BlockStateId)>;
+
+        struct ScheduledTick
+        {
+            BlockPos pos;
+            BlockStateId state = Blocks::AIR;
+            uint64_t dueTick = 0;
+
+            [[nodiscard]]
+            bool operator>(const ScheduledTick &a_other) const
+            {
+                return dueTick > a_other.dueTick;
+            }
+        };
+
+        // Scheduled ticks due within this many ticks are kept in the timing wheel, later ones wait in a heap
+        static constexpr uint64_t WHEEL_SIZE = 256;
+        static constexpr size_t MAX_SCHEDULED_TICKS_PER_TICK = 65536;
+        static constexpr size_t MAX_NEIGHBOR_UPDATES_PER_TICK = 65536;
+        // Pending neighbor updates beyond this are dropped, so update loops can't grow the queue forever
+        static constexpr size_t MAX_PENDING_NEIGHBOR_UPDATES = 1 << 20;
+
+        explicit BlockTickScheduler(const ChunkMap &a_world, uint32_t a_randomTickSpeed = 3);
+
+        void setScheduledTickHandler(BlockStateId a_state, Handler a_handler);
+
+        void setRandomTickHandler(BlockStateId a_state, Handler a_handler);
+
+        void setNeighborUpdateHandler(BlockStateId a_state, Handler a_handler);
+
+        // The tick runs a_delay ticks from now if the block at a_pos is still a_state by then
+        // Does nothing if a tick is already scheduled at a_pos
+        void scheduleTick(const BlockPos &a_pos, BlockStateId a_state, uint32_t a_delay);
+
+        [[nodiscard]]
+        bool isTickScheduled(const BlockPos &a_pos) const
+        {
+            return m_scheduledPositions.contains(a_pos);
+        }
+
+        // Queues neighbor updates for a_pos itself (so placed blocks can react too) & the 6 blocks around it
+        void onBlockChanged(const BlockPos &a_pos);
+
+        void queueNeighborUpdate(const BlockPos &a_pos);
+
+        // Removes every pending scheduled tick & neighbor update, to hand them to another scheduler (e.g. the one of
+        // another region); schedulers exchanging ticks have to agree on the current tick
+        void takePending(std::vector<ScheduledTick> &a_scheduledTicks, std::vector<BlockPos> &a_neighborUpdates);
+
+        // A tick taken from another scheduler, overdue ones run with the next tick()
+        void addScheduledTick(const ScheduledTick &a_tick);
+
+        // Random ticks sampled per section & tick
+        void setRandomTickSpeed(const uint32_t a_randomTickSpeed)
+        {
+            m_randomTickSpeed = a_randomTickSpeed;
+        }
+
+        BlockTickStats tick();
+
+        // Only random ticks blocks in the given chunks, scheduled ticks & neighbor updates run wherever they are
+        BlockTickStats tick(std::span<const ChunkPos> a_chunks);
+
+        // Cheap random numbers for the handlers, also used for picking random tick positions
+        [[nodiscard]]
+        uint32_t nextRandom();
+
+        // Must not be 0
+        void setRandomSeed(const uint32_t a_seed)
+        {
+            m_randomState = a_seed;
+        }
+
+        [[nodiscard]]
+        uint64_t getCurrentTick() const
+        {
+            return m_currentTick;
+        }
+
+        // Only while nothing is scheduled, ticks are stored with the tick they are due at
+        void setCurrentTick(const uint64_t a_tick)
+        {
+            m_currentTick = a_tick;
+        }
+
+        [[nodiscard]]
+        size_t getScheduledTickCount() const
+        {
+            return m_scheduledPositions.size();
+        }
+
+        [[nodiscard]]
+        size_t getPendingNeighborUpdateCount() const
+        {
+            return m_neighborUpdates.size();
+        }
+
+    private:
+        const ChunkMap &m_world;
+        uint32_t m_randomTickSpeed;
+        uint32_t m_randomState = 0x9E3779B9;
+        uint64_t m_currentTick = 0;
+
+        std::vector<Handler> m_scheduledTickHandlers;
+        std::vector<Handler> m_randomTickHandlers;
+        std::vector<Handler> m_neighborUpdateHandlers;
+
+        // Bucket dueTick % WHEEL_SIZE, holds only ticks due within WHEEL_SIZE ticks of the current one
+        std::array<std::vector<ScheduledTick>, WHEEL_SIZE> m_wheel;
+        std::priority_queue<ScheduledTick, std::vector<ScheduledTick>, std::greater<>> m_farTicks;
+        std::unordered_set<BlockPos> m_scheduledPositions;
+        std::vector<ScheduledTick> m_dueTicks;
+
+        std::deque<BlockPos> m_neighborUpdates;
+        std::unordered_set<BlockPos> m_pendingNeighborUpdates;
+
+        size_t m_droppedNeighborUpdates = 0;
+
+        std::vector<SectionPos> m_randomTickSections;
+
+        static void setHandler(std::vector<Handler> &a_handlers, BlockStateId a_state, Handler a_handler);
+
+        [[nodiscard]]
+        static Handler *getHandler(std::vector<Handler> &a_handlers, BlockStateId a_state);
+
+        void runScheduledTicks(BlockTickStats &a_stats);
+
+        void addRandomTickSections(const Chunk &a_chunk);
+
+        void runRandomTicks(BlockTickStats &a_stats);
+
+        void runNeighborUpdates(BlockTickStats &a_stats);
+    };
+}
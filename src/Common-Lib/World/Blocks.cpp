@@ -0,0 +1,77 @@
+#include <stdexcept>
+
+#include "Utils/Identifier.h"
+#include "Blocks.h"
+
+using World::BlockStateId, World::BlockProperties;
+
+[[nodiscard]]
+std::string vanillaName(const string &a_path)
+{
+    return Utils::Identifier::ofVanilla(a_path).value().toString();
+}
+
+[[nodiscard]]
+std::vector<BlockProperties> makeVanillaBlockStates()
+{
+    // Must match the order of the constants in World::Blocks
+    return {
+        {.name = vanillaName("air"), .collisionShape = &World::EMPTY_SHAPE, .isOpaque = false},
+        {.name = vanillaName("stone")},
+        {.name = vanillaName("dirt")},
+        {.name = vanillaName("grass_block"), .ticksRandomly = true},
+        {.name = vanillaName("sand")},
+        {.name = vanillaName("glass"), .isOpaque = false},
+        {.name = vanillaName("oak_log")},
+        {.name = vanillaName("oak_leaves"), .isOpaque = false},
+        {.name = vanillaName("stone_slab"), .collisionShape = &World::BOTTOM_SLAB_SHAPE, .isOpaque = false},
+        {.name = vanillaName("water"), .collisionShape = &World::EMPTY_SHAPE, .isOpaque = false},
+        {.name = vanillaName("bedrock")},
+    };
+}
+
+[[nodiscard]]
+std::vector<BlockProperties> &getBlockStateTable()
+{
+    static std::vector<BlockProperties> s_blockStates = makeVanillaBlockStates();
+    return s_blockStates;
+}
+
+BlockStateId World::Blocks::registerBlockState(BlockProperties a_properties)
+{
+    std::vector<BlockProperties> &table = getBlockStateTable();
+    if (table.size() > UINT16_MAX)
+    {
+        throw std::runtime_error("Too many block states, failed to register " + a_properties.name);
+    }
+
+    table.push_back(std::move(a_properties));
+    return static_cast<BlockStateId>(table.size() - 1);
+}
+
+const BlockProperties &World::Blocks::getProperties(const BlockStateId a_state)
+{
+    const std::vector<BlockProperties> &table = getBlockStateTable();
+    return a_state < table.size() ? table[a_state] : table[AIR];
+}
+
+const World::BlockShape &World::Blocks::getCollisionShape(const BlockStateId a_state)
+{
+    return *getProperties(a_state).collisionShape;
+}
+
+std::optional<BlockStateId> World::Blocks::findByName(const std::string &a_name)
+{
+    const std::vector<BlockProperties> &table = getBlockStateTable();
+    for (size_t i = 0; i < table.size(); i++)
+    {
+        if (table[i].name == a_name)
+            return static_cast<BlockStateId>(i);
+    }
+    return {};
+}
+
+size_t World::Blocks::getBlockStateCount()
+{
+    return getBlockStateTable().size();
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Utils/Aabb.h"
+
+namespace World
+{
+    using BlockStateId = uint16_t;
+
+    // Collision boxes of a block in block local coordinates (0 ... 1)
+    struct BlockShape
+    {
+        std::vector<Utils::Aabb> boxes;
+
+        [[nodiscard]]
+        bool isEmpty() const
+        {
+            return boxes.empty();
+        }
+    };
+
+    inline const BlockShape EMPTY_SHAPE{};
+    inline const BlockShape FULL_CUBE_SHAPE{{{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}}};
+    inline const BlockShape BOTTOM_SLAB_SHAPE{{{{0.0, 0.0, 0.0}, {1.0, 0.5, 1.0}}}};
+
+    struct BlockProperties
+    {
+        std::string name;
+        const BlockShape *collisionShape = &FULL_CUBE_SHAPE;
+        bool isOpaque = true;
+        // Whether random ticks are sampled for this block, sections keep count of these blocks
+        bool ticksRandomly = false;
+    };
+
+    namespace Blocks
+    {
+        // The vanilla block states, registered in this order on startup
+        inline constexpr BlockStateId AIR = 0;
+        inline constexpr BlockStateId STONE = 1;
+        inline constexpr BlockStateId DIRT = 2;
+        inline constexpr BlockStateId GRASS_BLOCK = 3;
+        inline constexpr BlockStateId SAND = 4;
+        inline constexpr BlockStateId GLASS = 5;
+        inline constexpr BlockStateId OAK_LOG = 6;
+        inline constexpr BlockStateId OAK_LEAVES = 7;
+        inline constexpr BlockStateId STONE_SLAB = 8;
+        inline constexpr BlockStateId WATER = 9;
+        inline constexpr BlockStateId BEDROCK = 10;
+
+        // Block states must be registered before any world is created, the table is read without locking afterward
+        BlockStateId registerBlockState(BlockProperties a_properties);
+
+        [[nodiscard]]
+        const BlockProperties &getProperties(BlockStateId a_state);
+
+        [[nodiscard]]
+        const BlockShape &getCollisionShape(BlockStateId a_state);
+
+        [[nodiscard]]
+        std::optional<BlockStateId> findByName(const std::string &a_name);
+
+        [[nodiscard]]
+        size_t getBlockStateCount();
+    }
+}
@@ -0,0 +1,37 @@
+#include "Chunk.h"
+
+using World::Chunk, World::BlockStateId;
+
+BlockStateId Chunk::setBlock(const BlockPos &a_pos, const BlockStateId a_state)
+{
+    const int32_t index = blockToSection(a_pos.y) - MIN_SECTION_Y;
+    if (index < 0 || index >= SECTIONS_PER_CHUNK)
+        return Blocks::AIR;
+
+    const int32_t x = blockToLocal(a_pos.x);
+    const int32_t y = blockToLocal(a_pos.y);
+    const int32_t z = blockToLocal(a_pos.z);
+    std::shared_ptr<ChunkSection> &section = m_sections[index];
+    if (section == nullptr)
+    {
+        if (a_state == Blocks::AIR)
+            return Blocks::AIR;
+        section.reset(new ChunkSection());
+    }
+    else if (section->getBlock(x, y, z) == a_state)
+    {
+        return a_state;
+    }
+    else if ((m_sharedSections >> index & 1) != 0)
+    {
+        // Copied even if the other references are gone by now, so nothing has to synchronize with the threads that held them
+        section.reset(new ChunkSection(*section));
+        m_sharedSections &= ~(1u << index);
+    }
+
+    const BlockStateId previous = section->setBlock(x, y, z, a_state);
+    m_dirtySections |= 1u << index;
+    if (section->isEmpty())
+        section.reset();
+    return previous;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+#include "BlockPos.h"
+#include "ChunkSection.h"
+
+namespace World
+{
+    // A column of SECTIONS_PER_CHUNK sections, sections that are entirely air aren't allocated
+    // Sections can be shared with other threads (see shareSection()), shared sections are copied before they change,
+    // so whoever shares one keeps reading the blocks as they were
+    class Chunk final
+    {
+    public:
+        explicit Chunk(const ChunkPos a_pos)
+            : m_pos(a_pos) {}
+
+        [[nodiscard]]
+        ChunkPos getPos() const
+        {
+            return m_pos;
+        }
+
+        // nullptr if the section is empty or a_sectionY is outside the world
+        [[nodiscard]]
+        const ChunkSection *getSection(const int32_t a_sectionY) const
+        {
+            const int32_t index = a_sectionY - MIN_SECTION_Y;
+            if (index < 0 || index >= SECTIONS_PER_CHUNK)
+                return nullptr;
+            return m_sections[index].get();
+        }
+
+        // A reference to the section that stays valid & unchanged however the chunk changes afterwards, e.g. for
+        // saving it on another thread; the next change of the section copies it
+        [[nodiscard]]
+        std::shared_ptr<const ChunkSection> shareSection(const int32_t a_sectionY)
+        {
+            const int32_t index = a_sectionY - MIN_SECTION_Y;
+            if (index < 0 || index >= SECTIONS_PER_CHUNK)
+                return nullptr;
+            if (m_sections[index] != nullptr)
+                m_sharedSections |= 1u << index;
+            return m_sections[index];
+        }
+
+        [[nodiscard]]
+        BlockStateId getBlock(const BlockPos &a_pos) const
+        {
+            const ChunkSection *section = getSection(blockToSection(a_pos.y));
+            return section == nullptr ? Blocks::AIR : section->getBlock(blockToLocal(a_pos.x), blockToLocal(a_pos.y), blockToLocal(a_pos.z));
+        }
+
+        // Replaces the whole section, nullptr makes it air; sections outside the world are ignored
+        void setSection(const int32_t a_sectionY, std::unique_ptr<ChunkSection> a_section)
+        {
+            const int32_t index = a_sectionY - MIN_SECTION_Y;
+            if (index >= 0 && index < SECTIONS_PER_CHUNK)
+            {
+                m_sections[index] = std::move(a_section);
+                m_sharedSections &= ~(1u << index);
+                m_dirtySections |= 1u << index;
+            }
+        }
+
+        // Returns the previous block state, positions outside the world are ignored
+        BlockStateId setBlock(const BlockPos &a_pos, BlockStateId a_state);
+
+        // Bit i is set if section MIN_SECTION_Y + i changed since the bits were last cleared
+        [[nodiscard]]
+        uint32_t getDirtySections() const
+        {
+            return m_dirtySections;
+        }
+
+        void clearDirtySections()
+        {
+            m_dirtySections = 0;
+        }
+
+    private:
+        ChunkPos m_pos;
+        std::array<std::shared_ptr<ChunkSection>, SECTIONS_PER_CHUNK> m_sections;
+        uint32_t m_dirtySections = 0;
+        // Bit i is set if m_sections[i] was shared since it was last copied, only touched by whoever changes the chunk
+        uint32_t m_sharedSections = 0;
+    };
+}
@@ -0,0 +1,34 @@
+#include "ChunkMap.h"
+
+using World::ChunkMap, World::Chunk, World::BlockStateId;
+
+Chunk &ChunkMap::getOrCreateChunk(const ChunkPos a_pos)
+{
+    std::unique_ptr<Chunk> &chunk = m_chunks[a_pos];
+    if (chunk == nullptr)
+        chunk = std::make_unique<Chunk>(a_pos);
+    return *chunk;
+}
+
+void ChunkMap::addChunk(std::unique_ptr<Chunk> a_chunk)
+{
+    const ChunkPos pos = a_chunk->getPos();
+    m_chunks[pos] = std::move(a_chunk);
+}
+
+std::unique_ptr<Chunk> ChunkMap::removeChunk(const ChunkPos a_pos)
+{
+    const auto found = m_chunks.find(a_pos);
+    if (found == m_chunks.end())
+        return nullptr;
+
+    std::unique_ptr<Chunk> chunk = std::move(found->second);
+    m_chunks.erase(found);
+    return chunk;
+}
+
+BlockStateId ChunkMap::setBlock(const BlockPos &a_pos, const BlockStateId a_state)
+{
+    Chunk *chunk = getChunk(ChunkPos::of(a_pos));
+    return chunk == nullptr ? Blocks::AIR : chunk->setBlock(a_pos, a_state);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+
+#include "BlockPos.h"
+#include "Chunk.h"
+
+namespace World
+{
+    // The loaded chunks of a world
+    // Reading is safe from any number of threads as long as nobody modifies the map or its chunks at the same time
+    class ChunkMap final
+    {
+    public:
+        [[nodiscard]]
+        const Chunk *getChunk(const ChunkPos a_pos) const
+        {
+            const auto found = m_chunks.find(a_pos);
+            return found == m_chunks.end() ? nullptr : found->second.get();
+        }
+
+        [[nodiscard]]
+        Chunk *getChunk(const ChunkPos a_pos)
+        {
+            const auto found = m_chunks.find(a_pos);
+            return found == m_chunks.end() ? nullptr : found->second.get();
+        }
+
+        Chunk &getOrCreateChunk(ChunkPos a_pos);
+
+        void addChunk(std::unique_ptr<Chunk> a_chunk);
+
+        std::unique_ptr<Chunk> removeChunk(ChunkPos a_pos);
+
+        // nullptr if the chunk isn't loaded or the section is empty
+        [[nodiscard]]
+        const ChunkSection *getSection(const SectionPos &a_pos) const
+        {
+            const Chunk *chunk = getChunk(ChunkPos::of(a_pos));
+            return chunk == nullptr ? nullptr : chunk->getSection(a_pos.y);
+        }
+
+        [[nodiscard]]
+        BlockStateId getBlock(const BlockPos &a_pos) const
+        {
+            const Chunk *chunk = getChunk(ChunkPos::of(a_pos));
+            return chunk == nullptr ? Blocks::AIR : chunk->getBlock(a_pos);
+        }
+
+        // Returns the previous block state, does nothing if the chunk isn't loaded
+        BlockStateId setBlock(const BlockPos &a_pos, BlockStateId a_state);
+
+        [[nodiscard]]
+        size_t getChunkCount() const
+        {
+            return m_chunks.size();
+        }
+
+        [[nodiscard]]
+        const std::unordered_map<ChunkPos, std::unique_ptr<Chunk>> &getChunks() const
+        {
+            return m_chunks;
+        }
+
+    private:
+        std::unordered_map<ChunkPos, std::unique_ptr<Chunk>> m_chunks;
+    };
+}
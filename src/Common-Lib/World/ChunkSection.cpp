@@ -0,0 +1,49 @@
+#include "Memory/FixedSizePool.h"
+#include "ChunkSection.h"
+
+using World::ChunkSection, World::BlockStateId;
+
+// 512 KiB
+constexpr size_t g_sectionsPerSlab = 64;
+
+// Never destroyed, sections may still be freed by the destructors of other statics; freed sections are kept for the
+// next ones instead of going back to the system
+Memory::FixedSizePool &getSectionPool()
+{
+    static auto *pool = new Memory::FixedSizePool(sizeof(ChunkSection), alignof(ChunkSection), g_sectionsPerSlab);
+    return *pool;
+}
+
+void *ChunkSection::operator new(const size_t a_bytes)
+{
+    void *pointer = getSectionPool().allocate(a_bytes, alignof(ChunkSection));
+    Memory::trackAllocation(Memory::MemoryTag::Chunks, a_bytes);
+    return pointer;
+}
+
+void ChunkSection::operator delete(void *a_pointer, const size_t a_bytes)
+{
+    getSectionPool().deallocate(a_pointer, a_bytes, alignof(ChunkSection));
+    Memory::trackDeallocation(Memory::MemoryTag::Chunks, a_bytes);
+}
+
+BlockStateId ChunkSection::setBlock(const int32_t a_x, const int32_t a_y, const int32_t a_z, const BlockStateId a_state)
+{
+    BlockStateId &block = m_blocks[getIndex(a_x, a_y, a_z)];
+    const BlockStateId previous = block;
+    if (previous == a_state)
+        return previous;
+
+    if (previous == Blocks::AIR)
+        m_nonAirCount++;
+    else if (a_state == Blocks::AIR)
+        m_nonAirCount--;
+
+    if (Blocks::getProperties(previous).ticksRandomly)
+        m_randomTickingCount--;
+    if (Blocks::getProperties(a_state).ticksRandomly)
+        m_randomTickingCount++;
+
+    block = a_state;
+    return previous;
+}
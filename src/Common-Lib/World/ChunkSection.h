@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "Memory/MemoryTracker.h"
+#include "BlockPos.h"
+#include "Blocks.h"
+
+namespace World
+{
+    // 16x16x16 blocks, stored as one block state per block
+    class ChunkSection final
+    {
+    public:
+        // Sections make up almost all chunk memory, so their allocations are what's tracked as MemoryTag::Chunks
+        // They come from a Memory::FixedSizePool, chunks are generated on the pipeline workers & unloaded on the ticking
+        // thread without either of them going through the global heap for every section
+        static void *operator new(size_t a_bytes);
+
+        static void operator delete(void *a_pointer, size_t a_bytes);
+
+        [[nodiscard]]
+        static constexpr size_t getIndex(const int32_t a_x, const int32_t a_y, const int32_t a_z)
+        {
+            return static_cast<size_t>(a_y << 8 | a_z << 4 | a_x);
+        }
+
+        [[nodiscard]]
+        BlockStateId getBlock(const int32_t a_x, const int32_t a_y, const int32_t a_z) const
+        {
+            return m_blocks[getIndex(a_x, a_y, a_z)];
+        }
+
+        // Returns the previous block state
+        BlockStateId setBlock(int32_t a_x, int32_t a_y, int32_t a_z, BlockStateId a_state);
+
+        [[nodiscard]]
+        bool isEmpty() const
+        {
+            return m_nonAirCount == 0;
+        }
+
+        [[nodiscard]]
+        uint16_t getNonAirCount() const
+        {
+            return m_nonAirCount;
+        }
+
+        // Blocks that receive random ticks, sections without any are skipped by the random tick sampling
+        [[nodiscard]]
+        uint16_t getRandomTickingCount() const
+        {
+            return m_randomTickingCount;
+        }
+
+        [[nodiscard]]
+        const std::array<BlockStateId, SECTION_VOLUME> &getBlocks() const
+        {
+            return m_blocks;
+        }
+
+    private:
+        std::array<BlockStateId, SECTION_VOLUME> m_blocks{};
+        uint16_t m_nonAirCount = 0;
+        uint16_t m_randomTickingCount = 0;
+    };
+}
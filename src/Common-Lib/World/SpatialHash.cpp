@@ -0,0 +1,125 @@
+#include "SpatialHash.h"
+
+using World::SpatialHash;
+
+SpatialHash::SpatialHash(const double a_cellSize)
+    : m_cellSize(a_cellSize), m_inverseCellSize(1.0 / a_cellSize) {}
+
+uint64_t SpatialHash::packCellKey(const int64_t a_x, const int64_t a_y, const int64_t a_z)
+{
+    // 21 bits per axis, far away cells may alias, which only costs a few extra box tests
+    constexpr uint64_t mask = (1 << 21) - 1;
+    return static_cast<uint64_t>(a_x) & mask
+           | (static_cast<uint64_t>(a_y) & mask) << 21
+           | (static_cast<uint64_t>(a_z) & mask) << 42;
+}
+
+glm::i64vec3 SpatialHash::getCellCoordinates(const glm::dvec3 &a_position) const
+{
+    return {
+        static_cast<int64_t>(std::floor(a_position.x * m_inverseCellSize)),
+        static_cast<int64_t>(std::floor(a_position.y * m_inverseCellSize)),
+        static_cast<int64_t>(std::floor(a_position.z * m_inverseCellSize))
+    };
+}
+
+uint32_t SpatialHash::getOrCreateCell(const glm::dvec3 &a_position)
+{
+    const glm::i64vec3 coordinates = getCellCoordinates(a_position);
+    const uint64_t key = packCellKey(coordinates.x, coordinates.y, coordinates.z);
+    if (const auto found = m_cellLookup.find(key); found != m_cellLookup.end())
+        return found->second;
+
+    const auto cell = static_cast<uint32_t>(m_cells.size());
+    m_cells.emplace_back();
+    m_cellLookup.emplace(key, cell);
+    return cell;
+}
+
+void SpatialHash::removeFromCell(const uint32_t a_cell, const uint32_t a_slot)
+{
+    std::vector<CellEntry> &entries = m_cells[a_cell].entries;
+    if (a_slot != entries.size() - 1)
+    {
+        entries[a_slot] = entries.back();
+        m_locations[entries[a_slot].entity.index].slot = a_slot;
+    }
+    entries.pop_back();
+
+    // Empty cells stay in the lookup & keep their capacity, mob farms tend to refill the same cells
+}
+
+void SpatialHash::insert(const Ecs::EntityId a_entity, const Utils::Aabb &a_box)
+{
+    update(a_entity, a_box);
+}
+
+void SpatialHash::update(const Ecs::EntityId a_entity, const Utils::Aabb &a_box)
+{
+    if (a_entity.index >= m_locations.size())
+        m_locations.resize(a_entity.index + 1);
+
+    const glm::dvec3 halfExtents = a_box.getHalfExtents();
+    m_maxHalfExtent = std::max({m_maxHalfExtent, halfExtents.x, halfExtents.y, halfExtents.z});
+
+    const uint32_t cell = getOrCreateCell(a_box.getCenter());
+    Location &location = m_locations[a_entity.index];
+
+    if (location.cell != Location::NONE)
+    {
+        if (location.cell == cell && location.generation == a_entity.generation)
+        {
+            m_cells[cell].entries[location.slot].box = a_box;
+            return;
+        }
+
+        removeFromCell(location.cell, location.slot);
+        m_size--;
+    }
+
+    location.cell = cell;
+    location.slot = static_cast<uint32_t>(m_cells[cell].entries.size());
+    location.generation = a_entity.generation;
+    m_cells[cell].entries.push_back({a_box, a_entity});
+    m_size++;
+}
+
+bool SpatialHash::remove(const Ecs::EntityId a_entity)
+{
+    if (!contains(a_entity))
+        return false;
+
+    Location &location = m_locations[a_entity.index];
+    removeFromCell(location.cell, location.slot);
+    location.cell = Location::NONE;
+    m_size--;
+    return true;
+}
+
+void SpatialHash::clear()
+{
+    m_cells.clear();
+    m_cellLookup.clear();
+    m_locations.clear();
+    m_maxHalfExtent = 0.0;
+    m_size = 0;
+}
+
+bool SpatialHash::contains(const Ecs::EntityId a_entity) const
+{
+    return a_entity.index < m_locations.size()
+           && m_locations[a_entity.index].cell != Location::NONE
+           && m_locations[a_entity.index].generation == a_entity.generation;
+}
+
+std::optional<SpatialHash::RayHit> SpatialHash::raycastNearest(const glm::dvec3 &a_origin, const glm::dvec3 &a_direction,
+                                                               const double a_maxDistance, const Ecs::EntityId a_ignored) const
+{
+    std::optional<RayHit> nearest;
+    forEachOnRay(a_origin, a_direction, a_maxDistance, [&](const Ecs::EntityId a_entity, const Utils::Aabb &, const double a_distance)
+    {
+        if (a_entity != a_ignored && (!nearest.has_value() || a_distance < nearest->distance))
+            nearest = RayHit{a_entity, a_distance};
+    });
+    return nearest;
+}
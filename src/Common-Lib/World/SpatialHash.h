@@ -0,0 +1,274 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "glm/vec3.hpp"
+
+#include "Ecs/EntityId.h"
+#include "Utils/Aabb.h"
+#include "Utils/JobSystem.h"
+
+namespace World
+{
+    // Loose uniform grid of entity bounding boxes
+    // Every entity lives in exactly one cell (the one containing its center), queries widen their search by the
+    // largest half extent seen so far, so moving an entity is only a cell change once its center crosses a border
+    // Queries report results through a visitor & never allocate, so they are safe to run concurrently with each other
+    // (but not with insert / update / remove)
+    class SpatialHash final
+    {
+    public:
+        struct RayHit
+        {
+            Ecs::EntityId entity;
+            double distance = 0.0;
+        };
+
+        explicit SpatialHash(double a_cellSize = 8.0);
+
+        void insert(Ecs::EntityId a_entity, const Utils::Aabb &a_box);
+
+        // Inserts the entity if it isn't in the index yet
+        void update(Ecs::EntityId a_entity, const Utils::Aabb &a_box);
+
+        bool remove(Ecs::EntityId a_entity);
+
+        void clear();
+
+        [[nodiscard]]
+        bool contains(Ecs::EntityId a_entity) const;
+
+        [[nodiscard]]
+        size_t size() const
+        {
+            return m_size;
+        }
+
+        [[nodiscard]]
+        double getCellSize() const
+        {
+            return m_cellSize;
+        }
+
+        // a_visitor(Ecs::EntityId, const Utils::Aabb &) for every entity whose box intersects a_box
+        template<typename F>
+        void forEachInAabb(const Utils::Aabb &a_box, F &&a_visitor) const
+        {
+            forEachCandidateCell(a_box.inflate(m_maxHalfExtent), [&](const Cell &a_cell)
+            {
+                for (const CellEntry &entry: a_cell.entries)
+                {
+                    if (entry.box.intersects(a_box))
+                        a_visitor(entry.entity, entry.box);
+                }
+            });
+        }
+
+        // a_visitor(Ecs::EntityId, const Utils::Aabb &) for every entity whose box is within a_radius of a_center
+        template<typename F>
+        void forEachInRadius(const glm::dvec3 &a_center, const double a_radius, F &&a_visitor) const
+        {
+            const double radiusSquared = a_radius * a_radius;
+            forEachCandidateCell(Utils::Aabb::fromCenter(a_center, glm::dvec3(a_radius + m_maxHalfExtent)), [&](const Cell &a_cell)
+            {
+                for (const CellEntry &entry: a_cell.entries)
+                {
+                    if (entry.box.distanceSquaredTo(a_center) <= radiusSquared)
+                        a_visitor(entry.entity, entry.box);
+                }
+            });
+        }
+
+        // a_visitor(Ecs::EntityId, const Utils::Aabb &, double distance) for every entity hit by the ray segment
+        // a_direction must be normalized, hits are reported roughly (not strictly) in order of distance
+        template<typename F>
+        void forEachOnRay(const glm::dvec3 &a_origin, const glm::dvec3 &a_direction, const double a_maxDistance, F &&a_visitor) const
+        {
+            const glm::dvec3 inverseDirection = 1.0 / a_direction;
+
+            // Walk the ray in segments of one cell length, every segment visits the (loose) cells its bounding box
+            // touches except those the previous segment already visited; since the segment boxes move monotonically
+            // along every axis, a cell can't be part of two segments without also being part of the one between them
+            CellRange previous{};
+            bool hasPrevious = false;
+            for (double start = 0.0; start < a_maxDistance; start += m_cellSize)
+            {
+                const double end = std::min(start + m_cellSize, a_maxDistance);
+                const glm::dvec3 from = a_origin + a_direction * start;
+                const glm::dvec3 to = a_origin + a_direction * end;
+                const Utils::Aabb segment{glm::min(from, to), glm::max(from, to)};
+                const CellRange range = getCellRange(segment.inflate(m_maxHalfExtent));
+
+                forEachCellIn(range, hasPrevious ? &previous : nullptr, [&](const Cell &a_cell)
+                {
+                    for (const CellEntry &entry: a_cell.entries)
+                    {
+                        if (const double distance = entry.box.intersectRay(a_origin, inverseDirection, a_maxDistance); distance >= 0.0)
+                            a_visitor(entry.entity, entry.box, distance);
+                    }
+                });
+
+                previous = range;
+                hasPrevious = true;
+            }
+        }
+
+        [[nodiscard]]
+        std::optional<RayHit> raycastNearest(const glm::dvec3 &a_origin, const glm::dvec3 &a_direction, double a_maxDistance,
+                                             Ecs::EntityId a_ignored = Ecs::NULL_ENTITY) const;
+
+        // a_visitor(size_t queryIndex, Ecs::EntityId, const Utils::Aabb &) for every hit of every query
+        // With a job system the queries are spread over its threads, so a_visitor has to be thread safe
+        template<typename F>
+        void forEachInAabbBatch(std::span<const Utils::Aabb> a_queries, F &&a_visitor, Utils::JobSystem *a_jobSystem = nullptr) const
+        {
+            runBatch(a_queries.size(), a_jobSystem, [&](const size_t a_query)
+            {
+                forEachInAabb(a_queries[a_query], [&](const Ecs::EntityId a_entity, const Utils::Aabb &a_box)
+                {
+                    a_visitor(a_query, a_entity, a_box);
+                });
+            });
+        }
+
+        // a_visitor(size_t queryIndex, Ecs::EntityId, const Utils::Aabb &), see forEachInAabbBatch()
+        template<typename F>
+        void forEachInRadiusBatch(std::span<const glm::dvec3> a_centers, const double a_radius, F &&a_visitor,
+                                  Utils::JobSystem *a_jobSystem = nullptr) const
+        {
+            runBatch(a_centers.size(), a_jobSystem, [&](const size_t a_query)
+            {
+                forEachInRadius(a_centers[a_query], a_radius, [&](const Ecs::EntityId a_entity, const Utils::Aabb &a_box)
+                {
+                    a_visitor(a_query, a_entity, a_box);
+                });
+            });
+        }
+
+    private:
+        struct CellEntry
+        {
+            Utils::Aabb box;
+            Ecs::EntityId entity;
+        };
+
+        struct Cell
+        {
+            std::vector<CellEntry> entries;
+        };
+
+        struct CellRange
+        {
+            glm::i64vec3 min{0};
+            glm::i64vec3 max{0};
+
+            [[nodiscard]]
+            bool contains(const int64_t a_x, const int64_t a_y, const int64_t a_z) const
+            {
+                return a_x >= min.x && a_x <= max.x && a_y >= min.y && a_y <= max.y && a_z >= min.z && a_z <= max.z;
+            }
+        };
+
+        // Where an entity is stored, indexed by Ecs::EntityId::index
+        struct Location
+        {
+            static constexpr uint32_t NONE = UINT32_MAX;
+
+            uint32_t cell = NONE;
+            uint32_t slot = 0;
+            uint32_t generation = 0;
+        };
+
+        double m_cellSize;
+        double m_inverseCellSize;
+        double m_maxHalfExtent = 0.0;
+        size_t m_size = 0;
+        std::vector<Cell> m_cells;
+        std::unordered_map<uint64_t, uint32_t> m_cellLookup;
+        std::vector<Location> m_locations;
+
+        [[nodiscard]]
+        static uint64_t packCellKey(int64_t a_x, int64_t a_y, int64_t a_z);
+
+        [[nodiscard]]
+        glm::i64vec3 getCellCoordinates(const glm::dvec3 &a_position) const;
+
+        [[nodiscard]]
+        CellRange getCellRange(const Utils::Aabb &a_box) const
+        {
+            return {getCellCoordinates(a_box.min), getCellCoordinates(a_box.max)};
+        }
+
+        [[nodiscard]]
+        const Cell *findCell(const int64_t a_x, const int64_t a_y, const int64_t a_z) const
+        {
+            const auto found = m_cellLookup.find(packCellKey(a_x, a_y, a_z));
+            return found == m_cellLookup.end() ? nullptr : &m_cells[found->second];
+        }
+
+        uint32_t getOrCreateCell(const glm::dvec3 &a_position);
+
+        void removeFromCell(uint32_t a_cell, uint32_t a_slot);
+
+        template<typename F>
+        void forEachCellIn(const CellRange &a_range, const CellRange *a_skipped, F &&a_function) const
+        {
+            // Iterate the lookup table instead when the range covers more cells than exist
+            const auto volume = static_cast<uint64_t>(a_range.max.x - a_range.min.x + 1)
+                                * static_cast<uint64_t>(a_range.max.y - a_range.min.y + 1)
+                                * static_cast<uint64_t>(a_range.max.z - a_range.min.z + 1);
+            if (volume > m_cellLookup.size() && a_skipped == nullptr)
+            {
+                for (const auto &[key, cell]: m_cellLookup)
+                {
+                    if (!m_cells[cell].entries.empty())
+                        a_function(m_cells[cell]);
+                }
+                return;
+            }
+
+            for (int64_t x = a_range.min.x; x <= a_range.max.x; x++)
+            {
+                for (int64_t z = a_range.min.z; z <= a_range.max.z; z++)
+                {
+                    for (int64_t y = a_range.min.y; y <= a_range.max.y; y++)
+                    {
+                        if (a_skipped != nullptr && a_skipped->contains(x, y, z))
+                            continue;
+
+                        if (const Cell *cell = findCell(x, y, z); cell != nullptr && !cell->entries.empty())
+                            a_function(*cell);
+                    }
+                }
+            }
+        }
+
+        template<typename F>
+        void forEachCandidateCell(const Utils::Aabb &a_box, F &&a_function) const
+        {
+            forEachCellIn(getCellRange(a_box), nullptr, std::forward<F>(a_function));
+        }
+
+        template<typename F>
+        static void runBatch(const size_t a_count, Utils::JobSystem *a_jobSystem, F &&a_function)
+        {
+            if (a_jobSystem == nullptr)
+            {
+                for (size_t i = 0; i < a_count; i++)
+                    a_function(i);
+                return;
+            }
+
+            a_jobSystem->parallelFor(a_count, 64, [&a_function](const size_t a_begin, const size_t a_end)
+            {
+                for (size_t i = a_begin; i < a_end; i++)
+                    a_function(i);
+            });
+        }
+    };
+}
@@ -0,0 +1,242 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "VoxelRaycaster.h"
+
+using World::VoxelRaycaster, World::RaycastHit;
+
+constexpr double g_infinity = std::numeric_limits<double>::infinity();
+
+// The face a ray moving along a_axis in direction a_step enters a block through
+[[nodiscard]]
+constexpr World::Face getEntryFace(const int a_axis, const int a_step)
+{
+    constexpr World::Face positiveEntries[3]{World::Face::West, World::Face::Down, World::Face::North};
+    const World::Face face = positiveEntries[a_axis];
+    return a_step > 0 ? face : World::getOpposite(face);
+}
+
+// Tests the ray against the collision boxes of the block at a_pos, keeps the closest hit in a_hit
+bool intersectShape(const World::BlockShape &a_shape, const World::BlockPos &a_pos, const glm::dvec3 &a_origin,
+                    const glm::dvec3 &a_inverseDirection, const double a_maxDistance, RaycastHit &a_hit)
+{
+    const glm::dvec3 blockOrigin(a_pos.x, a_pos.y, a_pos.z);
+    bool hit = false;
+    for (const Utils::Aabb &localBox: a_shape.boxes)
+    {
+        const Utils::Aabb box = localBox.offset(blockOrigin);
+        const double distance = box.intersectRay(a_origin, a_inverseDirection, hit ? a_hit.distance : a_maxDistance);
+        if (distance < 0.0)
+            continue;
+
+        // The ray enters through the slab it crosses last
+        int entryAxis = 0;
+        double entryDistance = -g_infinity;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            const double bound = a_inverseDirection[axis] >= 0.0 ? box.min[axis] : box.max[axis];
+            const double axisDistance = (bound - a_origin[axis]) * a_inverseDirection[axis];
+            if (axisDistance > entryDistance)
+            {
+                entryDistance = axisDistance;
+                entryAxis = axis;
+            }
+        }
+
+        a_hit.distance = distance;
+        a_hit.face = getEntryFace(entryAxis, a_inverseDirection[entryAxis] >= 0.0 ? 1 : -1);
+        hit = true;
+    }
+    return hit;
+}
+
+VoxelRaycaster::VoxelRaycaster(const ChunkMap &a_world)
+    : m_world(a_world)
+{
+    const size_t stateCount = Blocks::getBlockStateCount();
+    for (std::vector<BlockHitKind> &hitKinds: m_hitKinds)
+        hitKinds.resize(stateCount, BlockHitKind::None);
+
+    for (size_t state = 0; state < stateCount; state++)
+    {
+        const BlockProperties &properties = Blocks::getProperties(static_cast<BlockStateId>(state));
+        if (properties.collisionShape == &FULL_CUBE_SHAPE)
+            m_hitKinds[static_cast<size_t>(RaycastMode::Collider)][state] = BlockHitKind::FullBlock;
+        else if (!properties.collisionShape->isEmpty())
+            m_hitKinds[static_cast<size_t>(RaycastMode::Collider)][state] = BlockHitKind::Shape;
+
+        if (properties.isOpaque)
+            m_hitKinds[static_cast<size_t>(RaycastMode::Opaque)][state] = BlockHitKind::FullBlock;
+    }
+}
+
+std::optional<RaycastHit> VoxelRaycaster::cast(const Ray &a_ray, const RaycastMode a_mode) const
+{
+    const std::vector<BlockHitKind> &hitKinds = m_hitKinds[static_cast<size_t>(a_mode)];
+    const glm::dvec3 inverseDirection = 1.0 / a_ray.direction;
+
+    int32_t cell[3];
+    int step[3];
+    double tMax[3];
+    double tDelta[3];
+    int dominantAxis = 0;
+    for (int axis = 0; axis < 3; axis++)
+    {
+        const double origin = a_ray.origin[axis];
+        const double direction = a_ray.direction[axis];
+        cell[axis] = static_cast<int32_t>(std::floor(origin));
+        step[axis] = direction > 0.0 ? 1 : direction < 0.0 ? -1 : 0;
+        tDelta[axis] = step[axis] == 0 ? g_infinity : std::abs(inverseDirection[axis]);
+        tMax[axis] = step[axis] > 0 ? (cell[axis] + 1 - origin) * inverseDirection[axis]
+                     : step[axis] < 0 ? (cell[axis] - origin) * inverseDirection[axis]
+                     : g_infinity;
+        if (std::abs(direction) > std::abs(a_ray.direction[dominantAxis]))
+            dominantAxis = axis;
+    }
+
+    // A ray starting inside a block counts as having entered it along its main direction
+    Face face = getEntryFace(dominantAxis, step[dominantAxis] == 0 ? 1 : step[dominantAxis]);
+    double t = 0.0;
+
+    const Chunk *chunk = nullptr;
+    ChunkPos chunkPos{};
+    bool hasChunk = false;
+
+    while (t <= a_ray.maxDistance)
+    {
+        if ((cell[1] < MIN_BLOCK_Y && step[1] <= 0) || (cell[1] > MAX_BLOCK_Y && step[1] >= 0))
+            return std::nullopt;
+
+        const SectionPos sectionPos{blockToSection(cell[0]), blockToSection(cell[1]), blockToSection(cell[2])};
+        if (!hasChunk || chunkPos != ChunkPos::of(sectionPos))
+        {
+            chunkPos = ChunkPos::of(sectionPos);
+            chunk = m_world.getChunk(chunkPos);
+            hasChunk = true;
+        }
+
+        const ChunkSection *section = chunk == nullptr ? nullptr : chunk->getSection(sectionPos.y);
+        if (section == nullptr)
+        {
+            // Jump straight to the first block of the next section, every axis moves by the number of block
+            // borders it crosses before the ray leaves the section, which keeps tMax consistent
+            int exitAxis = 0;
+            double exitDistance = g_infinity;
+            int32_t remaining[3]{};
+            for (int axis = 0; axis < 3; axis++)
+            {
+                if (step[axis] == 0)
+                    continue;
+
+                const int32_t local = blockToLocal(cell[axis]);
+                remaining[axis] = step[axis] > 0 ? SECTION_SIZE - 1 - local : local;
+                const double axisExit = tMax[axis] + tDelta[axis] * remaining[axis];
+                if (axisExit < exitDistance)
+                {
+                    exitDistance = axisExit;
+                    exitAxis = axis;
+                }
+            }
+
+            for (int axis = 0; axis < 3; axis++)
+            {
+                if (step[axis] == 0)
+                    continue;
+
+                int32_t crossings;
+                if (axis == exitAxis)
+                    crossings = remaining[axis] + 1;
+                else if (tMax[axis] > exitDistance)
+                    crossings = 0;
+                else
+                    crossings = std::min(static_cast<int32_t>((exitDistance - tMax[axis]) / tDelta[axis]) + 1, remaining[axis]);
+
+                cell[axis] += step[axis] * crossings;
+                tMax[axis] += tDelta[axis] * crossings;
+            }
+
+            t = exitDistance;
+            face = getEntryFace(exitAxis, step[exitAxis]);
+            continue;
+        }
+
+        const BlockStateId state = section->getBlock(blockToLocal(cell[0]), blockToLocal(cell[1]), blockToLocal(cell[2]));
+        if (const BlockHitKind kind = state < hitKinds.size() ? hitKinds[state] : BlockHitKind::None; kind != BlockHitKind::None)
+        {
+            RaycastHit hit{{cell[0], cell[1], cell[2]}, state, face, t};
+            if (kind == BlockHitKind::FullBlock)
+                return hit;
+
+            if (intersectShape(Blocks::getCollisionShape(state), hit.pos, a_ray.origin, inverseDirection, a_ray.maxDistance, hit))
+                return hit;
+        }
+
+        const int axis = tMax[0] < tMax[1] ? (tMax[0] < tMax[2] ? 0 : 2) : (tMax[1] < tMax[2] ? 1 : 2);
+        t = tMax[axis];
+        cell[axis] += step[axis];
+        tMax[axis] += tDelta[axis];
+        face = getEntryFace(axis, step[axis]);
+    }
+
+    return std::nullopt;
+}
+
+void VoxelRaycaster::castBatch(const std::span<const Ray> a_rays, const std::span<std::optional<RaycastHit>> a_results,
+                               const RaycastMode a_mode, Utils::JobSystem *a_jobSystem) const
+{
+    if (a_jobSystem == nullptr)
+    {
+        for (size_t i = 0; i < a_rays.size(); i++)
+            a_results[i] = cast(a_rays[i], a_mode);
+        return;
+    }
+
+    a_jobSystem->parallelFor(a_rays.size(), 64, [&](const size_t a_begin, const size_t a_end)
+    {
+        for (size_t i = a_begin; i < a_end; i++)
+            a_results[i] = cast(a_rays[i], a_mode);
+    });
+}
+
+bool VoxelRaycaster::hasLineOfSight(const glm::dvec3 &a_from, const glm::dvec3 &a_to) const
+{
+    const glm::dvec3 delta = a_to - a_from;
+    const double distance = std::sqrt(delta.x * delta.x + delta.y * delta.y + delta.z * delta.z);
+    if (distance == 0.0)
+        return true;
+
+    return !cast({a_from, delta / distance, distance}, RaycastMode::Opaque).has_value();
+}
+
+float VoxelRaycaster::computeExposure(const glm::dvec3 &a_source, const Utils::Aabb &a_box) const
+{
+    // About two sample points per block along every axis, including the corners, like vanilla
+    const glm::dvec3 size = a_box.max - a_box.min;
+    int32_t steps[3];
+    for (int axis = 0; axis < 3; axis++)
+        steps[axis] = static_cast<int32_t>(std::floor(size[axis] * 2.0 + 1.0));
+
+    size_t reached = 0;
+    size_t total = 0;
+    for (int32_t x = 0; x <= steps[0]; x++)
+    {
+        for (int32_t y = 0; y <= steps[1]; y++)
+        {
+            for (int32_t z = 0; z <= steps[2]; z++)
+            {
+                const glm::dvec3 point(
+                    a_box.min.x + size.x * x / steps[0],
+                    a_box.min.y + size.y * y / steps[1],
+                    a_box.min.z + size.z * z / steps[2]
+                );
+                const glm::dvec3 delta = point - a_source;
+                const double distance = std::sqrt(delta.x * delta.x + delta.y * delta.y + delta.z * delta.z);
+                total++;
+                if (distance == 0.0 || !cast({a_source, delta / distance, distance}).has_value())
+                    reached++;
+            }
+        }
+    }
+    return static_cast<float>(reached) / static_cast<float>(total);
+}
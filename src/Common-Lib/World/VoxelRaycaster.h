@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "glm/vec3.hpp"
+
+#include "Utils/Aabb.h"
+#include "Utils/JobSystem.h"
+#include "BlockPos.h"
+#include "Blocks.h"
+#include "ChunkMap.h"
+
+namespace World
+{
+    // What a ray stops at
+    enum class RaycastMode : uint8_t
+    {
+        // Collision boxes, what block picking & explosions use
+        Collider,
+        // Whole opaque blocks, for line of sight checks
+        Opaque
+    };
+
+    struct Ray
+    {
+        glm::dvec3 origin{0.0};
+        // Must be normalized
+        glm::dvec3 direction{0.0, 0.0, 1.0};
+        double maxDistance = 0.0;
+    };
+
+    struct RaycastHit
+    {
+        BlockPos pos;
+        BlockStateId state = Blocks::AIR;
+        // The face of the block the ray entered through
+        Face face = Face::Down;
+        double distance = 0.0;
+    };
+
+    // 3D DDA over the block grid, reading sections directly; empty & unloaded sections are crossed in one step
+    // Casting is read only, any number of rays can be cast concurrently as long as the world isn't modified
+    class VoxelRaycaster final
+    {
+    public:
+        // Reads the block table, so every block state has to be registered by then
+        explicit VoxelRaycaster(const ChunkMap &a_world);
+
+        [[nodiscard]]
+        std::optional<RaycastHit> cast(const Ray &a_ray, RaycastMode a_mode = RaycastMode::Collider) const;
+
+        // a_results[i] is the hit of a_rays[i], with a job system the rays are spread over its threads
+        void castBatch(std::span<const Ray> a_rays, std::span<std::optional<RaycastHit>> a_results,
+                       RaycastMode a_mode = RaycastMode::Collider, Utils::JobSystem *a_jobSystem = nullptr) const;
+
+        [[nodiscard]]
+        bool hasLineOfSight(const glm::dvec3 &a_from, const glm::dvec3 &a_to) const;
+
+        // Fraction of sample points spread over a_box that a_source can reach without hitting a collision box,
+        // what explosions scale their damage & knockback by
+        [[nodiscard]]
+        float computeExposure(const glm::dvec3 &a_source, const Utils::Aabb &a_box) const;
+
+    private:
+        enum class BlockHitKind : uint8_t
+        {
+            None,
+            // The ray stops at the border of the block
+            FullBlock,
+            // The ray has to be tested against the collision boxes of the block
+            Shape
+        };
+
+        const ChunkMap &m_world;
+        // Per block state & RaycastMode, so the DDA loop doesn't look at block properties
+        std::vector<BlockHitKind> m_hitKinds[2];
+    };
+}
@@ -0,0 +1,197 @@
+#include <cmath>
+#include <format>
+#include <numbers>
+
+#include "Network/Packets.h"
+#include "Network/TcpConnection.h"
+#include "World/Blocks.h"
+#include "Bot.h"
+
+using LoadTest::Bot, LoadTest::Clock;
+namespace Packets = Network::Packets;
+
+// Like the client, bots act once per server tick
+constexpr std::chrono::milliseconds g_tickDuration(50);
+// Blocks per second, about a player walking
+constexpr double g_walkingSpeed = 4.3;
+// Path centers are at most this far from the spawn, so the paths stay within the spawn area
+constexpr double g_pathArea = 96.0;
+constexpr double g_minPathRadius = 4.0;
+constexpr double g_maxPathRadius = 16.0;
+// Ticks between KeepAlives, placing or breaking a block & chat messages
+constexpr uint64_t g_keepAliveInterval = 20;
+constexpr uint64_t g_blockInterval = 40;
+constexpr uint64_t g_chatInterval = 600;
+// How far in front of the bot blocks are placed
+constexpr double g_reach = 2.0;
+
+Bot::Bot(const uint32_t a_id, const uint64_t a_seed, const bool a_recordTickTimes)
+    : m_id(a_id), m_recordTickTimes(a_recordTickTimes)
+{
+    std::seed_seq seed{static_cast<uint32_t>(a_seed), static_cast<uint32_t>(a_seed >> 32), a_id};
+    m_random.seed(seed);
+
+    std::uniform_real_distribution area(-g_pathArea, g_pathArea);
+    std::uniform_real_distribution radius(g_minPathRadius, g_maxPathRadius);
+    std::uniform_real_distribution angle(0.0, 2.0 * std::numbers::pi);
+    m_center = {area(m_random), 0.0, area(m_random)};
+    m_radius = radius(m_random);
+    m_angle = angle(m_random);
+    m_blockPhase = std::uniform_int_distribution<uint64_t>(0, g_blockInterval - 1)(m_random);
+    m_chatPhase = std::uniform_int_distribution<uint64_t>(0, g_chatInterval - 1)(m_random);
+}
+
+bool Bot::connect(asio::thread_pool &a_networkThreads, const asio::ip::tcp::endpoint &a_endpoint)
+{
+    m_stats.connectedAt = Clock::now();
+    asio::ip::tcp::socket socket(asio::make_strand(a_networkThreads));
+    asio::error_code error;
+    socket.connect(a_endpoint, error);
+    if (error)
+    {
+        m_stats.failedToConnect = true;
+        m_stats.disconnectedAt = m_stats.connectedAt;
+        return false;
+    }
+
+    m_connection.emplace(Network::createTcpConnection(std::move(socket)));
+    m_nextTick = Clock::now();
+    send(Packets::Login{std::format("Bot{}", m_id)});
+    return true;
+}
+
+void Bot::update(const Clock::time_point a_now)
+{
+    if (!isConnected())
+        return;
+
+    try
+    {
+        // Every buffer holds whole frames
+        while (std::optional<Network::PooledBuffer> buffer = m_connection->receive())
+        {
+            m_stats.bytesReceived += buffer->getData().size();
+            std::span<const std::byte> data = buffer->getData();
+            while (const std::optional<Network::PacketFrame> frame = Network::readFrame(data))
+            {
+                handlePacket(*frame, a_now);
+                data = data.subspan(frame->frameSize);
+            }
+            if (!data.empty())
+                throw Network::ProtocolError("Incomplete packet frame");
+        }
+    } catch (const Network::ProtocolError &)
+    {
+        m_connection->close();
+    }
+
+    if (m_connection->isClosed())
+    {
+        m_stats.lostConnection = true;
+        m_stats.disconnectedAt = a_now;
+        return;
+    }
+
+    if (m_loggedIn && a_now >= m_nextTick)
+    {
+        tick(a_now);
+        m_nextTick += g_tickDuration;
+        // A driver that fell behind doesn't make up for the missed ticks
+        if (m_nextTick < a_now)
+            m_nextTick = a_now + g_tickDuration;
+    }
+}
+
+void Bot::disconnect()
+{
+    if (!isConnected())
+        return;
+
+    m_connection->close();
+    m_stats.disconnectedAt = Clock::now();
+}
+
+void Bot::tick(const Clock::time_point a_now)
+{
+    m_tick++;
+
+    m_angle += g_walkingSpeed * std::chrono::duration<double>(g_tickDuration).count() / m_radius;
+    m_position.x = m_center.x + std::cos(m_angle) * m_radius;
+    m_position.z = m_center.z + std::sin(m_angle) * m_radius;
+    // Walking along the circle, counterclockwise
+    const glm::dvec3 direction(-std::sin(m_angle), 0.0, std::cos(m_angle));
+    const auto yaw = static_cast<float>(std::atan2(-direction.x, direction.z) * 180.0 / std::numbers::pi);
+    send(Packets::EntityPosition{{0}, m_position.x, m_position.y, m_position.z, yaw, 0.0f, true});
+
+    if (m_tick % g_blockInterval == m_blockPhase)
+    {
+        if (m_placedBlock.has_value())
+        {
+            send(Packets::BlockChange{*m_placedBlock, {World::Blocks::AIR}});
+            m_placedBlock.reset();
+        }
+        else
+        {
+            m_placedBlock = World::BlockPos::containing(m_position + direction * g_reach);
+            send(Packets::BlockChange{*m_placedBlock, {World::Blocks::STONE}});
+        }
+    }
+
+    if (m_tick % g_chatInterval == m_chatPhase)
+        send(Packets::ChatMessage{std::format("Bot{} at tick {}", m_id, m_tick), 0});
+
+    if (m_tick % g_keepAliveInterval == 0)
+        send(Packets::KeepAlive{std::chrono::duration_cast<std::chrono::microseconds>(a_now.time_since_epoch()).count()});
+}
+
+void Bot::handlePacket(const Network::PacketFrame &a_frame, const Clock::time_point a_now)
+{
+    switch (a_frame.id)
+    {
+        case Packets::LoginSuccess::ID:
+        {
+            const auto packet = Network::decodePacket<Packets::LoginSuccess>(a_frame.body);
+            m_loggedIn = true;
+            m_position.y = packet.y;
+            m_stats.loginLatency = std::chrono::duration_cast<std::chrono::microseconds>(a_now - m_stats.connectedAt);
+            break;
+        }
+        case Packets::KeepAlive::ID:
+        {
+            const std::chrono::microseconds sent(Network::decodePacket<Packets::KeepAlive>(a_frame.body).id);
+            m_stats.roundTrips.push_back(std::chrono::duration_cast<std::chrono::microseconds>(a_now.time_since_epoch()) - sent);
+            break;
+        }
+        case Packets::TickTimes::ID:
+        {
+            if (!m_recordTickTimes)
+                break;
+
+            Network::PacketReader reader(Network::decodePacket<Packets::TickTimes>(a_frame.body).durations);
+            while (reader.getRemaining() > 0)
+            {
+                const int32_t duration = reader.readVarInt();
+                if (reader.hasFailed())
+                    throw Network::ProtocolError("Malformed tick times");
+                m_stats.tickTimes.emplace_back(duration);
+            }
+            break;
+        }
+        case Packets::SetCompression::ID:
+            // The transport switched to compression when it passed through
+            break;
+        case Packets::EntitySnapshot::ID:
+            // Acked without decoding, so the server sends deltas like it would to a real client
+            send(Packets::SnapshotAck{Network::decodePacket<Packets::EntitySnapshot>(a_frame.body).tick});
+            break;
+        case Packets::ChunkSectionData::ID:
+        case Packets::BlockChange::ID:
+        case Packets::MultiBlockChange::ID:
+        case Packets::UnloadChunk::ID:
+        case Packets::ChatMessage::ID:
+            // Only counted
+            break;
+        default:
+            throw Network::ProtocolError(std::format("Unexpected packet {}", a_frame.id));
+    }
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "asio.hpp"
+#include "glm/vec3.hpp"
+
+#include "Network/BufferPool.h"
+#include "Network/Connection.h"
+#include "World/BlockPos.h"
+
+namespace LoadTest
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct BotStats
+    {
+        uint64_t bytesSent = 0;
+        uint64_t bytesReceived = 0;
+        // From starting to connect until the LoginSuccess arrived
+        std::optional<std::chrono::microseconds> loginLatency;
+        // KeepAlive round trips
+        std::vector<std::chrono::microseconds> roundTrips;
+        // Server tick durations from the TickTimes packets, only kept by the bot recording them
+        std::vector<std::chrono::microseconds> tickTimes;
+        Clock::time_point connectedAt;
+        Clock::time_point disconnectedAt;
+        bool failedToConnect = false;
+        // The server closed the connection before the bot disconnected
+        bool lostConnection = false;
+    };
+
+    // A simulated player: logs in, walks a circle around a random point of the spawn area, places & breaks blocks in
+    // front of itself & chats, everything driven by its seed, so a load profile can be reproduced
+    // Used by one driver thread at a time
+    class Bot final
+    {
+    public:
+        Bot(uint32_t a_id, uint64_t a_seed, bool a_recordTickTimes);
+
+        Bot(const Bot &) = delete;
+
+        Bot &operator=(const Bot &) = delete;
+
+        // Connects synchronously & sends the login, false if the server couldn't be reached; the socket works on a
+        // strand of the network threads
+        bool connect(asio::thread_pool &a_networkThreads, const asio::ip::tcp::endpoint &a_endpoint);
+
+        // Handles what was received & runs the script once per client tick
+        void update(Clock::time_point a_now);
+
+        void disconnect();
+
+        [[nodiscard]]
+        bool isConnected() const
+        {
+            return m_connection.has_value() && !m_connection->isClosed();
+        }
+
+        [[nodiscard]]
+        bool isLoggedIn() const
+        {
+            return m_loggedIn;
+        }
+
+        [[nodiscard]]
+        const BotStats &getStats() const
+        {
+            return m_stats;
+        }
+
+    private:
+        uint32_t m_id;
+        std::mt19937_64 m_random;
+        bool m_recordTickTimes;
+        std::optional<Network::Connection> m_connection;
+        Network::BufferPool m_buffers;
+        BotStats m_stats;
+        bool m_loggedIn = false;
+        uint64_t m_tick = 0;
+        Clock::time_point m_nextTick;
+
+        // The scripted path, a circle walked at walking speed
+        glm::dvec3 m_center{0.0};
+        double m_radius = 0.0;
+        double m_angle = 0.0;
+        glm::dvec3 m_position{0.0};
+        // Offsets into the action intervals, so the bots don't all act in the same tick
+        uint64_t m_blockPhase = 0;
+        uint64_t m_chatPhase = 0;
+        std::optional<World::BlockPos> m_placedBlock;
+
+        void tick(Clock::time_point a_now);
+
+        // Throws a Network::ProtocolError for packets the server must not send
+        void handlePacket(const Network::PacketFrame &a_frame, Clock::time_point a_now);
+
+        template<typename P>
+        void send(const P &a_packet)
+        {
+            Network::PooledBuffer buffer = m_buffers.acquire();
+            Network::encodePacket(*buffer, a_packet);
+            m_stats.bytesSent += buffer->size();
+            m_connection->send(std::move(buffer));
+        }
+    };
+}
@@ -0,0 +1,258 @@
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "asio.hpp"
+
+#include "Bot.h"
+
+using LoadTest::Bot, LoadTest::BotStats, LoadTest::Clock;
+using namespace std::chrono_literals;
+
+// How often the drivers look for received packets, bounds the precision of the latencies
+constexpr std::chrono::milliseconds g_pollInterval(1);
+constexpr std::chrono::seconds g_progressInterval(5);
+
+// The load profile, every option is given as --name=value
+struct Options
+{
+    std::string host = "127.0.0.1";
+    uint16_t port = 25565;
+    uint32_t bots = 100;
+    // Bots join evenly spread over the ramp, the measurement covers the whole duration
+    std::chrono::seconds duration{60};
+    std::chrono::seconds ramp{10};
+    uint64_t seed = 1;
+    uint32_t threads = std::max(1u, std::thread::hardware_concurrency() / 2);
+};
+
+struct Percentiles
+{
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+template<typename T>
+bool parseNumber(const std::string_view a_value, T &a_out)
+{
+    const auto [end, error] = std::from_chars(a_value.data(), a_value.data() + a_value.size(), a_out);
+    return error == std::errc() && end == a_value.data() + a_value.size();
+}
+
+bool parseOption(Options &a_options, const std::string_view a_argument)
+{
+    const size_t separator = a_argument.find('=');
+    if (!a_argument.starts_with("--") || separator == std::string_view::npos)
+        return false;
+
+    const std::string_view name = a_argument.substr(2, separator - 2);
+    const std::string_view value = a_argument.substr(separator + 1);
+    int64_t seconds = 0;
+    if (name == "host")
+    {
+        a_options.host = value;
+        return true;
+    }
+    if (name == "port")
+        return parseNumber(value, a_options.port);
+    if (name == "bots")
+        return parseNumber(value, a_options.bots);
+    if (name == "duration" && parseNumber(value, seconds))
+    {
+        a_options.duration = std::chrono::seconds(seconds);
+        return true;
+    }
+    if (name == "ramp" && parseNumber(value, seconds))
+    {
+        a_options.ramp = std::chrono::seconds(seconds);
+        return true;
+    }
+    if (name == "seed")
+        return parseNumber(value, a_options.seed);
+    if (name == "threads")
+        return parseNumber(value, a_options.threads) && a_options.threads > 0;
+    return false;
+}
+
+Percentiles getPercentiles(std::vector<double> a_values)
+{
+    if (a_values.empty())
+        return {};
+
+    std::ranges::sort(a_values);
+    const auto at = [&a_values](const double a_fraction)
+    {
+        return a_values[static_cast<size_t>(a_fraction * static_cast<double>(a_values.size() - 1))];
+    };
+    return {at(0.5), at(0.95), at(0.99), a_values.back()};
+}
+
+void printPercentiles(const std::string_view a_name, const std::string_view a_unit, const std::vector<double> &a_values)
+{
+    const Percentiles percentiles = getPercentiles(a_values);
+    std::cout << std::format("{:<32} {:>10} {:>10.2f} {:>10.2f} {:>10.2f} {:>10.2f}  {}\n", a_name, a_values.size(),
+                             percentiles.p50, percentiles.p95, percentiles.p99, percentiles.max, a_unit);
+}
+
+// Every driver thread owns every threads-th bot, connects it once its start time came & updates it until the end
+void runDriver(const std::vector<std::unique_ptr<Bot>> &a_bots, const size_t a_first, const size_t a_stride,
+               const Options &a_options, asio::thread_pool &a_networkThreads, const asio::ip::tcp::endpoint &a_endpoint,
+               const Clock::time_point a_start, std::atomic<uint32_t> &a_online)
+{
+    const Clock::time_point end = a_start + a_options.duration;
+    std::vector<bool> started(a_bots.size(), false);
+    for (Clock::time_point now = Clock::now(); now < end; now = Clock::now())
+    {
+        for (size_t i = a_first; i < a_bots.size(); i += a_stride)
+        {
+            Bot &bot = *a_bots[i];
+            if (!started[i])
+            {
+                if (now < a_start + std::chrono::nanoseconds(a_options.ramp) * i / a_bots.size())
+                    continue;
+
+                started[i] = true;
+                if (bot.connect(a_networkThreads, a_endpoint))
+                    a_online.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            const bool wasConnected = bot.isConnected();
+            bot.update(now);
+            if (wasConnected && !bot.isConnected())
+                a_online.fetch_sub(1, std::memory_order_relaxed);
+        }
+        std::this_thread::sleep_for(g_pollInterval);
+    }
+
+    for (size_t i = a_first; i < a_bots.size(); i += a_stride)
+    {
+        a_bots[i]->disconnect();
+    }
+}
+
+void printReport(const std::vector<std::unique_ptr<Bot>> &a_bots)
+{
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    std::vector<double> loginLatencies;
+    std::vector<double> roundTrips;
+    std::vector<double> tickTimes;
+    std::vector<double> bytesDown;
+    std::vector<double> bytesUp;
+    size_t failed = 0;
+    size_t lost = 0;
+    size_t notLoggedIn = 0;
+    uint64_t totalDown = 0;
+    uint64_t totalUp = 0;
+
+    for (const std::unique_ptr<Bot> &bot: a_bots)
+    {
+        const BotStats &stats = bot->getStats();
+        failed += stats.failedToConnect;
+        lost += stats.lostConnection;
+        notLoggedIn += !stats.failedToConnect && !stats.loginLatency.has_value();
+        totalDown += stats.bytesReceived;
+        totalUp += stats.bytesSent;
+        if (stats.loginLatency.has_value())
+            loginLatencies.push_back(Milliseconds(*stats.loginLatency).count());
+        for (const std::chrono::microseconds roundTrip: stats.roundTrips)
+        {
+            roundTrips.push_back(Milliseconds(roundTrip).count());
+        }
+        for (const std::chrono::microseconds tickTime: stats.tickTimes)
+        {
+            tickTimes.push_back(Milliseconds(tickTime).count());
+        }
+
+        const double seconds = std::chrono::duration<double>(stats.disconnectedAt - stats.connectedAt).count();
+        if (!stats.failedToConnect && seconds > 0.0)
+        {
+            bytesDown.push_back(static_cast<double>(stats.bytesReceived) / 1024.0 / seconds);
+            bytesUp.push_back(static_cast<double>(stats.bytesSent) / 1024.0 / seconds);
+        }
+    }
+
+    std::cout << std::format("\n{} bots, {} failed to connect, {} never logged in, {} lost their connection\n",
+                             a_bots.size(), failed, notLoggedIn, lost);
+    std::cout << std::format("{} MiB received, {} MiB sent\n\n", totalDown >> 20, totalUp >> 20);
+    std::cout << std::format("{:<32} {:>10} {:>10} {:>10} {:>10} {:>10}\n", "", "Samples", "p50", "p95", "p99", "max");
+    printPercentiles("Server mspt", "ms", tickTimes);
+    printPercentiles("Login latency", "ms", loginLatencies);
+    printPercentiles("KeepAlive round trip", "ms", roundTrips);
+    printPercentiles("Bandwidth per bot, down", "KiB/s", bytesDown);
+    printPercentiles("Bandwidth per bot, up", "KiB/s", bytesUp);
+}
+
+// Spawns simulated players against a running Server & reports its tick times, the latencies & bandwidth they saw
+int main(const int a_argc, char **a_argv)
+{
+    Options options;
+    for (int i = 1; i < a_argc; i++)
+    {
+        if (!parseOption(options, a_argv[i]))
+        {
+            std::cerr << std::format("Invalid option '{}', expected --host, --port, --bots, --duration, --ramp, --seed "
+                                     "or --threads as --name=value\n", a_argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    asio::thread_pool networkThreads(options.threads);
+    asio::ip::tcp::endpoint endpoint;
+    try
+    {
+        asio::io_context context;
+        asio::ip::tcp::resolver resolver(context);
+        endpoint = *resolver.resolve(options.host, std::to_string(options.port)).begin();
+    } catch (const std::exception &e)
+    {
+        std::cerr << std::format("Failed to resolve {}: {}\n", options.host, e.what());
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::unique_ptr<Bot>> bots;
+    for (uint32_t i = 0; i < options.bots; i++)
+    {
+        // One bot records the server's tick times, they're the same for every bot
+        bots.push_back(std::make_unique<Bot>(i, options.seed, i == 0));
+    }
+
+    std::cout << std::format("{} bots against {}:{} for {}s ({}s ramp), seed {}, {} threads\n", options.bots,
+                             options.host, options.port, options.duration.count(), options.ramp.count(), options.seed,
+                             options.threads);
+
+    std::atomic<uint32_t> online = 0;
+    const Clock::time_point start = Clock::now();
+    {
+        std::vector<std::jthread> drivers;
+        for (uint32_t i = 0; i < options.threads; i++)
+        {
+            drivers.emplace_back([&, i]
+            {
+                runDriver(bots, i, options.threads, options, networkThreads, endpoint, start, online);
+            });
+        }
+
+        for (Clock::time_point next = start + g_progressInterval; next < start + options.duration; next += g_progressInterval)
+        {
+            std::this_thread::sleep_until(next);
+            std::cout << std::format("{:>4}s: {} bots online\n", (next - start) / 1s, online.load(std::memory_order_relaxed));
+        }
+    }
+
+    // Lets the disconnects go out
+    networkThreads.join();
+    printReport(bots);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,100 @@
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "spdlog/spdlog.h"
+#include "glslang/Public/ShaderLang.h"
+
+#include "../Client/ResourceManager.h"
+#include "Utils/AssetBundle.h"
+#include "Utils/Identifier.h"
+
+// Packs <resource directory>/assets/<namespace>/<path> into one bundle for the ResourceManager, shaders are compiled to
+// SPIR-V here so the Client doesn't have to
+// Usage: MCpp-Pack <resource directory> [bundle file], the bundle file is <resource directory>/assets.mcpack by default
+int packResources(const std::filesystem::path &a_resourceDirectory, const std::filesystem::path &a_bundlePath)
+{
+    spdlog::logger &logger = *spdlog::default_logger();
+    Utils::AssetBundleWriter writer;
+    size_t shaderCount = 0;
+    bool failed = false;
+
+    for (const std::filesystem::directory_entry &namespaceDirectory: std::filesystem::directory_iterator(a_resourceDirectory / "assets"))
+    {
+        if (!namespaceDirectory.is_directory())
+            continue;
+
+        for (const std::filesystem::directory_entry &file: std::filesystem::recursive_directory_iterator(namespaceDirectory.path()))
+        {
+            if (!file.is_regular_file())
+                continue;
+
+            const std::string path = std::filesystem::relative(file.path(), namespaceDirectory.path()).generic_string();
+            const std::optional<Utils::Identifier> identifier = Utils::Identifier::of(namespaceDirectory.path().filename().string(), path);
+            if (!identifier.has_value())
+            {
+                logger.warn("Skipping '{}', it isn't a valid identifier", file.path().string());
+                continue;
+            }
+
+            std::ifstream stream(file.path(), std::ios::binary);
+            const std::vector<char> chars(std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{});
+            const std::span<const std::byte> data = std::as_bytes(std::span(chars));
+            writer.add(*identifier, data);
+
+            if (const std::optional<EShLanguage> stage = ResourceManager::getShaderStage(file.path()))
+            {
+                const std::optional<std::vector<uint32_t>> spirV = ResourceManager::compileShader(logger, identifier->toString(), data, *stage);
+                if (!spirV.has_value())
+                {
+                    failed = true;
+                    continue;
+                }
+                writer.add(identifier->withSuffixedPath(std::string(ResourceManager::SPIR_V_SUFFIX)), std::as_bytes(std::span(*spirV)));
+                shaderCount++;
+            }
+        }
+    }
+
+    // A bundle without some shaders would be used instead of the loose files that have them
+    if (failed)
+    {
+        logger.error("Not writing '{}', some shaders failed to compile", a_bundlePath.string());
+        return EXIT_FAILURE;
+    }
+
+    writer.write(a_bundlePath);
+    logger.info("Packed {} resources with {} compiled shaders into '{}'", writer.getEntryCount(), shaderCount, a_bundlePath.string());
+    return EXIT_SUCCESS;
+}
+
+int main(const int a_argc, char **a_argv)
+{
+    if (a_argc < 2 || a_argc > 3)
+    {
+        spdlog::error("Usage: MCpp-Pack <resource directory> [bundle file]");
+        return EXIT_FAILURE;
+    }
+
+    const std::filesystem::path resourceDirectory = a_argv[1];
+    const std::filesystem::path bundlePath = a_argc == 3 ? std::filesystem::path(a_argv[2]) : resourceDirectory / ResourceManager::BUNDLE_FILE_NAME;
+
+    glslang::InitializeProcess();
+    int result;
+    try
+    {
+        result = packResources(resourceDirectory, bundlePath);
+    } catch (const std::exception &e)
+    {
+        spdlog::error("Failed to pack '{}': {}", resourceDirectory.string(), e.what());
+        result = EXIT_FAILURE;
+    }
+    glslang::FinalizeProcess();
+    return result;
+}
@@ -0,0 +1,276 @@
+#include <format>
+#include <stdexcept>
+
+#include "libdeflate.h"
+
+#include "Network/SectionEncoding.h"
+#include "ChunkCache.h"
+
+using World::ChunkPos, World::MIN_SECTION_Y, World::SECTIONS_PER_CHUNK;
+
+// Encoded chunks smaller than this aren't deflated, flat terrain is a few dozen bytes already
+constexpr size_t g_deflateThreshold = 256;
+// Fast, the compressed chunks are a fraction of a section either way
+constexpr int g_deflateLevel = 1;
+// Per cached chunk besides its blocks, the entry, list node & index
+constexpr size_t g_entryOverhead = 128;
+
+size_t getUncompressedMemory(const World::Chunk &a_chunk)
+{
+    size_t memory = g_entryOverhead + sizeof(World::Chunk);
+    for (int32_t sectionY = MIN_SECTION_Y; sectionY < MIN_SECTION_Y + SECTIONS_PER_CHUNK; sectionY++)
+    {
+        if (a_chunk.getSection(sectionY) != nullptr)
+            memory += sizeof(World::ChunkSection);
+    }
+    return memory;
+}
+
+ChunkCache::ChunkCache(const size_t a_memoryCap)
+    : m_memoryCap(a_memoryCap), m_compressor(libdeflate_alloc_compressor(g_deflateLevel)),
+      m_encoded(Memory::getTrackedResource(Memory::MemoryTag::Chunks))
+{
+    if (m_compressor == nullptr)
+        throw std::runtime_error(std::format("Failed to allocate a compressor for level {}", g_deflateLevel));
+
+    m_thread = std::jthread([this]
+    {
+        run();
+    });
+}
+
+ChunkCache::~ChunkCache()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_workAvailable.notify_all();
+    m_thread = {};
+
+    libdeflate_free_compressor(m_compressor);
+    for (libdeflate_decompressor *decompressor: m_decompressors)
+    {
+        libdeflate_free_decompressor(decompressor);
+    }
+}
+
+void ChunkCache::add(std::unique_ptr<World::Chunk> a_chunk)
+{
+    const ChunkPos pos = a_chunk->getPos();
+    const size_t memory = getUncompressedMemory(*a_chunk);
+    {
+        std::unique_lock lock(m_mutex);
+        if (const auto existing = find(lock, pos); existing != m_index.end())
+        {
+            // Not expected, chunks are taken out before they're loaded again; the newer one wins
+            m_memory -= existing->second->memory;
+            m_compressedChunks -= existing->second->state == State::Compressed;
+            m_entries.erase(existing->second);
+        }
+
+        Entry &entry = m_entries.emplace_front();
+        entry.pos = pos;
+        entry.chunk = std::move(a_chunk);
+        entry.memory = memory;
+        m_index[pos] = m_entries.begin();
+        m_toCompress.push_back(pos);
+        m_memory += memory;
+    }
+    m_workAvailable.notify_one();
+}
+
+std::unique_ptr<World::Chunk> ChunkCache::take(const ChunkPos a_pos)
+{
+    Entry entry;
+    libdeflate_decompressor *decompressor = nullptr;
+    {
+        std::unique_lock lock(m_mutex);
+        const auto found = find(lock, a_pos);
+        if (found == m_index.end())
+        {
+            m_misses++;
+            return nullptr;
+        }
+
+        entry = std::move(*found->second);
+        m_entries.erase(found->second);
+        m_index.erase(found);
+        m_memory -= entry.memory;
+        m_hits++;
+        if (entry.state == State::Uncompressed)
+            return std::move(entry.chunk);
+
+        m_compressedChunks--;
+        if (!m_decompressors.empty())
+        {
+            decompressor = m_decompressors.back();
+            m_decompressors.pop_back();
+        }
+    }
+
+    if (decompressor == nullptr)
+    {
+        decompressor = libdeflate_alloc_decompressor();
+        if (decompressor == nullptr)
+            throw std::runtime_error("Failed to allocate a decompressor");
+    }
+    std::unique_ptr<World::Chunk> chunk;
+    try
+    {
+        chunk = decompress(entry, decompressor);
+    } catch (...)
+    {
+        libdeflate_free_decompressor(decompressor);
+        throw;
+    }
+
+    std::lock_guard lock(m_mutex);
+    m_decompressors.push_back(decompressor);
+    return chunk;
+}
+
+ChunkCache::Stats ChunkCache::getStats() const
+{
+    std::lock_guard lock(m_mutex);
+    return {
+        .chunks = m_entries.size(),
+        .compressedChunks = m_compressedChunks,
+        .memory = m_memory,
+        .hits = m_hits,
+        .misses = m_misses,
+        .evicted = m_evicted
+    };
+}
+
+void ChunkCache::run()
+{
+    std::unique_lock lock(m_mutex);
+    while (true)
+    {
+        m_workAvailable.wait(lock, [this]
+        {
+            return m_stopping || !m_toCompress.empty() || (m_memory > m_memoryCap && m_compressedChunks > 0);
+        });
+        if (m_stopping)
+            return;
+
+        // Only compressed chunks are evicted, see below for while chunks wait for compression
+        if (m_toCompress.empty())
+        {
+            while (m_memory > m_memoryCap && evictOldest()) {}
+            continue;
+        }
+
+        const ChunkPos pos = m_toCompress.front();
+        m_toCompress.pop_front();
+        const auto found = m_index.find(pos);
+        if (found == m_index.end() || found->second->state != State::Uncompressed)
+            continue;
+
+        // The chunk is only read while unlocked, take() waits for it until it's compressed
+        Entry &entry = *found->second;
+        entry.state = State::Compressing;
+        const World::Chunk &chunk = *entry.chunk;
+        lock.unlock();
+        Entry compressed;
+        compress(chunk, compressed);
+        lock.lock();
+
+        // The entry can't have been removed, taking or replacing a compressing chunk waits for it
+        m_memory -= entry.memory;
+        entry.state = State::Compressed;
+        entry.chunk.reset();
+        entry.data = std::move(compressed.data);
+        entry.encodedSize = compressed.encodedSize;
+        entry.memory = g_entryOverhead + entry.data.capacity();
+        m_memory += entry.memory;
+        m_compressedChunks++;
+        m_compressed.notify_all();
+
+        // After every compression too, or a steady stream of unloads would keep the memory above the cap for good
+        while (m_memory > m_memoryCap && evictOldest()) {}
+    }
+}
+
+std::unordered_map<ChunkPos, std::list<ChunkCache::Entry>::iterator>::iterator ChunkCache::find(std::unique_lock<std::mutex> &a_lock, const ChunkPos a_pos)
+{
+    m_compressed.wait(a_lock, [this, a_pos]
+    {
+        const auto found = m_index.find(a_pos);
+        return found == m_index.end() || found->second->state != State::Compressing;
+    });
+    return m_index.find(a_pos);
+}
+
+bool ChunkCache::evictOldest()
+{
+    for (auto entry = m_entries.rbegin(); entry != m_entries.rend(); ++entry)
+    {
+        if (entry->state != State::Compressed)
+            continue;
+
+        m_memory -= entry->memory;
+        m_compressedChunks--;
+        m_evicted++;
+        m_index.erase(entry->pos);
+        m_entries.erase(std::next(entry).base());
+        return true;
+    }
+    return false;
+}
+
+void ChunkCache::compress(const World::Chunk &a_chunk, Entry &a_entry)
+{
+    std::vector<Network::IndexedSection> sections;
+    for (int32_t i = 0; i < SECTIONS_PER_CHUNK; i++)
+    {
+        if (const World::ChunkSection *section = a_chunk.getSection(MIN_SECTION_Y + i); section != nullptr && !section->isEmpty())
+            sections.push_back({i, section});
+    }
+    m_encoded.clear();
+    Network::encodeChunkSections(sections, m_encoded);
+
+    if (m_encoded.size() < g_deflateThreshold)
+    {
+        a_entry.data.assign(m_encoded.begin(), m_encoded.end());
+        a_entry.encodedSize = 0;
+        return;
+    }
+
+    a_entry.data.resize(libdeflate_deflate_compress_bound(m_compressor, m_encoded.size()));
+    const size_t compressedSize = libdeflate_deflate_compress(m_compressor, m_encoded.data(), m_encoded.size(),
+                                                              a_entry.data.data(), a_entry.data.size());
+    if (compressedSize == 0 || compressedSize >= m_encoded.size())
+    {
+        a_entry.data.assign(m_encoded.begin(), m_encoded.end());
+        a_entry.encodedSize = 0;
+        return;
+    }
+    a_entry.data.resize(compressedSize);
+    a_entry.data.shrink_to_fit();
+    a_entry.encodedSize = m_encoded.size();
+}
+
+std::unique_ptr<World::Chunk> ChunkCache::decompress(const Entry &a_entry, libdeflate_decompressor *a_decompressor) const
+{
+    std::span<const std::byte> encoded = a_entry.data;
+    Network::ByteBuffer inflated(Memory::getTrackedResource(Memory::MemoryTag::Chunks));
+    if (a_entry.encodedSize != 0)
+    {
+        inflated.resize(a_entry.encodedSize);
+        size_t actualSize = 0;
+        if (libdeflate_deflate_decompress(a_decompressor, a_entry.data.data(), a_entry.data.size(), inflated.data(),
+                                          inflated.size(), &actualSize) != LIBDEFLATE_SUCCESS
+            || actualSize != inflated.size())
+            throw std::runtime_error(std::format("Cached chunk {}, {} is corrupted", a_entry.pos.x, a_entry.pos.z));
+        encoded = inflated;
+    }
+
+    auto chunk = std::make_unique<World::Chunk>(a_entry.pos);
+    for (auto &[index, section]: Network::decodeChunkSections(encoded))
+    {
+        chunk->setSection(MIN_SECTION_Y + index, std::move(section));
+    }
+    return chunk;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Memory/MemoryTracker.h"
+#include "Network/PacketCodec.h"
+#include "World/Chunk.h"
+
+struct libdeflate_compressor;
+struct libdeflate_decompressor;
+
+// Keeps chunks that were unloaded from the world in memory, so areas players come back to are there again in
+// microseconds instead of being generated again
+// Added chunks are compressed (run length encoded sections, deflated if that's still large) on the cache's own thread,
+// oldest first; once the cache uses more memory than its cap, that thread evicts the least recently unloaded chunks
+// Evicted chunks are generated again when they're needed, with their changes restored from the world storage
+class ChunkCache final
+{
+public:
+    struct Stats
+    {
+        size_t chunks = 0;
+        size_t compressedChunks = 0;
+        // Estimated, chunks that weren't compressed yet count with their sections
+        size_t memory = 0;
+        // Since the cache was created
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evicted = 0;
+    };
+
+    explicit ChunkCache(size_t a_memoryCap = 256 << 20);
+
+    ChunkCache(const ChunkCache &) = delete;
+
+    ChunkCache &operator=(const ChunkCache &) = delete;
+
+    ~ChunkCache();
+
+    // Returns right away, the chunk is compressed later on the cache's thread
+    void add(std::unique_ptr<World::Chunk> a_chunk);
+
+    // Safe to call from any thread; nullptr if the chunk isn't cached, otherwise it's no longer cached afterwards
+    [[nodiscard]]
+    std::unique_ptr<World::Chunk> take(World::ChunkPos a_pos);
+
+    [[nodiscard]]
+    Stats getStats() const;
+
+private:
+    enum class State : uint8_t
+    {
+        Uncompressed,
+        // The cache's thread has the chunk, take() waits for it
+        Compressing,
+        Compressed
+    };
+
+    struct Entry
+    {
+        World::ChunkPos pos;
+        State state = State::Uncompressed;
+        std::unique_ptr<World::Chunk> chunk;
+        Network::ByteBuffer data{Memory::getTrackedResource(Memory::MemoryTag::Chunks)};
+        // Of the encoded sections before deflating, 0 if data isn't deflated
+        size_t encodedSize = 0;
+        size_t memory = 0;
+    };
+
+    size_t m_memoryCap;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_compressed;
+    // Most recently added first
+    std::list<Entry> m_entries;
+    std::unordered_map<World::ChunkPos, std::list<Entry>::iterator> m_index;
+    // Chunks still to compress, oldest first; may contain chunks that were taken since
+    std::deque<World::ChunkPos> m_toCompress;
+    // Reused by take(), one per thread that takes at the same time
+    std::vector<libdeflate_decompressor *> m_decompressors;
+    size_t m_memory = 0;
+    size_t m_compressedChunks = 0;
+    size_t m_hits = 0;
+    size_t m_misses = 0;
+    size_t m_evicted = 0;
+    bool m_stopping = false;
+
+    // Only used by the cache's thread
+    libdeflate_compressor *m_compressor;
+    Network::ByteBuffer m_encoded;
+
+    // Last, so it's stopped before the rest is destroyed
+    std::jthread m_thread;
+
+    void run();
+
+    // Waits until the chunk isn't being compressed anymore, m_index.end() if it isn't cached
+    [[nodiscard]]
+    std::unordered_map<World::ChunkPos, std::list<Entry>::iterator>::iterator find(std::unique_lock<std::mutex> &a_lock, World::ChunkPos a_pos);
+
+    // Returns whether an entry was evicted
+    bool evictOldest();
+
+    // Sets the data & encoded size of the entry
+    void compress(const World::Chunk &a_chunk, Entry &a_entry);
+
+    [[nodiscard]]
+    std::unique_ptr<World::Chunk> decompress(const Entry &a_entry, libdeflate_decompressor *a_decompressor) const;
+};
@@ -0,0 +1,412 @@
+#include <algorithm>
+#include <bit>
+#include <exception>
+
+#include "../Common-Lib/Logging.h"
+#include "ChunkPipeline.h"
+
+using World::ChunkPos;
+
+ChunkPipeline::ChunkPipeline(World::ChunkMap &a_world, Stages a_stages, LoadedFunction a_onLoaded, UnloadedFunction a_onUnloaded,
+                             const int32_t a_ticketRadius, const uint32_t a_workerCount)
+    : m_world(a_world), m_stages(std::move(a_stages)), m_onLoaded(std::move(a_onLoaded)),
+      m_onUnloaded(std::move(a_onUnloaded)), m_ticketRadius(a_ticketRadius)
+{
+    for (uint32_t i = 0; i < std::max<uint32_t>(a_workerCount, 1); i++)
+    {
+        m_workers.emplace_back([this]
+        {
+            runWorker();
+        });
+    }
+}
+
+ChunkPipeline::~ChunkPipeline()
+{
+    {
+        std::lock_guard lock(m_queueMutex);
+        m_stopping = true;
+    }
+    m_queueCondition.notify_all();
+    // Joined before the members the workers use are destroyed
+    m_workers.clear();
+
+    std::unique_lock lock(m_queueMutex);
+    m_restored.wait(lock, [this]
+    {
+        return m_restoring == 0;
+    });
+}
+
+void ChunkPipeline::addPlayer(const PlayerId a_player, const ChunkPos a_pos)
+{
+    if (m_players.contains(a_player))
+    {
+        setPlayerPosition(a_player, a_pos);
+        return;
+    }
+
+    m_players.emplace(a_player, a_pos);
+    addPlayerTickets(a_pos);
+}
+
+void ChunkPipeline::removePlayer(const PlayerId a_player)
+{
+    const auto player = m_players.find(a_player);
+    if (player == m_players.end())
+        return;
+
+    removePlayerTickets(player->second);
+    m_players.erase(player);
+}
+
+void ChunkPipeline::setPlayerPosition(const PlayerId a_player, const ChunkPos a_pos)
+{
+    const auto player = m_players.find(a_player);
+    if (player == m_players.end() || player->second == a_pos)
+        return;
+
+    const ChunkPos previous = player->second;
+    player->second = a_pos;
+    addPlayerTickets(a_pos);
+    removePlayerTickets(previous);
+}
+
+void ChunkPipeline::addTicket(const ChunkPos a_pos)
+{
+    Entry &entry = m_entries[a_pos];
+    if (entry.tickets++ > 0)
+        return;
+
+    switch (entry.state)
+    {
+        case State::Waiting:
+            // A new entry
+            m_pending.push_back(a_pos);
+            break;
+        case State::InFlight:
+            // Too late if the worker already gave up on it, then it's queued again once it's back
+            entry.request->cancelled.store(false, std::memory_order_relaxed);
+            break;
+        case State::Loaded:
+        case State::Failed:
+            break;
+    }
+}
+
+void ChunkPipeline::removeTicket(const ChunkPos a_pos)
+{
+    const auto found = m_entries.find(a_pos);
+    if (found == m_entries.end() || found->second.tickets == 0 || --found->second.tickets > 0)
+        return;
+
+    Entry &entry = found->second;
+    switch (entry.state)
+    {
+        case State::Waiting:
+            m_totals.cancelled++;
+            m_entries.erase(found);
+            break;
+        case State::InFlight:
+            // The entry stays until the worker hands the request back
+            entry.request->cancelled.store(true, std::memory_order_relaxed);
+            break;
+        case State::Loaded:
+            entry.releasedTick = m_currentTick;
+            m_released.emplace_back(a_pos, m_currentTick);
+            break;
+        case State::Failed:
+            m_entries.erase(found);
+            break;
+    }
+}
+
+void ChunkPipeline::tick()
+{
+    finishRequests();
+    unloadReleased();
+    dispatch();
+    m_currentTick++;
+}
+
+ChunkPipeline::Stats ChunkPipeline::getStats() const
+{
+    Stats stats = m_totals;
+    for (const auto &[pos, entry]: m_entries)
+    {
+        stats.loadedChunks += entry.state == State::Loaded;
+        stats.pendingChunks += entry.state == State::Waiting;
+    }
+    std::lock_guard lock(m_queueMutex);
+    stats.pendingChunks += m_queue.size();
+    stats.inFlightChunks = m_inFlight - m_queue.size();
+    return stats;
+}
+
+void ChunkPipeline::addPlayerTickets(const ChunkPos a_center)
+{
+    for (int32_t x = -m_ticketRadius; x <= m_ticketRadius; x++)
+    {
+        for (int32_t z = -m_ticketRadius; z <= m_ticketRadius; z++)
+        {
+            addTicket({a_center.x + x, a_center.z + z});
+        }
+    }
+}
+
+void ChunkPipeline::removePlayerTickets(const ChunkPos a_center)
+{
+    for (int32_t x = -m_ticketRadius; x <= m_ticketRadius; x++)
+    {
+        for (int32_t z = -m_ticketRadius; z <= m_ticketRadius; z++)
+        {
+            removeTicket({a_center.x + x, a_center.z + z});
+        }
+    }
+}
+
+void ChunkPipeline::finishRequests()
+{
+    while (std::optional<std::shared_ptr<Request>> finished = m_finished.tryPop())
+    {
+        Request &request = **finished;
+        m_inFlight--;
+        const auto found = m_entries.find(request.pos);
+        Entry &entry = found->second;
+        entry.request.reset();
+
+        if (entry.tickets == 0)
+        {
+            m_totals.cancelled++;
+            m_entries.erase(found);
+            continue;
+        }
+        if (!request.error.empty())
+        {
+            Logging::getLogger("ChunkPipeline")->error("Failed to load chunk {}, {}: {}", request.pos.x, request.pos.z, request.error);
+            m_totals.failed++;
+            entry.state = State::Failed;
+            continue;
+        }
+        if (request.reached != Stage::Ready)
+        {
+            // Cancelled, but it got a ticket again before it came back
+            entry.state = State::Waiting;
+            m_pending.push_back(request.pos);
+            continue;
+        }
+
+        if (request.fromStorage)
+            m_totals.loaded++;
+        else
+            m_totals.generated++;
+        entry.state = State::Loaded;
+        // Whatever the stages changed is either stored already or generated the same way again
+        request.chunk->clearDirtySections();
+        m_world.addChunk(std::move(request.chunk));
+        m_onLoaded(request.pos);
+    }
+}
+
+void ChunkPipeline::unloadReleased()
+{
+    while (!m_released.empty() && m_released.front().second + UNLOAD_DELAY <= m_currentTick)
+    {
+        const auto [pos, releasedTick] = m_released.front();
+        m_released.pop_front();
+
+        // Chunks that got a ticket in the meantime & were released again are further back in the queue
+        const auto found = m_entries.find(pos);
+        if (found == m_entries.end() || found->second.tickets > 0 || found->second.releasedTick != releasedTick)
+            continue;
+
+        m_entries.erase(found);
+        m_totals.unloaded++;
+        if (std::unique_ptr<World::Chunk> chunk = m_world.removeChunk(pos); chunk != nullptr)
+            m_onUnloaded(std::move(chunk));
+    }
+}
+
+void ChunkPipeline::dispatch()
+{
+    std::vector<std::shared_ptr<Request>> requests;
+    for (const ChunkPos &pos: m_pending)
+    {
+        const auto found = m_entries.find(pos);
+        if (found == m_entries.end() || found->second.state != State::Waiting)
+            continue;
+
+        Entry &entry = found->second;
+        entry.state = State::InFlight;
+        entry.request = std::make_shared<Request>();
+        entry.request->pos = pos;
+        requests.push_back(entry.request);
+    }
+    m_pending.clear();
+    const size_t added = requests.size();
+    m_inFlight += added;
+
+    // Cells are at least as wide as the ticket radius & every ticket of a player is within it, so a chunk's nearest
+    // player is in one of the 3x3 cells around it
+    const int cellShift = std::bit_width(static_cast<uint32_t>(m_ticketRadius));
+    std::unordered_map<ChunkPos, std::vector<ChunkPos>> cells;
+    for (const auto &[id, pos]: m_players)
+    {
+        cells[{pos.x >> cellShift, pos.z >> cellShift}].push_back(pos);
+    }
+    const auto getDistance = [this, &cells, cellShift](const ChunkPos a_pos)
+    {
+        // Chunks that are only ticketed for something else come after every chunk of a player
+        int32_t distance = m_ticketRadius + 1;
+        const ChunkPos cell{a_pos.x >> cellShift, a_pos.z >> cellShift};
+        for (int32_t x = -1; x <= 1; x++)
+        {
+            for (int32_t z = -1; z <= 1; z++)
+            {
+                const auto players = cells.find({cell.x + x, cell.z + z});
+                if (players == cells.end())
+                    continue;
+
+                for (const ChunkPos &player: players->second)
+                {
+                    distance = std::min(distance, a_pos.distanceTo(player));
+                }
+            }
+        }
+        return distance;
+    };
+
+    {
+        std::lock_guard lock(m_queueMutex);
+        m_queue.insert(m_queue.end(), std::make_move_iterator(requests.begin()), std::make_move_iterator(requests.end()));
+
+        // Chunks that lost their tickets are handed back right away instead of waiting for a worker
+        std::erase_if(m_queue, [this](std::shared_ptr<Request> &a_request)
+        {
+            if (!a_request->cancelled.load(std::memory_order_relaxed))
+                return false;
+            m_finished.push(std::move(a_request));
+            return true;
+        });
+
+        for (const std::shared_ptr<Request> &request: m_queue)
+        {
+            request->distance = getDistance(request->pos);
+        }
+        std::ranges::sort(m_queue, [](const std::shared_ptr<Request> &a_first, const std::shared_ptr<Request> &a_second)
+        {
+            if (a_first->distance != a_second->distance)
+                return a_first->distance > a_second->distance;
+            return a_first->pos.x != a_second->pos.x ? a_first->pos.x > a_second->pos.x : a_first->pos.z > a_second->pos.z;
+        });
+    }
+
+    for (size_t i = 0; i < added; i++)
+    {
+        m_queueCondition.notify_one();
+    }
+}
+
+void ChunkPipeline::runWorker()
+{
+    while (true)
+    {
+        std::shared_ptr<Request> request;
+        {
+            std::unique_lock lock(m_queueMutex);
+            m_queueCondition.wait(lock, [this]
+            {
+                return m_stopping || !m_queue.empty();
+            });
+            if (m_stopping)
+                return;
+
+            request = std::move(m_queue.back());
+            m_queue.pop_back();
+        }
+
+        try
+        {
+            if (!process(request))
+                continue;
+        } catch (const std::exception &e)
+        {
+            request->error = e.what();
+            request->chunk.reset();
+        }
+        m_finished.push(std::move(request));
+    }
+}
+
+bool ChunkPipeline::process(const std::shared_ptr<Request> &a_request)
+{
+    const auto isCancelled = [&a_request]
+    {
+        return a_request->cancelled.load(std::memory_order_relaxed);
+    };
+
+    if (isCancelled())
+        return true;
+    if (m_stages.load)
+        a_request->chunk = m_stages.load(a_request->pos);
+    if (a_request->chunk != nullptr)
+    {
+        a_request->fromStorage = true;
+        a_request->reached = Stage::Ready;
+        return true;
+    }
+
+    a_request->reached = Stage::Generate;
+    if (isCancelled())
+        return true;
+    a_request->chunk = std::make_unique<World::Chunk>(a_request->pos);
+    m_stages.generate(*a_request->chunk);
+
+    a_request->reached = Stage::Decorate;
+    if (isCancelled())
+        return true;
+    m_stages.decorate(*a_request->chunk);
+
+    a_request->reached = Stage::Restore;
+    if (isCancelled())
+        return true;
+    if (!m_stages.restore)
+    {
+        a_request->reached = Stage::Ready;
+        return true;
+    }
+
+    {
+        std::lock_guard lock(m_queueMutex);
+        m_restoring++;
+    }
+    m_stages.restore(*a_request->chunk, [this, request = a_request](const std::exception_ptr a_error) mutable
+    {
+        finishRestore(std::move(request), a_error);
+    });
+    return false;
+}
+
+void ChunkPipeline::finishRestore(std::shared_ptr<Request> a_request, const std::exception_ptr a_error)
+{
+    if (a_error == nullptr)
+    {
+        a_request->reached = Stage::Ready;
+    } else
+    {
+        try
+        {
+            std::rethrow_exception(a_error);
+        } catch (const std::exception &e)
+        {
+            a_request->error = e.what();
+            a_request->chunk.reset();
+        }
+    }
+    m_finished.push(std::move(a_request));
+
+    // Still locked, the destructor could otherwise return before this notifies
+    std::lock_guard lock(m_queueMutex);
+    m_restoring--;
+    m_restored.notify_all();
+}
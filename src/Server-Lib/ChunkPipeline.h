@@ -0,0 +1,191 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Utils/MpscQueue.h"
+#include "Utils/UniqueFunction.h"
+#include "World/ChunkMap.h"
+
+// Brings chunks into the world on its own worker threads: a chunk is loaded or, if there's nothing stored for it,
+// generated, decorated & then gets its stored changes restored, before the ticking thread adds it to the world with
+// its dirty sections cleared
+// Chunks are kept loaded by tickets: every player holds one on the chunks within its ticket radius & others can be
+// added for e.g. the spawn; once the last ticket of a chunk is gone, it's cancelled if it is still being worked on or
+// unloaded after UNLOAD_DELAY ticks
+// Waiting chunks go into one queue the workers take the chunk nearest to a player from whenever they finished one; it's
+// prioritized again every tick as players move, so after a teleport the chunks around the player's new position come
+// first, abandoned chunks are dropped from it & work on those a worker already has stops at the next stage
+// Everything but the stage functions runs on the ticking thread
+class ChunkPipeline final
+{
+public:
+    using PlayerId = uint32_t;
+
+    enum class Stage : uint8_t
+    {
+        Load,
+        Generate,
+        Decorate,
+        Restore,
+        Ready
+    };
+
+    // Called once a stage that doesn't run on the workers finished, on any thread, with what it threw if it failed
+    using StageDoneFunction = Utils::UniqueFunction<void(std::exception_ptr)>;
+
+    struct Stages
+    {
+        // Returns the stored chunk or nullptr if it has to be generated, an empty function loads nothing
+        Utils::UniqueFunction<std::unique_ptr<World::Chunk>(World::ChunkPos)> load;
+        Utils::UniqueFunction<void(World::Chunk &)> generate;
+        Utils::UniqueFunction<void(World::Chunk &)> decorate;
+        // Puts the stored sections into a generated chunk without holding up the worker, which goes on with the next
+        // chunk; has to call a_done exactly once & report failures through it, an empty function restores nothing
+        Utils::UniqueFunction<void(World::Chunk &, StageDoneFunction a_done)> restore;
+    };
+
+    // Called on the ticking thread right after a chunk was added to the world
+    using LoadedFunction = Utils::UniqueFunction<void(World::ChunkPos)>;
+    // Called on the ticking thread with every chunk that was removed from the world
+    using UnloadedFunction = Utils::UniqueFunction<void(std::unique_ptr<World::Chunk>)>;
+
+    struct Stats
+    {
+        size_t loadedChunks = 0;
+        size_t pendingChunks = 0;
+        size_t inFlightChunks = 0;
+        // Since the pipeline was created
+        size_t loaded = 0;
+        size_t generated = 0;
+        size_t unloaded = 0;
+        // Dropped while waiting or while a worker was on them
+        size_t cancelled = 0;
+        size_t failed = 0;
+    };
+
+    // Chunks without a ticket stay loaded for this many ticks, so players moving back & forth over a chunk border
+    // don't unload & reload the same chunks
+    static constexpr uint64_t UNLOAD_DELAY = 100;
+
+    // The stage functions are called on the workers, for several chunks at once
+    ChunkPipeline(World::ChunkMap &a_world, Stages a_stages, LoadedFunction a_onLoaded, UnloadedFunction a_onUnloaded,
+                  int32_t a_ticketRadius = 8, uint32_t a_workerCount = 2);
+
+    ChunkPipeline(const ChunkPipeline &) = delete;
+
+    ChunkPipeline &operator=(const ChunkPipeline &) = delete;
+
+    // Waits for the restores that are still running
+    ~ChunkPipeline();
+
+    void addPlayer(PlayerId a_player, World::ChunkPos a_pos);
+
+    void removePlayer(PlayerId a_player);
+
+    // Cheap if the player stays in the same chunk, can be called every tick
+    void setPlayerPosition(PlayerId a_player, World::ChunkPos a_pos);
+
+    // Tickets are counted, every addTicket() needs a removeTicket()
+    void addTicket(World::ChunkPos a_pos);
+
+    void removeTicket(World::ChunkPos a_pos);
+
+    // Adds what the workers finished to the world, unloads expired chunks & hands the nearest waiting chunks to the
+    // workers
+    void tick();
+
+    [[nodiscard]]
+    Stats getStats() const;
+
+private:
+    enum class State : uint8_t
+    {
+        // In m_pending until the next tick
+        Waiting,
+        // Queued for the workers or worked on
+        InFlight,
+        Loaded,
+        // A stage threw, not retried until the chunk lost all its tickets
+        Failed
+    };
+
+    struct Request
+    {
+        World::ChunkPos pos;
+        // Set on the ticking thread, checked by the worker before every stage
+        std::atomic<bool> cancelled = false;
+        // Written by the worker, read by the ticking thread once it got the request back
+        Stage reached = Stage::Load;
+        bool fromStorage = false;
+        // Set if a stage threw
+        std::string error;
+        // To the nearest player, set on the ticking thread while the request is queued
+        int32_t distance = 0;
+        std::unique_ptr<World::Chunk> chunk;
+    };
+
+    struct Entry
+    {
+        uint32_t tickets = 0;
+        State state = State::Waiting;
+        std::shared_ptr<Request> request;
+        // When a loaded chunk lost its last ticket
+        uint64_t releasedTick = 0;
+    };
+
+    World::ChunkMap &m_world;
+    Stages m_stages;
+    LoadedFunction m_onLoaded;
+    UnloadedFunction m_onUnloaded;
+    int32_t m_ticketRadius;
+    uint64_t m_currentTick = 0;
+    std::unordered_map<PlayerId, World::ChunkPos> m_players;
+    std::unordered_map<World::ChunkPos, Entry> m_entries;
+    // Ticketed since the last tick, may contain chunks that are no longer waiting, they are skipped
+    std::vector<World::ChunkPos> m_pending;
+    // Loaded chunks that lost their last ticket, unloaded once the delay passed unless they got one again
+    std::deque<std::pair<World::ChunkPos, uint64_t>> m_released;
+    size_t m_inFlight = 0;
+    Stats m_totals;
+
+    mutable std::mutex m_queueMutex;
+    std::condition_variable m_queueCondition;
+    // Nearest last, the workers take from the back
+    std::vector<std::shared_ptr<Request>> m_queue;
+    bool m_stopping = false;
+    // Requests a restore stage has, guarded by m_queueMutex
+    size_t m_restoring = 0;
+    std::condition_variable m_restored;
+    Utils::MpscQueue<std::shared_ptr<Request>> m_finished;
+    std::vector<std::jthread> m_workers;
+
+    // The tickets of a player, moving players get their new tickets before the old ones are removed, so the chunks
+    // both squares share never lose all their tickets
+    void addPlayerTickets(World::ChunkPos a_center);
+
+    void removePlayerTickets(World::ChunkPos a_center);
+
+    void finishRequests();
+
+    void unloadReleased();
+
+    void dispatch();
+
+    void runWorker();
+
+    // Returns false if the restore stage took the request over, it's finished once that's done
+    bool process(const std::shared_ptr<Request> &a_request);
+
+    void finishRestore(std::shared_ptr<Request> a_request, std::exception_ptr a_error);
+};
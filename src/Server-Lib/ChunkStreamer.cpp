@@ -0,0 +1,259 @@
+#include <algorithm>
+#include <numeric>
+
+#include "Network/Packets.h"
+#include "Network/SectionEncoding.h"
+#include "ChunkStreamer.h"
+
+using World::ChunkPos, World::SectionPos, World::BlockPos, World::BlockStateId, World::MIN_SECTION_Y,
+        World::SECTIONS_PER_CHUNK;
+
+ChunkStreamer::ChunkStreamer(const World::ChunkMap &a_world, const int32_t a_viewDistance, const size_t a_bytesPerTick)
+    : m_world(a_world), m_viewDistance(a_viewDistance), m_bytesPerTick(a_bytesPerTick)
+{
+    // Walks every ring clockwise, starting at its north west corner
+    m_spiral.push_back({0, 0});
+    for (int32_t ring = 1; ring <= m_viewDistance; ring++)
+    {
+        for (int32_t x = -ring; x < ring; x++)
+            m_spiral.push_back({x, -ring});
+        for (int32_t z = -ring; z < ring; z++)
+            m_spiral.push_back({ring, z});
+        for (int32_t x = ring; x > -ring; x--)
+            m_spiral.push_back({x, ring});
+        for (int32_t z = ring; z > -ring; z--)
+            m_spiral.push_back({-ring, z});
+    }
+}
+
+void ChunkStreamer::addPlayer(const PlayerId a_player, const ChunkPos a_pos, SendFunction a_send)
+{
+    Player &player = m_players[a_player];
+    player.center = a_pos;
+    player.send = std::move(a_send);
+}
+
+void ChunkStreamer::removePlayer(const PlayerId a_player)
+{
+    m_players.erase(a_player);
+}
+
+void ChunkStreamer::setPlayerPosition(const PlayerId a_player, const ChunkPos a_pos)
+{
+    const auto found = m_players.find(a_player);
+    if (found == m_players.end() || found->second.center == a_pos)
+        return;
+
+    Player &player = found->second;
+    player.center = a_pos;
+    player.spiralIndex = 0;
+    player.missedColumns = false;
+
+    for (auto column = player.columns.begin(); column != player.columns.end();)
+    {
+        if (column->first.distanceTo(a_pos) > m_viewDistance + UNLOAD_MARGIN)
+        {
+            Network::encodePacket(getBuffer(player), Network::Packets::UnloadChunk{column->first});
+            column = player.columns.erase(column);
+        }
+        else
+        {
+            ++column;
+        }
+    }
+}
+
+void ChunkStreamer::onBlockChanged(const BlockPos &a_pos, const BlockStateId a_state)
+{
+    if (m_players.empty() || a_pos.y < World::MIN_BLOCK_Y || a_pos.y > World::MAX_BLOCK_Y)
+        return;
+
+    std::vector<std::pair<uint16_t, BlockStateId>> &changes = m_changes[SectionPos::of(a_pos)];
+    if (changes.size() > MAX_CHANGES_PER_SECTION)
+        return;
+
+    const auto index = static_cast<uint16_t>(World::ChunkSection::getIndex(World::blockToLocal(a_pos.x), World::blockToLocal(a_pos.y), World::blockToLocal(a_pos.z)));
+    const auto existing = std::ranges::find(changes, index, &std::pair<uint16_t, BlockStateId>::first);
+    if (existing != changes.end())
+        existing->second = a_state;
+    else
+        changes.emplace_back(index, a_state);
+}
+
+void ChunkStreamer::onChunkChanged(const ChunkPos a_pos)
+{
+    for (auto &[id, player]: m_players)
+    {
+        if (const auto column = player.columns.find(a_pos); column != player.columns.end())
+        {
+            column->second = 0;
+            player.spiralIndex = 0;
+        }
+        else if (a_pos.distanceTo(player.center) <= m_viewDistance)
+        {
+            // Newly loaded, sent right away instead of with the next retry of the missed columns
+            player.spiralIndex = 0;
+        }
+    }
+}
+
+void ChunkStreamer::tick()
+{
+    sendBlockChanges();
+
+    for (auto &[id, player]: m_players)
+    {
+        // Columns that weren't loaded yet are looked for again once a second
+        if (player.spiralIndex == m_spiral.size() && player.missedColumns && m_tickCount % BYTES_HISTORY_TICKS == 0)
+        {
+            player.spiralIndex = 0;
+            player.missedColumns = false;
+        }
+        sendSections(player);
+
+        size_t bytes = 0;
+        if (player.buffer.has_value())
+        {
+            bytes = (*player.buffer)->size();
+            if (bytes > 0)
+                player.send(std::move(*player.buffer));
+            player.buffer.reset();
+        }
+        player.bytesPerTick[m_tickCount % BYTES_HISTORY_TICKS] = bytes;
+    }
+
+    m_tickCount++;
+}
+
+std::optional<ChunkStreamer::PlayerStats> ChunkStreamer::getStats(const PlayerId a_player) const
+{
+    const auto found = m_players.find(a_player);
+    if (found == m_players.end())
+        return {};
+
+    const Player &player = found->second;
+    return PlayerStats{
+        .bytesPerSecond = std::accumulate(player.bytesPerTick.begin(), player.bytesPerTick.end(), size_t{0}),
+        .loadedColumns = player.columns.size(),
+        .sentSections = player.sentSections,
+        .sentBlockChanges = player.sentBlockChanges
+    };
+}
+
+size_t ChunkStreamer::getTotalBytesPerSecond() const
+{
+    size_t total = 0;
+    for (const auto &[id, player]: m_players)
+    {
+        total += std::accumulate(player.bytesPerTick.begin(), player.bytesPerTick.end(), size_t{0});
+    }
+    return total;
+}
+
+Network::ByteBuffer &ChunkStreamer::getBuffer(Player &a_player)
+{
+    if (!a_player.buffer.has_value())
+        a_player.buffer = m_buffers.acquire();
+    return **a_player.buffer;
+}
+
+void ChunkStreamer::sendBlockChanges()
+{
+    for (const auto &[section, changes]: m_changes)
+    {
+        if (changes.empty())
+            continue;
+        if (changes.size() > MAX_CHANGES_PER_SECTION)
+        {
+            forgetSection(section);
+            continue;
+        }
+
+        // Encoded once, then copied to every player that has the section
+        m_frameScratch.clear();
+        if (changes.size() == 1)
+        {
+            const auto [index, state] = changes.front();
+            const BlockPos pos = section.getOrigin().offset(index & 15, index >> 8, index >> 4 & 15);
+            Network::encodePacket(m_frameScratch, Network::Packets::BlockChange{pos, {state}});
+        }
+        else
+        {
+            size_t size = 0;
+            for (const auto &[index, state]: changes)
+            {
+                size += Network::getVarLongSize(static_cast<int64_t>(state) << 12 | index);
+            }
+            m_scratch.resize(size);
+            Network::PacketWriter writer(m_scratch);
+            for (const auto &[index, state]: changes)
+            {
+                writer.writeVarLong(static_cast<int64_t>(state) << 12 | index);
+            }
+            Network::encodePacket(m_frameScratch, Network::Packets::MultiBlockChange{section, m_scratch});
+        }
+
+        const uint32_t sectionBit = 1u << (section.y - MIN_SECTION_Y);
+        for (auto &[id, player]: m_players)
+        {
+            const auto column = player.columns.find(ChunkPos::of(section));
+            if (column == player.columns.end() || (column->second & sectionBit) == 0)
+                continue;
+
+            Network::ByteBuffer &buffer = getBuffer(player);
+            buffer.insert(buffer.end(), m_frameScratch.begin(), m_frameScratch.end());
+            player.sentBlockChanges += changes.size();
+        }
+    }
+    m_changes.clear();
+}
+
+void ChunkStreamer::sendSections(Player &a_player)
+{
+    while (a_player.spiralIndex < m_spiral.size())
+    {
+        const ChunkPos offset = m_spiral[a_player.spiralIndex];
+        const ChunkPos pos{a_player.center.x + offset.x, a_player.center.z + offset.z};
+        const World::Chunk *chunk = m_world.getChunk(pos);
+        if (chunk == nullptr)
+        {
+            a_player.missedColumns = true;
+            a_player.spiralIndex++;
+            continue;
+        }
+
+        uint32_t &sentSections = a_player.columns[pos];
+        for (int32_t i = 0; i < SECTIONS_PER_CHUNK && sentSections != ALL_SECTIONS; i++)
+        {
+            if ((sentSections >> i & 1) != 0)
+                continue;
+
+            // Block changes count against the budget too, they are what the uplink has to carry this tick
+            Network::ByteBuffer &buffer = getBuffer(a_player);
+            if (buffer.size() >= m_bytesPerTick)
+                return;
+
+            m_scratch.clear();
+            if (const World::ChunkSection *section = chunk->getSection(MIN_SECTION_Y + i); section != nullptr && !section->isEmpty())
+                Network::encodeSectionBlocks(*section, m_scratch);
+            Network::encodePacket(buffer, Network::Packets::ChunkSectionData{{pos.x, MIN_SECTION_Y + i, pos.z}, m_scratch});
+
+            sentSections |= 1u << i;
+            a_player.sentSections++;
+        }
+        a_player.spiralIndex++;
+    }
+}
+
+void ChunkStreamer::forgetSection(const SectionPos &a_pos)
+{
+    const uint32_t sectionBit = 1u << (a_pos.y - MIN_SECTION_Y);
+    for (auto &[id, player]: m_players)
+    {
+        if (const auto column = player.columns.find(ChunkPos::of(a_pos)); column != player.columns.end())
+        {
+            column->second &= ~sectionBit;
+            player.spiralIndex = 0;
+        }
+    }
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Memory/MemoryTracker.h"
+#include "Network/BufferPool.h"
+#include "Utils/UniqueFunction.h"
+#include "World/BlockPos.h"
+#include "World/ChunkMap.h"
+
+// Keeps track of which sections every player has received, sends missing ones nearest first under a per tick bandwidth
+// budget & afterwards only the block changes of sections the player already has
+class ChunkStreamer final
+{
+public:
+    using PlayerId = uint32_t;
+    // Gets everything sent to a player in one tick as one buffer of packet frames
+    using SendFunction = Utils::UniqueFunction<void(Network::PooledBuffer &&)>;
+
+    // Columns stay loaded on the client until they are this much further away than the view distance, so players
+    // moving back & forth over a chunk border don't get the same columns sent again & again
+    static constexpr int32_t UNLOAD_MARGIN = 2;
+    // Sections with more block changes in one tick are sent again as a whole instead
+    static constexpr size_t MAX_CHANGES_PER_SECTION = 1024;
+    static constexpr size_t BYTES_HISTORY_TICKS = 20;
+
+    struct PlayerStats
+    {
+        // Sent over the last BYTES_HISTORY_TICKS ticks (a second at 20 TPS)
+        size_t bytesPerSecond = 0;
+        size_t loadedColumns = 0;
+        size_t sentSections = 0;
+        size_t sentBlockChanges = 0;
+    };
+
+    explicit ChunkStreamer(const World::ChunkMap &a_world, int32_t a_viewDistance = 8, size_t a_bytesPerTick = 128 << 10);
+
+    void addPlayer(PlayerId a_player, World::ChunkPos a_pos, SendFunction a_send);
+
+    void removePlayer(PlayerId a_player);
+
+    // Cheap if the player stays in the same chunk, can be called every tick
+    void setPlayerPosition(PlayerId a_player, World::ChunkPos a_pos);
+
+    // Must be called for every block change, changes are collected & sent with the next tick()
+    void onBlockChanged(const World::BlockPos &a_pos, World::BlockStateId a_state);
+
+    // The column was replaced or newly loaded, players that have it get it again & players in view of it get it
+    void onChunkChanged(World::ChunkPos a_pos);
+
+    void tick();
+
+    [[nodiscard]]
+    std::optional<PlayerStats> getStats(PlayerId a_player) const;
+
+    [[nodiscard]]
+    size_t getTotalBytesPerSecond() const;
+
+    [[nodiscard]]
+    size_t getPlayerCount() const
+    {
+        return m_players.size();
+    }
+
+private:
+    struct Player
+    {
+        World::ChunkPos center;
+        SendFunction send;
+        // Bit i is set once section MIN_SECTION_Y + i of the column was sent
+        std::unordered_map<World::ChunkPos, uint32_t> columns;
+        // Position in m_spiral, restarted whenever the player enters another chunk
+        size_t spiralIndex = 0;
+        // Columns in view that weren't loaded when the spiral passed them
+        bool missedColumns = false;
+        std::optional<Network::PooledBuffer> buffer;
+        std::array<size_t, BYTES_HISTORY_TICKS> bytesPerTick{};
+        size_t sentSections = 0;
+        size_t sentBlockChanges = 0;
+    };
+
+    static constexpr uint32_t ALL_SECTIONS = (1u << World::SECTIONS_PER_CHUNK) - 1;
+
+    const World::ChunkMap &m_world;
+    int32_t m_viewDistance;
+    size_t m_bytesPerTick;
+    // Offsets of the columns in view, ring by ring from the center outwards
+    std::vector<World::ChunkPos> m_spiral;
+    std::unordered_map<PlayerId, Player> m_players;
+    // Block changes since the last tick per section as (index, state), only the last change of a block is kept
+    std::unordered_map<World::SectionPos, std::vector<std::pair<uint16_t, World::BlockStateId>>> m_changes;
+    Network::BufferPool m_buffers;
+    Network::ByteBuffer m_scratch{Memory::getTrackedResource(Memory::MemoryTag::NetworkBuffers)};
+    Network::ByteBuffer m_frameScratch{Memory::getTrackedResource(Memory::MemoryTag::NetworkBuffers)};
+    uint64_t m_tickCount = 0;
+
+    [[nodiscard]]
+    Network::ByteBuffer &getBuffer(Player &a_player);
+
+    void sendBlockChanges();
+
+    void sendSections(Player &a_player);
+
+    // Sections that were resent as a whole are dropped from every player, so the spiral picks them up again
+    void forgetSection(const World::SectionPos &a_pos);
+};
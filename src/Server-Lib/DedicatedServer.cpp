@@ -0,0 +1,598 @@
+#include <cmath>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "spdlog/spdlog.h"
+#include "../Common-Lib/Logging.h"
+#include "Network/Packets.h"
+#include "Network/TcpConnection.h"
+#include "DedicatedServer.h"
+
+using std::chrono::steady_clock;
+namespace Packets = Network::Packets;
+
+// Average tick timings are logged every this many ticks
+constexpr uint64_t g_tickReportInterval = 30 * DedicatedServer::TICKS_PER_SECOND;
+// If the server falls further behind than this, the missed ticks are dropped instead of caught up on
+constexpr std::chrono::seconds g_maxTickBacklog(2);
+// Time per tick spent on pending path requests, the rest carries over to the next tick
+constexpr std::chrono::milliseconds g_pathfindingBudget(4);
+// Tick arenas keep the memory of their busiest tick, past this it's given back after the tick
+constexpr size_t g_scratchMemoryBudget = 64 << 20;
+// Unloaded chunks are kept in memory up to this, compressed
+constexpr size_t g_chunkCacheMemory = 256 << 20;
+constexpr const char *g_worldDirectory = "world";
+// Every 5 minutes, only the sections that changed since are written
+constexpr uint64_t g_autosaveInterval = 5 * 60 * DedicatedServer::TICKS_PER_SECOND;
+constexpr uint64_t g_worldSeed = 0x4D43707053656564;
+// Chunks around the spawn chunk that stay loaded without players
+constexpr int32_t g_spawnChunkRadius = 2;
+// On top of the terrain
+constexpr glm::dvec3 g_spawnPosition(0.5, WorldGenerator::SURFACE_Y + 1.0, 0.5);
+// Players can't move further out than this
+constexpr double g_maxHorizontalPosition = 30'000'000.0;
+constexpr size_t g_maxNameLength = 16;
+constexpr size_t g_maxChatMessageLength = 256;
+// Sent to every client at login, packets from this size on are compressed
+constexpr int32_t g_compressionThreshold = static_cast<int32_t>(Network::DEFAULT_COMPRESSION_THRESHOLD);
+
+DedicatedServer::DedicatedServer()
+    : m_generator(g_worldSeed), m_storage(m_files, g_worldDirectory), m_chunkCache(g_chunkCacheMemory)
+{
+    Logging::setupLogging();
+    m_logger = Logging::getLogger("Server");
+
+    m_logger->info("Starting Server ...");
+    m_logger->debug("Using {} job threads", m_jobSystem.getThreadCount());
+
+    const World::ChunkPos spawnChunk = World::ChunkPos::of(World::BlockPos::containing(g_spawnPosition));
+    for (int32_t x = -g_spawnChunkRadius; x <= g_spawnChunkRadius; x++)
+    {
+        for (int32_t z = -g_spawnChunkRadius; z <= g_spawnChunkRadius; z++)
+        {
+            m_chunkPipeline.addTicket({spawnChunk.x + x, spawnChunk.z + z});
+        }
+    }
+
+    Memory::setBudget(Memory::MemoryTag::Scratch, g_scratchMemoryBudget);
+    m_scratchEvictionCallback = Memory::addEvictionCallback(Memory::MemoryTag::Scratch, this, [this](size_t)
+    {
+        const size_t released = m_tickArena.getCapacity();
+        m_tickArena.release();
+        return released;
+    });
+};
+
+DedicatedServer::~DedicatedServer()
+{
+    m_logger->info("Stopping Server ...");
+    Memory::removeEvictionCallback(Memory::MemoryTag::Scratch, m_scratchEvictionCallback);
+    if (m_acceptor.has_value())
+    {
+        // On its strand, so a connection that was just accepted is pending by the time the acceptor is closed
+        std::promise<void> closed;
+        asio::post(m_acceptor->get_executor(), [this, &closed]
+        {
+            m_acceptor->close();
+            closed.set_value();
+        });
+        closed.get_future().wait();
+    }
+    if (m_metricsEndpoint.has_value())
+        m_metricsEndpoint->close();
+    for (auto &[id, session]: m_sessions)
+    {
+        session.connection.close();
+    }
+    while (std::optional<Network::Connection> connection = m_pendingConnections.tryPop())
+    {
+        connection->close();
+    }
+    // Lets the connections send what's still queued
+    m_networkThreads.join();
+
+    // The storage writes them before it's destroyed
+    m_logger->info("Saving {} sections ...", m_storage.save(m_world));
+
+    m_logger->flush();
+};
+
+int DedicatedServer::run()
+{
+    m_logger->info("Running Server ...");
+
+    steady_clock::time_point nextTick = steady_clock::now();
+    while (m_running)
+    {
+        tick();
+
+        nextTick += TICK_DURATION;
+        const steady_clock::time_point now = steady_clock::now();
+        if (now - nextTick > g_maxTickBacklog)
+        {
+            m_logger->warn("Can't keep up! Running {} ticks behind, skipping them",
+                           (now - nextTick) / TICK_DURATION);
+            m_metrics.skippedTicks.add(static_cast<uint64_t>((now - nextTick) / TICK_DURATION));
+            nextTick = now;
+        }
+        std::this_thread::sleep_until(nextTick);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+void DedicatedServer::stop()
+{
+    m_running = false;
+}
+
+void DedicatedServer::addConnection(Network::Connection &&a_connection)
+{
+    m_pendingConnections.push(std::move(a_connection));
+}
+
+void DedicatedServer::listen(const uint16_t a_port)
+{
+    m_acceptor.emplace(asio::make_strand(m_networkThreads), asio::ip::tcp::endpoint(asio::ip::tcp::v4(), a_port));
+    m_logger->info("Listening on port {}", m_acceptor->local_endpoint().port());
+    asio::post(m_acceptor->get_executor(), [this]
+    {
+        acceptConnection();
+    });
+}
+
+void DedicatedServer::serveMetrics(const uint16_t a_port)
+{
+    m_metricsEndpoint.emplace(m_networkThreads.get_executor(), m_metricRegistry, a_port);
+}
+
+void DedicatedServer::setBlock(const World::BlockPos &a_pos, const World::BlockStateId a_state)
+{
+    m_regions.setBlock(a_pos, a_state);
+}
+
+void DedicatedServer::registerBlockBehaviors(TickRegion &a_region)
+{
+    World::BlockTickScheduler &blockTicks = a_region.getBlockTicks();
+
+    // Sand falls one block every 2 ticks while there is nothing to rest on below it
+    blockTicks.setNeighborUpdateHandler(World::Blocks::SAND, [this, &blockTicks](const World::BlockPos &a_pos, const World::BlockStateId a_state)
+    {
+        if (World::Blocks::getCollisionShape(m_world.getBlock(a_pos.offset(0, -1, 0))).isEmpty())
+            blockTicks.scheduleTick(a_pos, a_state, 2);
+    });
+    blockTicks.setScheduledTickHandler(World::Blocks::SAND, [this, &a_region](const World::BlockPos &a_pos, const World::BlockStateId a_state)
+    {
+        const World::BlockPos below = a_pos.offset(0, -1, 0);
+        if (below.y < World::MIN_BLOCK_Y || !World::Blocks::getCollisionShape(m_world.getBlock(below)).isEmpty())
+            return;
+
+        a_region.setBlock(a_pos, World::Blocks::AIR);
+        a_region.setBlock(below, a_state);
+    });
+
+    // Grass turns into dirt under opaque blocks & otherwise spreads onto nearby uncovered dirt
+    blockTicks.setRandomTickHandler(World::Blocks::GRASS_BLOCK, [this, &a_region](const World::BlockPos &a_pos, World::BlockStateId)
+    {
+        if (World::Blocks::getProperties(m_world.getBlock(a_pos.offset(0, 1, 0))).isOpaque)
+        {
+            a_region.setBlock(a_pos, World::Blocks::DIRT);
+            return;
+        }
+
+        const uint32_t random = a_region.getBlockTicks().nextRandom();
+        const World::BlockPos target = a_pos.offset(static_cast<int32_t>(random % 3) - 1,
+                                                     static_cast<int32_t>(random / 3 % 5) - 3,
+                                                     static_cast<int32_t>(random / 15 % 3) - 1);
+        if (m_world.getBlock(target) == World::Blocks::DIRT
+            && !World::Blocks::getProperties(m_world.getBlock(target.offset(0, 1, 0))).isOpaque)
+            a_region.setBlock(target, World::Blocks::GRASS_BLOCK);
+    });
+}
+
+void DedicatedServer::tick()
+{
+    const steady_clock::time_point tickStart = steady_clock::now();
+
+    // First, so what the clients did since the last tick is part of this one
+    handleConnections();
+    m_lastTickTimings.network = steady_clock::now() - tickStart;
+
+    // Before anything reads the world, so chunks that finished loading are part of this tick
+    const steady_clock::time_point chunkLoadingStart = steady_clock::now();
+    m_chunkPipeline.tick();
+    m_lastTickTimings.chunkLoading = steady_clock::now() - chunkLoadingStart;
+
+    const World::BlockTickStats blockStats = m_regions.tick(m_jobSystem);
+    m_lastTickTimings.blocks = blockStats.duration;
+    if (blockStats.droppedNeighborUpdates > 0)
+    {
+        m_logger->warn("Too many neighbor updates, dropped {} of them", blockStats.droppedNeighborUpdates);
+        m_metrics.droppedNeighborUpdates.add(blockStats.droppedNeighborUpdates);
+    }
+    m_lastTickTimings.physics = m_physics.step(m_world, m_entities, m_jobSystem).duration;
+
+    const steady_clock::time_point pathfindingStart = steady_clock::now();
+    m_pathfinding.tick(g_pathfindingBudget);
+    m_lastTickTimings.pathfinding = steady_clock::now() - pathfindingStart;
+
+    // Last, so the block changes of this tick go out with it
+    const steady_clock::time_point chunkStreamingStart = steady_clock::now();
+    m_chunkStreamer.tick();
+    m_lastTickTimings.chunkStreaming = steady_clock::now() - chunkStreamingStart;
+
+    const steady_clock::time_point entityReplicationStart = steady_clock::now();
+    m_entityReplicator.tick(m_entities);
+    m_lastTickTimings.entityReplication = steady_clock::now() - entityReplicationStart;
+
+    m_tickArena.reset();
+    if (const size_t overBudget = Memory::enforceBudgets(this); overBudget > 0)
+    {
+        m_logger->warn("Memory budgets exceeded by {} KiB after eviction", overBudget / 1024);
+    }
+
+    m_lastTickTimings.total = steady_clock::now() - tickStart;
+    m_timingsSinceReport.total += m_lastTickTimings.total;
+    m_timingsSinceReport.network += m_lastTickTimings.network;
+    m_timingsSinceReport.chunkLoading += m_lastTickTimings.chunkLoading;
+    m_timingsSinceReport.blocks += m_lastTickTimings.blocks;
+    m_timingsSinceReport.physics += m_lastTickTimings.physics;
+    m_timingsSinceReport.pathfinding += m_lastTickTimings.pathfinding;
+    m_timingsSinceReport.chunkStreaming += m_lastTickTimings.chunkStreaming;
+    m_timingsSinceReport.entityReplication += m_lastTickTimings.entityReplication;
+
+    using Seconds = std::chrono::duration<double>;
+    m_metrics.tickTotal.observe(Seconds(m_lastTickTimings.total).count());
+    m_metrics.tickNetwork.observe(Seconds(m_lastTickTimings.network).count());
+    m_metrics.tickChunkLoading.observe(Seconds(m_lastTickTimings.chunkLoading).count());
+    m_metrics.tickBlocks.observe(Seconds(m_lastTickTimings.blocks).count());
+    m_metrics.tickPhysics.observe(Seconds(m_lastTickTimings.physics).count());
+    m_metrics.tickPathfinding.observe(Seconds(m_lastTickTimings.pathfinding).count());
+    m_metrics.tickChunkStreaming.observe(Seconds(m_lastTickTimings.chunkStreaming).count());
+    m_metrics.tickEntityReplication.observe(Seconds(m_lastTickTimings.entityReplication).count());
+    m_metrics.ticks.add();
+
+    m_recentTickTimes.push_back(static_cast<int32_t>(std::chrono::duration_cast<std::chrono::microseconds>(m_lastTickTimings.total).count()));
+
+    m_tickCount++;
+    if (m_tickCount % TICKS_PER_SECOND == 0)
+    {
+        sendTickTimes();
+        updateMetrics();
+    }
+    if (m_tickCount % g_tickReportInterval == 0)
+    {
+        reportTickTimings();
+    }
+    if (m_tickCount % g_autosaveInterval == 0)
+    {
+        autosave();
+    }
+}
+
+void DedicatedServer::handleConnections()
+{
+    while (std::optional<Network::Connection> connection = m_pendingConnections.tryPop())
+    {
+        const uint32_t sessionId = m_nextSessionId++;
+        m_sessions.emplace(sessionId, Session{std::move(*connection), Ecs::NULL_ENTITY, {}, {}});
+    }
+
+    for (auto session = m_sessions.begin(); session != m_sessions.end();)
+    {
+        auto &[id, state] = *session;
+        try
+        {
+            // Every buffer holds whole frames
+            while (std::optional<Network::PooledBuffer> buffer = state.connection.receive())
+            {
+                std::span<const std::byte> data = buffer->getData();
+                while (const std::optional<Network::PacketFrame> frame = Network::readFrame(data))
+                {
+                    handlePacket(id, state, *frame);
+                    data = data.subspan(frame->frameSize);
+                }
+                if (!data.empty())
+                    throw Network::ProtocolError("Incomplete packet frame");
+            }
+        } catch (const Network::ProtocolError &e)
+        {
+            m_logger->warn("Disconnecting {}: {}", state.name.empty() ? std::format("connection {}", id) : state.name, e.what());
+            state.connection.close();
+        }
+
+        if (state.connection.isClosed())
+        {
+            removeSession(id, state);
+            session = m_sessions.erase(session);
+        }
+        else
+        {
+            ++session;
+        }
+    }
+}
+
+void DedicatedServer::handlePacket(const uint32_t a_sessionId, Session &a_session, const Network::PacketFrame &a_frame)
+{
+    if (a_frame.id == Packets::Login::ID)
+    {
+        if (a_session.entity.isValid())
+            throw Network::ProtocolError("Logged in twice");
+        onLogin(a_sessionId, a_session, Network::decodePacket<Packets::Login>(a_frame.body).name);
+        return;
+    }
+    if (!a_session.entity.isValid())
+        throw Network::ProtocolError(std::format("Packet {} before logging in", a_frame.id));
+
+    switch (a_frame.id)
+    {
+        case Packets::KeepAlive::ID:
+            // Echoed, so the client can measure the round trip
+            send(a_session, Network::decodePacket<Packets::KeepAlive>(a_frame.body));
+            break;
+        case Packets::EntityPosition::ID:
+        {
+            // The player's own position, the entity id isn't used
+            const auto packet = Network::decodePacket<Packets::EntityPosition>(a_frame.body);
+            const glm::dvec3 position(packet.x, packet.y, packet.z);
+            if (!std::isfinite(packet.x) || !std::isfinite(packet.y) || !std::isfinite(packet.z)
+                || std::abs(packet.x) > g_maxHorizontalPosition || std::abs(packet.z) > g_maxHorizontalPosition)
+                throw Network::ProtocolError("Invalid position");
+
+            m_entities.addComponent(a_session.entity, Physics::Position{position});
+            m_entities.addComponent(a_session.entity, Physics::Rotation{packet.yaw, packet.pitch});
+            const World::ChunkPos chunk = World::ChunkPos::of(World::BlockPos::containing(position));
+            m_chunkStreamer.setPlayerPosition(a_sessionId, chunk);
+            m_regions.setPlayerPosition(a_sessionId, chunk);
+            m_chunkPipeline.setPlayerPosition(a_sessionId, chunk);
+            break;
+        }
+        case Packets::BlockChange::ID:
+        {
+            const auto packet = Network::decodePacket<Packets::BlockChange>(a_frame.body);
+            if (packet.state.value < 0 || packet.state.value >= static_cast<int32_t>(World::Blocks::getBlockStateCount()))
+                throw Network::ProtocolError("Invalid block state");
+            if (packet.pos.y >= World::MIN_BLOCK_Y && packet.pos.y <= World::MAX_BLOCK_Y && m_world.getChunk(World::ChunkPos::of(packet.pos)) != nullptr)
+                setBlock(packet.pos, static_cast<World::BlockStateId>(packet.state.value));
+            break;
+        }
+        case Packets::ChatMessage::ID:
+        {
+            const auto packet = Network::decodePacket<Packets::ChatMessage>(a_frame.body);
+            if (packet.message.size() > g_maxChatMessageLength)
+                throw Network::ProtocolError("Chat message too long");
+
+            const std::string message = std::format("<{}> {}", a_session.name, packet.message);
+            m_logger->info("[Chat] {}", message);
+            for (auto &[id, session]: m_sessions)
+            {
+                if (session.entity.isValid())
+                    send(session, Packets::ChatMessage{message, packet.timestamp});
+            }
+            break;
+        }
+        case Packets::SnapshotAck::ID:
+            m_entityReplicator.onSnapshotAck(a_sessionId, static_cast<uint64_t>(Network::decodePacket<Packets::SnapshotAck>(a_frame.body).tick.value));
+            break;
+        default:
+            throw Network::ProtocolError(std::format("Unexpected packet {}", a_frame.id));
+    }
+}
+
+void DedicatedServer::acceptConnection()
+{
+    m_acceptor->async_accept(asio::make_strand(m_networkThreads), [this](const asio::error_code &a_error, asio::ip::tcp::socket a_socket)
+    {
+        if (a_error == asio::error::operation_aborted)
+            return;
+        if (a_error)
+            m_logger->warn("Failed to accept a connection: {}", a_error.message());
+        else
+        {
+            m_metrics.acceptedConnections.add();
+            addConnection(Network::createTcpConnection(std::move(a_socket)));
+        }
+        acceptConnection();
+    });
+}
+
+void DedicatedServer::onLogin(const uint32_t a_sessionId, Session &a_session, const std::string_view a_name)
+{
+    if (a_name.empty() || a_name.size() > g_maxNameLength)
+        throw Network::ProtocolError("Invalid name");
+
+    a_session.name = a_name;
+    a_session.entity = m_entities.createEntity(Physics::Position{g_spawnPosition}, Physics::Rotation{});
+    // TCP connections compress every frame after this one, in both directions
+    send(a_session, Packets::SetCompression{{g_compressionThreshold}});
+    send(a_session, Packets::LoginSuccess{{static_cast<int64_t>(a_session.entity.toBits())}, g_spawnPosition.x, g_spawnPosition.y, g_spawnPosition.z});
+
+    // The streamer & replicator send into the connection directly, it stays in place until the session is removed
+    Network::Connection *connection = &a_session.connection;
+    m_chunkStreamer.addPlayer(a_sessionId, World::ChunkPos::of(World::BlockPos::containing(g_spawnPosition)), [connection](Network::PooledBuffer &&a_buffer)
+    {
+        connection->send(std::move(a_buffer));
+    });
+    m_regions.addPlayer(a_sessionId, World::ChunkPos::of(World::BlockPos::containing(g_spawnPosition)));
+    m_chunkPipeline.addPlayer(a_sessionId, World::ChunkPos::of(World::BlockPos::containing(g_spawnPosition)));
+    m_entityReplicator.addClient(a_sessionId, [connection](Network::PooledBuffer &&a_buffer)
+    {
+        connection->send(std::move(a_buffer));
+    });
+    a_session.metrics.emplace(m_metricRegistry, a_sessionId);
+    m_logger->info("{} joined the game", a_session.name);
+}
+
+void DedicatedServer::removeSession(const uint32_t a_sessionId, Session &a_session)
+{
+    if (!a_session.entity.isValid())
+        return;
+
+    m_chunkStreamer.removePlayer(a_sessionId);
+    m_regions.removePlayer(a_sessionId);
+    m_chunkPipeline.removePlayer(a_sessionId);
+    m_entityReplicator.removeClient(a_sessionId);
+    m_entities.destroyEntity(a_session.entity);
+    a_session.metrics.reset();
+    ServerMetrics::ConnectionMetrics::remove(m_metricRegistry, a_sessionId);
+    m_logger->info("{} left the game", a_session.name);
+}
+
+void DedicatedServer::sendTickTimes()
+{
+    size_t size = 0;
+    for (const int32_t time: m_recentTickTimes)
+    {
+        size += Network::getVarIntSize(time);
+    }
+    std::pmr::vector<std::byte> durations(size, &m_tickArena);
+    Network::PacketWriter writer(durations);
+    for (const int32_t time: m_recentTickTimes)
+    {
+        writer.writeVarInt(time);
+    }
+    m_recentTickTimes.clear();
+
+    m_scratch.clear();
+    Network::encodePacket(m_scratch, Packets::TickTimes{{static_cast<int64_t>(m_tickCount)}, durations});
+    for (auto &[id, session]: m_sessions)
+    {
+        if (!session.entity.isValid())
+            continue;
+
+        Network::PooledBuffer buffer = m_buffers.acquire();
+        buffer->assign(m_scratch.begin(), m_scratch.end());
+        session.connection.send(std::move(buffer));
+    }
+}
+
+void DedicatedServer::reportTickTimings()
+{
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    const Milliseconds averageTotal = m_timingsSinceReport.total / g_tickReportInterval;
+    const Milliseconds averageNetwork = m_timingsSinceReport.network / g_tickReportInterval;
+    const Milliseconds averageChunkLoading = m_timingsSinceReport.chunkLoading / g_tickReportInterval;
+    const Milliseconds averageBlocks = m_timingsSinceReport.blocks / g_tickReportInterval;
+    const Milliseconds averagePhysics = m_timingsSinceReport.physics / g_tickReportInterval;
+    const Milliseconds averagePathfinding = m_timingsSinceReport.pathfinding / g_tickReportInterval;
+    const Milliseconds averageChunkStreaming = m_timingsSinceReport.chunkStreaming / g_tickReportInterval;
+    const Milliseconds averageEntityReplication = m_timingsSinceReport.entityReplication / g_tickReportInterval;
+    const Pathfinding::PathfindingStats pathfindingStats = m_pathfinding.getStats();
+
+    m_logger->debug("Tick {}: {:.3f} mspt, blocks {:.3f} ms/tick ({} regions of {} chunks, {} scheduled ticks pending), "
+                    "physics {:.3f} ms/tick ({} entities moved last tick), "
+                    "pathfinding {:.3f} ms/tick ({} paths, {} from cache, {} pending), "
+                    "chunk streaming {:.3f} ms/tick ({} players, {} KiB/s)",
+                    m_tickCount, averageTotal.count(), averageBlocks.count(), m_regions.getRegionCount(),
+                    m_regions.getSimulatedChunkCount(), m_regions.getScheduledTickCount(),
+                    averagePhysics.count(), m_physics.getLastStepStats().movedEntities,
+                    averagePathfinding.count(), pathfindingStats.completedRequests, pathfindingStats.cachedRequests,
+                    pathfindingStats.pendingRequests, averageChunkStreaming.count(), m_chunkStreamer.getPlayerCount(),
+                    m_chunkStreamer.getTotalBytesPerSecond() / 1024);
+    const EntityReplicator::Stats replicationStats = m_entityReplicator.getStats();
+    m_logger->debug("Entity replication: {:.3f} ms/tick, {} entities to {} clients, {} KiB/s, {} delta & {} full snapshots",
+                    averageEntityReplication.count(), replicationStats.replicatedEntities,
+                    m_entityReplicator.getClientCount(), replicationStats.bytesPerSecond / 1024,
+                    replicationStats.deltaSnapshots, replicationStats.fullSnapshots);
+    m_logger->debug("Network: {:.3f} ms/tick, {} connections", averageNetwork.count(), m_sessions.size());
+    const ChunkPipeline::Stats chunkStats = m_chunkPipeline.getStats();
+    m_logger->debug("Chunk loading: {:.3f} ms/tick, {} chunks loaded, {} waiting, {} in flight, "
+                    "{} loaded & {} generated, {} unloaded, {} cancelled, {} failed",
+                    averageChunkLoading.count(), chunkStats.loadedChunks, chunkStats.pendingChunks,
+                    chunkStats.inFlightChunks, chunkStats.loaded, chunkStats.generated, chunkStats.unloaded,
+                    chunkStats.cancelled, chunkStats.failed);
+    const ChunkCache::Stats cacheStats = m_chunkCache.getStats();
+    m_logger->debug("Chunk cache: {} chunks ({} compressed) in {} KiB, {} hits, {} misses, {} evicted",
+                    cacheStats.chunks, cacheStats.compressedChunks, cacheStats.memory / 1024, cacheStats.hits,
+                    cacheStats.misses, cacheStats.evicted);
+    const WorldStorage::Stats storageStats = m_storage.getStats();
+    m_logger->debug("World storage: {} chunks waiting, {} sections saved, {} chunks written ({} KiB), {} failed, {} lost",
+                    storageStats.pendingChunks, storageStats.savedSections, storageStats.writtenChunks,
+                    storageStats.writtenBytes / 1024, storageStats.failedWrites, storageStats.lostChunks);
+    m_logger->debug("Tick scratch memory: {} KiB peak, {} KiB reserved",
+                    m_tickArena.getHighWaterMark() / 1024, m_tickArena.getCapacity() / 1024);
+
+    m_timingsSinceReport = {};
+    reportMemoryUsage();
+}
+
+void DedicatedServer::updateMetrics()
+{
+    const ChunkPipeline::Stats chunkStats = m_chunkPipeline.getStats();
+    m_metrics.loadedChunks.set(static_cast<double>(m_world.getChunkCount()));
+    m_metrics.pendingChunks.set(static_cast<double>(chunkStats.pendingChunks));
+    m_metrics.inFlightChunks.set(static_cast<double>(chunkStats.inFlightChunks));
+    m_metrics.generatedChunks.set(chunkStats.generated);
+    m_metrics.unloadedChunks.set(chunkStats.unloaded);
+    m_metrics.failedChunks.set(chunkStats.failed);
+
+    const ChunkCache::Stats cacheStats = m_chunkCache.getStats();
+    m_metrics.cachedChunks.set(static_cast<double>(cacheStats.chunks));
+    m_metrics.chunkCacheMemory.set(static_cast<double>(cacheStats.memory));
+    m_metrics.chunkCacheHits.set(cacheStats.hits);
+    m_metrics.chunkCacheMisses.set(cacheStats.misses);
+
+    const WorldStorage::Stats storageStats = m_storage.getStats();
+    m_metrics.pendingChunkWrites.set(static_cast<double>(storageStats.pendingChunks));
+    m_metrics.writtenBytes.set(storageStats.writtenBytes);
+    m_metrics.failedWrites.set(storageStats.failedWrites);
+    m_metrics.lostChunks.set(storageStats.lostChunks);
+
+    m_metrics.entities.set(static_cast<double>(m_entities.getEntityCount()));
+    m_metrics.players.set(static_cast<double>(m_chunkStreamer.getPlayerCount()));
+
+    const Memory::MemoryUsage usage = Memory::getMemoryUsage();
+    for (size_t i = 0; i < Memory::MEMORY_TAG_COUNT; i++)
+    {
+        m_metrics.hostMemory[i]->set(static_cast<double>(usage.host[i]));
+        m_metrics.deviceMemory[i]->set(static_cast<double>(usage.device[i]));
+        m_metrics.memoryBudgets[i]->set(static_cast<double>(Memory::getBudget(static_cast<Memory::MemoryTag>(i))));
+    }
+
+    size_t receiveQueueBuffers = 0;
+    for (auto &[id, session]: m_sessions)
+    {
+        receiveQueueBuffers += session.connection.getReceiveQueueSize();
+        if (session.metrics)
+        {
+            const Network::CompressionStats compression = session.connection.getCompressionStats();
+            session.metrics->compressionRatio.set(compression.getRatio());
+            session.metrics->compressionSeconds.set(std::chrono::duration<double>(compression.time).count());
+        }
+    }
+    m_metrics.connections.set(static_cast<double>(m_sessions.size()));
+    m_metrics.receiveQueueBuffers.set(static_cast<double>(receiveQueueBuffers));
+    m_metrics.sendQueueBytes.set(static_cast<double>(Network::getQueuedTcpBytes()));
+
+    m_metrics.droppedLogMessages.set(Logging::getDroppedMessageCount());
+    m_metrics.queuedLogMessages.set(static_cast<double>(Logging::getQueuedMessageCount()));
+}
+
+void DedicatedServer::autosave()
+{
+    const steady_clock::time_point start = steady_clock::now();
+    const size_t sections = m_storage.save(m_world);
+    const std::chrono::duration<double, std::milli> duration = steady_clock::now() - start;
+    m_logger->debug("Autosave: {} sections queued in {:.3f} ms", sections, duration.count());
+}
+
+void DedicatedServer::reportMemoryUsage() const
+{
+    const Memory::MemoryUsage usage = Memory::getMemoryUsage();
+    std::string perTag;
+    for (size_t i = 0; i < Memory::MEMORY_TAG_COUNT; i++)
+    {
+        const auto tag = static_cast<Memory::MemoryTag>(i);
+        if (usage.get(tag) == 0)
+            continue;
+
+        const size_t budget = Memory::getBudget(tag);
+        if (budget == 0)
+            perTag += std::format(", {} {} KiB", Memory::getTagName(tag), usage.get(tag) / 1024);
+        else
+            perTag += std::format(", {} {}/{} KiB", Memory::getTagName(tag), usage.get(tag) / 1024, budget / 1024);
+    }
+    m_logger->debug("Tracked memory: {} KiB{}", usage.getHostTotal() / 1024, perTag);
+}
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "asio.hpp"
+#include "spdlog/spdlog.h"
+
+#include "Ecs/Registry.h"
+#include "Memory/LinearArena.h"
+#include "Memory/MemoryTracker.h"
+#include "Network/Connection.h"
+#include "Pathfinding/PathfindingService.h"
+#include "Physics/PhysicsSystem.h"
+#include "Utils/FileService.h"
+#include "Utils/JobSystem.h"
+#include "Utils/Metrics.h"
+#include "Utils/MpscQueue.h"
+#include "World/ChunkMap.h"
+#include "ChunkCache.h"
+#include "ChunkPipeline.h"
+#include "ChunkStreamer.h"
+#include "EntityReplicator.h"
+#include "MetricsEndpoint.h"
+#include "ServerMetrics.h"
+#include "TickRegions.h"
+#include "WorldGenerator.h"
+#include "WorldStorage.h"
+
+class DedicatedServer final
+{
+public:
+    static constexpr int32_t TICKS_PER_SECOND = 20;
+    static constexpr std::chrono::nanoseconds TICK_DURATION = std::chrono::nanoseconds(std::chrono::seconds(1)) / TICKS_PER_SECOND;
+    static constexpr uint16_t DEFAULT_PORT = 25565;
+    static constexpr uint16_t DEFAULT_METRICS_PORT = 9565;
+
+    struct TickTimings
+    {
+        std::chrono::nanoseconds total{0};
+        std::chrono::nanoseconds network{0};
+        std::chrono::nanoseconds chunkLoading{0};
+        std::chrono::nanoseconds blocks{0};
+        std::chrono::nanoseconds physics{0};
+        std::chrono::nanoseconds pathfinding{0};
+        std::chrono::nanoseconds chunkStreaming{0};
+        std::chrono::nanoseconds entityReplication{0};
+    };
+
+    DedicatedServer();
+
+    ~DedicatedServer();
+
+    [[nodiscard]]
+    int run();
+
+    // Makes run() return after the current tick, safe to call from any thread & from signal handlers
+    void stop();
+
+    // Safe to call from any thread, the connection is picked up with the next tick & expected to log in
+    void addConnection(Network::Connection &&a_connection);
+
+    // Accepts TCP connections on the port from now on, on the network threads; throws an asio::system_error if the
+    // port can't be bound
+    void listen(uint16_t a_port);
+
+    // Serves the metrics at http://127.0.0.1:<port>/metrics in the Prometheus text format from now on, on the network
+    // threads; throws an asio::system_error if the port can't be bound
+    void serveMetrics(uint16_t a_port);
+
+    // Every block change of the server world has to go through here, so the systems caching world state see it
+    void setBlock(const World::BlockPos &a_pos, World::BlockStateId a_state);
+
+    // Scratch memory for the current tick, only for the tick thread, everything in it is freed after the tick
+    [[nodiscard]]
+    Memory::LinearArena &getTickArena()
+    {
+        return m_tickArena;
+    }
+
+    // TCP connections read, (de)compress & write their packets on these, not on the tick thread
+    [[nodiscard]]
+    asio::thread_pool &getNetworkThreads()
+    {
+        return m_networkThreads;
+    }
+
+    // Players are added here once they joined, with a function that sends to their connection
+    [[nodiscard]]
+    ChunkStreamer &getChunkStreamer()
+    {
+        return m_chunkStreamer;
+    }
+
+    // Clients are added here once they joined, their SnapshotAcks go to onSnapshotAck()
+    [[nodiscard]]
+    EntityReplicator &getEntityReplicator()
+    {
+        return m_entityReplicator;
+    }
+
+    // Safe to read from any thread
+    [[nodiscard]]
+    const Utils::MetricRegistry &getMetrics() const
+    {
+        return m_metricRegistry;
+    }
+
+    [[nodiscard]]
+    const TickTimings &getLastTickTimings() const
+    {
+        return m_lastTickTimings;
+    }
+
+private:
+    struct Session
+    {
+        Network::Connection connection;
+        // Until the client logged in there's no player entity
+        Ecs::EntityId entity;
+        std::string name;
+        // Added at login as well
+        std::optional<ServerMetrics::ConnectionMetrics> metrics;
+    };
+
+    std::shared_ptr<spdlog::logger> m_logger;
+    Utils::MetricRegistry m_metricRegistry;
+    ServerMetrics m_metrics{m_metricRegistry};
+    // Set up front, so a stop() before run() isn't lost
+    std::atomic<bool> m_running = true;
+    uint64_t m_tickCount = 0;
+    Utils::JobSystem m_jobSystem;
+    asio::thread_pool m_networkThreads{2};
+    // Only used on its own strand
+    std::optional<asio::ip::tcp::acceptor> m_acceptor;
+    std::optional<MetricsEndpoint> m_metricsEndpoint;
+    Memory::LinearArena m_tickArena{1 << 20, Memory::getTrackedResource(Memory::MemoryTag::Scratch)};
+    uint64_t m_scratchEvictionCallback = 0;
+    Ecs::Registry m_entities;
+    World::ChunkMap m_world;
+    Physics::PhysicsSystem m_physics;
+    Pathfinding::PathfindingService m_pathfinding{m_world};
+    ChunkStreamer m_chunkStreamer{m_world};
+    TickRegions m_regions{m_world, [this](TickRegion &a_region)
+    {
+        registerBlockBehaviors(a_region);
+    }, [this](const World::BlockPos &a_pos, const World::BlockStateId a_state)
+    {
+        m_pathfinding.onBlockChanged(a_pos);
+        m_chunkStreamer.onBlockChanged(a_pos, a_state);
+    }};
+    WorldGenerator m_generator;
+    Utils::FileService m_files;
+    WorldStorage m_storage;
+    ChunkCache m_chunkCache;
+    // After the systems it notifies, so its workers are stopped before those are destroyed
+    ChunkPipeline m_chunkPipeline{m_world, {
+        .load = [this](const World::ChunkPos a_pos)
+        {
+            return m_chunkCache.take(a_pos);
+        },
+        .generate = [this](World::Chunk &a_chunk)
+        {
+            m_generator.generate(a_chunk);
+        },
+        .decorate = [this](World::Chunk &a_chunk)
+        {
+            m_generator.decorate(a_chunk);
+        },
+        .restore = [this](World::Chunk &a_chunk, ChunkPipeline::StageDoneFunction a_done)
+        {
+            m_storage.restore(a_chunk, std::move(a_done));
+        }
+    }, [this](const World::ChunkPos a_pos)
+    {
+        m_pathfinding.onChunkChanged(a_pos);
+        m_chunkStreamer.onChunkChanged(a_pos);
+    }, [this](std::unique_ptr<World::Chunk> a_chunk)
+    {
+        m_pathfinding.onChunkChanged(a_chunk->getPos());
+        // Saved first, so the cache can evict it
+        m_storage.save(*a_chunk);
+        m_chunkCache.add(std::move(a_chunk));
+    }};
+    EntityReplicator m_entityReplicator;
+    Utils::MpscQueue<Network::Connection> m_pendingConnections;
+    std::unordered_map<uint32_t, Session> m_sessions;
+    uint32_t m_nextSessionId = 1;
+    Network::BufferPool m_buffers;
+    TickTimings m_lastTickTimings;
+    TickTimings m_timingsSinceReport;
+    // Microseconds per tick since the last TickTimes packet
+    std::vector<int32_t> m_recentTickTimes;
+    Network::ByteBuffer m_scratch;
+
+    // Handlers run on the job of their region & only change blocks through it
+    void registerBlockBehaviors(TickRegion &a_region);
+
+    void tick();
+
+    void handleConnections();
+
+    // Throws a Network::ProtocolError for packets the client must not send
+    void handlePacket(uint32_t a_sessionId, Session &a_session, const Network::PacketFrame &a_frame);
+
+    void acceptConnection();
+
+    void onLogin(uint32_t a_sessionId, Session &a_session, std::string_view a_name);
+
+    void removeSession(uint32_t a_sessionId, Session &a_session);
+
+    template<typename P>
+    void send(Session &a_session, const P &a_packet)
+    {
+        Network::PooledBuffer buffer = m_buffers.acquire();
+        Network::encodePacket(*buffer, a_packet);
+        a_session.connection.send(std::move(buffer));
+    }
+
+    // So clients (e.g. the load test) can measure the server's tick times
+    void sendTickTimes();
+
+    void reportTickTimings();
+
+    // Copies what the subsystems count themselves into the metrics
+    void updateMetrics();
+
+    // Snapshots the changed sections between two ticks, they're written on the storage's thread
+    void autosave();
+
+    void reportMemoryUsage() const;
+};
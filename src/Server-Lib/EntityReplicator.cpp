@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <numeric>
+
+#include "Network/Packets.h"
+#include "EntityReplicator.h"
+
+using Network::EntityState, Network::SNAPSHOT_HISTORY;
+
+void EntityReplicator::addClient(const ClientId a_client, SendFunction a_send)
+{
+    Client &client = m_clients[a_client];
+    client.send = std::move(a_send);
+    client.ackedTick = 0;
+}
+
+void EntityReplicator::removeClient(const ClientId a_client)
+{
+    m_clients.erase(a_client);
+}
+
+void EntityReplicator::onSnapshotAck(const ClientId a_client, const uint64_t a_tick)
+{
+    const auto found = m_clients.find(a_client);
+    if (found == m_clients.end() || a_tick > m_tick)
+        return;
+
+    found->second.ackedTick = std::max(found->second.ackedTick, a_tick);
+}
+
+void EntityReplicator::tick(const Ecs::Registry &a_entities)
+{
+    m_tick++;
+    Snapshot &snapshot = m_snapshots[m_tick % SNAPSHOT_HISTORY];
+    captureSnapshot(a_entities, snapshot);
+
+    m_frameCount = 0;
+    for (auto &[id, client]: m_clients)
+    {
+        // Acks older than the history fall back to a full snapshot
+        uint64_t baseTick = client.ackedTick;
+        if (baseTick != 0 && (m_tick - baseTick >= SNAPSHOT_HISTORY || m_snapshots[baseTick % SNAPSHOT_HISTORY].tick != baseTick))
+            baseTick = 0;
+
+        const Network::ByteBuffer &frame = getFrame(baseTick);
+        Network::PooledBuffer buffer = m_buffers.acquire();
+        buffer->assign(frame.begin(), frame.end());
+        client.bytesPerTick[m_tick % BYTES_HISTORY_TICKS] = frame.size();
+        client.send(std::move(buffer));
+        (baseTick == 0 ? m_fullSnapshots : m_deltaSnapshots)++;
+    }
+}
+
+EntityReplicator::Stats EntityReplicator::getStats() const
+{
+    size_t bytesPerSecond = 0;
+    for (const auto &[id, client]: m_clients)
+    {
+        bytesPerSecond += std::accumulate(client.bytesPerTick.begin(), client.bytesPerTick.end(), size_t{0});
+    }
+
+    return {
+        .replicatedEntities = m_snapshots[m_tick % SNAPSHOT_HISTORY].entities.size(),
+        .bytesPerSecond = bytesPerSecond,
+        .deltaSnapshots = m_deltaSnapshots,
+        .fullSnapshots = m_fullSnapshots
+    };
+}
+
+void EntityReplicator::captureSnapshot(const Ecs::Registry &a_entities, Snapshot &a_snapshot)
+{
+    a_snapshot.tick = m_tick;
+    a_snapshot.entities.clear();
+    m_query.forEachChunk(a_entities, [&a_snapshot](const Ecs::ChunkView &a_chunk)
+    {
+        const std::span<const Ecs::EntityId> entities = a_chunk.getEntities();
+        const std::span<const Physics::Position> positions = a_chunk.get<const Physics::Position>();
+        const std::span<const Physics::Rotation> rotations = a_chunk.has<Physics::Rotation>()
+                                                                 ? a_chunk.get<const Physics::Rotation>()
+                                                                 : std::span<const Physics::Rotation>();
+        const std::span<const Physics::RigidBody> bodies = a_chunk.has<Physics::RigidBody>()
+                                                               ? a_chunk.get<const Physics::RigidBody>()
+                                                               : std::span<const Physics::RigidBody>();
+
+        for (size_t i = 0; i < a_chunk.size(); i++)
+        {
+            const Physics::Rotation rotation = rotations.empty() ? Physics::Rotation() : rotations[i];
+            const Physics::RigidBody body = bodies.empty() ? Physics::RigidBody() : bodies[i];
+            a_snapshot.entities.push_back(EntityState::quantize(entities[i], positions[i].value, body.velocity,
+                                                                rotation.yaw, rotation.pitch, body.onGround));
+        }
+    });
+
+    // Archetypes are iterated in creation order, deltas need index order
+    std::ranges::sort(a_snapshot.entities, {}, [](const EntityState &a_state) { return a_state.entity.index; });
+}
+
+const Network::ByteBuffer &EntityReplicator::getFrame(const uint64_t a_baseTick)
+{
+    for (size_t i = 0; i < m_frameCount; i++)
+    {
+        if (m_frames[i].first == a_baseTick)
+            return m_frames[i].second;
+    }
+
+    const std::vector<EntityState> &entities = m_snapshots[m_tick % SNAPSHOT_HISTORY].entities;
+    m_scratch.clear();
+    if (a_baseTick == 0)
+        Network::encodeSnapshotDelta({}, entities, m_scratch);
+    else
+        Network::encodeSnapshotDelta(m_snapshots[a_baseTick % SNAPSHOT_HISTORY].entities, entities, m_scratch);
+
+    if (m_frameCount == m_frames.size())
+        m_frames.emplace_back(0, Network::ByteBuffer(Memory::getTrackedResource(Memory::MemoryTag::NetworkBuffers)));
+    auto &[baseTick, frame] = m_frames[m_frameCount++];
+    baseTick = a_baseTick;
+    frame.clear();
+    Network::encodePacket(frame, Network::Packets::EntitySnapshot{{static_cast<int64_t>(m_tick)}, {static_cast<int64_t>(a_baseTick)}, m_scratch});
+    return frame;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Ecs/Query.h"
+#include "Memory/MemoryTracker.h"
+#include "Network/BufferPool.h"
+#include "Network/EntitySnapshot.h"
+#include "Physics/PhysicsComponents.h"
+#include "Utils/UniqueFunction.h"
+
+// Sends every client a snapshot of the entities each tick, as a delta to the last snapshot the client acknowledged
+// Entities with a Physics::Position are replicated, their Physics::Rotation & Physics::RigidBody too if they have one
+class EntityReplicator final
+{
+public:
+    using ClientId = uint32_t;
+    using SendFunction = Utils::UniqueFunction<void(Network::PooledBuffer &&)>;
+
+    static constexpr size_t BYTES_HISTORY_TICKS = Network::SNAPSHOTS_PER_SECOND;
+
+    struct Stats
+    {
+        size_t replicatedEntities = 0;
+        // Sent to all clients over the last BYTES_HISTORY_TICKS ticks
+        size_t bytesPerSecond = 0;
+        uint64_t deltaSnapshots = 0;
+        // Snapshots for clients without a usable acknowledged one
+        uint64_t fullSnapshots = 0;
+    };
+
+    void addClient(ClientId a_client, SendFunction a_send);
+
+    void removeClient(ClientId a_client);
+
+    // Acks for snapshots older than the last acknowledged one are ignored
+    void onSnapshotAck(ClientId a_client, uint64_t a_tick);
+
+    void tick(const Ecs::Registry &a_entities);
+
+    [[nodiscard]]
+    Stats getStats() const;
+
+    [[nodiscard]]
+    size_t getClientCount() const
+    {
+        return m_clients.size();
+    }
+
+private:
+    struct Client
+    {
+        SendFunction send;
+        uint64_t ackedTick = 0;
+        std::array<size_t, BYTES_HISTORY_TICKS> bytesPerTick{};
+    };
+
+    struct Snapshot
+    {
+        uint64_t tick = 0;
+        std::vector<Network::EntityState> entities;
+    };
+
+    Ecs::Query<const Physics::Position> m_query;
+    // Ring of the last snapshots, indexed by tick
+    std::array<Snapshot, Network::SNAPSHOT_HISTORY> m_snapshots;
+    uint64_t m_tick = 0;
+    std::unordered_map<ClientId, Client> m_clients;
+    // Frames encoded this tick by base tick, clients that acknowledged the same snapshot get the same bytes
+    std::vector<std::pair<uint64_t, Network::ByteBuffer>> m_frames;
+    size_t m_frameCount = 0;
+    Network::ByteBuffer m_scratch{Memory::getTrackedResource(Memory::MemoryTag::NetworkBuffers)};
+    Network::BufferPool m_buffers;
+    uint64_t m_deltaSnapshots = 0;
+    uint64_t m_fullSnapshots = 0;
+
+    void captureSnapshot(const Ecs::Registry &a_entities, Snapshot &a_snapshot);
+
+    [[nodiscard]]
+    const Network::ByteBuffer &getFrame(uint64_t a_baseTick);
+};
@@ -0,0 +1,100 @@
+#include <array>
+#include <format>
+#include <string_view>
+
+#include "../Common-Lib/Logging.h"
+#include "MetricsEndpoint.h"
+
+// Scrapers send a few hundred bytes, anything that doesn't end its headers before this is cut off
+constexpr size_t g_maxRequestSize = 8 << 10;
+
+MetricsEndpoint::MetricsEndpoint(const asio::any_io_executor &a_executor, const Utils::MetricRegistry &a_registry, const uint16_t a_port)
+    : m_registry(a_registry), m_logger(Logging::getLogger("Metrics")), m_executor(a_executor),
+      m_acceptor(asio::make_strand(a_executor), asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), a_port)),
+      m_port(m_acceptor.local_endpoint().port())
+{
+    m_logger->info("Serving metrics on http://127.0.0.1:{}/metrics", m_port);
+    asio::co_spawn(m_acceptor.get_executor(), accept(), asio::detached);
+}
+
+void MetricsEndpoint::close()
+{
+    asio::post(m_acceptor.get_executor(), [this]
+    {
+        asio::error_code ignored;
+        m_acceptor.close(ignored);
+    });
+}
+
+asio::awaitable<void> MetricsEndpoint::accept()
+{
+    while (true)
+    {
+        asio::error_code error;
+        asio::ip::tcp::socket socket = co_await m_acceptor.async_accept(asio::make_strand(m_executor), asio::redirect_error(asio::use_awaitable, error));
+        if (!m_acceptor.is_open())
+            co_return;
+        if (error)
+        {
+            m_logger->warn("Failed to accept a connection: {}", error.message());
+            continue;
+        }
+        const asio::any_io_executor executor = socket.get_executor();
+        asio::co_spawn(executor, serve(std::move(socket)), asio::detached);
+    }
+}
+
+asio::awaitable<void> MetricsEndpoint::serve(asio::ip::tcp::socket a_socket)
+{
+    // Shared with the timer, which can still run once this is done
+    const auto socket = std::make_shared<asio::ip::tcp::socket>(std::move(a_socket));
+    asio::steady_timer timeout(socket->get_executor(), REQUEST_TIMEOUT);
+    timeout.async_wait([weakSocket = std::weak_ptr(socket)](const asio::error_code &a_error)
+    {
+        if (const std::shared_ptr<asio::ip::tcp::socket> expired = weakSocket.lock(); expired != nullptr && !a_error)
+        {
+            asio::error_code ignored;
+            expired->close(ignored);
+        }
+    });
+
+    try
+    {
+        std::string request;
+        co_await asio::async_read_until(*socket, asio::dynamic_buffer(request, g_maxRequestSize), "\r\n\r\n", asio::use_awaitable);
+
+        // Request line: method, target & version
+        const std::string_view requestLine = std::string_view(request).substr(0, request.find("\r\n"));
+        const size_t methodEnd = requestLine.find(' ');
+        const std::string_view method = requestLine.substr(0, methodEnd);
+        const std::string_view target = methodEnd == std::string_view::npos
+                                            ? std::string_view()
+                                            : requestLine.substr(methodEnd + 1, requestLine.find_first_of(" ?", methodEnd + 1) - methodEnd - 1);
+
+        std::string_view status = "200 OK";
+        std::string body;
+        if (method != "GET")
+        {
+            status = "405 Method Not Allowed";
+        }
+        else if (target != "/metrics")
+        {
+            status = "404 Not Found";
+        }
+        else
+        {
+            body = m_registry.render();
+        }
+
+        const std::string header = std::format("HTTP/1.1 {}\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                                               "Content-Length: {}\r\nConnection: close\r\n\r\n", status, body.size());
+        const std::array<asio::const_buffer, 2> buffers = {asio::buffer(header), asio::buffer(body)};
+        co_await asio::async_write(*socket, buffers, asio::use_awaitable);
+
+        asio::error_code ignored;
+        socket->shutdown(asio::ip::tcp::socket::shutdown_both, ignored);
+    } catch (const asio::system_error &)
+    {
+        // The client went away, sent too much or timed out, there's no one to answer
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+#include "asio.hpp"
+#include "spdlog/spdlog.h"
+
+#include "Utils/Metrics.h"
+
+// A minimal HTTP listener on the loopback interface that answers GET /metrics with the rendered registry, so the
+// server can be scraped by Prometheus without attaching anything to it; every request gets its own connection
+// Requests are served on the executor's threads, rendering only reads the metrics & never blocks whoever updates them
+class MetricsEndpoint final
+{
+public:
+    // Closes requests that aren't answered within this, so a stalled client can't keep the executor busy
+    static constexpr std::chrono::seconds REQUEST_TIMEOUT{5};
+
+    // Throws an asio::system_error if the port can't be bound; the endpoint & the registry have to stay alive until
+    // the executor ran out of work
+    MetricsEndpoint(const asio::any_io_executor &a_executor, const Utils::MetricRegistry &a_registry, uint16_t a_port);
+
+    MetricsEndpoint(const MetricsEndpoint &) = delete;
+
+    MetricsEndpoint &operator=(const MetricsEndpoint &) = delete;
+
+    // Stops accepting, safe to call from any thread; requests that are being served finish or time out on their own
+    void close();
+
+    [[nodiscard]]
+    uint16_t getPort() const
+    {
+        return m_port;
+    }
+
+private:
+    const Utils::MetricRegistry &m_registry;
+    std::shared_ptr<spdlog::logger> m_logger;
+    // Accepted connections get a strand of it each
+    asio::any_io_executor m_executor;
+    // Only used on its own strand
+    asio::ip::tcp::acceptor m_acceptor;
+    uint16_t m_port;
+
+    asio::awaitable<void> accept();
+
+    // Answers one request & closes the connection
+    asio::awaitable<void> serve(asio::ip::tcp::socket a_socket);
+};
@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+
+#include "RegionFile.h"
+
+using World::ChunkPos;
+
+constexpr std::array<std::byte, RegionFile::SECTOR_SIZE> g_padding{};
+
+size_t getSectorCount(const size_t a_bytes)
+{
+    return (a_bytes + RegionFile::SECTOR_SIZE - 1) / RegionFile::SECTOR_SIZE;
+}
+
+// Creates the file with an empty header if it doesn't exist yet, the header is read before the file is opened for I/O
+const std::filesystem::path &createRegionFile(const std::filesystem::path &a_path, const size_t a_headerSize)
+{
+    if (std::filesystem::exists(a_path))
+        return a_path;
+
+    std::ofstream created(a_path, std::ios::binary);
+    const std::vector<char> header(a_headerSize, 0);
+    created.write(header.data(), static_cast<std::streamsize>(header.size()));
+    if (!created)
+        throw std::runtime_error(std::format("Failed to create region file {}", a_path.string()));
+    return a_path;
+}
+
+RegionFile::RegionFile(Utils::FileService &a_files, const std::filesystem::path &a_path)
+    : m_path(a_path),
+      m_file(a_files, createRegionFile(a_path, HEADER_SECTORS * SECTOR_SIZE), Utils::FileService::File::Mode::ReadWrite)
+{
+    // Once per region, so it's fine to block for it
+    std::array<std::byte, CHUNK_COUNT * 8> header{};
+    std::ifstream stream(a_path, std::ios::binary);
+    stream.read(reinterpret_cast<char *>(header.data()), static_cast<std::streamsize>(header.size()));
+    if (!stream)
+        throw std::runtime_error(std::format("Failed to read the header of region file {}", a_path.string()));
+
+    m_usedSectors.assign(HEADER_SECTORS, true);
+    Network::PacketReader reader(header);
+    for (Location &location: m_locations)
+    {
+        location.sector = reader.readInteger<uint32_t>();
+        location.size = reader.readInteger<uint32_t>();
+        if (location.sector == 0)
+            continue;
+
+        const size_t end = location.sector + getSectorCount(location.size);
+        if (location.sector < HEADER_SECTORS)
+            throw std::runtime_error(std::format("Region file {} is corrupted", a_path.string()));
+        if (m_usedSectors.size() < end)
+            m_usedSectors.resize(end, false);
+        std::fill(m_usedSectors.begin() + location.sector, m_usedSectors.begin() + static_cast<std::ptrdiff_t>(end), true);
+    }
+}
+
+asio::awaitable<bool> RegionFile::read(const ChunkPos a_chunk, Network::ByteBuffer &a_data)
+{
+    Location location;
+    {
+        std::lock_guard lock(m_mutex);
+        location = m_locations[getIndex(a_chunk)];
+        if (location.sector == 0)
+            co_return false;
+        m_runningReads++;
+    }
+
+    a_data.resize(location.size);
+    size_t bytes = 0;
+    try
+    {
+        bytes = co_await m_file.read(location.sector * SECTOR_SIZE, a_data);
+    } catch (...)
+    {
+        finishRead();
+        throw;
+    }
+    finishRead();
+
+    if (bytes != location.size)
+        throw std::runtime_error(std::format("Region file {} is truncated", m_path.string()));
+    co_return true;
+}
+
+asio::awaitable<void> RegionFile::write(const ChunkPos a_chunk, const std::span<const std::byte> a_data)
+{
+    const size_t index = getIndex(a_chunk);
+    const size_t sectors = getSectorCount(a_data.size());
+    size_t sector;
+    {
+        std::lock_guard lock(m_mutex);
+        sector = allocateSectors(sectors);
+    }
+
+    const Location location{static_cast<uint32_t>(sector), static_cast<uint32_t>(a_data.size())};
+    std::array<std::byte, 8> entry{};
+    Network::PacketWriter writer(entry);
+    writer.writeInteger(location.sector);
+    writer.writeInteger(location.size);
+    try
+    {
+        // Padded to whole sectors, so the file never ends in the middle of a sector
+        co_await m_file.write(sector * SECTOR_SIZE, a_data);
+        co_await m_file.write(sector * SECTOR_SIZE + a_data.size(), std::span(g_padding).first(sectors * SECTOR_SIZE - a_data.size()));
+        co_await m_file.write(index * entry.size(), entry);
+    } catch (...)
+    {
+        std::lock_guard lock(m_mutex);
+        freeSectors(sector, sectors);
+        throw;
+    }
+
+    std::lock_guard lock(m_mutex);
+    const Location previous = std::exchange(m_locations[index], location);
+    if (previous.sector == 0)
+        co_return;
+    if (m_runningReads == 0)
+        freeSectors(previous.sector, getSectorCount(previous.size));
+    else
+        m_sectorsToFree.emplace_back(previous.sector, getSectorCount(previous.size));
+}
+
+size_t RegionFile::getIndex(const ChunkPos a_chunk)
+{
+    return static_cast<size_t>((a_chunk.z & CHUNKS_PER_SIDE - 1) * CHUNKS_PER_SIDE + (a_chunk.x & CHUNKS_PER_SIDE - 1));
+}
+
+size_t RegionFile::allocateSectors(const size_t a_count)
+{
+    size_t sector = HEADER_SECTORS;
+    for (size_t run = 0; sector + run < m_usedSectors.size() && run < a_count;)
+    {
+        if (m_usedSectors[sector + run])
+        {
+            sector += run + 1;
+            run = 0;
+        }
+        else
+        {
+            run++;
+        }
+    }
+    if (m_usedSectors.size() < sector + a_count)
+        m_usedSectors.resize(sector + a_count, false);
+    std::fill(m_usedSectors.begin() + static_cast<std::ptrdiff_t>(sector), m_usedSectors.begin() + static_cast<std::ptrdiff_t>(sector + a_count), true);
+    return sector;
+}
+
+void RegionFile::freeSectors(const size_t a_first, const size_t a_count)
+{
+    const auto first = m_usedSectors.begin() + static_cast<std::ptrdiff_t>(a_first);
+    std::fill(first, first + static_cast<std::ptrdiff_t>(a_count), false);
+}
+
+void RegionFile::finishRead()
+{
+    std::lock_guard lock(m_mutex);
+    if (--m_runningReads > 0)
+        return;
+
+    for (const auto &[first, count]: m_sectorsToFree)
+    {
+        freeSectors(first, count);
+    }
+    m_sectorsToFree.clear();
+}
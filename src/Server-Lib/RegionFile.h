@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "asio.hpp"
+
+#include "Network/PacketCodec.h"
+#include "Utils/FileService.h"
+#include "World/BlockPos.h"
+
+// The stored data of 32x32 chunks in one file: a header with the location of every chunk's data, then the data in
+// 4 KiB sectors
+// Data is always written to the first free sectors it fits in before the header points to it, so reads of the old data
+// that are still running & crashes in the middle of a write never see half written data; the old sectors are only
+// reused once no read is running anymore
+// Reads & writes of different chunks can run at the same time, but only one write per chunk; throws a
+// std::runtime_error (or std::system_error) if reading or writing fails
+class RegionFile final
+{
+public:
+    static constexpr int32_t CHUNKS_PER_SIDE = 32;
+    static constexpr size_t SECTOR_SIZE = 4096;
+
+    // Opens the file or creates it if it doesn't exist, only the header is read right away
+    RegionFile(Utils::FileService &a_files, const std::filesystem::path &a_path);
+
+    [[nodiscard]]
+    static World::ChunkPos getRegion(const World::ChunkPos a_chunk)
+    {
+        return {a_chunk.x >> 5, a_chunk.z >> 5};
+    }
+
+    [[nodiscard]]
+    static std::filesystem::path getFileName(const World::ChunkPos a_region)
+    {
+        return std::format("r.{}.{}.mcpp", a_region.x, a_region.z);
+    }
+
+    // Returns false if nothing was written for the chunk yet
+    [[nodiscard]]
+    asio::awaitable<bool> read(World::ChunkPos a_chunk, Network::ByteBuffer &a_data);
+
+    asio::awaitable<void> write(World::ChunkPos a_chunk, std::span<const std::byte> a_data);
+
+private:
+    static constexpr size_t CHUNK_COUNT = CHUNKS_PER_SIDE * CHUNKS_PER_SIDE;
+    // Sector index & byte size of every chunk, big endian
+    static constexpr size_t HEADER_SECTORS = CHUNK_COUNT * 8 / SECTOR_SIZE;
+
+    struct Location
+    {
+        // 0 if nothing was written
+        uint32_t sector = 0;
+        uint32_t size = 0;
+    };
+
+    std::filesystem::path m_path;
+    Utils::FileService::File m_file;
+
+    std::mutex m_mutex;
+    std::array<Location, CHUNK_COUNT> m_locations;
+    std::vector<bool> m_usedSectors;
+    size_t m_runningReads = 0;
+    // Sectors of overwritten data that were still being read, first sector & count
+    std::vector<std::pair<size_t, size_t>> m_sectorsToFree;
+
+    [[nodiscard]]
+    static size_t getIndex(World::ChunkPos a_chunk);
+
+    // Has to be called with m_mutex locked, returns the first sector
+    size_t allocateSectors(size_t a_count);
+
+    // Has to be called with m_mutex locked
+    void freeSectors(size_t a_first, size_t a_count);
+
+    void finishRead();
+};
@@ -0,0 +1,75 @@
+#include <string>
+
+#include "ServerMetrics.h"
+
+Utils::Histogram &addTickHistogram(Utils::MetricRegistry &a_registry, std::string a_phase)
+{
+    return a_registry.addHistogram("mcpp_tick_duration_seconds", "Time spent per tick, in total & per phase",
+                                   Utils::MetricRegistry::DURATION_BOUNDS, {{"phase", std::move(a_phase)}});
+}
+
+constexpr const char *g_compressionRatioName = "mcpp_connection_compression_ratio";
+constexpr const char *g_compressionSecondsName = "mcpp_connection_compression_seconds";
+
+Utils::MetricLabels getConnectionLabels(const uint32_t a_sessionId)
+{
+    return {{"connection", std::to_string(a_sessionId)}};
+}
+
+ServerMetrics::ConnectionMetrics::ConnectionMetrics(Utils::MetricRegistry &a_registry, const uint32_t a_sessionId)
+    : compressionRatio(a_registry.addGauge(g_compressionRatioName, "Bytes on the wire per uncompressed byte of a connection",
+                                           getConnectionLabels(a_sessionId))),
+      compressionSeconds(a_registry.addGauge(g_compressionSecondsName, "CPU time a connection spent on (de)compressing packets",
+                                             getConnectionLabels(a_sessionId)))
+{
+}
+
+void ServerMetrics::ConnectionMetrics::remove(Utils::MetricRegistry &a_registry, const uint32_t a_sessionId)
+{
+    a_registry.remove(g_compressionRatioName, getConnectionLabels(a_sessionId));
+    a_registry.remove(g_compressionSecondsName, getConnectionLabels(a_sessionId));
+}
+
+ServerMetrics::ServerMetrics(Utils::MetricRegistry &a_registry)
+    : tickTotal(addTickHistogram(a_registry, "total")),
+      tickNetwork(addTickHistogram(a_registry, "network")),
+      tickChunkLoading(addTickHistogram(a_registry, "chunk_loading")),
+      tickBlocks(addTickHistogram(a_registry, "blocks")),
+      tickPhysics(addTickHistogram(a_registry, "physics")),
+      tickPathfinding(addTickHistogram(a_registry, "pathfinding")),
+      tickChunkStreaming(addTickHistogram(a_registry, "chunk_streaming")),
+      tickEntityReplication(addTickHistogram(a_registry, "entity_replication")),
+      ticks(a_registry.addCounter("mcpp_ticks_total", "Ticks run")),
+      skippedTicks(a_registry.addCounter("mcpp_skipped_ticks_total", "Ticks dropped because the server couldn't keep up")),
+      droppedNeighborUpdates(a_registry.addCounter("mcpp_dropped_neighbor_updates_total", "Neighbor updates over the per tick limit")),
+      loadedChunks(a_registry.addGauge("mcpp_loaded_chunks", "Chunks in the world")),
+      pendingChunks(a_registry.addGauge("mcpp_pending_chunks", "Chunks with a ticket waiting to be loaded")),
+      inFlightChunks(a_registry.addGauge("mcpp_in_flight_chunks", "Chunks a pipeline worker is on")),
+      generatedChunks(a_registry.addCounter("mcpp_generated_chunks_total", "Chunks generated instead of taken from the cache")),
+      unloadedChunks(a_registry.addCounter("mcpp_unloaded_chunks_total", "Chunks unloaded")),
+      failedChunks(a_registry.addCounter("mcpp_failed_chunks_total", "Chunks that failed to load")),
+      cachedChunks(a_registry.addGauge("mcpp_chunk_cache_chunks", "Unloaded chunks kept in memory")),
+      chunkCacheMemory(a_registry.addGauge("mcpp_chunk_cache_bytes", "Estimated memory of the chunk cache")),
+      chunkCacheHits(a_registry.addCounter("mcpp_chunk_cache_hits_total", "Chunks loaded from the cache")),
+      chunkCacheMisses(a_registry.addCounter("mcpp_chunk_cache_misses_total", "Chunks that weren't in the cache")),
+      pendingChunkWrites(a_registry.addGauge("mcpp_storage_pending_chunks", "Saved chunks waiting to be written")),
+      writtenBytes(a_registry.addCounter("mcpp_storage_written_bytes_total", "Compressed bytes written to region files")),
+      failedWrites(a_registry.addCounter("mcpp_storage_failed_writes_total", "Chunk writes that failed")),
+      lostChunks(a_registry.addCounter("mcpp_storage_lost_chunks_total", "Saved chunks dropped because every write of them failed")),
+      entities(a_registry.addGauge("mcpp_entities", "Entities in the world")),
+      players(a_registry.addGauge("mcpp_players", "Players that joined")),
+      acceptedConnections(a_registry.addCounter("mcpp_accepted_connections_total", "TCP connections accepted")),
+      connections(a_registry.addGauge("mcpp_connections", "Open connections, including the ones that didn't log in yet")),
+      receiveQueueBuffers(a_registry.addGauge("mcpp_network_receive_queue_buffers", "Received buffers waiting for the next tick")),
+      sendQueueBytes(a_registry.addGauge("mcpp_network_send_queue_bytes", "Bytes waiting to be written to TCP sockets")),
+      droppedLogMessages(a_registry.addCounter("mcpp_log_dropped_messages_total", "Log messages dropped because the queue was full")),
+      queuedLogMessages(a_registry.addGauge("mcpp_log_queued_messages", "Log messages waiting to be written"))
+{
+    for (size_t i = 0; i < Memory::MEMORY_TAG_COUNT; i++)
+    {
+        const std::string tag(Memory::getTagName(static_cast<Memory::MemoryTag>(i)));
+        hostMemory[i] = &a_registry.addGauge("mcpp_memory_bytes", "Tracked memory per tag", {{"tag", tag}, {"kind", "host"}});
+        deviceMemory[i] = &a_registry.addGauge("mcpp_memory_bytes", "Tracked memory per tag", {{"tag", tag}, {"kind", "device"}});
+        memoryBudgets[i] = &a_registry.addGauge("mcpp_memory_budget_bytes", "Memory budget per tag, 0 for none", {{"tag", tag}});
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "Memory/MemoryTracker.h"
+#include "Utils/Metrics.h"
+
+// What the dedicated server exposes for scraping, see MetricsEndpoint
+// Counters on the hot path are updated as things happen, everything the subsystems count themselves is copied over
+// about once per second on the ticking thread
+struct ServerMetrics
+{
+    // Series of a single connection, added once it logged in & removed again when it closes
+    struct ConnectionMetrics
+    {
+        // Both directions, see Network::CompressionStats
+        Utils::Gauge &compressionRatio;
+        Utils::Gauge &compressionSeconds;
+
+        ConnectionMetrics(Utils::MetricRegistry &a_registry, uint32_t a_sessionId);
+
+        static void remove(Utils::MetricRegistry &a_registry, uint32_t a_sessionId);
+    };
+
+    // Per tick phase, like DedicatedServer::TickTimings
+    Utils::Histogram &tickTotal;
+    Utils::Histogram &tickNetwork;
+    Utils::Histogram &tickChunkLoading;
+    Utils::Histogram &tickBlocks;
+    Utils::Histogram &tickPhysics;
+    Utils::Histogram &tickPathfinding;
+    Utils::Histogram &tickChunkStreaming;
+    Utils::Histogram &tickEntityReplication;
+    Utils::Counter &ticks;
+    Utils::Counter &skippedTicks;
+    Utils::Counter &droppedNeighborUpdates;
+
+    Utils::Gauge &loadedChunks;
+    Utils::Gauge &pendingChunks;
+    Utils::Gauge &inFlightChunks;
+    Utils::Counter &generatedChunks;
+    Utils::Counter &unloadedChunks;
+    Utils::Counter &failedChunks;
+    Utils::Gauge &cachedChunks;
+    Utils::Gauge &chunkCacheMemory;
+    Utils::Counter &chunkCacheHits;
+    Utils::Counter &chunkCacheMisses;
+    Utils::Gauge &pendingChunkWrites;
+    Utils::Counter &writtenBytes;
+    Utils::Counter &failedWrites;
+    Utils::Counter &lostChunks;
+
+    Utils::Gauge &entities;
+    Utils::Gauge &players;
+
+    // Indexed by Memory::MemoryTag
+    std::array<Utils::Gauge *, Memory::MEMORY_TAG_COUNT> hostMemory{};
+    std::array<Utils::Gauge *, Memory::MEMORY_TAG_COUNT> deviceMemory{};
+    std::array<Utils::Gauge *, Memory::MEMORY_TAG_COUNT> memoryBudgets{};
+
+    Utils::Counter &acceptedConnections;
+    Utils::Gauge &connections;
+    Utils::Gauge &receiveQueueBuffers;
+    Utils::Gauge &sendQueueBytes;
+
+    Utils::Counter &droppedLogMessages;
+    Utils::Gauge &queuedLogMessages;
+
+    explicit ServerMetrics(Utils::MetricRegistry &a_registry);
+};
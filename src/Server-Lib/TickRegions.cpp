@@ -0,0 +1,280 @@
+#include <algorithm>
+#include <numeric>
+#include <unordered_set>
+
+#include "TickRegions.h"
+
+using World::BlockPos, World::ChunkPos, World::BlockStateId, World::BlockTickStats;
+using std::chrono::steady_clock;
+
+constexpr int32_t g_neighborOffsets[7][3]{{0, 0, 0}, {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}};
+
+bool isBefore(const ChunkPos &a_first, const ChunkPos &a_second)
+{
+    return a_first.x != a_second.x ? a_first.x < a_second.x : a_first.z < a_second.z;
+}
+
+int32_t floorDivide(const int32_t a_value, const int32_t a_divisor)
+{
+    return a_value >= 0 ? a_value / a_divisor : (a_value - a_divisor + 1) / a_divisor;
+}
+
+void TickRegion::setBlock(const BlockPos &a_pos, const BlockStateId a_state)
+{
+    if (!std::ranges::binary_search(m_chunks, ChunkPos::of(a_pos), isBefore))
+    {
+        m_handoffs.push_back({a_pos, a_state});
+        return;
+    }
+
+    if (m_world.setBlock(a_pos, a_state) == a_state)
+        return;
+
+    m_blockTicks.onBlockChanged(a_pos);
+    m_changes.push_back({a_pos, a_state});
+}
+
+TickRegions::TickRegions(World::ChunkMap &a_world, SetupFunction a_setup, ChangeFunction a_onChanged, const int32_t a_simulationDistance)
+    : m_world(a_world), m_setup(std::move(a_setup)), m_onChanged(std::move(a_onChanged)),
+      m_simulationDistance(a_simulationDistance) {}
+
+void TickRegions::addPlayer(const PlayerId a_player, const ChunkPos a_pos)
+{
+    m_players[a_player] = a_pos;
+    m_playersMoved = true;
+}
+
+void TickRegions::removePlayer(const PlayerId a_player)
+{
+    if (m_players.erase(a_player) > 0)
+        m_playersMoved = true;
+}
+
+void TickRegions::setPlayerPosition(const PlayerId a_player, const ChunkPos a_pos)
+{
+    const auto player = m_players.find(a_player);
+    if (player == m_players.end() || player->second == a_pos)
+        return;
+
+    player->second = a_pos;
+    m_playersMoved = true;
+}
+
+void TickRegions::setBlock(const BlockPos &a_pos, const BlockStateId a_state)
+{
+    if (m_world.setBlock(a_pos, a_state) == a_state)
+        return;
+
+    m_onChanged(a_pos, a_state);
+    // Blocks outside of every region don't get updates, like blocks outside of the simulation distance
+    for (const auto &[x, y, z]: g_neighborOffsets)
+    {
+        const BlockPos neighbor = a_pos.offset(x, y, z);
+        if (TickRegion *owner = getOwner(neighbor); owner != nullptr)
+            owner->m_blockTicks.queueNeighborUpdate(neighbor);
+    }
+}
+
+BlockTickStats TickRegions::tick(Utils::JobSystem &a_jobSystem)
+{
+    const steady_clock::time_point start = steady_clock::now();
+    if (m_playersMoved && m_currentTick % REPARTITION_INTERVAL == 0)
+    {
+        repartition();
+        m_playersMoved = false;
+    }
+
+    // Every region only writes its own chunks, what it does elsewhere waits for the handoff
+    a_jobSystem.parallelFor(m_activeRegions, 1, [this](const size_t a_begin, const size_t a_end)
+    {
+        for (size_t i = a_begin; i < a_end; i++)
+        {
+            TickRegion &region = *m_regions[i];
+            region.m_lastStats = region.m_blockTicks.tick(region.m_chunks);
+        }
+    });
+
+    BlockTickStats stats;
+    for (size_t i = 0; i < m_activeRegions; i++)
+    {
+        TickRegion &region = *m_regions[i];
+        handOff(region);
+        stats.scheduledTicks += region.m_lastStats.scheduledTicks;
+        stats.randomTicks += region.m_lastStats.randomTicks;
+        stats.neighborUpdates += region.m_lastStats.neighborUpdates;
+        stats.randomTickedSections += region.m_lastStats.randomTickedSections;
+        stats.droppedNeighborUpdates += region.m_lastStats.droppedNeighborUpdates;
+    }
+
+    m_currentTick++;
+    stats.duration = steady_clock::now() - start;
+    return stats;
+}
+
+size_t TickRegions::getScheduledTickCount() const
+{
+    size_t count = m_dormantTicks.size();
+    for (size_t i = 0; i < m_activeRegions; i++)
+    {
+        count += m_regions[i]->m_blockTicks.getScheduledTickCount();
+    }
+    return count;
+}
+
+TickRegion *TickRegions::getOwner(const BlockPos &a_pos)
+{
+    const auto owner = m_owners.find(ChunkPos::of(a_pos));
+    return owner == m_owners.end() ? nullptr : m_regions[owner->second].get();
+}
+
+void TickRegions::repartition()
+{
+    std::vector<std::vector<ChunkPos>> regionChunks = buildRegionChunks();
+    if (regionChunks.size() == m_activeRegions)
+    {
+        bool unchanged = true;
+        for (size_t i = 0; i < m_activeRegions && unchanged; i++)
+        {
+            unchanged = regionChunks[i] == m_regions[i]->m_chunks;
+        }
+        if (unchanged)
+            return;
+    }
+
+    // Everything pending is collected & given to the new owner of its position
+    std::vector<World::BlockTickScheduler::ScheduledTick> scheduledTicks;
+    std::vector<BlockPos> neighborUpdates;
+    std::swap(scheduledTicks, m_dormantTicks);
+    for (size_t i = 0; i < m_activeRegions; i++)
+    {
+        m_regions[i]->m_blockTicks.takePending(scheduledTicks, neighborUpdates);
+    }
+
+    while (m_regions.size() < regionChunks.size())
+    {
+        m_regions.push_back(std::make_unique<TickRegion>(m_world));
+        m_setup(*m_regions.back());
+    }
+
+    m_owners.clear();
+    for (size_t i = 0; i < m_regions.size(); i++)
+    {
+        TickRegion &region = *m_regions[i];
+        if (i >= regionChunks.size())
+        {
+            region.m_chunks.clear();
+            continue;
+        }
+
+        region.m_chunks = std::move(regionChunks[i]);
+        region.m_blockTicks.setCurrentTick(m_currentTick);
+        // Depends on where the region is, not on which region object it got
+        region.m_blockTicks.setRandomSeed(static_cast<uint32_t>(std::hash<ChunkPos>{}(region.m_chunks.front()) ^ m_currentTick) | 1);
+        for (const ChunkPos &chunk: region.m_chunks)
+        {
+            m_owners.emplace(chunk, static_cast<uint32_t>(i));
+        }
+    }
+    m_activeRegions = regionChunks.size();
+
+    for (const World::BlockTickScheduler::ScheduledTick &scheduledTick: scheduledTicks)
+    {
+        if (TickRegion *owner = getOwner(scheduledTick.pos); owner != nullptr)
+            owner->m_blockTicks.addScheduledTick(scheduledTick);
+        else
+            m_dormantTicks.push_back(scheduledTick);
+    }
+    for (const BlockPos &pos: neighborUpdates)
+    {
+        if (TickRegion *owner = getOwner(pos); owner != nullptr)
+            owner->m_blockTicks.queueNeighborUpdate(pos);
+    }
+}
+
+std::vector<std::vector<ChunkPos>> TickRegions::buildRegionChunks() const
+{
+    std::vector<std::pair<PlayerId, ChunkPos>> players(m_players.begin(), m_players.end());
+    std::ranges::sort(players, {}, &std::pair<PlayerId, ChunkPos>::first);
+
+    // Players in the same group have overlapping or touching simulated squares, squares of different groups have at
+    // least one chunk between them
+    const int32_t groupDistance = 2 * m_simulationDistance + 1;
+    std::vector<uint32_t> parents(players.size());
+    std::iota(parents.begin(), parents.end(), 0);
+    const auto find = [&parents](uint32_t a_player)
+    {
+        while (parents[a_player] != a_player)
+        {
+            parents[a_player] = parents[parents[a_player]];
+            a_player = parents[a_player];
+        }
+        return a_player;
+    };
+
+    // Players that could be grouped are at most one cell apart
+    const int32_t cellSize = groupDistance + 1;
+    std::unordered_map<ChunkPos, std::vector<uint32_t>> cells;
+    for (uint32_t i = 0; i < players.size(); i++)
+    {
+        const ChunkPos pos = players[i].second;
+        const ChunkPos cell{floorDivide(pos.x, cellSize), floorDivide(pos.z, cellSize)};
+        for (int32_t x = -1; x <= 1; x++)
+        {
+            for (int32_t z = -1; z <= 1; z++)
+            {
+                const auto neighbors = cells.find({cell.x + x, cell.z + z});
+                if (neighbors == cells.end())
+                    continue;
+
+                for (const uint32_t other: neighbors->second)
+                {
+                    if (pos.distanceTo(players[other].second) <= groupDistance)
+                        parents[find(i)] = find(other);
+                }
+            }
+        }
+        cells[cell].push_back(i);
+    }
+
+    std::unordered_map<uint32_t, std::unordered_set<ChunkPos>> groups;
+    for (uint32_t i = 0; i < players.size(); i++)
+    {
+        std::unordered_set<ChunkPos> &chunks = groups[find(i)];
+        const ChunkPos center = players[i].second;
+        for (int32_t x = -m_simulationDistance; x <= m_simulationDistance; x++)
+        {
+            for (int32_t z = -m_simulationDistance; z <= m_simulationDistance; z++)
+            {
+                chunks.insert({center.x + x, center.z + z});
+            }
+        }
+    }
+
+    std::vector<std::vector<ChunkPos>> regions;
+    for (const auto &[root, chunks]: groups)
+    {
+        std::vector<ChunkPos> &region = regions.emplace_back(chunks.begin(), chunks.end());
+        std::ranges::sort(region, isBefore);
+    }
+    std::ranges::sort(regions, isBefore, [](const std::vector<ChunkPos> &a_chunks)
+    {
+        return a_chunks.front();
+    });
+    return regions;
+}
+
+void TickRegions::handOff(TickRegion &a_region)
+{
+    for (const TickRegion::BlockChange &change: a_region.m_changes)
+    {
+        m_onChanged(change.pos, change.state);
+    }
+    a_region.m_changes.clear();
+
+    // Applied like changes from outside, so they reach the region owning the block
+    for (const TickRegion::BlockChange &change: a_region.m_handoffs)
+    {
+        setBlock(change.pos, change.state);
+    }
+    a_region.m_handoffs.clear();
+}
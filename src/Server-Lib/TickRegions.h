@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "Utils/JobSystem.h"
+#include "Utils/UniqueFunction.h"
+#include "World/BlockTickScheduler.h"
+#include "World/ChunkMap.h"
+
+// Chunks around a group of players whose block updates run on one job, in parallel with the other regions
+// Handlers of the region's scheduler change blocks through the region: changes in its own chunks apply right away,
+// changes elsewhere are handed off & applied after every region finished its tick
+class TickRegion final
+{
+public:
+    struct BlockChange
+    {
+        World::BlockPos pos;
+        World::BlockStateId state = World::Blocks::AIR;
+    };
+
+    explicit TickRegion(World::ChunkMap &a_world)
+        : m_world(a_world), m_blockTicks(a_world) {}
+
+    TickRegion(const TickRegion &) = delete;
+
+    TickRegion &operator=(const TickRegion &) = delete;
+
+    // Only for the block handlers, while the region ticks
+    void setBlock(const World::BlockPos &a_pos, World::BlockStateId a_state);
+
+    [[nodiscard]]
+    World::BlockTickScheduler &getBlockTicks()
+    {
+        return m_blockTicks;
+    }
+
+    // Sorted, regions never own chunks next to the chunks of another region, so reading blocks up to a chunk away
+    // from the own chunks never races with another region
+    [[nodiscard]]
+    const std::vector<World::ChunkPos> &getChunks() const
+    {
+        return m_chunks;
+    }
+
+private:
+    friend class TickRegions;
+
+    World::ChunkMap &m_world;
+    World::BlockTickScheduler m_blockTicks;
+    std::vector<World::ChunkPos> m_chunks;
+    // Applied to own chunks during the tick, for the systems caching world state
+    std::vector<BlockChange> m_changes;
+    // Outside of the own chunks, applied in the handoff phase
+    std::vector<BlockChange> m_handoffs;
+    World::BlockTickStats m_lastStats;
+};
+
+// Splits the simulated part of the server world, the chunks within the simulation distance of a player, into regions
+// that tick in parallel on the job system; players whose simulated chunks touch share a region, so regions merge &
+// split as players move together & apart
+// After the parallel phase, the changes every region made & handed off are applied on the calling thread in region
+// order, which only depends on the player positions, so the result doesn't depend on thread timing
+class TickRegions final
+{
+public:
+    using PlayerId = uint32_t;
+    // Sets up the block handlers of a new region
+    using SetupFunction = Utils::UniqueFunction<void(TickRegion &)>;
+    // Called on the ticking thread for every block change, for the systems caching world state
+    using ChangeFunction = Utils::UniqueFunction<void(const World::BlockPos &, World::BlockStateId)>;
+
+    // Regions are rebuilt at most this often, they lag behind moving players by up to this many ticks
+    static constexpr uint64_t REPARTITION_INTERVAL = 10;
+
+    TickRegions(World::ChunkMap &a_world, SetupFunction a_setup, ChangeFunction a_onChanged, int32_t a_simulationDistance = 6);
+
+    void addPlayer(PlayerId a_player, World::ChunkPos a_pos);
+
+    void removePlayer(PlayerId a_player);
+
+    // Cheap if the player stays in the same chunk, can be called every tick
+    void setPlayerPosition(PlayerId a_player, World::ChunkPos a_pos);
+
+    // For changes from outside the block handlers (players, commands ...), not while ticking
+    void setBlock(const World::BlockPos &a_pos, World::BlockStateId a_state);
+
+    // Repartitions if players moved, ticks every region in parallel, then applies what they handed off
+    // The stats add up the regions, the duration is the wall time
+    World::BlockTickStats tick(Utils::JobSystem &a_jobSystem);
+
+    [[nodiscard]]
+    size_t getRegionCount() const
+    {
+        return m_activeRegions;
+    }
+
+    [[nodiscard]]
+    size_t getScheduledTickCount() const;
+
+    [[nodiscard]]
+    size_t getSimulatedChunkCount() const
+    {
+        return m_owners.size();
+    }
+
+private:
+    World::ChunkMap &m_world;
+    SetupFunction m_setup;
+    ChangeFunction m_onChanged;
+    int32_t m_simulationDistance;
+    uint64_t m_currentTick = 0;
+    std::unordered_map<PlayerId, World::ChunkPos> m_players;
+    bool m_playersMoved = false;
+    // Regions are kept & reused once created, the first m_activeRegions are ticked
+    std::vector<std::unique_ptr<TickRegion>> m_regions;
+    size_t m_activeRegions = 0;
+    // Region index of every simulated chunk
+    std::unordered_map<World::ChunkPos, uint32_t> m_owners;
+    // Scheduled ticks outside of every region, they continue once a region covers them again
+    std::vector<World::BlockTickScheduler::ScheduledTick> m_dormantTicks;
+
+    [[nodiscard]]
+    TickRegion *getOwner(const World::BlockPos &a_pos);
+
+    void repartition();
+
+    // The chunks of every group of players, sorted by their first chunk
+    [[nodiscard]]
+    std::vector<std::vector<World::ChunkPos>> buildRegionChunks() const;
+
+    void handOff(TickRegion &a_region);
+};
@@ -0,0 +1,70 @@
+#include "WorldGenerator.h"
+
+using World::BlockPos, World::ChunkPos;
+
+constexpr uint32_t g_maxTreesPerChunk = 2;
+constexpr int32_t g_trunkHeight = 5;
+// Trees stand this far from the chunk border, so their leaves stay inside
+constexpr int32_t g_treeMargin = 2;
+
+// splitmix64, so neighboring chunks get unrelated trees
+uint64_t mix(uint64_t a_value)
+{
+    a_value += 0x9E3779B97F4A7C15;
+    a_value = (a_value ^ a_value >> 30) * 0xBF58476D1CE4E5B9;
+    a_value = (a_value ^ a_value >> 27) * 0x94D049BB133111EB;
+    return a_value ^ a_value >> 31;
+}
+
+void placeTree(World::Chunk &a_chunk, const BlockPos &a_base)
+{
+    for (int32_t y = 3; y <= g_trunkHeight + 1; y++)
+    {
+        // Two wide layers around the top of the trunk & two narrow ones above them
+        const int32_t radius = y < g_trunkHeight ? 2 : 1;
+        for (int32_t x = -radius; x <= radius; x++)
+        {
+            for (int32_t z = -radius; z <= radius; z++)
+            {
+                if (a_chunk.getBlock(a_base.offset(x, y, z)) == World::Blocks::AIR)
+                    a_chunk.setBlock(a_base.offset(x, y, z), World::Blocks::OAK_LEAVES);
+            }
+        }
+    }
+    for (int32_t y = 0; y < g_trunkHeight; y++)
+    {
+        a_chunk.setBlock(a_base.offset(0, y, 0), World::Blocks::OAK_LOG);
+    }
+}
+
+void WorldGenerator::generate(World::Chunk &a_chunk) const
+{
+    const ChunkPos pos = a_chunk.getPos();
+    const BlockPos origin(pos.x * 16, 0, pos.z * 16);
+    for (int32_t x = 0; x < 16; x++)
+    {
+        for (int32_t z = 0; z < 16; z++)
+        {
+            for (int32_t y = 0; y < SURFACE_Y; y++)
+            {
+                a_chunk.setBlock(origin.offset(x, y, z), y == SURFACE_Y - 1 ? World::Blocks::DIRT : World::Blocks::STONE);
+            }
+            a_chunk.setBlock(origin.offset(x, SURFACE_Y, z), World::Blocks::GRASS_BLOCK);
+        }
+    }
+}
+
+void WorldGenerator::decorate(World::Chunk &a_chunk) const
+{
+    const ChunkPos pos = a_chunk.getPos();
+    uint64_t random = mix(m_seed ^ pos.pack());
+    const uint32_t trees = static_cast<uint32_t>(random % (g_maxTreesPerChunk + 1));
+    for (uint32_t i = 0; i < trees; i++)
+    {
+        random = mix(random);
+        constexpr uint64_t range = 16 - 2 * g_treeMargin;
+        const auto x = static_cast<int32_t>(random % range) + g_treeMargin;
+        const auto z = static_cast<int32_t>(random / range % range) + g_treeMargin;
+        placeTree(a_chunk, {pos.x * 16 + x, SURFACE_Y + 1, pos.z * 16 + z});
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+
+#include "World/Chunk.h"
+
+// Flat terrain until there is real world generation: stone, a layer of dirt & grass on top, with a few trees
+// Only reads its seed, so any number of chunks can be generated & decorated on different threads at once
+class WorldGenerator final
+{
+public:
+    // Top of the terrain, the grass layer
+    static constexpr int32_t SURFACE_Y = 3;
+
+    explicit WorldGenerator(const uint64_t a_seed)
+        : m_seed(a_seed) {}
+
+    void generate(World::Chunk &a_chunk) const;
+
+    // Trees are kept inside their own chunk, so decorating doesn't depend on the neighbors being generated
+    void decorate(World::Chunk &a_chunk) const;
+
+private:
+    uint64_t m_seed;
+};
@@ -0,0 +1,322 @@
+#include <bit>
+#include <format>
+#include <optional>
+#include <stdexcept>
+
+#include "libdeflate.h"
+
+#include "../Common-Lib/Logging.h"
+#include "Memory/MemoryTracker.h"
+#include "Network/SectionEncoding.h"
+#include "WorldStorage.h"
+
+using World::ChunkPos, World::MIN_SECTION_Y, World::SECTIONS_PER_CHUNK;
+
+constexpr int g_compressionLevel = 6;
+
+WorldStorage::WorldStorage(Utils::FileService &a_files, std::filesystem::path a_directory)
+    : m_files(a_files), m_directory(std::move(a_directory))
+{
+    std::filesystem::create_directories(m_directory);
+}
+
+WorldStorage::~WorldStorage()
+{
+    flush();
+
+    for (libdeflate_compressor *compressor: m_compressors)
+    {
+        libdeflate_free_compressor(compressor);
+    }
+    for (libdeflate_decompressor *decompressor: m_decompressors)
+    {
+        libdeflate_free_decompressor(decompressor);
+    }
+}
+
+size_t WorldStorage::save(World::Chunk &a_chunk)
+{
+    if (a_chunk.getDirtySections() == 0)
+        return 0;
+
+    std::lock_guard lock(m_mutex);
+    const size_t sections = snapshot(a_chunk);
+    startWrites();
+    return sections;
+}
+
+size_t WorldStorage::save(World::ChunkMap &a_world)
+{
+    // One lock for the whole world, the writes start on the file service while the tick continues
+    std::lock_guard lock(m_mutex);
+    size_t sections = 0;
+    for (const auto &[pos, chunk]: a_world.getChunks())
+    {
+        if (chunk->getDirtySections() != 0)
+            sections += snapshot(*chunk);
+    }
+    startWrites();
+    return sections;
+}
+
+void WorldStorage::restore(World::Chunk &a_chunk, RestoredFunction a_onRestored)
+{
+    asio::co_spawn(m_files.getContext(), restoreSections(a_chunk), [onRestored = std::move(a_onRestored)](const std::exception_ptr a_error) mutable
+    {
+        onRestored(a_error);
+    });
+}
+
+void WorldStorage::flush()
+{
+    std::unique_lock lock(m_mutex);
+    m_written.wait(lock, [this]
+    {
+        return m_pending.empty() && m_writing.empty();
+    });
+}
+
+WorldStorage::Stats WorldStorage::getStats() const
+{
+    std::lock_guard lock(m_mutex);
+    Stats stats = m_stats;
+    stats.pendingChunks = m_pending.size();
+    return stats;
+}
+
+size_t WorldStorage::snapshot(World::Chunk &a_chunk)
+{
+    const uint32_t dirty = a_chunk.getDirtySections();
+    const auto [pending, inserted] = m_pending.try_emplace(a_chunk.getPos());
+    if (inserted)
+        m_queue.push_back(a_chunk.getPos());
+
+    for (int32_t i = 0; i < SECTIONS_PER_CHUNK; i++)
+    {
+        if ((dirty >> i & 1) != 0)
+            pending->second.sections[i] = a_chunk.shareSection(MIN_SECTION_Y + i);
+    }
+    pending->second.dirty |= dirty;
+    a_chunk.clearDirtySections();
+    m_stats.savedSections += std::popcount(dirty);
+    return std::popcount(dirty);
+}
+
+void WorldStorage::startWrites()
+{
+    while (m_writing.size() < MAX_RUNNING_WRITES && !m_queue.empty())
+    {
+        const ChunkPos pos = m_queue.front();
+        m_queue.pop_front();
+        // Queued again once its running write finished
+        const auto pending = m_pending.find(pos);
+        if (pending == m_pending.end() || m_writing.contains(pos))
+            continue;
+
+        const PendingChunk &chunk = m_writing.emplace(pos, std::move(pending->second)).first->second;
+        m_pending.erase(pending);
+        asio::co_spawn(m_files.getContext(), write(pos, chunk), asio::detached);
+    }
+}
+
+asio::awaitable<void> WorldStorage::restoreSections(World::Chunk &a_chunk)
+{
+    // Newest last: what's stored, what's being written & what's waiting to be written
+    std::optional<PendingChunk> writing;
+    std::optional<PendingChunk> pending;
+    {
+        std::lock_guard lock(m_mutex);
+        if (const auto found = m_writing.find(a_chunk.getPos()); found != m_writing.end())
+            writing = found->second;
+        if (const auto found = m_pending.find(a_chunk.getPos()); found != m_pending.end())
+            pending = found->second;
+    }
+
+    for (auto &[index, section]: co_await readSections(a_chunk.getPos()))
+    {
+        a_chunk.setSection(MIN_SECTION_Y + index, std::move(section));
+    }
+    for (const std::optional<PendingChunk> &unwritten: {writing, pending})
+    {
+        if (!unwritten.has_value())
+            continue;
+
+        for (int32_t i = 0; i < SECTIONS_PER_CHUNK; i++)
+        {
+            if ((unwritten->dirty >> i & 1) == 0)
+                continue;
+
+            const std::shared_ptr<const World::ChunkSection> &section = unwritten->sections[i];
+            a_chunk.setSection(MIN_SECTION_Y + i, section == nullptr ? nullptr : std::make_unique<World::ChunkSection>(*section));
+        }
+    }
+}
+
+asio::awaitable<void> WorldStorage::write(const ChunkPos a_pos, const PendingChunk a_chunk)
+{
+    Network::ByteBuffer compressed(Memory::getTrackedResource(Memory::MemoryTag::Chunks));
+    libdeflate_compressor *compressor = nullptr;
+    {
+        std::lock_guard lock(m_mutex);
+        if (!m_compressors.empty())
+        {
+            compressor = m_compressors.back();
+            m_compressors.pop_back();
+        }
+    }
+
+    bool failed = false;
+    try
+    {
+        if (compressor == nullptr)
+            compressor = libdeflate_alloc_compressor(g_compressionLevel);
+        if (compressor == nullptr)
+            throw std::runtime_error("Failed to allocate a compressor");
+
+        // Sections that weren't saved this time keep what was stored for them
+        const StoredSections stored = co_await readSections(a_pos);
+        std::vector<Network::IndexedSection> sections;
+        for (int32_t i = 0; i < SECTIONS_PER_CHUNK; i++)
+        {
+            if ((a_chunk.dirty >> i & 1) != 0)
+            {
+                sections.push_back({i, a_chunk.sections[i].get()});
+                continue;
+            }
+            for (const auto &[index, section]: stored)
+            {
+                if (index == i)
+                    sections.push_back({i, section.get()});
+            }
+        }
+
+        Network::ByteBuffer encoded(Memory::getTrackedResource(Memory::MemoryTag::Chunks));
+        Network::encodeChunkSections(sections, encoded);
+
+        // The size before compression, then the zlib stream
+        compressed.resize(sizeof(uint32_t) + libdeflate_zlib_compress_bound(compressor, encoded.size()));
+        const size_t compressedSize = libdeflate_zlib_compress(compressor, encoded.data(), encoded.size(),
+                                                               compressed.data() + sizeof(uint32_t),
+                                                               compressed.size() - sizeof(uint32_t));
+        if (compressedSize == 0)
+            throw std::runtime_error("Failed to compress the sections");
+        compressed.resize(sizeof(uint32_t) + compressedSize);
+        Network::PacketWriter(compressed).writeInteger(static_cast<uint32_t>(encoded.size()));
+
+        RegionFile *region;
+        {
+            std::lock_guard lock(m_regionMutex);
+            region = getRegion(a_pos, true);
+        }
+        co_await region->write(a_pos, compressed);
+    } catch (const std::exception &e)
+    {
+        Logging::getLogger("WorldStorage")->error("Failed to save chunk {}, {}: {}", a_pos.x, a_pos.z, e.what());
+        failed = true;
+    }
+
+    if (compressor != nullptr)
+    {
+        std::lock_guard lock(m_mutex);
+        m_compressors.push_back(compressor);
+    }
+    finishWrite(a_pos, compressed.size(), failed);
+}
+
+void WorldStorage::finishWrite(const ChunkPos a_pos, const size_t a_bytes, const bool a_failed)
+{
+    std::lock_guard lock(m_mutex);
+    const auto writing = m_writing.find(a_pos);
+    if (!a_failed)
+    {
+        m_stats.writtenChunks++;
+        m_stats.writtenBytes += a_bytes;
+    }
+    else if (++writing->second.failedWrites >= MAX_WRITE_ATTEMPTS)
+    {
+        m_stats.failedWrites++;
+        m_stats.lostChunks++;
+        Logging::getLogger("WorldStorage")->error("Giving up on chunk {}, {} after {} failed writes", a_pos.x, a_pos.z, MAX_WRITE_ATTEMPTS);
+    }
+    else
+    {
+        m_stats.failedWrites++;
+        // Sections saved again meanwhile are newer than the ones that failed
+        PendingChunk &failed = writing->second;
+        const auto [pending, inserted] = m_pending.try_emplace(a_pos, std::move(failed));
+        if (!inserted)
+        {
+            for (int32_t i = 0; i < SECTIONS_PER_CHUNK; i++)
+            {
+                if ((failed.dirty >> i & 1) != 0 && (pending->second.dirty >> i & 1) == 0)
+                    pending->second.sections[i] = std::move(failed.sections[i]);
+            }
+            pending->second.dirty |= failed.dirty;
+            pending->second.failedWrites = failed.failedWrites;
+        }
+    }
+    m_writing.erase(writing);
+    if (m_pending.contains(a_pos))
+        m_queue.push_back(a_pos);
+    startWrites();
+    // Still locked, flush() in the destructor could otherwise return & destroy m_written before this notifies it
+    m_written.notify_all();
+}
+
+RegionFile *WorldStorage::getRegion(const ChunkPos a_chunk, const bool a_create)
+{
+    const ChunkPos region = RegionFile::getRegion(a_chunk);
+    if (const auto found = m_regions.find(region); found != m_regions.end())
+        return found->second.get();
+
+    const std::filesystem::path path = m_directory / RegionFile::getFileName(region);
+    if (!a_create && !std::filesystem::exists(path))
+        return nullptr;
+    return m_regions.emplace(region, std::make_unique<RegionFile>(m_files, path)).first->second.get();
+}
+
+asio::awaitable<WorldStorage::StoredSections> WorldStorage::readSections(const ChunkPos a_pos)
+{
+    RegionFile *region;
+    {
+        std::lock_guard lock(m_regionMutex);
+        region = getRegion(a_pos, false);
+    }
+    Network::ByteBuffer stored(Memory::getTrackedResource(Memory::MemoryTag::Chunks));
+    if (region == nullptr || !co_await region->read(a_pos, stored))
+        co_return StoredSections{};
+
+    Network::PacketReader reader(stored);
+    const auto encodedSize = reader.readInteger<uint32_t>();
+    if (reader.hasFailed() || encodedSize > RegionFile::SECTOR_SIZE * SECTIONS_PER_CHUNK * 8)
+        throw std::runtime_error(std::format("Stored chunk {}, {} is corrupted", a_pos.x, a_pos.z));
+
+    libdeflate_decompressor *decompressor = nullptr;
+    {
+        std::lock_guard lock(m_regionMutex);
+        if (!m_decompressors.empty())
+        {
+            decompressor = m_decompressors.back();
+            m_decompressors.pop_back();
+        }
+    }
+    if (decompressor == nullptr)
+    {
+        decompressor = libdeflate_alloc_decompressor();
+        if (decompressor == nullptr)
+            throw std::runtime_error("Failed to allocate a decompressor");
+    }
+
+    Network::ByteBuffer encoded(Memory::getTrackedResource(Memory::MemoryTag::Chunks));
+    encoded.resize(encodedSize);
+    size_t actualSize = 0;
+    const libdeflate_result result = libdeflate_zlib_decompress(decompressor, stored.data() + sizeof(uint32_t), stored.size() - sizeof(uint32_t),
+                                                                encoded.data(), encoded.size(), &actualSize);
+    {
+        std::lock_guard lock(m_regionMutex);
+        m_decompressors.push_back(decompressor);
+    }
+    if (result != LIBDEFLATE_SUCCESS || actualSize != encoded.size())
+        throw std::runtime_error(std::format("Stored chunk {}, {} is corrupted", a_pos.x, a_pos.z));
+    co_return Network::decodeChunkSections(encoded);
+}
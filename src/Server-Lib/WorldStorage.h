@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "asio.hpp"
+
+#include "Utils/FileService.h"
+#include "Utils/UniqueFunction.h"
+#include "World/ChunkMap.h"
+#include "RegionFile.h"
+
+struct libdeflate_compressor;
+struct libdeflate_decompressor;
+
+// Stores the sections of the server world that changed since their chunk was generated in region files & puts them
+// back into the chunks once they're generated again; sections that never changed are never written
+// Saving only takes a copy-on-write snapshot of the dirty sections on the ticking thread (the chunks copy a shared
+// section before changing it), merging them with what was stored before, compressing & writing runs as coroutines on
+// the file service, up to MAX_RUNNING_WRITES chunks at a time & alongside the reads of restore()
+class WorldStorage final
+{
+public:
+    static constexpr size_t MAX_RUNNING_WRITES = 16;
+    // A chunk whose write failed is queued again with whatever was saved for it meanwhile, until it failed this often
+    static constexpr uint32_t MAX_WRITE_ATTEMPTS = 3;
+
+    struct Stats
+    {
+        // Waiting to be written
+        size_t pendingChunks = 0;
+        // Since the storage was created
+        size_t savedSections = 0;
+        size_t writtenChunks = 0;
+        size_t writtenBytes = 0;
+        // Every attempt counts
+        size_t failedWrites = 0;
+        // Chunks whose sections were dropped after MAX_WRITE_ATTEMPTS
+        size_t lostChunks = 0;
+    };
+
+    // Creates the directory if it doesn't exist
+    WorldStorage(Utils::FileService &a_files, std::filesystem::path a_directory);
+
+    WorldStorage(const WorldStorage &) = delete;
+
+    WorldStorage &operator=(const WorldStorage &) = delete;
+
+    // Writes everything that was saved
+    ~WorldStorage();
+
+    // Snapshots the dirty sections of the chunk & clears its dirty bits, returns how many sections were saved
+    size_t save(World::Chunk &a_chunk);
+
+    // Saves every chunk of the world, cheap enough to call between two ticks
+    size_t save(World::ChunkMap &a_world);
+
+    // Called on the file service once a chunk was restored, with what was thrown if it failed
+    using RestoredFunction = Utils::UniqueFunction<void(std::exception_ptr)>;
+
+    // Replaces the sections of a freshly generated chunk with the stored ones, including saves that weren't written
+    // yet; reads on the file service without blocking the caller, the chunk isn't touched by anyone else until
+    // a_onRestored is called
+    void restore(World::Chunk &a_chunk, RestoredFunction a_onRestored);
+
+    // Blocks until everything saved so far is written
+    void flush();
+
+    [[nodiscard]]
+    Stats getStats() const;
+
+private:
+    // Section index & the section, nullptr is air
+    using StoredSections = std::vector<std::pair<int32_t, std::unique_ptr<World::ChunkSection>>>;
+
+    // Sections of one chunk that weren't written yet, bit i of dirty is set for sections[i], nullptr is air
+    struct PendingChunk
+    {
+        std::array<std::shared_ptr<const World::ChunkSection>, World::SECTIONS_PER_CHUNK> sections;
+        uint32_t dirty = 0;
+        uint32_t failedWrites = 0;
+    };
+
+    Utils::FileService &m_files;
+    std::filesystem::path m_directory;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_written;
+    // Merged per chunk, a chunk that is saved again before it was written is only written once
+    std::unordered_map<World::ChunkPos, PendingChunk> m_pending;
+    // Chunks in m_pending in the order they were saved first
+    std::deque<World::ChunkPos> m_queue;
+    // Taken out of m_pending while they're written, restore() still has to see them; a chunk that is saved again
+    // meanwhile waits for its write to finish
+    std::unordered_map<World::ChunkPos, PendingChunk> m_writing;
+    std::vector<libdeflate_compressor *> m_compressors;
+    Stats m_stats;
+
+    // Region files are opened on first use & kept open
+    std::mutex m_regionMutex;
+    std::unordered_map<World::ChunkPos, std::unique_ptr<RegionFile>> m_regions;
+    std::vector<libdeflate_decompressor *> m_decompressors;
+
+    // Has to be called with m_mutex locked
+    size_t snapshot(World::Chunk &a_chunk);
+
+    // Has to be called with m_mutex locked, starts writing queued chunks until MAX_RUNNING_WRITES are running
+    void startWrites();
+
+    asio::awaitable<void> restoreSections(World::Chunk &a_chunk);
+
+    asio::awaitable<void> write(World::ChunkPos a_pos, PendingChunk a_chunk);
+
+    // Called on the file service once a write finished, the last thing a write does with the storage
+    void finishWrite(World::ChunkPos a_pos, size_t a_bytes, bool a_failed);
+
+    // nullptr if the region doesn't exist & a_create is false
+    [[nodiscard]]
+    RegionFile *getRegion(World::ChunkPos a_chunk, bool a_create);
+
+    // The stored sections of the chunk, decompressed
+    [[nodiscard]]
+    asio::awaitable<StoredSections> readSections(World::ChunkPos a_pos);
+};
@@ -1,14 +1,35 @@
+#include <csignal>
+
 #include "DedicatedServer.h"
 #include "spdlog/spdlog.h"
 
+DedicatedServer *g_server = nullptr;
+
+void onStopSignal(int)
+{
+    if (g_server != nullptr)
+    {
+        g_server->stop();
+    }
+}
+
 int main()
 {
     try
     {
         DedicatedServer server;
-        return server.run();
+        g_server = &server;
+        std::signal(SIGINT, &onStopSignal);
+        std::signal(SIGTERM, &onStopSignal);
+        server.listen(DedicatedServer::DEFAULT_PORT);
+        server.serveMetrics(DedicatedServer::DEFAULT_METRICS_PORT);
+
+        const int exitCode = server.run();
+        g_server = nullptr;
+        return exitCode;
     } catch (std::exception &e)
     {
+        g_server = nullptr;
         spdlog::critical("An exception occurred while running Server: {}", e.what());
         spdlog::error("Terminating ...");
         spdlog::default_logger()->flush();